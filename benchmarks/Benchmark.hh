@@ -0,0 +1,301 @@
+#ifndef ALEPH_BENCHMARKS_BENCHMARK_HH__
+#define ALEPH_BENCHMARKS_BENCHMARK_HH__
+
+/*
+  Harness for the benchmarks shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  Every benchmark executable consists of a set of cases, each of which
+  is run repeatedly. For every case, the harness reports a single JSON
+  object per line, containing the wall time of the repetitions, the peak
+  heap memory, the number of allocations, and the throughput. Results of
+  different releases can thus be compared by a script.
+
+  The harness replaces the global allocation functions in order to track
+  the heap memory. Hence, this header must only be included by the file
+  containing `main()`.
+*/
+
+#define ALEPH_WITH_HEAP_STATISTICS
+
+#include <aleph/utilities/AllocationCounter.hh>
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <getopt.h>
+
+namespace aleph
+{
+
+namespace benchmarks
+{
+
+namespace detail
+{
+
+/** Formats a value as a JSON string, escaping all special characters */
+inline std::string quote( const std::string& s )
+{
+  std::ostringstream stream;
+  stream << "\"";
+
+  for( auto&& c : s )
+  {
+    if( c == '"' || c == '\\' )
+      stream << "\\" << c;
+    else if( static_cast<unsigned char>( c ) < 0x20 )
+      stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>( c ) << std::dec;
+    else
+      stream << c;
+  }
+
+  stream << "\"";
+  return stream.str();
+}
+
+} // namespace detail
+
+/**
+  @class Parameters
+  @brief Parameters of a benchmark case
+
+  Stores the parameters that describe a case, such as the number of
+  points or the representation of the boundary matrix, in the order in
+  which they have been added.
+*/
+
+class Parameters
+{
+public:
+  Parameters& operator()( const std::string& name, const std::string& value )
+  {
+    _parameters.emplace_back( name, detail::quote( value ) );
+    return *this;
+  }
+
+  Parameters& operator()( const std::string& name, const char* value )
+  {
+    return this->operator()( name, std::string( value ) );
+  }
+
+  template <class T, class = typename std::enable_if< std::is_arithmetic<T>::value >::type>
+  Parameters& operator()( const std::string& name, T value )
+  {
+    std::ostringstream stream;
+    stream << std::setprecision( std::numeric_limits<T>::digits10 + 1 ) << value;
+
+    _parameters.emplace_back( name, stream.str() );
+    return *this;
+  }
+
+  /** @returns JSON object of all parameters */
+  std::string toJSON() const
+  {
+    std::string result = "{";
+
+    for( auto it = _parameters.begin(); it != _parameters.end(); ++it )
+    {
+      if( it != _parameters.begin() )
+        result += ", ";
+
+      result += detail::quote( it->first ) + ": " + it->second;
+    }
+
+    return result + "}";
+  }
+
+private:
+  std::vector< std::pair<std::string, std::string> > _parameters;
+};
+
+/**
+  @class Runner
+  @brief Runs the cases of a benchmark and reports their results
+
+  Parses the common command-line options of all benchmarks:
+
+  - `--repetitions N`: number of repetitions of every case
+  - `--output FILE`: appends results to a file instead of writing them
+    to `stdout`
+  - `--quick`: uses smaller workloads, e.g. for smoke tests
+
+  All remaining arguments are available as input files, which permits
+  benchmarking real data sets in addition to synthetic ones.
+*/
+
+class Runner
+{
+public:
+  Runner( const std::string& benchmark, int argc, char** argv )
+    : _benchmark( benchmark )
+  {
+    static option commandLineOptions[] =
+    {
+      { "output"     , required_argument, nullptr, 'o' },
+      { "quick"      , no_argument      , nullptr, 'q' },
+      { "repetitions", required_argument, nullptr, 'r' },
+      { nullptr      , 0                , nullptr,  0  }
+    };
+
+    std::string output;
+
+    int option = 0;
+    while( ( option = getopt_long( argc, argv, "o:qr:", commandLineOptions, nullptr ) ) != -1 )
+    {
+      switch( option )
+      {
+      case 'o':
+        output = optarg;
+        break;
+      case 'q':
+        _quick = true;
+        break;
+      case 'r':
+        _repetitions = static_cast<unsigned>( std::stoul( optarg ) );
+        break;
+      default:
+        throw std::runtime_error( "Usage: " + benchmark + " [--output FILE] [--quick] [--repetitions N] [FILENAMES]" );
+      }
+    }
+
+    if( _repetitions == 0 )
+      throw std::runtime_error( "Number of repetitions must be positive" );
+
+    for( int i = optind; i < argc; i++ )
+      _inputs.push_back( argv[i] );
+
+    if( !output.empty() )
+    {
+      _file.open( output, std::ios::app );
+
+      if( !_file )
+        throw std::runtime_error( "Unable to open output file" );
+    }
+  }
+
+  bool quick() const noexcept
+  {
+    return _quick;
+  }
+
+  const std::vector<std::string>& inputs() const noexcept
+  {
+    return _inputs;
+  }
+
+  /**
+    Runs a case and reports its results. The functor is called once for
+    every repetition and has to return the number of items it processed,
+    such as the number of simplices or bytes. This number is used for
+    calculating the throughput.
+
+    @param name       Name of the case
+    @param parameters Parameters of the case
+    @param unit       Unit of the items
+    @param f          Functor for running the case
+  */
+
+  template <class Functor> void run( const std::string& name,
+                                     const Parameters& parameters,
+                                     const std::string& unit,
+                                     Functor f )
+  {
+    auto&& heap = aleph::utilities::HeapStatistics::instance();
+
+    std::vector<double> seconds;
+    std::uint64_t peakBytes   = 0;
+    std::uint64_t allocations = 0;
+    std::size_t items         = 0;
+
+    for( unsigned i = 0; i < _repetitions; i++ )
+    {
+      heap.resetPeak();
+
+      auto baseline       = heap.current();
+      auto numAllocations = heap.allocations();
+
+      aleph::utilities::Timer timer;
+      items = f();
+      seconds.push_back( timer.elapsed_s() );
+
+      peakBytes   = std::max( peakBytes, heap.peak() - baseline );
+      allocations = heap.allocations() - numAllocations;
+    }
+
+    std::sort( seconds.begin(), seconds.end() );
+
+    auto n      = seconds.size();
+    auto median = n % 2 == 1 ? seconds[n/2] : 0.5 * ( seconds[n/2 - 1] + seconds[n/2] );
+    auto mean   = std::accumulate( seconds.begin(), seconds.end(), 0.0 ) / static_cast<double>( n );
+
+    std::ostringstream stream;
+    stream << std::setprecision( 9 )
+           << "{"
+           << "\"benchmark\": "      << detail::quote( _benchmark ) << ", "
+           << "\"case\": "           << detail::quote( name )       << ", "
+           << "\"parameters\": "     << parameters.toJSON()         << ", "
+           << "\"repetitions\": "    << n                           << ", "
+           << "\"seconds_min\": "    << seconds.front()             << ", "
+           << "\"seconds_median\": " << median                      << ", "
+           << "\"seconds_mean\": "   << mean                        << ", "
+           << "\"seconds_max\": "    << seconds.back()              << ", "
+           << "\"peak_bytes\": "     << peakBytes                   << ", "
+           << "\"allocations\": "    << allocations                 << ", "
+           << "\"items\": "          << items                       << ", "
+           << "\"unit\": "           << detail::quote( unit )       << ", "
+           << "\"throughput\": "     << ( median > 0 ? static_cast<double>( items ) / median : 0.0 )
+           << "}\n";
+
+    if( _file.is_open() )
+      _file << stream.str() << std::flush;
+    else
+      std::cout << stream.str() << std::flush;
+
+    std::cerr << "* " << _benchmark << "/" << name << " " << parameters.toJSON()
+              << ": " << median << "s\n";
+  }
+
+private:
+  std::string _benchmark;
+
+  unsigned _repetitions = 5;
+  bool _quick           = false;
+
+  std::vector<std::string> _inputs;
+  std::ofstream _file;
+};
+
+/**
+  Prevents the compiler from removing a computation whose result is not
+  used otherwise.
+*/
+
+template <class T> void doNotOptimize( const T& value )
+{
+  static const void* volatile sink = nullptr;
+
+  sink = &value;
+  (void) sink;
+}
+
+} // namespace benchmarks
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef ALEPH_BENCHMARKS_REDUCTIONS_HH__
+#define ALEPH_BENCHMARKS_REDUCTIONS_HH__
+
+#include "Benchmark.hh"
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/persistentHomology/algorithms/Standard.hh>
+#include <aleph/persistentHomology/algorithms/Twist.hh>
+
+#include <aleph/topology/representations/Heap.hh>
+#include <aleph/topology/representations/List.hh>
+#include <aleph/topology/representations/Set.hh>
+#include <aleph/topology/representations/Vector.hh>
+
+#include <string>
+
+namespace aleph
+{
+
+namespace benchmarks
+{
+
+namespace detail
+{
+
+template <class ReductionAlgorithm, class Representation, class SimplicialComplex>
+void benchmarkReduction( Runner& runner,
+                         Parameters parameters,
+                         const std::string& algorithm,
+                         const std::string& representation,
+                         const SimplicialComplex& K )
+{
+  parameters( "algorithm", algorithm )
+            ( "representation", representation );
+
+  runner.run( "persistent_homology", parameters, "simplices",
+    [&K] ()
+    {
+      auto diagrams = aleph::calculatePersistenceDiagrams<ReductionAlgorithm, Representation>( K );
+      doNotOptimize( diagrams );
+
+      return K.size();
+    }
+  );
+}
+
+template <class ReductionAlgorithm, class SimplicialComplex>
+void benchmarkRepresentations( Runner& runner,
+                               const Parameters& parameters,
+                               const std::string& algorithm,
+                               const SimplicialComplex& K )
+{
+  using namespace aleph::topology::representations;
+
+  using Index = unsigned;
+
+  benchmarkReduction<ReductionAlgorithm, Vector<Index> >( runner, parameters, algorithm, "Vector", K );
+  benchmarkReduction<ReductionAlgorithm, Heap<Index>   >( runner, parameters, algorithm, "Heap",   K );
+  benchmarkReduction<ReductionAlgorithm, Set<Index>    >( runner, parameters, algorithm, "Set",    K );
+  benchmarkReduction<ReductionAlgorithm, List<Index>   >( runner, parameters, algorithm, "List",   K );
+}
+
+} // namespace detail
+
+/**
+  Benchmarks the calculation of persistence diagrams of a simplicial
+  complex, which has to be in filtration order, for all combinations
+  of boundary matrix representations and reduction algorithms. This
+  includes the creation of the boundary matrix, as its costs depend
+  on the representation.
+
+  @param runner     Benchmark runner
+  @param parameters Parameters describing the simplicial complex
+  @param K          Simplicial complex
+*/
+
+template <class SimplicialComplex> void benchmarkReductions( Runner& runner,
+                                                             const Parameters& parameters,
+                                                             const SimplicialComplex& K )
+{
+  using namespace aleph::persistentHomology::algorithms;
+
+  detail::benchmarkRepresentations<Standard>( runner, parameters, "Standard", K );
+  detail::benchmarkRepresentations<Twist>   ( runner, parameters, "Twist",    K );
+}
+
+} // namespace benchmarks
+
+} // namespace aleph
+
+#endif
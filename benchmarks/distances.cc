@@ -0,0 +1,122 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It measures the calculation of the bottleneck distance and of the
+  Wasserstein distance for pairs of persistence diagrams of growing
+  size. Synthetic persistence diagrams have uniformly-distributed
+  creation values and exponentially-distributed persistence values,
+  so that most of their points are close to the diagonal. Additional
+  persistence diagrams may be specified as input files, in which case
+  all pairs of consecutive diagrams are compared.
+*/
+
+#include "Benchmark.hh"
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/Bottleneck.hh>
+#include <aleph/persistenceDiagrams/distances/Wasserstein.hh>
+
+#include <aleph/persistenceDiagrams/io/Raw.hh>
+
+#include <aleph/utilities/Filesystem.hh>
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using DataType           = double;
+using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
+
+PersistenceDiagram makePersistenceDiagram( std::size_t n, std::mt19937& rng )
+{
+  std::uniform_real_distribution<DataType> creation;
+  std::exponential_distribution<DataType> persistence( 10.0 );
+
+  PersistenceDiagram D;
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto x = creation( rng );
+    auto y = x + persistence( rng );
+
+    D.add( x, y );
+  }
+
+  return D;
+}
+
+void benchmark( aleph::benchmarks::Runner& runner,
+                const std::string& name,
+                const PersistenceDiagram& D1,
+                const PersistenceDiagram& D2 )
+{
+  aleph::benchmarks::Parameters parameters;
+  parameters( "diagrams", name )
+            ( "points", D1.size() + D2.size() );
+
+  auto points = D1.size() + D2.size();
+
+  runner.run( "bottleneck_distance", parameters, "points",
+    [&] ()
+    {
+      auto d = aleph::distances::bottleneckDistance( D1, D2 );
+      aleph::benchmarks::doNotOptimize( d );
+
+      return points;
+    }
+  );
+
+  runner.run( "wasserstein_distance", parameters, "points",
+    [&] ()
+    {
+      auto d = aleph::distances::wassersteinDistance( D1, D2 );
+      aleph::benchmarks::doNotOptimize( d );
+
+      return points;
+    }
+  );
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    aleph::benchmarks::Runner runner( "distances", argc, argv );
+
+    std::vector<std::size_t> sizes = { 25, 50, 100, 200 };
+
+    if( runner.quick() )
+      sizes = { 10, 25 };
+
+    std::mt19937 rng( 42 );
+
+    for( auto&& n : sizes )
+    {
+      auto D1 = makePersistenceDiagram( n, rng );
+      auto D2 = makePersistenceDiagram( n, rng );
+
+      benchmark( runner, "random_" + std::to_string( n ), D1, D2 );
+    }
+
+    auto&& inputs = runner.inputs();
+
+    for( std::size_t i = 0; i + 1 < inputs.size(); i++ )
+    {
+      auto D1 = aleph::io::load<DataType>( inputs[i]   );
+      auto D2 = aleph::io::load<DataType>( inputs[i+1] );
+
+      benchmark( runner,
+                 aleph::utilities::basename( inputs[i] ) + "," + aleph::utilities::basename( inputs[i+1] ),
+                 D1, D2 );
+    }
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "Error: " << e.what() << "\n";
+    return -1;
+  }
+}
@@ -0,0 +1,151 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It measures the calculation of sublevel set filtrations of images as
+  well as the calculation of their persistent homology for all boundary
+  matrix representations and reduction algorithms.
+
+  Synthetic images of different sizes consist of randomly-placed bumps
+  with additional noise, resulting in many features of low persistence
+  and a few features of high persistence. Additional images may be
+  specified as input files in the matrix format.
+*/
+
+#include "Benchmark.hh"
+#include "Reductions.hh"
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/topology/io/Matrix.hh>
+
+#include <aleph/utilities/Filesystem.hh>
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cmath>
+
+using DataType          = double;
+using VertexType        = unsigned;
+using Simplex           = aleph::topology::Simplex<DataType, VertexType>;
+using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+using Filtration        = aleph::topology::filtrations::Data<Simplex>;
+
+/**
+  Creates a synthetic image in the matrix format of `MatrixReader`. The
+  image is the sum of Gaussian bumps with random centres and heights.
+*/
+
+std::string makeImage( unsigned size )
+{
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> uniform;
+  std::normal_distribution<DataType> noise( 0.0, 0.05 );
+
+  struct Bump
+  {
+    DataType x;
+    DataType y;
+    DataType height;
+  };
+
+  std::vector<Bump> bumps( 32 );
+
+  for( auto&& bump : bumps )
+    bump = { uniform( rng ), uniform( rng ), uniform( rng ) };
+
+  auto sigma = 0.1;
+
+  std::ostringstream stream;
+
+  for( unsigned i = 0; i < size; i++ )
+  {
+    for( unsigned j = 0; j < size; j++ )
+    {
+      auto x     = static_cast<DataType>( j ) / size;
+      auto y     = static_cast<DataType>( i ) / size;
+      auto value = noise( rng );
+
+      for( auto&& bump : bumps )
+        value += bump.height * std::exp( -( ( x - bump.x ) * ( x - bump.x ) + ( y - bump.y ) * ( y - bump.y ) ) / ( 2 * sigma * sigma ) );
+
+      stream << ( j > 0 ? " " : "" ) << value;
+    }
+
+    stream << "\n";
+  }
+
+  return stream.str();
+}
+
+void benchmark( aleph::benchmarks::Runner& runner, const std::string& name, const std::string& image )
+{
+  aleph::benchmarks::Parameters parameters;
+  parameters( "image", name );
+
+  SimplicialComplex K;
+  std::size_t pixels = 0;
+
+  runner.run( "image_filtration", parameters, "pixels",
+    [&] ()
+    {
+      aleph::topology::io::MatrixReader reader;
+
+      std::istringstream in( image );
+      K = SimplicialComplex();
+
+      reader( in, K );
+      K.sort( Filtration() );
+
+      pixels = reader.width() * reader.height();
+      return pixels;
+    }
+  );
+
+  parameters( "pixels", pixels )
+            ( "simplices", K.size() );
+
+  aleph::benchmarks::benchmarkReductions( runner, parameters, K );
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    aleph::benchmarks::Runner runner( "images", argc, argv );
+
+    std::vector<unsigned> sizes = { 64, 128, 256 };
+
+    if( runner.quick() )
+      sizes = { 16, 32 };
+
+    for( auto&& size : sizes )
+      benchmark( runner, "bumps_" + std::to_string( size ), makeImage( size ) );
+
+    for( auto&& filename : runner.inputs() )
+    {
+      std::ifstream in( filename );
+
+      if( !in )
+        throw std::runtime_error( "Unable to read input file" );
+
+      std::string image( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+      benchmark( runner, aleph::utilities::basename( filename ), image );
+    }
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "Error: " << e.what() << "\n";
+    return -1;
+  }
+}
@@ -0,0 +1,186 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It measures the throughput of readers for large text files, viz. the
+  readers for point clouds, persistence diagrams, matrices (which are
+  used for images), and adjacency matrices. The files are created in a
+  temporary directory and removed afterwards. The throughput is given
+  in bytes per second, including the creation of the data structures.
+*/
+
+#include "Benchmark.hh"
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/persistenceDiagrams/io/Raw.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/io/AdjacencyMatrix.hh>
+#include <aleph/topology/io/Matrix.hh>
+
+#include <aleph/utilities/Filesystem.hh>
+
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+using DataType          = double;
+using VertexType        = unsigned;
+using Simplex           = aleph::topology::Simplex<DataType, VertexType>;
+using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+/**
+  Writes a file of random values with a given number of rows and columns
+  and returns its size in bytes. If the matrix is symmetric, the entry
+  in row i and column j equals the entry in row j and column i.
+*/
+
+std::size_t writeFile( const std::string& filename, std::size_t rows, std::size_t columns, bool symmetric = false )
+{
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> distribution;
+
+  std::vector<DataType> values( rows * columns );
+
+  for( auto&& value : values )
+    value = distribution( rng );
+
+  if( symmetric )
+  {
+    for( std::size_t i = 0; i < rows; i++ )
+      for( std::size_t j = 0; j < i; j++ )
+        values[i * columns + j] = values[j * columns + i];
+  }
+
+  std::ofstream out( filename );
+
+  if( !out )
+    throw std::runtime_error( "Unable to write benchmark file" );
+
+  for( std::size_t i = 0; i < rows; i++ )
+  {
+    for( std::size_t j = 0; j < columns; j++ )
+      out << ( j > 0 ? " " : "" ) << values[i * columns + j];
+
+    out << "\n";
+  }
+
+  return static_cast<std::size_t>( out.tellp() );
+}
+
+/**
+  Benchmarks a reader on a temporary file, which is removed afterwards,
+  regardless of whether the reader succeeds.
+*/
+
+void benchmark( aleph::benchmarks::Runner& runner,
+                const std::string& name,
+                const std::string& directory,
+                std::size_t rows, std::size_t columns, bool symmetric,
+                std::function<void( const std::string& )> read )
+{
+  auto filename = directory + "/aleph_benchmark_" + name + "_" + std::to_string( rows ) + ".txt";
+  auto bytes    = writeFile( filename, rows, columns, symmetric );
+
+  aleph::benchmarks::Parameters parameters;
+  parameters( "rows", rows )
+            ( "columns", columns )
+            ( "bytes", bytes );
+
+  try
+  {
+    runner.run( name, parameters, "bytes",
+      [&] ()
+      {
+        read( filename );
+        return bytes;
+      }
+    );
+  }
+  catch( ... )
+  {
+    std::remove( filename.c_str() );
+    throw;
+  }
+
+  std::remove( filename.c_str() );
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    aleph::benchmarks::Runner runner( "readers", argc, argv );
+
+    auto directory = aleph::utilities::tempDirectory();
+    if( directory.empty() )
+      directory = ".";
+
+    bool quick = runner.quick();
+
+    // The point cloud reader supports different separators, making it
+    // considerably slower than the other readers, so it uses smaller
+    // files in order to keep the running time of the benchmark short.
+    for( std::size_t n : quick ? std::vector<std::size_t>{ 1000, 10000 } : std::vector<std::size_t>{ 10000, 100000 } )
+    {
+      benchmark( runner, "point_cloud", directory, n, 3, false,
+        [] ( const std::string& filename )
+        {
+          auto pointCloud = aleph::containers::load<DataType>( filename );
+          aleph::benchmarks::doNotOptimize( pointCloud );
+        }
+      );
+    }
+
+    for( std::size_t n : quick ? std::vector<std::size_t>{ 1000, 10000 } : std::vector<std::size_t>{ 10000, 100000, 1000000 } )
+    {
+      benchmark( runner, "persistence_diagram", directory, n, 2, false,
+        [] ( const std::string& filename )
+        {
+          auto D = aleph::io::load<DataType>( filename );
+          aleph::benchmarks::doNotOptimize( D );
+        }
+      );
+    }
+
+    for( std::size_t n : quick ? std::vector<std::size_t>{ 32, 64 } : std::vector<std::size_t>{ 128, 256, 512 } )
+    {
+      benchmark( runner, "matrix", directory, n, n, false,
+        [] ( const std::string& filename )
+        {
+          SimplicialComplex K;
+
+          aleph::topology::io::MatrixReader reader;
+          reader( filename, K );
+        }
+      );
+    }
+
+    for( std::size_t n : quick ? std::vector<std::size_t>{ 50, 100 } : std::vector<std::size_t>{ 250, 500, 1000 } )
+    {
+      benchmark( runner, "adjacency_matrix", directory, n, n, true,
+        [] ( const std::string& filename )
+        {
+          SimplicialComplex K;
+
+          aleph::topology::io::AdjacencyMatrixReader reader;
+          reader( filename, K );
+        }
+      );
+    }
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "Error: " << e.what() << "\n";
+    return -1;
+  }
+}
@@ -0,0 +1,263 @@
+/*
+  This is a benchmark shipped by 'Aleph - A Library for Exploring
+  Persistent Homology'.
+
+  It measures the construction of Vietoris--Rips complexes, i.e. the
+  calculation of their 1-skeleton and their expansion, as well as the
+  calculation of their persistent homology for all representations of
+  boundary matrices and all reduction algorithms. In addition, it
+  measures the expansion after collapsing the edges of the skeleton,
+  as well as the construction of alpha complexes, which are smaller
+  alternatives for low-dimensional point clouds.
+
+  Finally, it measures the detection of apparent pairs and reports how
+  many of the finite persistence pairs are apparent. Since apparent
+  pairs require no column additions, this fraction indicates how much
+  of a complex is already reduced by construction.
+
+  Synthetic point clouds are sampled uniformly from the unit cube, at
+  different scales. Additional point clouds may be specified as input
+  files. For every point cloud, the threshold of the complex is chosen
+  as the median distance of a point to its k-th nearest neighbour, so
+  that complexes of different point clouds are comparable.
+*/
+
+#include "Benchmark.hh"
+#include "Reductions.hh"
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/AlphaComplex.hh>
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/RipsExpander.hh>
+#include <aleph/geometry/RipsSkeleton.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/ApparentPairs.hh>
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/topology/Conversions.hh>
+#include <aleph/topology/EdgeCollapse.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/utilities/Filesystem.hh>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+using DataType          = double;
+using PointCloud        = aleph::containers::PointCloud<DataType>;
+using Distance          = aleph::geometry::distances::Euclidean<DataType>;
+using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+using Simplex           = aleph::topology::Simplex<DataType, NearestNeighbours::IndexType>;
+using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+// Number of neighbours that is used for choosing the threshold
+constexpr std::size_t k = 20;
+
+// Maximum dimension of simplices in the expansion
+constexpr unsigned dimension = 2;
+
+PointCloud makeUniformPointCloud( std::size_t n, std::size_t d )
+{
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<DataType> distribution;
+
+  PointCloud pointCloud( n, d );
+  std::vector<DataType> p( d );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    std::generate( p.begin(), p.end(), [&] () { return distribution( rng ); } );
+    pointCloud.set( i, p.begin(), p.end() );
+  }
+
+  return pointCloud;
+}
+
+/**
+  Calculates the median distance of a point to its k-th nearest neighbour
+  by brute force.
+*/
+
+DataType chooseThreshold( const PointCloud& pointCloud )
+{
+  auto n = pointCloud.size();
+  if( n <= k )
+    throw std::runtime_error( "Point cloud has too few points" );
+
+  aleph::geometry::distances::Traits<Distance> traits;
+
+  std::vector<DataType> thresholds;
+  thresholds.reserve( n );
+
+  std::vector< std::vector<DataType> > points;
+  points.reserve( n );
+
+  for( std::size_t i = 0; i < n; i++ )
+    points.push_back( pointCloud[i] );
+
+  std::vector<DataType> distances( n );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    for( std::size_t j = 0; j < n; j++ )
+      distances[j] = traits.from( Distance()( points[i].begin(), points[j].begin(), pointCloud.dimension() ) );
+
+    // The point itself is its nearest neighbour, so the k-th nearest
+    // neighbour has index k.
+    std::nth_element( distances.begin(), distances.begin() + k, distances.end() );
+    thresholds.push_back( distances[k] );
+  }
+
+  std::nth_element( thresholds.begin(), thresholds.begin() + n/2, thresholds.end() );
+  return thresholds[n/2];
+}
+
+/**
+  Counts the finite persistence pairs of a boundary matrix, i.e. all
+  pairs whose destroyer is a simplex of the complex.
+*/
+
+template <class BoundaryMatrix> std::size_t countFinitePairs( const BoundaryMatrix& M )
+{
+  auto pairing = aleph::calculatePersistencePairing( M );
+  auto n       = M.getNumColumns();
+
+  std::size_t numPairs = 0;
+
+  for( auto&& pair : pairing )
+  {
+    if( pair.second < n )
+      ++numPairs;
+  }
+
+  return numPairs;
+}
+
+void benchmark( aleph::benchmarks::Runner& runner, const std::string& name, const PointCloud& pointCloud )
+{
+  auto epsilon = chooseThreshold( pointCloud );
+
+  aleph::benchmarks::Parameters parameters;
+  parameters( "point_cloud", name )
+            ( "points", pointCloud.size() )
+            ( "dimension", pointCloud.dimension() )
+            ( "epsilon", epsilon );
+
+  NearestNeighbours nearestNeighbours( pointCloud );
+  aleph::geometry::RipsSkeleton<NearestNeighbours> ripsSkeleton;
+  aleph::geometry::RipsExpander<SimplicialComplex> ripsExpander;
+
+  SimplicialComplex skeleton;
+
+  runner.run( "rips_skeleton", parameters, "simplices",
+    [&] ()
+    {
+      skeleton = ripsSkeleton( nearestNeighbours, epsilon );
+      return skeleton.size();
+    }
+  );
+
+  SimplicialComplex K;
+
+  runner.run( "rips_expansion", parameters, "simplices",
+    [&] ()
+    {
+      K = ripsExpander( skeleton, dimension );
+      K = ripsExpander.assignMaximumWeight( K );
+
+      K.sort( aleph::topology::filtrations::Data<Simplex>() );
+      return K.size();
+    }
+  );
+
+  skeleton.sort( aleph::topology::filtrations::Data<Simplex>() );
+
+  SimplicialComplex L;
+
+  runner.run( "rips_edge_collapse", parameters, "simplices",
+    [&] ()
+    {
+      L = aleph::topology::collapseEdges( skeleton );
+      return skeleton.size();
+    }
+  );
+
+  runner.run( "rips_collapsed_expansion", parameters, "simplices",
+    [&] ()
+    {
+      L = ripsExpander( aleph::topology::collapseEdges( skeleton ), dimension );
+      L = ripsExpander.assignMaximumWeight( L );
+
+      L.sort( aleph::topology::filtrations::Data<Simplex>() );
+      return L.size();
+    }
+  );
+
+  // Alpha complexes are only available for two-dimensional and three-
+  // dimensional point clouds. They are not restricted by the threshold
+  // because their size does not depend on it.
+  if( pointCloud.dimension() == 2 || pointCloud.dimension() == 3 )
+  {
+    runner.run( "alpha_complex", parameters, "simplices",
+      [&] ()
+      {
+        return aleph::geometry::buildAlphaComplex( pointCloud ).size();
+      }
+    );
+  }
+
+  parameters( "simplices", K.size() );
+
+  auto M = aleph::topology::makeBoundaryMatrix<aleph::defaults::Representation>( K );
+  std::size_t numApparentPairs = 0;
+
+  runner.run( "apparent_pairs", parameters, "simplices",
+    [&] ()
+    {
+      numApparentPairs = aleph::calculateApparentPairs( M ).size();
+      return K.size();
+    }
+  );
+
+  auto numPairs = countFinitePairs( M );
+
+  parameters( "apparent_pairs", numApparentPairs )
+            ( "apparent_pairs_fraction", numPairs > 0 ? static_cast<double>( numApparentPairs ) / static_cast<double>( numPairs ) : 0.0 );
+
+  aleph::benchmarks::benchmarkReductions( runner, parameters, K );
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    aleph::benchmarks::Runner runner( "rips", argc, argv );
+
+    std::vector<std::size_t> scales = { 500, 1000, 2000, 4000 };
+
+    if( runner.quick() )
+      scales = { 100, 250 };
+
+    for( auto&& n : scales )
+      benchmark( runner, "uniform", makeUniformPointCloud( n, 3 ) );
+
+    for( auto&& filename : runner.inputs() )
+      benchmark( runner, aleph::utilities::basename( filename ), aleph::containers::load<DataType>( filename ) );
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "Error: " << e.what() << "\n";
+    return -1;
+  }
+}
@@ -31,6 +31,7 @@
 // Step functions ------------------------------------------------------
 
 #include <aleph/math/StepFunction.hh>
+#include <aleph/math/SymmetricMatrix.hh>
 
 // Simplicial complexes ------------------------------------------------
 //
@@ -52,6 +53,7 @@
 #include <aleph/persistenceDiagrams/Norms.hh>
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 #include <aleph/persistenceDiagrams/PersistenceIndicatorFunction.hh>
+#include <aleph/persistenceDiagrams/Vectorization.hh>
 
 #include <aleph/persistenceDiagrams/distances/Bottleneck.hh>
 #include <aleph/persistenceDiagrams/distances/Hausdorff.hh>
@@ -70,8 +72,17 @@
 #include <aleph/persistentHomology/ConnectedComponents.hh>
 #include <aleph/persistentHomology/PersistencePairing.hh>
 
+// Instrumentation -----------------------------------------------------
+//
+// Permits profiling calculations from Python. The allocation counter is
+// not installed because the module must not replace the allocation
+// functions of the interpreter, so phases report zero allocations.
+
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <tuple>
 
@@ -656,6 +667,157 @@ void wrapKernelCalculations( py::module& m )
       return aleph::multiScalePseudoMetric( D1, D2, sigma );
     }
   );
+
+  // Converts a symmetric matrix into a square matrix for use in other
+  // Python libraries.
+  auto toArray = [] ( const aleph::math::SymmetricMatrix<double>& M )
+  {
+    auto n = M.numRows();
+
+    py::array_t<double> result( { static_cast<unsigned long>(n), static_cast<unsigned long>(n) } );
+    auto data = result.mutable_data();
+
+    for( std::size_t i = 0; i < n; i++ )
+      for( std::size_t j = 0; j < n; j++ )
+        data[i*n+j] = M(i,j);
+
+    return result;
+  };
+
+  m.def( "multiScaleKernelMatrix",
+    [toArray] ( const std::vector<PersistenceDiagram>& diagrams, double sigma, double epsilon )
+    {
+      return toArray( aleph::multiScaleKernelMatrix( diagrams, sigma, epsilon ) );
+    },
+    "diagrams"_a,
+    "sigma"_a,
+    "epsilon"_a = 0.0
+  );
+
+  m.def( "multiScalePseudoMetricMatrix",
+    [toArray] ( const std::vector<PersistenceDiagram>& diagrams, double sigma, double epsilon )
+    {
+      return toArray( aleph::multiScalePseudoMetricMatrix( diagrams, sigma, epsilon ) );
+    },
+    "diagrams"_a,
+    "sigma"_a,
+    "epsilon"_a = 0.0
+  );
+}
+
+/*
+  Calculates a feature matrix for a set of persistence diagrams and wraps
+  it in a NumPy array that takes ownership of the buffer. Hence, no copy
+  of the features is required.
+*/
+
+template <class Features> py::array_t<float> makeFeatureMatrix( const Features& features,
+                                                                const std::vector<PersistenceDiagram>& diagrams )
+{
+  auto n = diagrams.size();
+  auto m = features.size();
+
+  std::unique_ptr<float[]> buffer( new float[ n*m ] );
+
+  {
+    py::gil_scoped_release release;
+    aleph::calculateFeatureMatrix( features, diagrams, buffer.get() );
+  }
+
+  py::capsule free_when_done( buffer.get(),
+    [] (void* f)
+    {
+      float* buf = reinterpret_cast<float*>( f );
+      delete[] buf;
+    }
+  );
+
+  return py::array_t<float>(
+    {static_cast<unsigned long>(n), static_cast<unsigned long>(m)},                           // shape
+    {static_cast<unsigned long>(m*sizeof(float)), static_cast<unsigned long>(sizeof(float))}, // stride
+    buffer.release(),                                                                         // the data pointer
+    free_when_done);                                                                          // numpy array references this parent
+}
+
+void wrapVectorization( py::module& m )
+{
+  using namespace pybind11::literals;
+
+  m.def( "persistenceImages",
+    [] ( const std::vector<PersistenceDiagram>& diagrams,
+         unsigned width, unsigned height,
+         DataType xMin, DataType xMax,
+         DataType yMin, DataType yMax,
+         double sigma )
+    {
+      aleph::PersistenceImage<DataType> features( width, height, xMin, xMax, yMin, yMax, sigma );
+      return makeFeatureMatrix( features, diagrams );
+    },
+    "diagrams"_a,
+    "width"_a,
+    "height"_a,
+    "xMin"_a,
+    "xMax"_a,
+    "yMin"_a,
+    "yMax"_a,
+    "sigma"_a
+  );
+
+  m.def( "bettiCurves",
+    [] ( const std::vector<PersistenceDiagram>& diagrams, unsigned n, DataType tMin, DataType tMax )
+    {
+      aleph::BettiCurve<DataType> features( n, tMin, tMax );
+      return makeFeatureMatrix( features, diagrams );
+    },
+    "diagrams"_a,
+    "n"_a,
+    "tMin"_a,
+    "tMax"_a
+  );
+}
+
+void wrapInstrumentation( py::module& m )
+{
+  using Recorder = aleph::utilities::instrumentation::Recorder;
+
+  m.def( "instrumentationAvailable",
+    [] ()
+    {
+#ifdef ALEPH_WITH_INSTRUMENTATION
+      return true;
+#else
+      return false;
+#endif
+    }
+  );
+
+  m.def( "enableInstrumentation",
+    [] ()
+    {
+      Recorder::instance().enable();
+    }
+  );
+
+  m.def( "disableInstrumentation",
+    [] ()
+    {
+      Recorder::instance().disable();
+    }
+  );
+
+  m.def( "resetInstrumentation",
+    [] ()
+    {
+      Recorder::instance().reset();
+    }
+  );
+
+  m.def( "instrumentationJSON",
+    [] ()
+    {
+      return Recorder::instance().toJSON();
+    }
+  );
 }
 
 void wrapRipsExpander( py::module& m )
@@ -1185,6 +1347,9 @@ PYBIND11_MODULE(aleph, m)
   wrapPersistenceDiagram(m);
   wrapPersistencePairing(m);
   wrapPersistentHomologyCalculation(m);
+  wrapKernelCalculations(m);
+  wrapVectorization(m);
+  wrapInstrumentation(m);
   wrapRipsExpander(m);
   wrapStepFunction(m);
   wrapInputFunctions(m);
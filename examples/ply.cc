@@ -119,9 +119,9 @@ int main( int argc, char** argv )
   using Simplex           = aleph::topology::Simplex<DataType, VertexType>;
   using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
 
-  // Declares the reader for loading a PLY file. At present, the loading
-  // of binary files is not yet supported (even though some code exists)
-  // and the reader only handles ASCII files properly.
+  // Declares the reader for loading a PLY file. The reader handles ASCII
+  // files as well as binary files in both storage orders. Binary files are
+  // memory-mapped and decoded in bulk.
   //
   // Note that we set a 'data property'. This specifies the attribute of
   // every vertex that is used to assign the data values of simplices in
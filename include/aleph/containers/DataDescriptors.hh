@@ -2,18 +2,22 @@
 #define ALEPH_CONTAINERS_DATA_DESCRIPTORS_HH__
 
 #include <cmath>
+#include <cstddef>
 
 #include <algorithm>
 #include <vector>
 
 #include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/KDTree.hh>
 #include <aleph/geometry/NearestNeighbours.hh>
 
 #include <aleph/geometry/distances/Euclidean.hh>
 #include <aleph/geometry/distances/Traits.hh>
 
 #include <aleph/math/KahanSummation.hh>
+#include <aleph/math/KernelDensityEstimator.hh>
 #include <aleph/math/SymmetricMatrix.hh>
+#include <aleph/math/TreeKernelDensityEstimator.hh>
 
 namespace aleph
 {
@@ -90,6 +94,10 @@ template <class Distance, class Container> std::vector<double> eccentricities( c
   Density estimation using a truncated Gaussian estimator. Points whose
   Euclidean distance is smaller than the bandwidth will not be used for
   estimating the density.
+
+  The points are stored in a k-d tree, so only points that are close to
+  each other have to be compared. Neighbours are processed in the order
+  of their indices, so the results do not depend on the tree.
 */
 
 template <class Container> std::vector<double> estimateDensityTruncatedGaussian( const Container& container, double bandwidth )
@@ -99,32 +107,76 @@ template <class Container> std::vector<double> estimateDensityTruncatedGaussian(
 
   const auto bandwidthSquare = bandwidth * bandwidth;
 
-  std::vector<double> densities;
-  densities.reserve( n );
+  std::vector<double> densities( n );
 
   aleph::geometry::distances::Euclidean<double> distanceFunctor;
+  aleph::geometry::KDTree tree( container );
 
-  for( decltype(n) i = 0; i < n; i++ )
+  #pragma omp parallel
   {
-    auto p                                      = container[i];
-    aleph::math::KahanSummation<double> density = 0.0;
+    std::vector<double> x( d );
+    std::vector<std::size_t> neighbours;
 
-    for( decltype(n) j = 0; j < n; j++ )
+    #pragma omp for schedule(dynamic, 64)
+    for( std::size_t i = 0; i < n; i++ )
     {
-      auto q        = container[j];
-      auto distance = distanceFunctor( p.begin(),
-                                       q.begin(),
-                                       d );
-      if( distance <= bandwidthSquare )
-        density += std::exp( -1.0 * distance / ( 2.0 * bandwidth ) );
-    }
+      auto p = container[i];
+
+      std::copy( p.begin(), p.end(), x.begin() );
+
+      neighbours.clear();
+      tree.radiusSearch( x.data(), bandwidth,
+                         [&neighbours] ( std::size_t j )
+                         {
+                           neighbours.push_back( j );
+                         } );
+
+      std::sort( neighbours.begin(), neighbours.end() );
+
+      aleph::math::KahanSummation<double> density = 0.0;
+
+      for( auto&& j : neighbours )
+      {
+        auto q        = container[j];
+        auto distance = distanceFunctor( p.begin(),
+                                         q.begin(),
+                                         d );
+        if( distance <= bandwidthSquare )
+          density += std::exp( -1.0 * distance / ( 2.0 * bandwidth ) );
+      }
 
-    densities.push_back( density / static_cast<double>(n) );
+      densities[i] = density / static_cast<double>(n);
+    }
   }
 
   return densities;
 }
 
+/**
+  Density estimation using a Gaussian kernel density estimator. The
+  points are stored in a k-d tree, which permits skipping points whose
+  contribution to the density is negligible. This makes the estimator
+  suitable for large point clouds.
+
+  @param container Point cloud
+  @param bandwidth Bandwidth of the estimator
+
+  @param tolerance Relative tolerance of the density estimates; use zero
+                   in order to obtain exact estimates.
+*/
+
+template <class Container> std::vector<double> estimateDensityGaussian( const Container& container,
+                                                                        double bandwidth,
+                                                                        double tolerance = 1e-3 )
+{
+  aleph::math::TreeKernelDensityEstimator<aleph::math::kernels::Gaussian> estimator( container,
+                                                                                      bandwidth,
+                                                                                      aleph::math::kernels::Gaussian(),
+                                                                                      tolerance );
+
+  return estimator.densities();
+}
+
 /**
   Density estimator using the distance to a measure density estimator as
   introduced by Chazal et al. in:
@@ -6,11 +6,15 @@
 #include <aleph/math/Statistics.hh>
 
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace aleph
 {
@@ -90,6 +94,178 @@ template <
   return cds;
 }
 
+namespace detail
+{
+
+/**
+  Determines the smallest positive and the largest distance between all
+  pairs of points of a container. Both values are zero if the container
+  does not contain any two distinct points.
+*/
+
+template <class Distance, class Container> std::pair<double, double> distanceRange( const Container& container, Distance dist )
+{
+  auto n = container.size();
+  auto d = container.dimension();
+
+  aleph::geometry::distances::Traits<Distance> traits;
+
+  double rMin = std::numeric_limits<double>::max();
+  double rMax = 0.0;
+
+  #pragma omp parallel for schedule(dynamic) reduction(min:rMin) reduction(max:rMax)
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto&& p = container[i];
+
+    for( std::size_t j = i+1; j < n; j++ )
+    {
+      auto&& q = container[j];
+      auto r   = static_cast<double>( traits.from( dist( p.begin(), q.begin(), d ) ) );
+
+      if( r > 0 )
+        rMin = std::min( rMin, r );
+
+      rMax = std::max( rMax, r );
+    }
+  }
+
+  if( rMax == 0.0 )
+    rMin = 0.0;
+
+  return std::make_pair( rMin, rMax );
+}
+
+} // namespace detail
+
+/**
+  Calculates samples of the correlation dimension integral for a given
+  point cloud without storing the pairwise distances. Distances are
+  counted in a histogram with logarithmically-spaced bins, so memory
+  requirements only depend on the number of bins. The loop over all
+  pairs of points runs in parallel if OpenMP is available; every thread
+  uses its own histogram, and all histograms are merged at the end.
+
+  The resulting sequence contains one sample for the upper boundary of
+  every bin, i.e. the fraction of pairs whose distance does not exceed
+  the boundary. Bins that do not contain any pairs yet are skipped, so
+  that the sequence may be used to estimate the correlation dimension.
+
+  @param container Point cloud
+  @param numBins   Number of bins, i.e. the resolution of the sequence
+  @param dist      Distance functor
+
+  @param rMin      Smallest radius to consider; distances below this
+                   value are counted in the first bin.
+
+  @param rMax      Largest radius to consider; distances exceeding it
+                   will be ignored.
+
+  If both radii are zero, they will be set to the smallest positive and
+  the largest distance in the point cloud, respectively. This requires
+  an additional pass over all pairs of points.
+*/
+
+template <
+  class Distance,
+  class Container
+> CorrelationDimensionSequence streamingCorrelationDimensionIntegral(
+  const Container& container,
+  unsigned numBins,
+  Distance dist = Distance(),
+  double rMin = 0.0,
+  double rMax = 0.0 )
+{
+  if( numBins == 0 )
+    throw std::runtime_error( "Number of bins must be positive" );
+
+  auto n = container.size();
+  auto d = container.dimension();
+
+  CorrelationDimensionSequence cds;
+
+  if( n < 2 )
+    return cds;
+
+  if( rMin == 0.0 && rMax == 0.0 )
+  {
+    auto range = detail::distanceRange( container, dist );
+    rMin       = range.first;
+    rMax       = range.second;
+
+    // All points coincide, so there is no positive radius at which the
+    // correlation integral could be sampled.
+    if( rMax == 0.0 )
+      return cds;
+  }
+
+  if( !( rMin > 0 ) || rMax < rMin )
+    throw std::runtime_error( "Invalid radius range" );
+
+  aleph::geometry::distances::Traits<Distance> traits;
+
+  // Number of bins per unit of the logarithm of the radius; a range
+  // that consists of a single radius uses one bin only.
+  auto logMin = std::log( rMin );
+  auto scale  = rMax > rMin ? numBins / ( std::log( rMax ) - logMin ) : 0.0;
+
+  std::vector<std::uint64_t> histogram( numBins );
+
+  #pragma omp parallel
+  {
+    std::vector<std::uint64_t> localHistogram( numBins );
+
+    #pragma omp for schedule(dynamic)
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      auto&& p = container[i];
+
+      for( std::size_t j = i+1; j < n; j++ )
+      {
+        auto&& q = container[j];
+        auto r   = static_cast<double>( traits.from( dist( p.begin(), q.begin(), d ) ) );
+
+        if( r > rMax )
+          continue;
+
+        std::size_t bin = 0;
+
+        if( r > rMin )
+          bin = std::min( static_cast<std::size_t>( ( std::log( r ) - logMin ) * scale ), std::size_t( numBins - 1 ) );
+
+        ++localHistogram[bin];
+      }
+    }
+
+    #pragma omp critical
+    {
+      for( std::size_t k = 0; k < numBins; k++ )
+        histogram[k] += localHistogram[k];
+    }
+  }
+
+  auto numPairs = static_cast<double>( n ) * static_cast<double>( n-1 ) * 0.5;
+
+  cds.x.reserve( numBins );
+  cds.y.reserve( numBins );
+
+  std::uint64_t seen = 0;
+  for( std::size_t k = 0; k < numBins; k++ )
+  {
+    seen += histogram[k];
+
+    if( seen == 0 )
+      continue;
+
+    auto radius = scale > 0 ? std::exp( logMin + static_cast<double>( k+1 ) / scale ) : rMax;
+
+    cds.x.push_back( radius );
+    cds.y.push_back( static_cast<double>( seen ) / numPairs );
+  }
+
+  return cds;
+}
+
 /**
   Estimates the correlation dimension from a correlation dimension
   sequence, which involves calculating a log-log plot of the data,
@@ -0,0 +1,374 @@
+#ifndef ALEPH_GEOMETRY_ALPHA_COMPLEX_HH__
+#define ALEPH_GEOMETRY_ALPHA_COMPLEX_HH__
+
+#include <aleph/geometry/DelaunayTriangulation.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/utilities/Instrumentation.hh>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+namespace detail
+{
+
+/**
+  Calculates the smallest circumsphere of a simplex, i.e. the sphere
+  that passes through all of its vertices and whose center lies in the
+  affine hull of the simplex. The vertices need to be affinely
+  independent.
+
+  @returns Pair of the center and the squared radius of the sphere
+*/
+
+template <std::size_t D> std::pair<std::array<double, D>, double> circumsphere( const std::vector< std::array<double, D> >& points )
+{
+  auto&& p0 = points.front();
+  auto k    = points.size() - 1;
+
+  std::array<double, D> center = p0;
+
+  if( k == 0 )
+    return std::make_pair( center, 0.0 );
+
+  // The center is given by p0 + sum_i lambda_i (p_i - p0). Since it
+  // has the same distance to all vertices, the coefficients satisfy a
+  // linear system whose matrix is the Gram matrix of the edge vectors.
+  std::vector< std::array<double, D> > V( k );
+
+  for( std::size_t i = 0; i < k; i++ )
+    for( std::size_t j = 0; j < D; j++ )
+      V[i][j] = points[i+1][j] - p0[j];
+
+  std::vector< std::vector<double> > A( k, std::vector<double>( k+1 ) );
+
+  for( std::size_t i = 0; i < k; i++ )
+  {
+    for( std::size_t j = 0; j < k; j++ )
+      for( std::size_t l = 0; l < D; l++ )
+        A[i][j] += V[i][l] * V[j][l];
+
+    A[i][k] = 0.5 * A[i][i];
+  }
+
+  // Gaussian elimination with partial pivoting; the system has at most
+  // three unknowns.
+  for( std::size_t i = 0; i < k; i++ )
+  {
+    auto pivot = i;
+
+    for( std::size_t j = i+1; j < k; j++ )
+      if( std::abs( A[j][i] ) > std::abs( A[pivot][i] ) )
+        pivot = j;
+
+    std::swap( A[i], A[pivot] );
+
+    for( std::size_t j = i+1; j < k; j++ )
+    {
+      auto factor = A[j][i] / A[i][i];
+
+      for( std::size_t l = i; l <= k; l++ )
+        A[j][l] -= factor * A[i][l];
+    }
+  }
+
+  std::vector<double> lambda( k );
+
+  for( std::size_t i = k; i-- > 0; )
+  {
+    auto sum = A[i][k];
+
+    for( std::size_t j = i+1; j < k; j++ )
+      sum -= A[i][j] * lambda[j];
+
+    lambda[i] = sum / A[i][i];
+  }
+
+  double radius = 0.0;
+
+  for( std::size_t l = 0; l < D; l++ )
+  {
+    double offset = 0.0;
+
+    for( std::size_t i = 0; i < k; i++ )
+      offset += lambda[i] * V[i][l];
+
+    center[l] += offset;
+    radius    += offset * offset;
+  }
+
+  return std::make_pair( center, radius );
+}
+
+template <std::size_t D> double squaredDistance( const std::array<double, D>& p, const std::array<double, D>& q )
+{
+  double result = 0.0;
+
+  for( std::size_t i = 0; i < D; i++ )
+    result += ( p[i] - q[i] ) * ( p[i] - q[i] );
+
+  return result;
+}
+
+/**
+  Calculates the squared alpha values of all simplices of a Delaunay
+  triangulation. The value of a cell is its squared circumradius. The
+  value of any other simplex is its own squared circumradius unless
+  its smallest circumsphere contains the remaining vertex of one of its
+  cofaces. In this case, the simplex is *attached* to the coface, and
+  it obtains the minimum value of all of its cofaces.
+
+  @returns Simplices of every dimension, encoded as sorted vertex
+  indices that are padded with the largest index, along with their
+  squared alpha values
+*/
+
+template <std::size_t D> std::vector< std::pair< std::vector< std::array<std::size_t, D+1> >, std::vector<double> > > calculateAlphaValues( const DelaunayTriangulation<D>& triangulation, const std::vector< std::array<double, D> >& points )
+{
+  using Key = std::array<std::size_t, D+1>;
+
+  constexpr std::size_t padding = std::numeric_limits<std::size_t>::max();
+
+  std::vector< std::vector<Key> > simplices( D+1 );
+
+  for( auto&& cell : triangulation.cells() )
+  {
+    auto vertices = cell;
+    std::sort( vertices.begin(), vertices.end() );
+
+    // Every non-empty subset of the vertices of a cell is a simplex of
+    // the triangulation. The order of the vertices is kept.
+    for( unsigned mask = 1; mask < ( 1u << (D+1) ); mask++ )
+    {
+      Key key;
+      key.fill( padding );
+
+      std::size_t k = 0;
+
+      for( std::size_t i = 0; i <= D; i++ )
+        if( mask & ( 1u << i ) )
+          key[k++] = vertices[i];
+
+      simplices[k-1].push_back( key );
+    }
+  }
+
+  for( auto&& S : simplices )
+  {
+    std::sort( S.begin(), S.end() );
+    S.erase( std::unique( S.begin(), S.end() ), S.end() );
+  }
+
+  auto sphere = [&points] ( const Key& key, std::size_t size )
+  {
+    std::vector< std::array<double, D> > vertices;
+
+    for( std::size_t i = 0; i < size; i++ )
+      vertices.push_back( points[ key[i] ] );
+
+    return circumsphere<D>( vertices );
+  };
+
+  std::vector< std::vector<double> > values( D+1 );
+
+  for( auto&& key : simplices[D] )
+    values[D].push_back( sphere( key, D+1 ).second );
+
+  for( std::size_t d = D; d >= 1; d-- )
+  {
+    auto n = simplices[d-1].size();
+
+    std::vector< std::pair<std::array<double, D>, double> > spheres;
+    spheres.reserve( n );
+
+    for( auto&& key : simplices[d-1] )
+      spheres.push_back( sphere( key, d ) );
+
+    std::vector<double> minima( n, std::numeric_limits<double>::infinity() );
+    std::vector<bool> attached( n, false );
+
+    for( std::size_t i = 0; i < simplices[d].size(); i++ )
+    {
+      auto&& key = simplices[d][i];
+
+      // Removing a vertex from the sorted key results in the sorted key
+      // of a face.
+      for( std::size_t j = 0; j <= d; j++ )
+      {
+        Key face;
+        face.fill( padding );
+
+        std::copy( key.begin(), key.begin() + std::ptrdiff_t( j ), face.begin() );
+        std::copy( key.begin() + std::ptrdiff_t( j+1 ), key.begin() + std::ptrdiff_t( d+1 ), face.begin() + std::ptrdiff_t( j ) );
+
+        auto it    = std::lower_bound( simplices[d-1].begin(), simplices[d-1].end(), face );
+        auto index = static_cast<std::size_t>( std::distance( simplices[d-1].begin(), it ) );
+
+        minima[index] = std::min( minima[index], values[d][i] );
+
+        if( squaredDistance<D>( points[ key[j] ], spheres[index].first ) < spheres[index].second )
+          attached[index] = true;
+      }
+    }
+
+    // The minimum only serves to prevent rounding errors from creating
+    // faces that appear after their cofaces.
+    for( std::size_t i = 0; i < n; i++ )
+      values[d-1].push_back( attached[i] ? minima[i] : std::min( minima[i], spheres[i].second ) );
+
+    if( d == 1 )
+      break;
+  }
+
+  std::vector< std::pair< std::vector<Key>, std::vector<double> > > result;
+
+  for( std::size_t d = 0; d <= D; d++ )
+    result.push_back( std::make_pair( simplices[d], values[d] ) );
+
+  return result;
+}
+
+template <std::size_t D, class Container> auto buildAlphaComplex( const Container& container, typename Container::ElementType r ) -> topology::SimplicialComplex< topology::Simplex<typename Container::ElementType, typename Container::IndexType> >
+{
+  using ElementType       = typename Container::ElementType;
+  using IndexType         = typename Container::IndexType;
+  using Simplex           = topology::Simplex<ElementType, IndexType>;
+  using SimplicialComplex = topology::SimplicialComplex<Simplex>;
+
+  std::vector< std::array<double, D> > points( container.size() );
+
+  for( std::size_t i = 0; i < container.size(); i++ )
+  {
+    auto p = container[ static_cast<IndexType>( i ) ];
+    std::copy( p.begin(), p.end(), points[i].begin() );
+  }
+
+  std::vector< std::pair< std::vector< std::array<std::size_t, D+1> >, std::vector<double> > > alphaValues;
+
+  {
+    utilities::instrumentation::ScopedPhase phase( "delaunayTriangulation" );
+
+    DelaunayTriangulation<D> triangulation( points );
+    alphaValues = calculateAlphaValues( triangulation, points );
+
+    // Points that coincide with a previous point are not part of the
+    // triangulation, so they are connected to the previous point at
+    // the beginning of the filtration.
+    for( std::size_t i = 0; i < points.size(); i++ )
+    {
+      auto j = triangulation.representative( i );
+
+      if( i != j )
+      {
+        std::array<std::size_t, D+1> vertex;
+        vertex.fill( std::numeric_limits<std::size_t>::max() );
+
+        auto edge = vertex;
+
+        vertex[0] = i;
+        edge[0]   = std::min( i, j );
+        edge[1]   = std::max( i, j );
+
+        alphaValues[0].first.push_back( vertex );
+        alphaValues[0].second.push_back( 0.0 );
+
+        alphaValues[1].first.push_back( edge );
+        alphaValues[1].second.push_back( 0.0 );
+      }
+    }
+  }
+
+  utilities::instrumentation::ScopedPhase phase( "alphaComplex" );
+
+  std::vector<Simplex> simplices;
+
+  for( std::size_t d = 0; d <= D; d++ )
+  {
+    auto&& keys   = alphaValues[d].first;
+    auto&& values = alphaValues[d].second;
+
+    for( std::size_t i = 0; i < keys.size(); i++ )
+    {
+      // Filtration values are diameters, analogous to the ones of Čech
+      // complexes and Vietoris--Rips complexes.
+      auto value = static_cast<ElementType>( 2 * std::sqrt( values[i] ) );
+
+      if( value > r )
+        continue;
+
+      std::vector<IndexType> vertices;
+
+      for( std::size_t j = 0; j <= d; j++ )
+        vertices.push_back( static_cast<IndexType>( keys[i][j] ) );
+
+      simplices.push_back( Simplex( vertices.begin(), vertices.end(), value ) );
+    }
+  }
+
+  utilities::instrumentation::count( "alpha_complex_simplices", static_cast<std::int64_t>( simplices.size() ) );
+
+  SimplicialComplex K( simplices.begin(), simplices.end() );
+  K.sort( topology::filtrations::Data<Simplex>() );
+
+  return K;
+}
+
+} // namespace detail
+
+/**
+  Calculates the alpha complex of a two-dimensional or three-dimensional
+  point cloud. The alpha complex is a subcomplex of the Delaunay
+  triangulation. Its filtration is homotopy-equivalent to the Čech
+  filtration at every scale, so its persistence diagrams coincide with
+  the ones of the Čech complex. In contrast to the Čech complex, the
+  number of simplices is roughly linear in the number of points.
+
+  The Delaunay triangulation is calculated using exact predicates. The
+  filtration values are calculated from the circumspheres of all
+  simplices. Similar to buildCechComplex(), every simplex is assigned
+  the *diameter* of its sphere, i.e. twice its radius.
+
+  @param container Point cloud
+  @param r         Maximum filtration value; simplices with a larger value
+                   are not reported
+
+  @returns Alpha complex in filtration order
+*/
+
+template <class Container> auto buildAlphaComplex( const Container& container,
+                                                   typename Container::ElementType r = std::numeric_limits<typename Container::ElementType>::max() ) -> topology::SimplicialComplex< topology::Simplex<typename Container::ElementType, typename Container::IndexType> >
+{
+  switch( container.dimension() )
+  {
+  case 2:
+    return detail::buildAlphaComplex<2>( container, r );
+  case 3:
+    return detail::buildAlphaComplex<3>( container, r );
+  default:
+    throw std::runtime_error( "Alpha complexes require two-dimensional or three-dimensional point clouds" );
+  }
+}
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,536 @@
+#ifndef ALEPH_GEOMETRY_DELAUNAY_TRIANGULATION_HH__
+#define ALEPH_GEOMETRY_DELAUNAY_TRIANGULATION_HH__
+
+#include <aleph/geometry/Predicates.hh>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  @class DelaunayTriangulation
+  @brief Exact Delaunay triangulation of points in two or three dimensions
+
+  The triangulation is calculated incrementally by the Bowyer--Watson
+  algorithm. Every point is located by walking through the current
+  triangulation. Afterwards, all cells whose circumsphere contains the
+  point are removed, and the resulting cavity is re-triangulated. All
+  geometric decisions use exact predicates, so the triangulation is
+  valid regardless of rounding errors or degenerate configurations,
+  such as grids of points.
+
+  In order to avoid special cases on the convex hull, the triangulation
+  uses an additional vertex at infinity, which is connected to all the
+  facets of the convex hull. Cells containing this vertex are never
+  reported.
+
+  Points that coincide with a previous point are not inserted into the
+  triangulation. Instead, they are represented by the previous point.
+
+  @tparam D Dimension of the points; must be either 2 or 3
+*/
+
+template <std::size_t D> class DelaunayTriangulation
+{
+public:
+  static_assert( D == 2 || D == 3, "Only two or three dimensions are supported" );
+
+  using Point    = std::array<double, D>;
+  using Vertices = std::array<std::size_t, D+1>;
+
+  /** Index of the vertex at infinity */
+  static constexpr std::size_t infinite = std::numeric_limits<std::size_t>::max();
+
+  explicit DelaunayTriangulation( const std::vector<Point>& points )
+    : _points( points )
+    , _representatives( points.size() )
+  {
+    std::iota( _representatives.begin(), _representatives.end(), std::size_t(0) );
+
+    auto order  = this->spatialOrder();
+    auto simplex = this->findInitialSimplex( order );
+
+    this->initialize( simplex );
+
+    for( auto&& i : order )
+    {
+      if( std::find( simplex.begin(), simplex.end(), i ) == simplex.end() )
+        this->insert( i );
+    }
+  }
+
+  /**
+    @returns All finite cells of the triangulation. The vertices of every
+    cell are positively oriented.
+  */
+
+  std::vector<Vertices> cells() const
+  {
+    std::vector<Vertices> result;
+
+    for( std::size_t c = 0; c < _cells.size(); c++ )
+      if( _cells[c].alive && !this->isInfinite( c ) )
+        result.push_back( _cells[c].vertices );
+
+    return result;
+  }
+
+  /**
+    @returns Index of the vertex that represents a given point in the
+    triangulation. This is the point itself unless it coincides with a
+    point that has been inserted before.
+  */
+
+  std::size_t representative( std::size_t i ) const
+  {
+    return _representatives.at( i );
+  }
+
+private:
+
+  struct Cell
+  {
+    Vertices vertices;
+    Vertices neighbours; // neighbours[i] is opposite to vertices[i]
+    bool alive;
+  };
+
+  /**
+    Sorts all points along a Z-order curve in their bounding box. Points
+    that are inserted consecutively are thus close to each other, which
+    keeps the walks for locating them short.
+  */
+
+  std::vector<std::size_t> spatialOrder() const
+  {
+    Point min;
+    Point max;
+
+    min.fill( std::numeric_limits<double>::max() );
+    max.fill( std::numeric_limits<double>::lowest() );
+
+    for( auto&& p : _points )
+    {
+      for( std::size_t j = 0; j < D; j++ )
+      {
+        min[j] = std::min( min[j], p[j] );
+        max[j] = std::max( max[j], p[j] );
+      }
+    }
+
+    constexpr unsigned bits = 63 / D;
+
+    std::vector<std::uint64_t> keys( _points.size() );
+
+    for( std::size_t i = 0; i < _points.size(); i++ )
+    {
+      std::uint64_t key = 0;
+
+      for( std::size_t j = 0; j < D; j++ )
+      {
+        auto range = max[j] - min[j];
+        auto x     = range > 0 ? ( _points[i][j] - min[j] ) / range : 0.0;
+        auto q     = static_cast<std::uint64_t>( x * double( ( std::uint64_t(1) << bits ) - 1 ) );
+
+        for( unsigned b = 0; b < bits; b++ )
+          key |= ( ( q >> b ) & 1 ) << ( b * D + j );
+      }
+
+      keys[i] = key;
+    }
+
+    std::vector<std::size_t> order( _points.size() );
+    std::iota( order.begin(), order.end(), std::size_t(0) );
+
+    std::stable_sort( order.begin(), order.end(),
+      [&keys] ( std::size_t i, std::size_t j )
+      {
+        return keys[i] < keys[j];
+      }
+    );
+
+    return order;
+  }
+
+  /**
+    Finds D+1 affinely independent points, which form the first cell of
+    the triangulation. The simplex is positively oriented.
+  */
+
+  Vertices findInitialSimplex( const std::vector<std::size_t>& order ) const
+  {
+    Vertices simplex;
+    simplex.fill( infinite );
+
+    std::size_t k = 0;
+
+    for( auto&& i : order )
+    {
+      if( k == 0 )
+        simplex[k++] = i;
+      else if( k == 1 && _points[i] != _points[ simplex[0] ] )
+        simplex[k++] = i;
+      else if( k == 2 && !this->isCollinear( simplex[0], simplex[1], i ) )
+        simplex[k++] = i;
+      else if( k == 3 && D == 3 )
+      {
+        std::array<const double*, D+1> vertices;
+
+        for( std::size_t j = 0; j < D; j++ )
+          vertices[j] = _points[ simplex[j] ].data();
+
+        vertices[D] = _points[i].data();
+
+        if( geometry::orientation<D>( vertices ) != 0 )
+          simplex[k++] = i;
+      }
+
+      if( k == D+1 )
+        break;
+    }
+
+    if( k != D+1 )
+      throw std::runtime_error( "Point cloud is degenerate; its points must not be contained in a hyperplane" );
+
+    if( this->orientation( simplex ) < 0 )
+      std::swap( simplex[0], simplex[1] );
+
+    return simplex;
+  }
+
+  /** Checks whether three points are collinear by checking all projections to coordinate planes */
+  bool isCollinear( std::size_t i, std::size_t j, std::size_t k ) const
+  {
+    for( std::size_t a = 0; a < D; a++ )
+    {
+      for( std::size_t b = a+1; b < D; b++ )
+      {
+        double p[2] = { _points[i][a], _points[i][b] };
+        double q[2] = { _points[j][a], _points[j][b] };
+        double r[2] = { _points[k][a], _points[k][b] };
+
+        if( geometry::orientation<2>( { p, q, r } ) != 0 )
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+    Creates the triangulation of a single simplex. Every facet of the
+    simplex is connected to the vertex at infinity.
+  */
+
+  void initialize( const Vertices& simplex )
+  {
+    auto c = this->createCell( simplex );
+
+    std::vector<std::size_t> cells = { c };
+
+    for( std::size_t i = 0; i <= D; i++ )
+    {
+      auto vertices = simplex;
+      vertices[i]   = infinite;
+
+      // Cells containing the vertex at infinity are oriented such that
+      // replacing it with a point outside of the convex hull results in
+      // a positively-oriented cell.
+      std::swap( vertices[ (i+1) % (D+1) ], vertices[ (i+2) % (D+1) ] );
+
+      cells.push_back( this->createCell( vertices ) );
+    }
+
+    this->glue( cells );
+    _last = c;
+  }
+
+  /**
+    Connects cells that share a facet. This requires the facets to be
+    unique, i.e. every facet may be shared by at most two cells.
+  */
+
+  void glue( const std::vector<std::size_t>& cells )
+  {
+    std::map< std::array<std::size_t, D>, std::pair<std::size_t, std::size_t> > facets;
+
+    for( auto&& c : cells )
+    {
+      for( std::size_t i = 0; i <= D; i++ )
+      {
+        std::array<std::size_t, D> facet;
+
+        for( std::size_t j = 0, k = 0; j <= D; j++ )
+          if( j != i )
+            facet[k++] = _cells[c].vertices[j];
+
+        std::sort( facet.begin(), facet.end() );
+
+        auto it = facets.find( facet );
+
+        if( it == facets.end() )
+          facets.insert( std::make_pair( facet, std::make_pair( c, i ) ) );
+        else
+        {
+          _cells[c].neighbours[i]                                = it->second.first;
+          _cells[ it->second.first ].neighbours[ it->second.second ] = c;
+
+          facets.erase( it );
+        }
+      }
+    }
+  }
+
+  void insert( std::size_t p )
+  {
+    auto c = this->locate( p );
+
+    // The point coincides with a vertex of the cell, so it is not
+    // inserted into the triangulation.
+    for( auto&& v : _cells[c].vertices )
+    {
+      if( v != infinite && _points[v] == _points[p] )
+      {
+        _representatives[p] = v;
+        return;
+      }
+    }
+
+    ++_stamp;
+
+    _conflicts.resize( _cells.size() );
+    _checked.resize( _cells.size() );
+
+    // Collect all cells in conflict with the point, i.e. the cavity, as
+    // well as its boundary facets. Every facet is stored as a pair of a
+    // cell in the cavity and the index of the opposite vertex.
+    std::vector<std::size_t> cavity = { c };
+    std::vector< std::pair<std::size_t, std::size_t> > boundary;
+
+    _conflicts[c] = _stamp;
+
+    for( std::size_t k = 0; k < cavity.size(); k++ )
+    {
+      auto d = cavity[k];
+
+      for( std::size_t i = 0; i <= D; i++ )
+      {
+        auto e = _cells[d].neighbours[i];
+
+        if( _conflicts[e] == _stamp )
+          continue;
+
+        if( _checked[e] != _stamp )
+        {
+          _checked[e] = _stamp;
+
+          if( this->isInConflict( e, p ) )
+          {
+            _conflicts[e] = _stamp;
+            cavity.push_back( e );
+
+            continue;
+          }
+        }
+
+        boundary.push_back( std::make_pair( d, i ) );
+      }
+    }
+
+    // Connect every boundary facet to the new point. The orientation of
+    // the new cells is the same as the one of the cells in the cavity,
+    // because the cavity is star-shaped with respect to the point.
+    std::vector<std::size_t> cells;
+    cells.reserve( boundary.size() );
+
+    for( auto&& facet : boundary )
+    {
+      auto d        = facet.first;
+      auto i        = facet.second;
+      auto vertices = _cells[d].vertices;
+      vertices[i]   = p;
+
+      auto e        = _cells[d].neighbours[i];
+      auto f        = this->createCell( vertices );
+
+      _cells[f].neighbours[i] = e;
+
+      for( auto&& neighbour : _cells[e].neighbours )
+      {
+        if( neighbour == d )
+        {
+          neighbour = f;
+          break;
+        }
+      }
+
+      cells.push_back( f );
+    }
+
+    this->glue( cells );
+
+    for( auto&& d : cavity )
+    {
+      _cells[d].alive = false;
+      _free.push_back( d );
+    }
+
+    _last = cells.front();
+  }
+
+  /**
+    Locates a point by a visibility walk, starting from the cell that
+    has been created most recently. The walk terminates for Delaunay
+    triangulations.
+
+    @returns Infinite cell in conflict with the point if it lies outside
+    of the convex hull, or a finite cell containing it
+  */
+
+  std::size_t locate( std::size_t p ) const
+  {
+    auto c = _last;
+
+    if( this->isInfinite( c ) )
+      c = _cells[c].neighbours[ this->infiniteIndex( c ) ];
+
+    while( true )
+    {
+      bool moved = false;
+
+      for( std::size_t i = 0; i <= D; i++ )
+      {
+        auto vertices = this->coordinates( _cells[c].vertices );
+        vertices[i]   = _points[p].data();
+
+        if( geometry::orientation<D>( vertices ) < 0 )
+        {
+          c     = _cells[c].neighbours[i];
+          moved = true;
+
+          break;
+        }
+      }
+
+      if( !moved || this->isInfinite( c ) )
+        return c;
+    }
+  }
+
+  /**
+    Checks whether a point is in conflict with a cell, i.e. whether it
+    lies strictly inside its circumsphere. For a cell that contains the
+    vertex at infinity, this is the case if the point lies on the outer
+    side of its finite facet. If the point lies in the hyperplane of the
+    facet, it is in conflict if it lies inside the circumsphere of the
+    facet, which is tested using the finite cell on the other side.
+  */
+
+  bool isInConflict( std::size_t c, std::size_t p ) const
+  {
+    auto&& point = _points[p].data();
+
+    if( !this->isInfinite( c ) )
+      return geometry::inSphere<D>( this->coordinates( _cells[c].vertices ), point ) > 0;
+
+    auto k        = this->infiniteIndex( c );
+    auto vertices = _cells[c].vertices;
+    vertices[k]   = p;
+
+    auto o = geometry::orientation<D>( this->coordinates( vertices ) );
+
+    if( o != 0 )
+      return o > 0;
+
+    auto d = _cells[c].neighbours[k];
+    return geometry::inSphere<D>( this->coordinates( _cells[d].vertices ), point ) > 0;
+  }
+
+  std::size_t createCell( const Vertices& vertices )
+  {
+    Cell cell;
+    cell.vertices = vertices;
+    cell.alive    = true;
+
+    cell.neighbours.fill( infinite );
+
+    if( !_free.empty() )
+    {
+      auto c = _free.back();
+      _free.pop_back();
+
+      _cells[c] = cell;
+      return c;
+    }
+
+    _cells.push_back( cell );
+    return _cells.size() - 1;
+  }
+
+  bool isInfinite( std::size_t c ) const
+  {
+    return this->infiniteIndex( c ) <= D;
+  }
+
+  std::size_t infiniteIndex( std::size_t c ) const
+  {
+    for( std::size_t i = 0; i <= D; i++ )
+      if( _cells[c].vertices[i] == infinite )
+        return i;
+
+    return D+1;
+  }
+
+  std::array<const double*, D+1> coordinates( const Vertices& vertices ) const
+  {
+    std::array<const double*, D+1> result;
+
+    for( std::size_t i = 0; i <= D; i++ )
+      result[i] = _points[ vertices[i] ].data();
+
+    return result;
+  }
+
+  int orientation( const Vertices& vertices ) const
+  {
+    return geometry::orientation<D>( this->coordinates( vertices ) );
+  }
+
+  std::vector<Point> _points;
+  std::vector<std::size_t> _representatives;
+
+  std::vector<Cell> _cells;
+  std::vector<std::size_t> _free;
+
+  // Stamps for marking cells during an insertion; a cell is marked if
+  // its stamp equals the current one.
+  std::vector<std::size_t> _conflicts;
+  std::vector<std::size_t> _checked;
+  std::size_t _stamp = 0;
+
+  // Cell that has been created most recently; it is used as the start
+  // of the next walk.
+  std::size_t _last = 0;
+};
+
+template <std::size_t D> constexpr std::size_t DelaunayTriangulation<D>::infinite;
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
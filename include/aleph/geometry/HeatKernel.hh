@@ -6,9 +6,12 @@
 #ifdef ALEPH_WITH_EIGEN
   #include <Eigen/Core>
   #include <Eigen/Eigenvalues>
+  #include <Eigen/Sparse>
+  #include <Eigen/SparseCholesky>
 #endif
 
 #include <aleph/math/KahanSummation.hh>
+#include <aleph/math/Lanczos.hh>
 
 #include <algorithm>
 #include <unordered_map>
@@ -130,6 +133,79 @@ template <class SimplicialComplex> auto weightedLaplacianMatrix( const Simplicia
   return L - W;
 }
 
+/**
+  Calculates the weighted Laplacian matrix of a given simplicial complex
+  and returns it as a sparse matrix. In contrast to the dense variant of
+  this function, the matrix is assembled directly from the edges of the
+  simplicial complex, so memory requirements are linear in the number
+  of edges.
+
+  @param K Simplicial complex
+
+  @returns Sparse weighted Laplacian matrix. The indices of rows and
+           columns follow the order of the vertices in the complex.
+*/
+
+template <class SimplicialComplex> auto sparseWeightedLaplacianMatrix( const SimplicialComplex& K ) -> Eigen::SparseMatrix<typename SimplicialComplex::ValueType::DataType>
+{
+  using Simplex    = typename SimplicialComplex::ValueType;
+  using VertexType = typename Simplex::VertexType;
+  using DataType   = typename Simplex::DataType;
+  using Matrix     = Eigen::SparseMatrix<DataType>;
+  using Triplet    = Eigen::Triplet<DataType>;
+
+#if EIGEN_VERSION_AT_LEAST(3,3,0)
+  using IndexType  = Eigen::Index;
+#else
+  using IndexType  = typename Matrix::Index;
+#endif
+
+  // Prepare map from vertex to index ----------------------------------
+
+  std::unordered_map<VertexType, IndexType> vertex_to_index;
+  IndexType n = IndexType();
+
+  {
+    std::vector<VertexType> vertices;
+    K.vertices( std::back_inserter( vertices ) );
+
+    IndexType index = IndexType();
+
+    for( auto&& vertex : vertices )
+      vertex_to_index[vertex] = index++;
+
+    n = static_cast<IndexType>( vertices.size() );
+  }
+
+  // Prepare matrix ----------------------------------------------------
+  //
+  // Every edge contributes four entries to the matrix: two off-diagonal
+  // ones and two diagonal ones. The diagonal entries will be summed up
+  // automatically when creating the matrix.
+
+  std::vector<Triplet> triplets;
+
+  for( auto&& s : K )
+  {
+    if( s.dimension() != 1 )
+      continue;
+
+    auto i = vertex_to_index.at( s[0] );
+    auto j = vertex_to_index.at( s[1] );
+    auto w = s.data();
+
+    triplets.emplace_back( i, j, -w );
+    triplets.emplace_back( j, i, -w );
+    triplets.emplace_back( i, i,  w );
+    triplets.emplace_back( j, j,  w );
+  }
+
+  Matrix L( n, n );
+  L.setFromTriplets( triplets.begin(), triplets.end() );
+
+  return L;
+}
+
 /**
   Calculates the Moore--Penrose pseudo-inverse of the weighted Laplacian
   matrix of a given simplicial complex and returns it.
@@ -154,6 +230,51 @@ template <class SimplicialComplex> auto pinvWeightedLaplacianMatrix( const Simpl
   return (M+L).inverse() - M;
 }
 
+namespace detail
+{
+
+/**
+  Shift-and-invert operator for a sparse symmetric positive
+  semi-definite matrix \f$A\f$. Products with this operator amount to
+  solving a linear system with \f$A + \sigma I\f$. The largest
+  eigenvalues of the operator correspond to the smallest eigenvalues
+  of \f$A\f$, which ensures that the Lanczos algorithm converges
+  quickly towards them.
+*/
+
+template <class T> class ShiftInvertOperator
+{
+public:
+  using Matrix = Eigen::SparseMatrix<T>;
+  using Vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+  ShiftInvertOperator( const Matrix& A, T sigma )
+    : _n( A.rows() )
+  {
+    Matrix I( A.rows(), A.cols() );
+    I.setIdentity();
+
+    _solver.compute( A + sigma * I );
+
+    if( _solver.info() != Eigen::Success )
+      throw std::runtime_error( "Unable to factorize shifted Laplacian matrix" );
+  }
+
+  typename Matrix::Index rows() const noexcept { return _n; }
+  typename Matrix::Index cols() const noexcept { return _n; }
+
+  template <class V> Vector operator*( const V& v ) const
+  {
+    return _solver.solve( v );
+  }
+
+private:
+  typename Matrix::Index _n;
+  Eigen::SimplicialLDLT<Matrix> _solver;
+};
+
+} // namespace detail
+
 #endif
 
 /**
@@ -164,6 +285,13 @@ template <class SimplicialComplex> auto pinvWeightedLaplacianMatrix( const Simpl
   vertices in a weighted simplicial complex. It will pre-calculate
   the heat matrix and permit queries about the progression of heat
   values for *all* vertices for some time \f$t\f$.
+
+  For large simplicial complexes, the heat kernel may be approximated
+  using only the smallest eigenvalues of the Laplacian. Their terms
+  dominate the heat kernel for all but the smallest time values. In
+  this case, a sparse Laplacian matrix will be used and the spectrum
+  will be calculated by the Lanczos algorithm in shift-and-invert
+  mode.
 */
 
 class HeatKernel
@@ -228,6 +356,68 @@ public:
 
   }
 
+  /**
+    Constructs an approximate heat kernel from a given simplicial
+    complex by using a truncated spectrum of its Laplacian. Only the
+    \f$k\f$ smallest eigenvalues and their eigenvectors are stored,
+    so memory requirements are linear in the number of vertices.
+
+    All queries of the functor remain valid; they are evaluated over
+    the truncated spectrum.
+
+    @param K     Simplicial complex
+    @param k     Number of eigenpairs to calculate
+
+    @param steps Number of Lanczos steps; if zero, a default value
+                 will be used. Increasing this value improves the
+                 accuracy of the eigenpairs.
+  */
+
+  template <class SimplicialComplex> HeatKernel( const SimplicialComplex& K, unsigned k, unsigned steps = 0 )
+  {
+#ifdef ALEPH_WITH_EIGEN
+
+    Eigen::SparseMatrix<T> L = sparseWeightedLaplacianMatrix( K ).template cast<T>();
+
+    // The shift is required because the Laplacian is singular. It is
+    // chosen relative to the magnitude of the matrix entries.
+    T sigma = T();
+
+    for( IndexType i = 0; i < L.rows(); i++ )
+      sigma = std::max( sigma, L.coeff(i,i) );
+
+    sigma = sigma > T() ? T(1e-6) * sigma : T(1e-6);
+
+    detail::ShiftInvertOperator<T> op( L, sigma );
+
+    aleph::math::Lanczos<T> solver( true );
+    solver.compute( op, IndexType( k ), IndexType( steps ) );
+
+    auto&& eigenvalues  = solver.eigenvalues();
+    auto&& eigenvectors = solver.eigenvectors();
+
+    _eigenvalues.reserve( std::size_t( eigenvalues.size() ) );
+    _eigenvectors.reserve( std::size_t( eigenvectors.cols() ) );
+
+    // The largest eigenvalues of the operator are reported in ascending
+    // order, so they need to be traversed in reverse to obtain the
+    // smallest eigenvalues of the Laplacian in ascending order.
+    for( IndexType i = eigenvalues.size() - ( _skip ? 2 : 1 ); i >= 0; i-- )
+    {
+      _eigenvalues.push_back( std::max( T(1) / eigenvalues(i) - sigma, T() ) );
+      _eigenvectors.push_back( eigenvectors.col(i) );
+    }
+
+#else
+  (void) K;
+  (void) k;
+  (void) steps;
+
+  THROW_EIGEN_REQUIRED_ERROR();
+#endif
+
+  }
+
   /**
     Evaluates the heat kernel for *all* vertices at a given time \f$t\f$
     and returns the resulting values. This function is guaranteed to be
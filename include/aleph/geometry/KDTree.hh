@@ -0,0 +1,273 @@
+#ifndef ALEPH_GEOMETRY_KD_TREE_HH__
+#define ALEPH_GEOMETRY_KD_TREE_HH__
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+/**
+  @class KDTree
+  @brief Static k-d tree with bounding boxes
+
+  This class stores the points of a container in a balanced k-d tree.
+  Nodes are split at the median of the widest dimension of their
+  bounding box. Coordinates are copied into a single contiguous array,
+  ordered by the leaves of the tree, so every node refers to a range
+  of points. In addition to the tree structure, every node stores the
+  bounding box of its points, which permits calculating bounds for the
+  distances between a position and all points of a node.
+*/
+
+class KDTree
+{
+public:
+
+  /** Node of the tree; children are only valid for inner nodes */
+  struct Node
+  {
+    std::size_t begin;
+    std::size_t end;
+
+    std::size_t left  = 0;
+    std::size_t right = 0;
+
+    bool leaf() const noexcept { return left == right; }
+    std::size_t size() const noexcept { return end - begin; }
+  };
+
+  /**
+    Creates a new tree from a container of points.
+
+    @param container Point cloud; the points are copied into the tree
+    @param leafSize  Maximum number of points stored in a leaf
+  */
+
+  template <class Container> explicit KDTree( const Container& container, std::size_t leafSize = 32 )
+    : _n( container.size() )
+    , _d( container.dimension() )
+  {
+    _points.reserve( _n * _d );
+
+    for( std::size_t i = 0; i < _n; i++ )
+    {
+      auto&& p = container[i];
+
+      for( std::size_t k = 0; k < _d; k++ )
+        _points.push_back( static_cast<double>( p[k] ) );
+    }
+
+    _indices.resize( _n );
+    std::iota( _indices.begin(), _indices.end(), std::size_t(0) );
+
+    if( _n > 0 )
+      this->build( 0, _n, std::max( leafSize, std::size_t(1) ) );
+
+    std::vector<double> points( _points.size() );
+
+    for( std::size_t i = 0; i < _n; i++ )
+      std::copy( _points.begin() + std::ptrdiff_t( _indices[i] * _d ),
+                 _points.begin() + std::ptrdiff_t( _indices[i] * _d + _d ),
+                 points.begin()  + std::ptrdiff_t( i * _d ) );
+
+    _points.swap( points );
+  }
+
+  std::size_t size()      const noexcept { return _n; }
+  std::size_t dimension() const noexcept { return _d; }
+  bool empty()            const noexcept { return _n == 0; }
+
+  /** Returns all nodes of the tree; the root has index zero */
+  const std::vector<Node>& nodes() const noexcept
+  {
+    return _nodes;
+  }
+
+  /** Returns the coordinates of the point at a position in the tree */
+  const double* point( std::size_t i ) const noexcept
+  {
+    return _points.data() + i * _d;
+  }
+
+  /** Returns the index in the original container of the point at a position in the tree */
+  std::size_t index( std::size_t i ) const noexcept
+  {
+    return _indices[i];
+  }
+
+  /**
+    Calculates the minimum and the maximum squared distance between a
+    position and the bounding box of a node.
+  */
+
+  std::pair<double, double> squaredDistanceBounds( const double* x, std::size_t node ) const noexcept
+  {
+    double minDistance = 0.0;
+    double maxDistance = 0.0;
+
+    auto lower = _lower.data() + node * _d;
+    auto upper = _upper.data() + node * _d;
+
+    for( std::size_t k = 0; k < _d; k++ )
+    {
+      auto a = lower[k] - x[k];
+      auto b = x[k] - upper[k];
+      auto c = std::max( std::max( a, b ), 0.0 );
+      auto e = std::max( std::abs( a ), std::abs( b ) );
+
+      minDistance += c * c;
+      maxDistance += e * e;
+    }
+
+    return std::make_pair( minDistance, maxDistance );
+  }
+
+  /** Calculates the squared distance between a position and a point of the tree */
+  double squaredDistance( const double* x, std::size_t i ) const noexcept
+  {
+    auto p          = this->point( i );
+    double distance = 0.0;
+
+    for( std::size_t k = 0; k < _d; k++ )
+      distance += ( p[k] - x[k] ) * ( p[k] - x[k] );
+
+    return distance;
+  }
+
+  /**
+    Enumerates all points within a given radius of a position and calls
+    a functor with their indices in the original container. In order to
+    be robust against rounding errors, the radius is enlarged slightly,
+    so clients that require an exact comparison with respect to their
+    own distance functor need to check the reported points again.
+  */
+
+  template <class Functor> void radiusSearch( const double* x, double radius, Functor f ) const
+  {
+    if( _n == 0 )
+      return;
+
+    auto threshold = radius * radius * ( 1.0 + 1e-9 );
+
+    std::vector<std::size_t> stack( 1, 0 );
+
+    while( !stack.empty() )
+    {
+      auto node = stack.back();
+      stack.pop_back();
+
+      if( this->squaredDistanceBounds( x, node ).first > threshold )
+        continue;
+
+      auto&& N = _nodes[node];
+
+      if( N.leaf() )
+      {
+        for( std::size_t i = N.begin; i < N.end; i++ )
+        {
+          if( this->squaredDistance( x, i ) <= threshold )
+            f( _indices[i] );
+        }
+      }
+      else
+      {
+        stack.push_back( N.right );
+        stack.push_back( N.left );
+      }
+    }
+  }
+
+private:
+
+  /** Builds the sub-tree for a range of points and returns its index */
+  std::size_t build( std::size_t begin, std::size_t end, std::size_t leafSize )
+  {
+    auto index = _nodes.size();
+
+    Node node;
+    node.begin = begin;
+    node.end   = end;
+
+    _nodes.push_back( node );
+
+    _lower.resize( _lower.size() + _d );
+    _upper.resize( _upper.size() + _d );
+
+    std::size_t split = 0;
+    double width      = -1.0;
+
+    for( std::size_t k = 0; k < _d; k++ )
+    {
+      auto lower = _points[ _indices[begin] * _d + k ];
+      auto upper = lower;
+
+      for( std::size_t i = begin + 1; i < end; i++ )
+      {
+        lower = std::min( lower, _points[ _indices[i] * _d + k ] );
+        upper = std::max( upper, _points[ _indices[i] * _d + k ] );
+      }
+
+      _lower[ index * _d + k ] = lower;
+      _upper[ index * _d + k ] = upper;
+
+      if( upper - lower > width )
+      {
+        width = upper - lower;
+        split = k;
+      }
+    }
+
+    if( end - begin <= leafSize || width <= 0.0 )
+      return index;
+
+    auto middle = begin + ( end - begin ) / 2;
+
+    std::nth_element( _indices.begin() + std::ptrdiff_t( begin ),
+                      _indices.begin() + std::ptrdiff_t( middle ),
+                      _indices.begin() + std::ptrdiff_t( end ),
+                      [this, split] ( std::size_t i, std::size_t j )
+                      {
+                        return _points[ i * _d + split ] < _points[ j * _d + split ];
+                      } );
+
+    auto left  = this->build( begin, middle, leafSize );
+    auto right = this->build( middle, end,   leafSize );
+
+    _nodes[index].left  = left;
+    _nodes[index].right = right;
+
+    return index;
+  }
+
+  std::size_t _n;
+  std::size_t _d;
+
+  /** Coordinates of all points, ordered by the leaves of the tree */
+  std::vector<double> _points;
+
+  /** Maps positions in the tree to indices of the original container */
+  std::vector<std::size_t> _indices;
+
+  std::vector<Node> _nodes;
+
+  /** Lower corners of the bounding boxes of all nodes */
+  std::vector<double> _lower;
+
+  /** Upper corners of the bounding boxes of all nodes */
+  std::vector<double> _upper;
+};
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef ALEPH_GEOMETRY_PREDICATES_HH__
+#define ALEPH_GEOMETRY_PREDICATES_HH__
+
+#include <aleph/math/Expansion.hh>
+
+#include <array>
+#include <limits>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+namespace detail
+{
+
+template <class T, std::size_t N> using SquareMatrix = std::array< std::array<T, N>, N>;
+
+/**
+  Calculates the determinant of a small square matrix by a Laplace
+  expansion along its first column. The calculation only requires
+  additions, subtractions, and multiplications, so it is exact for
+  expansions.
+*/
+
+template <class T, std::size_t N> struct Determinant
+{
+  static T calculate( const SquareMatrix<T, N>& M )
+  {
+    T result = T();
+
+    for( std::size_t i = 0; i < N; i++ )
+    {
+      SquareMatrix<T, N-1> minor;
+
+      for( std::size_t j = 0, k = 0; j < N; j++ )
+      {
+        if( j == i )
+          continue;
+
+        for( std::size_t l = 1; l < N; l++ )
+          minor[k][l-1] = M[j][l];
+
+        ++k;
+      }
+
+      T term = M[i][0] * Determinant<T, N-1>::calculate( minor );
+      result = ( i % 2 == 0 ) ? result + term : result - term;
+    }
+
+    return result;
+  }
+};
+
+template <class T> struct Determinant<T, 2>
+{
+  static T calculate( const SquareMatrix<T, 2>& M )
+  {
+    return M[0][0] * M[1][1] - M[1][0] * M[0][1];
+  }
+};
+
+/**
+  Calculates the permanent of a small square matrix, i.e. the sum of
+  all terms of its determinant without any signs. For a matrix with
+  non-negative entries, this bounds the magnitude of every term that
+  occurs while evaluating the determinant.
+*/
+
+template <std::size_t N> double permanent( const SquareMatrix<double, N>& M )
+{
+  double result = 0.0;
+
+  for( std::size_t i = 0; i < N; i++ )
+  {
+    SquareMatrix<double, N-1> minor;
+
+    for( std::size_t j = 0, k = 0; j < N; j++ )
+    {
+      if( j == i )
+        continue;
+
+      for( std::size_t l = 1; l < N; l++ )
+        minor[k][l-1] = M[j][l];
+
+      ++k;
+    }
+
+    result += M[i][0] * permanent<N-1>( minor );
+  }
+
+  return result;
+}
+
+template <> inline double permanent<1>( const SquareMatrix<double, 1>& M )
+{
+  return M[0][0];
+}
+
+/**
+  Calculates the sign of a determinant whose rows are given by the
+  differences of points to an origin, optionally followed by their
+  squared norms. The determinant is evaluated with floating point
+  numbers first. Only if its magnitude is too small to be certain
+  about its sign, it is evaluated again using exact arithmetic.
+
+  @tparam D    Dimension of the points
+  @tparam N    Number of points, which is also the size of the matrix
+  @tparam Lift Flag indicating whether squared norms are appended
+*/
+
+template <std::size_t D, std::size_t N, bool Lift> int signOfDeterminant( const std::array<const double*, N>& points, const double* origin )
+{
+  static_assert( N == D + ( Lift ? 1 : 0 ), "Matrix must be square" );
+
+  SquareMatrix<double, N> M;
+  SquareMatrix<double, N> A;
+
+  for( std::size_t i = 0; i < N; i++ )
+  {
+    double norm = 0.0;
+
+    for( std::size_t j = 0; j < D; j++ )
+    {
+      auto x = points[i][j] - origin[j];
+      norm  += x * x;
+
+      M[i][j] = x;
+      A[i][j] = std::abs( x );
+    }
+
+    if( Lift )
+    {
+      M[i][N-1] = norm;
+      A[i][N-1] = norm;
+    }
+  }
+
+  // The permanent of the absolute values of all entries is an upper
+  // bound for the magnitude of all terms of the determinant. Every path
+  // of the evaluation contains less than 16 operations, so the error
+  // bound is conservative.
+  auto det   = Determinant<double, N>::calculate( M );
+  auto bound = 32 * std::numeric_limits<double>::epsilon() * permanent<N>( A );
+
+  // The bound is not sufficient in the presence of underflow, because
+  // the relative error of denormalized numbers is larger.
+  if( bound > std::numeric_limits<double>::min() )
+  {
+    if( det > bound )
+      return 1;
+    else if( -det > bound )
+      return -1;
+  }
+
+  using Expansion = math::Expansion;
+
+  SquareMatrix<Expansion, N> E;
+
+  for( std::size_t i = 0; i < N; i++ )
+  {
+    Expansion norm;
+
+    for( std::size_t j = 0; j < D; j++ )
+    {
+      auto x  = Expansion::difference( points[i][j], origin[j] );
+      norm    = norm + x * x;
+      E[i][j] = x;
+    }
+
+    if( Lift )
+      E[i][N-1] = norm;
+  }
+
+  return Determinant<Expansion, N>::calculate( E ).sign();
+}
+
+} // namespace detail
+
+/**
+  Calculates the orientation of a simplex, i.e. the sign of the
+  determinant of the vectors \f$v_1 - v_0, \dots, v_D - v_0\f$. The
+  result is exact, regardless of rounding errors.
+
+  @param vertices Pointers to the coordinates of the vertices
+
+  @tparam D Dimension of the space
+
+  @returns 1 if the simplex is positively oriented, -1 if it is
+  negatively oriented, and 0 if its vertices are affinely dependent
+*/
+
+template <std::size_t D> int orientation( const std::array<const double*, D+1>& vertices )
+{
+  std::array<const double*, D> points;
+
+  for( std::size_t i = 0; i < D; i++ )
+    points[i] = vertices[i+1];
+
+  return detail::signOfDeterminant<D, D, false>( points, vertices[0] );
+}
+
+/**
+  Checks whether a point lies inside the circumsphere of a simplex. The
+  result is exact, regardless of rounding errors.
+
+  @param vertices Pointers to the coordinates of the vertices, which
+  must be affinely independent
+  @param p        Pointer to the coordinates of the query point
+
+  @tparam D Dimension of the space
+
+  @returns 1 if the point lies inside the circumsphere, -1 if it lies
+  outside, and 0 if it lies on the circumsphere
+*/
+
+template <std::size_t D> int inSphere( const std::array<const double*, D+1>& vertices, const double* p )
+{
+  auto s = detail::signOfDeterminant<D, D+1, true>( vertices, p );
+
+  // The sign of the lifted determinant depends on the orientation of
+  // the simplex and on the dimension of the space.
+  return ( D % 2 == 0 ? s : -s ) * orientation<D>( vertices );
+}
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
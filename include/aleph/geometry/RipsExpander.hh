@@ -1,6 +1,8 @@
 #ifndef ALEPH_GEOMETRY_RIPS_EXPANDER_HH__
 #define ALEPH_GEOMETRY_RIPS_EXPANDER_HH__
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <algorithm>
 #include <iterator>
 #include <list>
@@ -11,6 +13,8 @@
 #include <type_traits>
 #include <vector>
 
+#include <cstdint>
+
 namespace aleph
 {
 
@@ -52,6 +56,8 @@ public:
 
   SimplicialComplex operator()( const SimplicialComplex& K, unsigned dimension )
   {
+    utilities::instrumentation::ScopedPhase phase( "ripsExpansion" );
+
     std::set<VertexType> vertices;
     K.vertices( std::inserter( vertices,
                                vertices.begin() ) );
@@ -95,6 +101,8 @@ public:
       }
     }
 
+    utilities::instrumentation::count( "rips_expansion_simplices", static_cast<std::int64_t>( simplices.size() ) );
+
     return SimplicialComplex( simplices.begin(), simplices.end() );
   }
 
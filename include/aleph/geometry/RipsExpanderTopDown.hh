@@ -90,7 +90,7 @@ public:
 
   SimplicialComplex operator()( const SimplicialComplex& K, unsigned kMax, unsigned kMin )
   {
-    auto maximalCliques = aleph::topology::maximalCliquesKoch( K );
+    auto maximalCliques = aleph::topology::maximalCliquesEppstein( K );
 
     std::list<Simplex> simplices;
 
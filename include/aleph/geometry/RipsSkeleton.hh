@@ -4,6 +4,8 @@
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <vector>
 
 namespace aleph
@@ -23,6 +25,8 @@ public:
 
   SimplicialComplex operator()( const NearestNeighbours& nn, ElementType epsilon ) const
   {
+    utilities::instrumentation::ScopedPhase phase( "ripsSkeleton" );
+
     auto numVertices = nn.size();
 
     std::vector<Simplex> simplices;
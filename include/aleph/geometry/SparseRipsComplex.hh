@@ -0,0 +1,300 @@
+#ifndef ALEPH_GEOMETRY_SPARSE_RIPS_COMPLEX_HH__
+#define ALEPH_GEOMETRY_SPARSE_RIPS_COMPLEX_HH__
+
+#include <aleph/geometry/RipsExpander.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+#include <aleph/geometry/distances/Traits.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/utilities/Instrumentation.hh>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace geometry
+{
+
+namespace detail
+{
+
+/**
+  Copies all points of a container, permitting repeated distance
+  calculations without creating temporary objects.
+*/
+
+template <class Container> std::vector< std::vector<typename Container::ElementType> > getPoints( const Container& container )
+{
+  std::vector< std::vector<typename Container::ElementType> > points;
+  points.reserve( container.size() );
+
+  for( decltype( container.size() ) i = 0; i < container.size(); i++ )
+    points.push_back( container[i] );
+
+  return points;
+}
+
+/** @returns Largest value of a type, which is infinity if available */
+template <class T> T infinity()
+{
+  return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                              : std::numeric_limits<T>::max();
+}
+
+} // namespace detail
+
+/**
+  Calculates a greedy permutation of a point cloud, also known as its
+  farthest-point sampling. The first point of the permutation is the
+  first point of the container. Every subsequent point is the one that
+  is farthest away from all previous points. Its insertion radius is
+  its distance to the closest previous point. The insertion radius of
+  the first point is infinite.
+
+  This function requires \f$O(n^2)\f$ distance calculations and linear
+  memory.
+
+  @param container Point cloud
+  @param dist      Distance functor
+
+  @returns Pair of indices of the points, in the order in which they are
+  inserted, and their insertion radii, which are non-increasing
+*/
+
+template <
+  class Container,
+  class Distance = distances::Euclidean<typename Container::ElementType>
+> auto greedyPermutation( const Container& container,
+                          Distance dist = Distance() ) -> std::pair< std::vector<typename Container::IndexType>, std::vector<typename Container::ElementType> >
+{
+  using ElementType = typename Container::ElementType;
+  using IndexType   = typename Container::IndexType;
+
+  utilities::instrumentation::ScopedPhase phase( "greedyPermutation" );
+
+  auto n      = static_cast<std::size_t>( container.size() );
+  auto D      = container.dimension();
+  auto points = detail::getPoints( container );
+
+  distances::Traits<Distance> traits;
+
+  std::vector<IndexType> indices;
+  std::vector<ElementType> radii;
+
+  indices.reserve( n );
+  radii.reserve( n );
+
+  if( n == 0 )
+    return std::make_pair( indices, radii );
+
+  // Distance of every point to the closest point that has already been
+  // inserted into the permutation
+  std::vector<ElementType> distances( n, detail::infinity<ElementType>() );
+  std::vector<bool> inserted( n, false );
+
+  std::size_t current = 0;
+
+  for( std::size_t k = 0; k < n; k++ )
+  {
+    indices.push_back( static_cast<IndexType>( current ) );
+    radii.push_back( distances[current] );
+
+    inserted[current] = true;
+
+    std::size_t next = current;
+    ElementType max  = ElementType();
+    bool found       = false;
+
+    for( std::size_t j = 0; j < n; j++ )
+    {
+      if( inserted[j] )
+        continue;
+
+      auto d       = traits.from( dist( points[current].begin(), points[j].begin(), D ) );
+      distances[j] = std::min( distances[j], d );
+
+      if( !found || distances[j] > max )
+      {
+        next  = j;
+        max   = distances[j];
+        found = true;
+      }
+    }
+
+    current = next;
+  }
+
+  return std::make_pair( indices, radii );
+}
+
+/**
+  Calculates the 1-skeleton of a sparse Vietoris--Rips filtration,
+  following the construction by Cavanna, Jahanseir, and Sheehy, which
+  extends the original sparse Vietoris--Rips complex by Sheehy.
+
+  Points are inserted according to a greedy permutation. Every point
+  stops growing its neighbourhood at a scale that is proportional to
+  its insertion radius and is subsequently covered by its neighbours.
+  Hence, an edge is only created if both of its vertices are still
+  relevant at the scale at which the edge appears. The weight of an
+  edge is not smaller than the distance between its vertices.
+
+  For metrics of bounded doubling dimension, the number of edges is
+  linear in the number of points. The flag complex of the skeleton is
+  a filtration whose persistence diagrams are multiplicatively \f$(1 +
+  \varepsilon)\f$-interleaved with the persistence diagrams of the
+  Vietoris--Rips filtration, i.e. they are close on a logarithmic
+  scale. All vertices have a weight of zero.
+
+  @see https://arxiv.org/abs/1506.03797 (Cavanna et al.)
+  @see https://arxiv.org/abs/1203.6786 (Sheehy)
+
+  @param container Point cloud
+  @param epsilon   Approximation factor; must be positive
+  @param dist      Distance functor
+
+  @returns Sparse 1-skeleton whose vertex indices correspond to the
+  indices of the points in the container
+*/
+
+template <
+  class Container,
+  class Distance = distances::Euclidean<typename Container::ElementType>
+> auto buildSparseRipsSkeleton( const Container& container,
+                                typename Container::ElementType epsilon,
+                                Distance dist = Distance() ) -> topology::SimplicialComplex< topology::Simplex<typename Container::ElementType, typename Container::IndexType> >
+{
+  using ElementType       = typename Container::ElementType;
+  using IndexType         = typename Container::IndexType;
+  using Simplex           = topology::Simplex<ElementType, IndexType>;
+  using SimplicialComplex = topology::SimplicialComplex<Simplex>;
+
+  if( !( epsilon > ElementType() ) )
+    throw std::runtime_error( "Approximation factor must be positive" );
+
+  auto permutation = greedyPermutation( container, dist );
+
+  utilities::instrumentation::ScopedPhase phase( "sparseRipsSkeleton" );
+
+  auto&& indices = permutation.first;
+  auto&& radii   = permutation.second;
+
+  auto n      = indices.size();
+  auto D      = container.dimension();
+  auto points = detail::getPoints( container );
+
+  // The construction of Cavanna et al. yields a multiplicative
+  // interleaving with a factor of 1/(1-mu). The parameter is thus
+  // chosen such that this factor equals 1+epsilon.
+  auto mu = epsilon / ( 1 + epsilon );
+
+  distances::Traits<Distance> traits;
+
+  // Edges are collected separately for every point, which permits the
+  // parallel calculation while keeping the order of edges fixed.
+  std::vector< std::vector<Simplex> > edges( n );
+
+  #pragma omp parallel for schedule(dynamic)
+  for( std::size_t a = 0; a < n; a++ )
+  {
+    auto i  = indices[a];
+    auto li = radii[a];
+
+    for( std::size_t b = a+1; b < n; b++ )
+    {
+      auto j  = indices[b];
+      auto lj = radii[b];
+      auto d  = traits.from( dist( points[i].begin(), points[j].begin(), D ) );
+
+      ElementType weight = ElementType();
+
+      // Both neighbourhoods are still growing when they intersect, so
+      // the edge appears at the usual scale.
+      if( d * mu <= 2 * lj )
+        weight = d;
+
+      // The neighbourhood of the later point has already stopped
+      // growing; the edge is only created if the later point is still
+      // relevant at the scale at which the neighbourhoods intersect.
+      else if( d * mu <= li + lj && d * mu <= lj * ( 1 + 1 / ( 1 - mu ) ) )
+        weight = 2 * ( d - lj / mu );
+      else
+        continue;
+
+      edges[a].push_back( Simplex( { std::min( i, j ), std::max( i, j ) }, weight ) );
+    }
+  }
+
+  std::vector<Simplex> simplices;
+  simplices.reserve( n );
+
+  for( std::size_t i = 0; i < n; i++ )
+    simplices.push_back( Simplex( static_cast<IndexType>( i ) ) );
+
+  for( auto&& edgesOfPoint : edges )
+    simplices.insert( simplices.end(), edgesOfPoint.begin(), edgesOfPoint.end() );
+
+  utilities::instrumentation::count( "sparse_rips_edges", static_cast<std::int64_t>( simplices.size() - n ) );
+
+  return SimplicialComplex( simplices.begin(), simplices.end() );
+}
+
+/**
+  Convenience function for building a sparse Vietoris--Rips complex of
+  a point cloud. The sparse 1-skeleton is expanded up to the specified
+  dimension, and every simplex is assigned the maximum weight of its
+  faces. The resulting simplicial complex is in filtration order, so
+  its persistent homology may be calculated directly.
+
+  @param container Point cloud
+  @param epsilon   Approximation factor; must be positive
+  @param dimension Maximum dimension of simplices
+  @param dist      Distance functor
+
+  @see buildSparseRipsSkeleton()
+*/
+
+template <
+  class Container,
+  class Distance = distances::Euclidean<typename Container::ElementType>
+> auto buildSparseVietorisRipsComplex( const Container& container,
+                                       typename Container::ElementType epsilon,
+                                       unsigned dimension,
+                                       Distance dist = Distance() ) -> topology::SimplicialComplex< topology::Simplex<typename Container::ElementType, typename Container::IndexType> >
+{
+  using ElementType       = typename Container::ElementType;
+  using IndexType         = typename Container::IndexType;
+  using Simplex           = topology::Simplex<ElementType, IndexType>;
+  using SimplicialComplex = topology::SimplicialComplex<Simplex>;
+
+  auto skeleton
+    = buildSparseRipsSkeleton( container, epsilon, dist );
+
+  geometry::RipsExpander<SimplicialComplex> ripsExpander;
+
+  auto K = ripsExpander( skeleton, dimension );
+  K      = ripsExpander.assignMaximumWeight( K );
+
+  K.sort( topology::filtrations::Data<Simplex>() );
+
+  return K;
+}
+
+} // namespace geometry
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,396 @@
+#ifndef ALEPH_MATH_BINNED_KERNEL_DENSITY_ESTIMATOR_HH__
+#define ALEPH_MATH_BINNED_KERNEL_DENSITY_ESTIMATOR_HH__
+
+#include <aleph/config/Eigen.hh>
+
+#include <aleph/math/KernelDensityEstimator.hh>
+
+#ifdef ALEPH_WITH_EIGEN
+  #include <unsupported/Eigen/FFT>
+#endif
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace math
+{
+
+#ifdef ALEPH_WITH_EIGEN
+
+namespace detail
+{
+
+/**
+  Transforms a multi-dimensional array, stored in row-major order, by
+  applying one-dimensional discrete Fourier transforms along every axis.
+
+  @param data    Array to transform
+  @param sizes   Number of elements along every axis
+  @param inverse If set, calculates the inverse transform
+*/
+
+inline void fourierTransform( std::vector< std::complex<double> >& data,
+                              const std::vector<std::size_t>& sizes,
+                              bool inverse )
+{
+  Eigen::FFT<double> fft;
+
+  std::vector< std::complex<double> > input;
+  std::vector< std::complex<double> > output;
+
+  // Number of elements that separate two subsequent entries along the
+  // current axis.
+  std::size_t stride = data.size();
+
+  for( auto&& size : sizes )
+  {
+    stride /= size;
+
+    input.resize( size );
+
+    for( std::size_t offset = 0; offset < data.size(); offset++ )
+    {
+      // Only process the lines that start at the first element along
+      // the current axis.
+      if( ( offset / stride ) % size != 0 )
+        continue;
+
+      for( std::size_t i = 0; i < size; i++ )
+        input[i] = data[ offset + i * stride ];
+
+      if( inverse )
+        fft.inv( output, input );
+      else
+        fft.fwd( output, input );
+
+      for( std::size_t i = 0; i < size; i++ )
+        data[ offset + i * stride ] = output[i];
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+  @class BinnedKernelDensityEstimator
+  @brief Kernel density estimator on a regular grid
+
+  This class approximates the same estimate as the generic kernel
+  density estimator with a Euclidean norm. All points are distributed
+  to the vertices of a regular grid using linear binning. The estimate
+  at every grid vertex is then obtained by convolving the binned counts
+  with the kernel, which is performed by fast Fourier transforms. Hence,
+  the costs are dominated by the size of the grid, rather than by the
+  number of points. Estimates at arbitrary positions are interpolated
+  from the surrounding grid vertices.
+
+  The size of the grid grows exponentially with the dimension, so the
+  estimator is only suitable for low-dimensional data.
+
+  As for TreeKernelDensityEstimator, the interface differs from the one
+  of KernelDensityEstimator: the point cloud is passed upon construction
+  so that the grid only has to be convolved once for all queries, and
+  the norm is always the Euclidean norm.
+
+  @tparam Kernel Kernel to use for calculating density estimates
+*/
+
+template <class Kernel> class BinnedKernelDensityEstimator
+{
+public:
+
+  /**
+    Creates a new estimator for a given point cloud.
+
+    @param container Point cloud
+    @param bandwidth Bandwidth
+    @param kernel    Kernel to use for calculating density estimates
+    @param gridSize  Number of grid vertices along every axis that are
+                     used to cover the bounding box of the point cloud
+  */
+
+  template <class Container> BinnedKernelDensityEstimator( const Container& container,
+                                                           double bandwidth,
+                                                           Kernel kernel = Kernel(),
+                                                           std::size_t gridSize = 64 )
+    : _bandwidth( bandwidth )
+    , _n( container.size() )
+    , _d( container.dimension() )
+  {
+    if( _bandwidth <= 0 )
+      throw std::runtime_error( "Bandwidth must be positive" );
+
+    if( gridSize < 2 )
+      throw std::runtime_error( "Grid must contain at least two vertices per axis" );
+
+    _points.reserve( _n * _d );
+
+    for( std::size_t i = 0; i < _n; i++ )
+    {
+      auto&& p = container[i];
+
+      for( std::size_t k = 0; k < _d; k++ )
+        _points.push_back( static_cast<double>( p[k] ) );
+    }
+
+    if( _n == 0 )
+      return;
+
+    auto radius = BinnedKernelDensityEstimator::support( kernel ) * _bandwidth;
+
+    // Grid setup --------------------------------------------------------
+    //
+    // The grid covers the bounding box of the points. It is padded by the
+    // support of the kernel along every axis, so the cyclic convolution
+    // does not wrap around. Since the support is positive, every axis has
+    // at least three vertices.
+
+    _origin.resize( _d );
+    _spacing.resize( _d );
+    _sizes.resize( _d );
+
+    std::vector<std::size_t> offsets( _d );
+    std::size_t numVertices = 1;
+
+    for( std::size_t k = 0; k < _d; k++ )
+    {
+      auto lower = std::numeric_limits<double>::max();
+      auto upper = std::numeric_limits<double>::lowest();
+
+      for( std::size_t i = 0; i < _n; i++ )
+      {
+        lower = std::min( lower, _points[ i * _d + k ] );
+        upper = std::max( upper, _points[ i * _d + k ] );
+      }
+
+      _spacing[k] = upper > lower ? ( upper - lower ) / static_cast<double>( gridSize - 1 ) : _bandwidth;
+      offsets[k]  = static_cast<std::size_t>( std::ceil( radius / _spacing[k] ) );
+      _origin[k]  = lower - static_cast<double>( offsets[k] ) * _spacing[k];
+      _sizes[k]   = ( upper > lower ? gridSize : 1 ) + 2 * offsets[k];
+
+      if( numVertices > maxGridSize() / _sizes[k] )
+        throw std::runtime_error( "Grid is too large; please use a smaller grid or a tree-based estimator" );
+
+      numVertices *= _sizes[k];
+    }
+
+    // Linear binning ----------------------------------------------------
+
+    std::vector< std::complex<double> > counts( numVertices );
+
+    for( std::size_t i = 0; i < _n; i++ )
+    {
+      this->distribute( _points.data() + i * _d,
+                        [&counts] ( std::size_t vertex, double weight )
+                        {
+                          counts[vertex] += weight;
+                        } );
+    }
+
+    // Kernel ------------------------------------------------------------
+    //
+    // The kernel is sampled at all offsets within its support. Negative
+    // offsets are stored cyclically at the end of every axis.
+
+    std::vector< std::complex<double> > weights( numVertices );
+
+    for( std::size_t vertex = 0; vertex < numVertices; vertex++ )
+    {
+      double distance = 0.0;
+      bool inside     = true;
+      auto remainder  = vertex;
+
+      for( std::size_t k = _d; k-- > 0; )
+      {
+        auto j     = remainder % _sizes[k];
+        remainder /= _sizes[k];
+
+        auto offset = j <= _sizes[k] / 2 ? static_cast<double>( j ) : -static_cast<double>( _sizes[k] - j );
+        inside      = inside && std::abs( offset ) <= static_cast<double>( offsets[k] );
+        distance   += offset * offset * _spacing[k] * _spacing[k];
+      }
+
+      if( inside )
+        weights[vertex] = kernel( std::sqrt( distance ) / _bandwidth );
+    }
+
+    // Convolution -------------------------------------------------------
+
+    detail::fourierTransform( counts,  _sizes, false );
+    detail::fourierTransform( weights, _sizes, false );
+
+    for( std::size_t vertex = 0; vertex < numVertices; vertex++ )
+      counts[vertex] *= weights[vertex];
+
+    detail::fourierTransform( counts, _sizes, true );
+
+    auto normalization = std::pow( _bandwidth, static_cast<double>( _d ) ) * static_cast<double>( _n );
+
+    _grid.resize( numVertices );
+
+    // Small negative values may occur due to rounding errors of the
+    // transform, but they are not valid density estimates.
+    for( std::size_t vertex = 0; vertex < numVertices; vertex++ )
+      _grid[vertex] = std::max( counts[vertex].real() / normalization, 0.0 );
+  }
+
+  /**
+    Evaluates the kernel density estimator at a given position by
+    interpolating the estimates at the surrounding grid vertices.
+
+    @param x Input iterator to the coordinates of the position
+  */
+
+  template <class InputIterator> double operator()( InputIterator x ) const
+  {
+    std::vector<double> query( _d );
+
+    for( std::size_t k = 0; k < _d; k++, ++x )
+      query[k] = static_cast<double>( *x );
+
+    return this->interpolate( query.data() );
+  }
+
+  /**
+    Evaluates the kernel density estimator at all points that have been
+    used to create it.
+
+    @returns Density estimates, following the order of the points in
+             the original container
+  */
+
+  std::vector<double> densities() const
+  {
+    std::vector<double> result( _n );
+
+    for( std::size_t i = 0; i < _n; i++ )
+      result[i] = this->interpolate( _points.data() + i * _d );
+
+    return result;
+  }
+
+  std::size_t size()      const noexcept { return _n; }
+  std::size_t dimension() const noexcept { return _d; }
+
+private:
+
+  static constexpr std::size_t maxGridSize() { return std::size_t(1) << 27; }
+
+  /**
+    Determines the support of the kernel, i.e. the smallest radius for
+    which the kernel is negligible. The radius is doubled until the value
+    of the kernel drops below a small fraction of its maximum.
+  */
+
+  static double support( const Kernel& kernel )
+  {
+    auto threshold = 1e-12 * kernel( 0.0 );
+    auto radius    = 1.0;
+
+    while( kernel( radius ) > threshold && radius < 1024.0 )
+      radius *= 2.0;
+
+    return radius;
+  }
+
+  /**
+    Distributes a point to the vertices of the grid cell that contains
+    it. The weights are the coefficients of multilinear interpolation.
+  */
+
+  template <class Functor> void distribute( const double* x, Functor f ) const
+  {
+    std::vector<std::size_t> base( _d );
+    std::vector<double> fraction( _d );
+
+    for( std::size_t k = 0; k < _d; k++ )
+    {
+      auto position = ( x[k] - _origin[k] ) / _spacing[k];
+      position      = std::min( std::max( position, 0.0 ), static_cast<double>( _sizes[k] - 1 ) );
+
+      base[k]       = std::min( static_cast<std::size_t>( position ), _sizes[k] - 2 );
+      fraction[k]   = position - static_cast<double>( base[k] );
+    }
+
+    // Enumerate all corners of the cell; every bit of the corner index
+    // selects either the lower or the upper vertex along one axis.
+    for( std::size_t corner = 0; corner < ( std::size_t(1) << _d ); corner++ )
+    {
+      std::size_t vertex = 0;
+      double weight      = 1.0;
+
+      for( std::size_t k = 0; k < _d; k++ )
+      {
+        bool upper = ( ( corner >> k ) & 1 ) != 0;
+
+        vertex  = vertex * _sizes[k] + base[k] + ( upper ? 1 : 0 );
+        weight *= upper ? fraction[k] : 1.0 - fraction[k];
+      }
+
+      if( weight > 0.0 )
+        f( vertex, weight );
+    }
+  }
+
+  double interpolate( const double* x ) const
+  {
+    if( _n == 0 )
+      return 0.0;
+
+    // Positions outside the padded grid are farther away from all points
+    // than the support of the kernel.
+    for( std::size_t k = 0; k < _d; k++ )
+    {
+      auto position = ( x[k] - _origin[k] ) / _spacing[k];
+      if( position < 0.0 || position > static_cast<double>( _sizes[k] - 1 ) )
+        return 0.0;
+    }
+
+    double value = 0.0;
+
+    this->distribute( x,
+                      [this, &value] ( std::size_t vertex, double weight )
+                      {
+                        value += weight * _grid[vertex];
+                      } );
+
+    return value;
+  }
+
+  double _bandwidth;
+
+  std::size_t _n;
+  std::size_t _d;
+
+  /** Coordinates of all points */
+  std::vector<double> _points;
+
+  /** Position of the first grid vertex */
+  std::vector<double> _origin;
+
+  /** Distance between two grid vertices along every axis */
+  std::vector<double> _spacing;
+
+  /** Number of grid vertices along every axis */
+  std::vector<std::size_t> _sizes;
+
+  /** Density estimates at all grid vertices, in row-major order */
+  std::vector<double> _grid;
+};
+
+#endif
+
+} // namespace math
+
+} // namespace aleph
+
+#endif
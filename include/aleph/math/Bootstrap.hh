@@ -2,15 +2,19 @@
 #define ALEPH_MATH_BOOTSTRAP_HH__
 
 #include <aleph/math/KahanSummation.hh>
+#include <aleph/math/Philox.hh>
 
 #include <boost/math/distributions/students_t.hpp>
 
 #include <algorithm>
 #include <iterator>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace aleph
 {
@@ -18,6 +22,64 @@ namespace aleph
 namespace math
 {
 
+namespace detail
+{
+
+/**
+  @class IndexedIterator
+  @brief Random access iterator for traversing a range by indices
+
+  Provides a view of a bootstrap sample without copying any values. The
+  iterator traverses a range of indices and dereferences them using the
+  original data range.
+*/
+
+template <class RandomAccessIterator> class IndexedIterator
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type        = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  using difference_type   = std::ptrdiff_t;
+  using reference         = typename std::iterator_traits<RandomAccessIterator>::reference;
+  using pointer           = typename std::iterator_traits<RandomAccessIterator>::pointer;
+  using IndexIterator     = std::vector<std::uint32_t>::const_iterator;
+
+  IndexedIterator( RandomAccessIterator data, IndexIterator index )
+    : _data( data )
+    , _index( index )
+  {
+  }
+
+  reference operator*() const                    { return _data[ difference_type( *_index ) ];        }
+  pointer operator->() const                     { return &( this->operator*() );                     }
+  reference operator[]( difference_type n ) const { return _data[ difference_type( _index[n] ) ];     }
+
+  IndexedIterator& operator++()                  { ++_index; return *this;                            }
+  IndexedIterator& operator--()                  { --_index; return *this;                            }
+  IndexedIterator operator++( int )              { auto it = *this; ++_index; return it;              }
+  IndexedIterator operator--( int )              { auto it = *this; --_index; return it;              }
+  IndexedIterator& operator+=( difference_type n ) { _index += n; return *this;                       }
+  IndexedIterator& operator-=( difference_type n ) { _index -= n; return *this;                       }
+
+  IndexedIterator operator+( difference_type n ) const { return IndexedIterator( _data, _index + n ); }
+  IndexedIterator operator-( difference_type n ) const { return IndexedIterator( _data, _index - n ); }
+
+  difference_type operator-( const IndexedIterator& other ) const { return _index - other._index;      }
+
+  bool operator==( const IndexedIterator& other ) const { return _index == other._index; }
+  bool operator!=( const IndexedIterator& other ) const { return _index != other._index; }
+  bool operator< ( const IndexedIterator& other ) const { return _index <  other._index; }
+  bool operator> ( const IndexedIterator& other ) const { return _index >  other._index; }
+  bool operator<=( const IndexedIterator& other ) const { return _index <= other._index; }
+  bool operator>=( const IndexedIterator& other ) const { return _index >= other._index; }
+
+private:
+  RandomAccessIterator _data;
+  IndexIterator _index;
+};
+
+} // namespace detail
+
 /**
   @class Bootstrap
   @brief Generic bootstrap functor
@@ -26,18 +88,45 @@ namespace math
   operations on *arbitrary* data, using an *arbitrary* statistic for
   testing. Several convenience functions for estimating *confidence*
   values are provided.
+
+  Every bootstrap replicate draws its samples from a separate stream of
+  a counter-based random number generator. Hence, if a seed is given,
+  all results are reproducible, regardless of whether the replicates
+  are calculated sequentially or in parallel.
 */
 
 class Bootstrap
 {
 public:
 
+  /**
+    Creates a new bootstrap functor that uses a random seed for every
+    calculation.
+  */
+
+  Bootstrap() = default;
+
+  /**
+    Creates a new bootstrap functor with a fixed seed. All calculations
+    will be reproducible.
+  */
+
+  explicit Bootstrap( std::uint64_t seed )
+    : _seed( seed )
+    , _useSeed( true )
+  {
+  }
+
   /**
     Given a range of data of some type, calculates a set of bootstrap replicates
     for a desired statistic. This function will not perform any type conversions
     in order to preserve all original types. The type of the output data depends
     on the return value type of the functor.
 
+    Samples are not copied. Instead, the functor receives a pair of random
+    access iterators that traverse the original data according to the indices
+    of the current sample.
+
     @param[in]  numSamples samples Number of bootstrap samples
     @param[in]  begin      Input iterator to begin of data range
     @param[in]  end        Input iterator to end of data range
@@ -51,38 +140,41 @@ public:
                        Functor functor,
                        OutputIterator result )
   {
-    using SampleValueType  = typename std::iterator_traits<InputIterator>::value_type;
-    using FunctorValueType = decltype( functor( begin, end ) );
-
-    std::vector<SampleValueType> samples( begin, end );
-
-    // We cannot continue anyway, so let's just be nice and stop. This
-    // does *not* constitute an error condition, though, because users
-    // might just be weird when calling this function with empty data.
-    if( samples.empty() )
-      return;
+    this->makeReplicates( numSamples, begin, end, functor, result, _parallel );
+  }
 
-    std::random_device rd;
-    std::mt19937 rng( rd() );
+  /**
+    Calculates a set of bootstrap replicates in parallel. The results are
+    guaranteed to be identical to the ones of the sequential calculation,
+    for every number of threads. The functor must be safe to call from
+    multiple threads, and its return type must be default-constructible.
 
-    std::uniform_int_distribution<std::size_t> distribution( 0, samples.size() - 1 );
+    @see Bootstrap::makeReplicates()
+  */
 
-    std::vector<FunctorValueType> replicates;
-    replicates.reserve( numSamples );
+  template <class InputIterator, class OutputIterator, class Functor>
+  void makeReplicatesParallel( unsigned numSamples,
+                               InputIterator begin, InputIterator end,
+                               Functor functor,
+                               OutputIterator result )
+  {
+    this->makeReplicates( numSamples, begin, end, functor, result, true );
+  }
 
-    for( unsigned sampleIndex = 0; sampleIndex < numSamples; sampleIndex++ )
-    {
-      std::vector<SampleValueType> sample;
-      sample.reserve( samples.size() );
+  // Configuration -----------------------------------------------------
 
-      for( std::size_t i = 0; i < samples.size(); i++ )
-        sample.push_back( samples.at( distribution( rng ) ) );
+  /**
+    Sets whether replicates will be calculated in parallel for all of
+    the estimates of this class.
+  */
 
-      replicates.push_back( functor( sample.begin(),
-                                     sample.end() ) );
-    }
+  void setParallel( bool value = true ) noexcept { _parallel = value; }
+  bool parallel() const noexcept                 { return _parallel;  }
 
-    std::copy( replicates.begin(), replicates.end(), result );
+  void setSeed( std::uint64_t seed ) noexcept
+  {
+    _seed    = seed;
+    _useSeed = true;
   }
 
   /**
@@ -237,6 +329,123 @@ public:
     // is at index 99 of the vector.
     return static_cast<unsigned>( std::ceil( samples * alpha ) ) - 1;
   }
+
+private:
+
+  template <class InputIterator, class OutputIterator, class Functor>
+  void makeReplicates( unsigned numSamples,
+                       InputIterator begin, InputIterator end,
+                       Functor functor,
+                       OutputIterator result,
+                       bool parallel )
+  {
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+
+    this->makeReplicates( numSamples, begin, end, functor, result, parallel, Category() );
+  }
+
+  /**
+    Calculates replicates for ranges without random access. The range
+    needs to be copied *once* before indices can be used.
+  */
+
+  template <class InputIterator, class OutputIterator, class Functor>
+  void makeReplicates( unsigned numSamples,
+                       InputIterator begin, InputIterator end,
+                       Functor functor,
+                       OutputIterator result,
+                       bool parallel,
+                       std::input_iterator_tag )
+  {
+    using SampleValueType = typename std::iterator_traits<InputIterator>::value_type;
+
+    std::vector<SampleValueType> samples( begin, end );
+
+    this->makeReplicates( numSamples,
+                          samples.cbegin(), samples.cend(),
+                          functor,
+                          result,
+                          parallel,
+                          std::random_access_iterator_tag() );
+  }
+
+  template <class RandomAccessIterator, class OutputIterator, class Functor>
+  void makeReplicates( unsigned numSamples,
+                       RandomAccessIterator begin, RandomAccessIterator end,
+                       Functor functor,
+                       OutputIterator result,
+                       bool parallel,
+                       std::random_access_iterator_tag )
+  {
+    using Iterator         = detail::IndexedIterator<RandomAccessIterator>;
+    using FunctorValueType = decltype( functor( Iterator( begin, {} ), Iterator( begin, {} ) ) );
+
+    auto n = static_cast<std::size_t>( std::distance( begin, end ) );
+
+    // We cannot continue anyway, so let's just be nice and stop. This
+    // does *not* constitute an error condition, though, because users
+    // might just be weird when calling this function with empty data.
+    if( n == 0 )
+      return;
+
+    auto seed = this->seed();
+
+    // Every replicate uses its own stream of random numbers, so the
+    // results do not depend on the order in which they are calculated.
+    auto makeReplicate = [&] ( unsigned sampleIndex, std::vector<std::uint32_t>& indices )
+    {
+      aleph::math::Philox4x32 rng( seed, sampleIndex );
+
+      indices.resize( n );
+
+      for( auto&& index : indices )
+        index = rng.uniform( static_cast<std::uint32_t>( n ) );
+
+      return functor( Iterator( begin, indices.cbegin() ),
+                      Iterator( begin, indices.cend() ) );
+    };
+
+    if( parallel )
+    {
+      std::vector<FunctorValueType> replicates( numSamples );
+
+      #pragma omp parallel
+      {
+        std::vector<std::uint32_t> indices;
+
+        #pragma omp for schedule(dynamic)
+        for( unsigned sampleIndex = 0; sampleIndex < numSamples; sampleIndex++ )
+          replicates[sampleIndex] = makeReplicate( sampleIndex, indices );
+      }
+
+      std::move( replicates.begin(), replicates.end(), result );
+    }
+    else
+    {
+      std::vector<std::uint32_t> indices;
+
+      for( unsigned sampleIndex = 0; sampleIndex < numSamples; sampleIndex++ )
+        *result++ = makeReplicate( sampleIndex, indices );
+    }
+  }
+
+  /**
+    Returns the seed for the current calculation. Unless a seed has been
+    set explicitly, a new random seed will be used every time.
+  */
+
+  std::uint64_t seed() const
+  {
+    if( _useSeed )
+      return _seed;
+
+    std::random_device rd;
+    return ( std::uint64_t( rd() ) << 32 ) | std::uint64_t( rd() );
+  }
+
+  std::uint64_t _seed = 0;
+  bool _useSeed       = false;
+  bool _parallel      = false;
 };
 
 } // namespace math
@@ -0,0 +1,235 @@
+#ifndef ALEPH_MATH_EXPANSION_HH__
+#define ALEPH_MATH_EXPANSION_HH__
+
+#include <vector>
+
+#include <cmath>
+
+namespace aleph
+{
+
+namespace math
+{
+
+namespace detail
+{
+
+/**
+  Calculates the sum of two floating point numbers along with its
+  rounding error, such that \f$a + b = x + y\f$ holds exactly.
+*/
+
+inline void twoSum( double a, double b, double& x, double& y )
+{
+  x = a + b;
+
+  double bVirtual = x - a;
+  double aVirtual = x - bVirtual;
+
+  y = ( a - aVirtual ) + ( b - bVirtual );
+}
+
+/**
+  Calculates the product of two floating point numbers along with its
+  rounding error, such that \f$a \cdot b = x + y\f$ holds exactly.
+*/
+
+inline void twoProduct( double a, double b, double& x, double& y )
+{
+  x = a * b;
+  y = std::fma( a, b, -x );
+}
+
+} // namespace detail
+
+/**
+  @class Expansion
+  @brief Exact representation of a sum of floating point numbers
+
+  An expansion represents a real number as a sum of non-overlapping
+  floating point numbers that are sorted by increasing magnitude. As
+  long as no overflow or underflow occurs, sums, differences, and
+  products of expansions are *exact*, so the sign of an arithmetic
+  expression can be determined reliably. This is required for robust
+  geometric predicates.
+
+  The implementation follows the paper:
+
+  > Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates
+  > Jonathan Richard Shewchuk
+  > Discrete & Computational Geometry
+  > Volume 18, Issue 3, October 1997, Pages 305--363
+
+  Expansions are considerably slower than floating point numbers, so
+  they should only be used if a floating point calculation cannot be
+  trusted.
+*/
+
+class Expansion
+{
+public:
+  Expansion() = default;
+
+  Expansion( double x )
+  {
+    if( x != 0.0 )
+      _components.push_back( x );
+  }
+
+  /** Creates an expansion that represents the difference of two numbers exactly */
+  static Expansion difference( double a, double b )
+  {
+    double x = 0.0;
+    double y = 0.0;
+
+    detail::twoSum( a, -b, x, y );
+
+    Expansion e;
+
+    if( y != 0.0 )
+      e._components.push_back( y );
+
+    if( x != 0.0 )
+      e._components.push_back( x );
+
+    return e;
+  }
+
+  Expansion operator+( const Expansion& other ) const
+  {
+    Expansion result = *this;
+
+    for( auto&& c : other._components )
+      result.grow( c );
+
+    return result;
+  }
+
+  Expansion operator-() const
+  {
+    Expansion result = *this;
+
+    for( auto&& c : result._components )
+      c = -c;
+
+    return result;
+  }
+
+  Expansion operator-( const Expansion& other ) const
+  {
+    return *this + ( -other );
+  }
+
+  Expansion operator*( const Expansion& other ) const
+  {
+    Expansion result;
+
+    for( auto&& c : other._components )
+      result = result + this->scale( c );
+
+    return result;
+  }
+
+  /**
+    @returns Sign of the expansion, which is the sign of its component
+    with the largest magnitude
+  */
+
+  int sign() const noexcept
+  {
+    if( _components.empty() )
+      return 0;
+
+    return _components.back() > 0.0 ? 1 : -1;
+  }
+
+  /** @returns Approximation of the expansion */
+  double estimate() const noexcept
+  {
+    double sum = 0.0;
+
+    for( auto&& c : _components )
+      sum += c;
+
+    return sum;
+  }
+
+private:
+
+  /** Adds a single number to the expansion, eliminating all zeroes */
+  void grow( double b )
+  {
+    std::vector<double> components;
+    components.reserve( _components.size() + 1 );
+
+    double q = b;
+
+    for( auto&& c : _components )
+    {
+      double h = 0.0;
+      detail::twoSum( q, c, q, h );
+
+      if( h != 0.0 )
+        components.push_back( h );
+    }
+
+    if( q != 0.0 )
+      components.push_back( q );
+
+    _components.swap( components );
+  }
+
+  /** Multiplies the expansion with a single number */
+  Expansion scale( double b ) const
+  {
+    Expansion result;
+
+    if( _components.empty() || b == 0.0 )
+      return result;
+
+    auto&& components = result._components;
+    components.reserve( 2 * _components.size() );
+
+    double q = 0.0;
+    double h = 0.0;
+
+    detail::twoProduct( _components.front(), b, q, h );
+
+    if( h != 0.0 )
+      components.push_back( h );
+
+    for( std::size_t i = 1; i < _components.size(); i++ )
+    {
+      double p1 = 0.0;
+      double p0 = 0.0;
+      double s  = 0.0;
+
+      detail::twoProduct( _components[i], b, p1, p0 );
+      detail::twoSum( q, p0, s, h );
+
+      if( h != 0.0 )
+        components.push_back( h );
+
+      // Since the magnitude of p1 is at least as large as the one of s,
+      // the error of this sum could also be calculated with fewer
+      // operations.
+      detail::twoSum( p1, s, q, h );
+
+      if( h != 0.0 )
+        components.push_back( h );
+    }
+
+    if( q != 0.0 )
+      components.push_back( q );
+
+    return result;
+  }
+
+  std::vector<double> _components;
+};
+
+} // namespace math
+
+} // namespace aleph
+
+#endif
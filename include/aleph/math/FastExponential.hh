@@ -0,0 +1,89 @@
+#ifndef ALEPH_MATH_FAST_EXPONENTIAL_HH__
+#define ALEPH_MATH_FAST_EXPONENTIAL_HH__
+
+#include <cstdint>
+#include <cstring>
+
+namespace aleph
+{
+
+namespace math
+{
+
+/**
+  Calculates the exponential function for non-positive arguments. Unlike
+  `std::exp`, this function does not contain any branches or calls to
+  the C library, so compilers are able to vectorise loops that use it,
+  for example when evaluating Gaussian kernels for many points at once.
+
+  The argument is split into \f$k \ln 2 + r\f$ with \f$|r| \leq \ln 2 / 2\f$,
+  and \f$\exp(r)\f$ is approximated by its Taylor polynomial of degree
+  12. The relative error of the result is thus of the order of the
+  machine precision. Results below \f$2^{-1000}\f$, i.e. arguments less
+  than approximately \f$-693\f$, are flushed to zero. Positive arguments
+  are *not* supported.
+
+  @param x Argument; must not be positive
+
+  @returns Approximation of \f$\exp(x)\f$
+*/
+
+inline double fastExp( double x ) noexcept
+{
+  // Adding this constant rounds the quotient to the nearest integer and
+  // stores it in the lowest bits of the mantissa.
+  const double shift   = 6755399441055744.0; // 1.5 * 2^52
+  const double log2e   = 1.4426950408889634074;
+  const double ln2High = 6.93147180369123816490e-01;
+  const double ln2Low  = 1.90821492927058770002e-10;
+
+  double t = x * log2e + shift;
+  double k = t - shift;
+  double r = ( x - k * ln2High ) - k * ln2Low;
+
+  double p = 1.0 / 479001600.0;
+  p = p * r + 1.0 / 39916800.0;
+  p = p * r + 1.0 / 3628800.0;
+  p = p * r + 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  // Multiply by 2^k by adding k to the exponent of the result. Unsigned
+  // arithmetic ensures that negative values of k wrap around properly.
+  // All operations are free of branches, which would prevent the loops
+  // that call this function from being vectorised.
+  std::uint64_t kBits;
+  std::uint64_t pBits;
+
+  std::memcpy( &kBits, &t, sizeof(double) );
+  std::memcpy( &pBits, &p, sizeof(double) );
+
+  // Is one if k is less than -1000, and zero otherwise. Checking the sign
+  // of t covers arguments whose magnitude is too large for the rounding
+  // trick.
+  std::uint64_t underflow = kBits >> 63;
+
+  kBits     -= UINT64_C(0x4338000000000000);
+  underflow |= ( kBits + 1000 ) >> 63;
+
+  pBits += kBits << 52;
+  pBits &= underflow - 1;
+
+  double result;
+  std::memcpy( &result, &pBits, sizeof(double) );
+
+  return result;
+}
+
+} // namespace math
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,568 @@
+#ifndef ALEPH_MATH_FLAT_STEP_FUNCTION_HH__
+#define ALEPH_MATH_FLAT_STEP_FUNCTION_HH__
+
+#include <aleph/math/StepFunction.hh>
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace math
+{
+
+/**
+  @class FlatStepFunction
+  @brief Models a step function using contiguous arrays
+
+  This class stores a step function as a sorted array of breakpoints
+  \f$x_0 < x_1 < \dots < x_n\f$ and an array of values \f$y_0, \dots,
+  y_{n-1}\f$. The function attains the value \f$y_i\f$ on the interval
+  \f$[x_i, x_{i+1}]\f$ and is zero outside of \f$[x_0, x_n]\f$. Gaps
+  between the indicator functions of a step function are represented
+  by explicit zero values.
+
+  In contrast to the set-based @c StepFunction class, all arithmetical
+  operations are performed by merging the breakpoint arrays. Hence, they
+  require time that is linear in the number of breakpoints. This makes
+  the class suitable for calculating large numbers of distances between
+  step functions, e.g. between persistence indicator functions.
+
+  @tparam D Type of the *domain* of the step function
+  @tparam I Type of the *image* of the step function
+*/
+
+template <class D, class I = D> class FlatStepFunction
+{
+public:
+
+  using Domain = D;
+  using Image  = I;
+
+  /** Creates an empty step function, i.e. the zero function */
+  FlatStepFunction() = default;
+
+  /**
+    Creates a new step function from arrays of breakpoints and values.
+    The array of breakpoints must be strictly increasing and contain
+    exactly one element more than the array of values, unless both of
+    them are empty.
+  */
+
+  FlatStepFunction( std::vector<D> x, std::vector<I> y )
+    : _x( std::move( x ) )
+    , _y( std::move( y ) )
+  {
+    if( _x.empty() && _y.empty() )
+      return;
+
+    if( _x.size() != _y.size() + 1 )
+      throw std::runtime_error( "Number of breakpoints and number of values do not match" );
+
+    for( std::size_t i = 1; i < _x.size(); i++ )
+    {
+      if( !( _x[i-1] < _x[i] ) )
+        throw std::runtime_error( "Breakpoints must be strictly increasing" );
+    }
+
+    this->compact();
+  }
+
+  /**
+    Converts a set-based step function. Indicator functions of empty
+    volume are removed because they do not contribute to any integral.
+    Indicator functions may touch each other, but they must not overlap
+    because the value of the function would not be well-defined.
+  */
+
+  explicit FlatStepFunction( const StepFunction<D,I>& f )
+  {
+    auto indicatorFunctions = f.indicatorFunctions();
+
+    _x.reserve( 2 * indicatorFunctions.size() );
+    _y.reserve( 2 * indicatorFunctions.size() );
+
+    for( auto&& indicatorFunction : indicatorFunctions )
+    {
+      auto a = indicatorFunction.a();
+      auto b = indicatorFunction.b();
+
+      if( a == b )
+        continue;
+
+      if( _x.empty() )
+        _x.push_back( a );
+
+      else if( a < _x.back() )
+        throw std::runtime_error( "Indicator functions must not overlap" );
+
+      // Fill a gap between two subsequent indicator functions with an
+      // explicit zero value.
+      else if( _x.back() < a )
+      {
+        _y.push_back( I() );
+        _x.push_back( a );
+      }
+
+      _y.push_back( indicatorFunction.y() );
+      _x.push_back( b );
+    }
+
+    this->compact();
+  }
+
+  /** Converts the function into a set-based step function */
+  StepFunction<D,I> toStepFunction() const
+  {
+    StepFunction<D,I> f;
+
+    for( std::size_t i = 0; i < _y.size(); i++ )
+    {
+      if( _y[i] != I() )
+        f.add( _x[i], _x[i+1], _y[i] );
+    }
+
+    return f;
+  }
+
+  /** Returns the number of intervals of the step function */
+  std::size_t size() const noexcept
+  {
+    return _y.size();
+  }
+
+  /** Checks whether the step function has no intervals */
+  bool empty() const noexcept
+  {
+    return _y.empty();
+  }
+
+  /** Returns the sorted array of breakpoints */
+  const std::vector<D>& breakpoints() const noexcept
+  {
+    return _x;
+  }
+
+  /** Returns the array of values; value \f$i\f$ belongs to the interval starting at breakpoint \f$i\f$ */
+  const std::vector<I>& values() const noexcept
+  {
+    return _y;
+  }
+
+  /** Returns the domain of the function */
+  template <class OutputIterator> void domain( OutputIterator result ) const
+  {
+    std::copy( _x.begin(), _x.end(), result );
+  }
+
+  /** Returns the image of the function */
+  template <class OutputIterator> void image( OutputIterator result ) const
+  {
+    std::copy( _y.begin(), _y.end(), result );
+  }
+
+  /**
+    Returns the function value at a certain position. At a breakpoint,
+    the value of the interval starting at the breakpoint is used.
+  */
+
+  I operator()( D x ) const noexcept
+  {
+    if( _y.empty() || x < _x.front() || _x.back() < x )
+      return I();
+
+    auto it = std::upper_bound( _x.begin(), _x.end(), x );
+    auto i  = static_cast<std::size_t>( std::distance( _x.begin(), it ) );
+
+    // The last breakpoint belongs to the last interval because the
+    // intervals are closed.
+    return _y[ std::min( i, _y.size() ) - 1 ];
+  }
+
+  /** Calculates the maximum (supremum) of the step function */
+  I max() const noexcept
+  {
+    if( _y.empty() )
+      return I();
+
+    return *std::max_element( _y.begin(), _y.end() );
+  }
+
+  /** Calculates the supremum (maximum) of the step function */
+  I sup() const noexcept
+  {
+    return this->max();
+  }
+
+  // Arithmetic --------------------------------------------------------
+
+  /** Calculates the sum of this step function with another step function */
+  FlatStepFunction& operator+=( const FlatStepFunction& other )
+  {
+    *this = FlatStepFunction::merge( *this, other, [] ( I a, I b ) { return a + b; } );
+    return *this;
+  }
+
+  /** Calculates the sum of this step function with another step function */
+  FlatStepFunction operator+( const FlatStepFunction& rhs ) const
+  {
+    return FlatStepFunction::merge( *this, rhs, [] ( I a, I b ) { return a + b; } );
+  }
+
+  /** Calculates the difference of this step function with another step function */
+  FlatStepFunction& operator-=( const FlatStepFunction& other )
+  {
+    *this = FlatStepFunction::merge( *this, other, [] ( I a, I b ) { return a - b; } );
+    return *this;
+  }
+
+  /** Calculates the difference of this step function with another step function */
+  FlatStepFunction operator-( const FlatStepFunction& rhs ) const
+  {
+    return FlatStepFunction::merge( *this, rhs, [] ( I a, I b ) { return a - b; } );
+  }
+
+  /** Unary minus: negates all values in the image of the step function */
+  FlatStepFunction operator-() const
+  {
+    auto f = *this;
+
+    for( auto&& y : f._y )
+      y = -y;
+
+    return f;
+  }
+
+  /**
+    Adds a scalar to all values of the step function within its support,
+    i.e. on all intervals with a non-zero value. Gaps between indicator
+    functions, which are stored as zero values, remain zero.
+  */
+
+  FlatStepFunction operator+( I lambda ) const
+  {
+    auto f = *this;
+
+    for( auto&& y : f._y )
+    {
+      if( y != I() )
+        y += lambda;
+    }
+
+    f.compact();
+    return f;
+  }
+
+  /** Subtracts a scalar from all values of the step function within its support */
+  FlatStepFunction operator-( I lambda ) const
+  {
+    return this->operator+( -lambda );
+  }
+
+  /** Multiplies the given step function with a scalar value */
+  FlatStepFunction& operator*=( I lambda )
+  {
+    for( auto&& y : _y )
+      y *= lambda;
+
+    this->compact();
+    return *this;
+  }
+
+  /** Multiplies the given step function with a scalar value */
+  FlatStepFunction operator*( I lambda ) const
+  {
+    auto f = *this;
+    f *= lambda;
+    return f;
+  }
+
+  /** Divides the given step function by a scalar value */
+  FlatStepFunction& operator/=( I lambda )
+  {
+    if( lambda == I() )
+      throw std::runtime_error( "Attempted division by zero" );
+
+    return this->operator*=( 1/lambda );
+  }
+
+  /** Divides the given step function by a scalar value */
+  FlatStepFunction operator/( I lambda ) const
+  {
+    auto f = *this;
+    f /= lambda;
+    return f;
+  }
+
+  /** Calculates the integral over the domain of the step function */
+  I integral() const noexcept
+  {
+    I value = I();
+
+    for( std::size_t i = 0; i < _y.size(); i++ )
+      value += _y[i] * static_cast<I>( _x[i+1] - _x[i] );
+
+    return value;
+  }
+
+  /** Calculates the absolute value of the function */
+  FlatStepFunction& abs()
+  {
+    for( auto&& y : _y )
+      y = std::abs( y );
+
+    this->compact();
+    return *this;
+  }
+
+  /** Raises the function to a certain power */
+  FlatStepFunction& pow( I p )
+  {
+    for( auto&& y : _y )
+      y = std::pow( y, p );
+
+    this->compact();
+    return *this;
+  }
+
+  /**
+    Merges two step functions by applying a binary operation to their
+    values. The breakpoints of both functions are traversed only once,
+    so the resulting function is created in linear time.
+  */
+
+  template <class BinaryOperation> static FlatStepFunction merge( const FlatStepFunction& f,
+                                                                  const FlatStepFunction& g,
+                                                                  BinaryOperation op )
+  {
+    FlatStepFunction h;
+
+    h._x.reserve( f._x.size() + g._x.size() );
+    h._y.reserve( f._y.size() + g._y.size() + 1 );
+
+    FlatStepFunction::sweep( f, g,
+      [&h, &op] ( D a, D b, I y1, I y2 )
+      {
+        auto y = op( y1, y2 );
+
+        if( h._x.empty() )
+          h._x.push_back( a );
+
+        // Extend the previous interval instead of creating a new one in
+        // order to keep the representation minimal.
+        if( !h._y.empty() && h._y.back() == y )
+          h._x.back() = b;
+        else
+        {
+          h._y.push_back( y );
+          h._x.push_back( b );
+        }
+      }
+    );
+
+    return h;
+  }
+
+  /**
+    Traverses the common refinement of the intervals of two step functions.
+    For every interval \f$[a,b]\f$ of the refinement, the callback receives
+    the boundaries of the interval and the values of both functions. Gaps
+    between the domains of the functions are reported with zero values.
+  */
+
+  template <class Callback> static void sweep( const FlatStepFunction& f,
+                                               const FlatStepFunction& g,
+                                               Callback callback )
+  {
+    auto&& x1 = f._x;
+    auto&& x2 = g._x;
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    // Value of either function on the interval that starts at the
+    // current position of the sweep.
+    auto value = [] ( const FlatStepFunction& h, std::size_t k )
+    {
+      return k > 0 && k < h._x.size() ? h._y[k-1] : I();
+    };
+
+    bool first = true;
+    D a        = D();
+
+    while( i < x1.size() || j < x2.size() )
+    {
+      // The values on [a,b] are determined by all breakpoints that have
+      // been processed so far.
+      auto y1 = value( f, i );
+      auto y2 = value( g, j );
+
+      D b = D();
+
+      if( j == x2.size() || ( i < x1.size() && x1[i] < x2[j] ) )
+        b = x1[i++];
+      else if( i == x1.size() || x2[j] < x1[i] )
+        b = x2[j++];
+      else
+      {
+        b = x1[i++];
+        ++j;
+      }
+
+      if( !first )
+        callback( a, b, y1, y2 );
+
+      a     = b;
+      first = false;
+    }
+  }
+
+private:
+
+  /** Merges subsequent intervals that have the same value */
+  void compact()
+  {
+    if( _y.empty() )
+      return;
+
+    std::size_t m = 0;
+
+    for( std::size_t i = 1; i < _y.size(); i++ )
+    {
+      if( _y[i] == _y[m] )
+        continue;
+
+      ++m;
+
+      _x[m] = _x[i];
+      _y[m] = _y[i];
+    }
+
+    _x[m+1] = _x.back();
+
+    _x.resize( m+2 );
+    _y.resize( m+1 );
+  }
+
+  /** Sorted breakpoints */
+  std::vector<D> _x;
+
+  /** Values of the function; _y[i] is attained on [ _x[i], _x[i+1] ] */
+  std::vector<I> _y;
+};
+
+template <class D, class I> std::ostream& operator<<( std::ostream& o, const FlatStepFunction<D, I>& f )
+{
+  auto&& x = f.breakpoints();
+  auto&& y = f.values();
+
+  for( std::size_t i = 0; i < y.size(); i++ )
+  {
+    o << x[i]   << "\t" << y[i] << "\n"
+      << x[i+1] << "\t" << y[i] << "\n";
+  }
+
+  return o;
+}
+
+/**
+  Auxiliary function for normalizing a step function. Given a range
+  spanned by a minimum $a$ and a maximum $b$, the image of the step
+  function will be restricted to $[a,b]$. As for the set-based step
+  function, the minimum of the image is assumed to be zero.
+
+  The transformed step function will be returned.
+*/
+
+template <class D, class I> FlatStepFunction<D,I> normalize( const FlatStepFunction<D,I>& f,
+                                                             I a = I(),
+                                                             I b = I(1) )
+{
+  auto&& values = f.values();
+
+  if( values.empty() )
+    return f;
+
+  auto max = *std::max_element( values.begin(), values.end() );
+  auto min = I();
+
+  if( max == min )
+    return f;
+
+  auto g = f - min;
+  g      = g / ( max - min ); // now scaled between [0,1  ]
+  g      = g * (   b -   a ); // now scaled between [0,b-a]
+  g      = g + a;             // now scaled between [a,b  ]
+
+  return g;
+}
+
+/**
+  Calculates the \f$L_p\f$ distance between two step functions, i.e.
+  \f$\left(\int |f-g|^p\right)^{1/p}\f$. In contrast to evaluating the
+  expression with the arithmetical operators, this function does not
+  create any intermediate step functions. An infinite value of \f$p\f$
+  results in the supremum distance.
+*/
+
+template <class D, class I> I lpDistance( const FlatStepFunction<D,I>& f,
+                                          const FlatStepFunction<D,I>& g,
+                                          I p = I(1) )
+{
+  if( p < I(1) )
+    throw std::runtime_error( "Power must be at least one" );
+
+  I value = I();
+
+  if( std::isinf( p ) )
+  {
+    FlatStepFunction<D,I>::sweep( f, g,
+      [&value] ( D, D, I y1, I y2 )
+      {
+        value = std::max( value, std::abs( y1 - y2 ) );
+      }
+    );
+
+    return value;
+  }
+
+  if( p == I(1) )
+  {
+    FlatStepFunction<D,I>::sweep( f, g,
+      [&value] ( D a, D b, I y1, I y2 )
+      {
+        value += std::abs( y1 - y2 ) * static_cast<I>( b - a );
+      }
+    );
+
+    return value;
+  }
+
+  FlatStepFunction<D,I>::sweep( f, g,
+    [&value, &p] ( D a, D b, I y1, I y2 )
+    {
+      value += std::pow( std::abs( y1 - y2 ), p ) * static_cast<I>( b - a );
+    }
+  );
+
+  return std::pow( value, 1/p );
+}
+
+} // namespace math
+
+} // namespace aleph
+
+template <class D, class I, class T> aleph::math::FlatStepFunction<D, I> operator*( T lambda, const aleph::math::FlatStepFunction<D, I>& f )
+{
+  return f * lambda;
+}
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef ALEPH_MATH_LANCZOS_HH__
+#define ALEPH_MATH_LANCZOS_HH__
+
+#include <aleph/config/Eigen.hh>
+
+#ifdef ALEPH_WITH_EIGEN
+  #include <Eigen/Core>
+  #include <Eigen/Eigenvalues>
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <cmath>
+
+namespace aleph
+{
+
+namespace math
+{
+
+#ifdef ALEPH_WITH_EIGEN
+
+/**
+  @class Lanczos
+  @brief Calculates extremal eigenpairs of a symmetric matrix
+
+  This class implements the Lanczos algorithm with full
+  reorthogonalization. It only requires matrix--vector products, so
+  it works with dense and sparse matrices alike, as well as with any
+  other operator that supports `rows()`, `cols()`, and products with
+  vectors. The memory requirements are linear in the number of steps
+  and the number of rows of the matrix.
+
+  Should the Krylov subspace become invariant before the requested
+  number of steps has been performed, e.g. because the underlying
+  graph of a Laplacian matrix is disconnected, the iteration will be
+  restarted with a new vector that is orthogonal to all previous
+  ones.
+
+  Eigenvalues will be reported in ascending order. Depending on the
+  configuration, either the \f$k\f$ smallest or the \f$k\f$ largest
+  eigenpairs are kept.
+*/
+
+template <class T> class Lanczos
+{
+public:
+  using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+  using Vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+#if EIGEN_VERSION_AT_LEAST(3,3,0)
+  using IndexType  = Eigen::Index;
+#else
+  using IndexType  = typename Matrix::Index;
+#endif
+
+  /**
+    Creates a new solver.
+
+    @param largest If set, calculates the largest eigenpairs instead
+                   of the smallest ones
+  */
+
+  explicit Lanczos( bool largest = false )
+    : _largest( largest )
+  {
+  }
+
+  /**
+    Calculates the \f$k\f$ extremal eigenpairs of a given symmetric
+    matrix.
+
+    @param A     Symmetric matrix; only products with vectors are
+                 being used
+
+    @param k     Number of eigenpairs to calculate
+
+    @param steps Number of Lanczos steps. If zero, a default value
+                 based on \f$k\f$ will be used. More steps increase
+                 the accuracy of the eigenpairs.
+
+    @param seed  Seed for the start vector of the iteration
+  */
+
+  template <class M> void compute( const M& A,
+                                   IndexType k,
+                                   IndexType steps = 0,
+                                   unsigned seed   = 42 )
+  {
+    auto n = A.rows();
+
+    if( A.cols() != n )
+      throw std::runtime_error( "Lanczos iteration requires a square matrix" );
+
+    if( steps == 0 )
+      steps = std::max( 2 * k, k + 20 );
+
+    steps = std::min( steps, n );
+    k     = std::min( k, steps );
+
+    if( steps == 0 )
+    {
+      _eigenvalues  = Vector();
+      _eigenvectors = Matrix();
+
+      return;
+    }
+
+    Matrix Q = Matrix::Zero( n, steps );
+    Vector alpha = Vector::Zero( steps );
+    Vector beta  = Vector::Zero( std::max( steps - 1, IndexType(1) ) );
+
+    std::mt19937 rng( seed );
+
+    Q.col(0) = this->startVector( Q, 0, rng );
+
+    for( IndexType j = 0; j < steps; j++ )
+    {
+      Vector w = A * Q.col(j);
+      alpha(j) = Q.col(j).dot( w );
+
+      // Full reorthogonalization; the second pass is required to
+      // retain orthogonality in finite precision arithmetic.
+      for( unsigned pass = 0; pass < 2; pass++ )
+        w -= Q.leftCols( j+1 ) * ( Q.leftCols( j+1 ).transpose() * w );
+
+      if( j + 1 == steps )
+        break;
+
+      auto norm = w.norm();
+
+      // The Krylov subspace is invariant, so the iteration needs to be
+      // restarted. Setting the off-diagonal entry to zero decouples the
+      // new block of the tridiagonal matrix from the previous one.
+      if( norm <= this->tolerance() * std::max( std::abs( alpha(j) ), T(1) ) )
+      {
+        beta(j)    = T();
+        Q.col(j+1) = this->startVector( Q, j+1, rng );
+      }
+      else
+      {
+        beta(j)    = norm;
+        Q.col(j+1) = w / norm;
+      }
+    }
+
+    Eigen::SelfAdjointEigenSolver<Matrix> solver;
+    solver.computeFromTridiagonal( alpha, beta.head( steps - 1 ) );
+
+    if( _largest )
+    {
+      _eigenvalues  = solver.eigenvalues().tail( k );
+      _eigenvectors = Q * solver.eigenvectors().rightCols( k );
+    }
+    else
+    {
+      _eigenvalues  = solver.eigenvalues().head( k );
+      _eigenvectors = Q * solver.eigenvectors().leftCols( k );
+    }
+  }
+
+  const Vector& eigenvalues()  const noexcept { return _eigenvalues;  }
+  const Matrix& eigenvectors() const noexcept { return _eigenvectors; }
+
+private:
+
+  static T tolerance()
+  {
+    return std::sqrt( std::numeric_limits<T>::epsilon() );
+  }
+
+  /**
+    Creates a random unit vector that is orthogonal to the first
+    \f$j\f$ columns of the given matrix.
+  */
+
+  template <class RNG> static Vector startVector( const Matrix& Q, IndexType j, RNG& rng )
+  {
+    std::uniform_real_distribution<T> distribution( T(-1), T(1) );
+
+    Vector v( Q.rows() );
+
+    for( IndexType i = 0; i < v.size(); i++ )
+      v(i) = distribution( rng );
+
+    for( unsigned pass = 0; pass < 2; pass++ )
+      v -= Q.leftCols( j ) * ( Q.leftCols( j ).transpose() * v );
+
+    return v.normalized();
+  }
+
+  /** If set, keeps the largest eigenpairs */
+  bool _largest = false;
+
+  Vector _eigenvalues;
+  Matrix _eigenvectors;
+};
+
+#endif
+
+} // namespace math
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef ALEPH_MATH_PHILOX_HH__
+#define ALEPH_MATH_PHILOX_HH__
+
+#include <array>
+#include <limits>
+
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace math
+{
+
+/**
+  @class Philox4x32
+  @brief Counter-based random number generator
+
+  Implements the Philox-4x32-10 generator of Salmon et al., as described
+  in their paper *Parallel Random Numbers: As Easy as 1, 2, 3*. Numbers
+  are obtained by encrypting a counter with a key, so the generator has
+  no state except for its position. This makes it possible to create a
+  large number of independent *streams* from a single seed, which will
+  always produce the same numbers regardless of which thread uses them.
+
+  The class satisfies the requirements of a uniform random bit generator
+  and may thus be used with all distributions of the standard library.
+*/
+
+class Philox4x32
+{
+public:
+  using result_type = std::uint32_t;
+
+  /**
+    Creates a new generator.
+
+    @param seed   Seed, i.e. the key used for encrypting the counter
+    @param stream Identifier of the stream; different streams produce
+                  independent sequences of numbers
+  */
+
+  explicit Philox4x32( std::uint64_t seed = 0, std::uint64_t stream = 0 )
+    : _key( { { std::uint32_t( seed ), std::uint32_t( seed >> 32 ) } } )
+    , _counter( { { 0, 0, std::uint32_t( stream ), std::uint32_t( stream >> 32 ) } } )
+  {
+  }
+
+  static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()()
+  {
+    if( _index == 4 )
+    {
+      _block = Philox4x32::encrypt( _counter, _key );
+      _index = 0;
+
+      // Only the lower half of the counter describes the position in
+      // the stream; the upper half is the stream identifier.
+      if( ++_counter[0] == 0 )
+        ++_counter[1];
+    }
+
+    return _block[ _index++ ];
+  }
+
+  /** Skips a given number of values */
+  void discard( unsigned long long n )
+  {
+    for( unsigned long long i = 0; i < n; i++ )
+      this->operator()();
+  }
+
+  /**
+    Draws an integer uniformly from \f$\{0,\dots,n-1\}\f$. In contrast to
+    the distributions of the standard library, the result of this function
+    does *not* depend on the implementation, thus ensuring that results
+    are reproducible across different platforms.
+
+    The function uses the multiply-and-shift method of Lemire, including
+    a rejection step that removes any bias.
+  */
+
+  std::uint32_t uniform( std::uint32_t n )
+  {
+    std::uint64_t m = std::uint64_t( this->operator()() ) * n;
+    auto l          = std::uint32_t( m );
+
+    if( l < n )
+    {
+      auto threshold = std::uint32_t( -n ) % n;
+
+      while( l < threshold )
+      {
+        m = std::uint64_t( this->operator()() ) * n;
+        l = std::uint32_t( m );
+      }
+    }
+
+    return std::uint32_t( m >> 32 );
+  }
+
+  /** Performs one encryption of a counter with a key */
+  static std::array<std::uint32_t, 4> encrypt( std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key )
+  {
+    for( unsigned round = 0; round < 10; round++ )
+    {
+      auto p0 = std::uint64_t( 0xD2511F53 ) * counter[0];
+      auto p1 = std::uint64_t( 0xCD9E8D57 ) * counter[2];
+
+      counter = { { std::uint32_t( p1 >> 32 ) ^ counter[1] ^ key[0],
+                    std::uint32_t( p1 ),
+                    std::uint32_t( p0 >> 32 ) ^ counter[3] ^ key[1],
+                    std::uint32_t( p0 ) } };
+
+      key[0] += 0x9E3779B9;
+      key[1] += 0xBB67AE85;
+    }
+
+    return counter;
+  }
+
+private:
+  std::array<std::uint32_t, 2> _key;
+  std::array<std::uint32_t, 4> _counter;
+  std::array<std::uint32_t, 4> _block = { { 0, 0, 0, 0 } };
+
+  unsigned _index = 4;
+};
+
+} // namespace math
+
+} // namespace aleph
+
+#endif
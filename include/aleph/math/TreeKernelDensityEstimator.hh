@@ -0,0 +1,260 @@
+#ifndef ALEPH_MATH_TREE_KERNEL_DENSITY_ESTIMATOR_HH__
+#define ALEPH_MATH_TREE_KERNEL_DENSITY_ESTIMATOR_HH__
+
+#include <aleph/geometry/KDTree.hh>
+
+#include <aleph/math/KernelDensityEstimator.hh>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace math
+{
+
+/**
+  @class TreeKernelDensityEstimator
+  @brief Kernel density estimator that is accelerated by a k-d tree
+
+  This class evaluates the same estimate as the generic kernel density
+  estimator with a Euclidean norm, i.e.
+
+  \f[
+    \hat{f}(x) = \frac{1}{n h^d} \sum_{i=1}^{n} K\left(\frac{\|x - x_i\|}{h}\right),
+  \f]
+
+  but stores the data points in a k-d tree. Every node of the tree has
+  a bounding box, which yields lower and upper bounds for the values of
+  the kernel within the node. A node is not traversed any further if it
+  cannot contribute anything to the estimate, or if the bounds are tight
+  enough to satisfy the relative tolerance. In the latter case, the mean
+  of both bounds is used for all points of the node.
+
+  The kernel must be non-increasing with respect to its argument, which
+  is the case for the Gaussian and the Epanechnikov kernel, for example.
+  For a tolerance of zero, only nodes outside the support of the kernel
+  are skipped, so the estimate is exact up to rounding errors.
+
+  The interface differs from the one of KernelDensityEstimator, which
+  receives the data for every query. Here, the point cloud is passed
+  upon construction because building the tree is only worthwhile if it
+  is shared by all queries. The dimension is taken from the point cloud,
+  and the norm is always the Euclidean norm, since the bounds of the
+  tree rely on it. Kernels are shared with the generic estimator, and
+  for the same bandwidth and kernel, both estimators yield the same
+  values, up to the tolerance.
+
+  @tparam Kernel Kernel to use for calculating density estimates
+*/
+
+template <class Kernel> class TreeKernelDensityEstimator
+{
+public:
+
+  /**
+    Creates a new estimator for a given point cloud.
+
+    @param container Point cloud; the points are copied into the tree
+    @param bandwidth Bandwidth
+
+    @param kernel    Kernel to use for calculating density estimates
+
+    @param tolerance Relative tolerance of the estimate. The deviation
+                     from the exact estimate will not be larger than the
+                     product of the tolerance and the exact estimate.
+
+    @param leafSize  Maximum number of points stored in a leaf
+  */
+
+  template <class Container> TreeKernelDensityEstimator( const Container& container,
+                                                         double bandwidth,
+                                                         Kernel kernel    = Kernel(),
+                                                         double tolerance = 1e-3,
+                                                         std::size_t leafSize = 32 )
+    : _bandwidth( bandwidth )
+    , _tolerance( tolerance )
+    , _kernel( kernel )
+    , _tree( container, leafSize )
+  {
+    if( _bandwidth <= 0 )
+      throw std::runtime_error( "Bandwidth must be positive" );
+
+    if( _tolerance < 0 )
+      throw std::runtime_error( "Tolerance must be non-negative" );
+  }
+
+  /**
+    Evaluates the kernel density estimator at a given position.
+
+    @param x Input iterator to the coordinates of the position
+  */
+
+  template <class InputIterator> double operator()( InputIterator x ) const
+  {
+    std::vector<double> query( _tree.dimension() );
+
+    for( std::size_t k = 0; k < query.size(); k++, ++x )
+      query[k] = static_cast<double>( *x );
+
+    return this->evaluate( query.data() );
+  }
+
+  /**
+    Evaluates the kernel density estimator at all points that have been
+    used to create it. Points are processed in parallel if OpenMP is
+    available.
+
+    @returns Density estimates, following the order of the points in
+             the original container
+  */
+
+  std::vector<double> densities() const
+  {
+    auto n = _tree.size();
+
+    std::vector<double> result( n );
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for( std::size_t i = 0; i < n; i++ )
+      result[ _tree.index(i) ] = this->evaluate( _tree.point(i) );
+
+    return result;
+  }
+
+  std::size_t size()      const noexcept { return _tree.size();      }
+  std::size_t dimension() const noexcept { return _tree.dimension(); }
+
+private:
+
+  /** Calculates bounds for the kernel values of all points of a node */
+  std::pair<double, double> bounds( const double* x, std::size_t node ) const
+  {
+    auto distances = _tree.squaredDistanceBounds( x, node );
+
+    return std::make_pair( _kernel( std::sqrt( distances.second ) / _bandwidth ),
+                           _kernel( std::sqrt( distances.first  ) / _bandwidth ) );
+  }
+
+  /** Evaluates the normalized estimate at a position */
+  double evaluate( const double* x ) const
+  {
+    if( _tree.empty() )
+      return 0.0;
+
+    auto bounds = this->bounds( x, 0 );
+
+    Traversal traversal;
+    traversal.lowerBound = count( _tree.nodes().front() ) * bounds.first;
+
+    auto sum = this->evaluate( x, 0, bounds, traversal );
+
+    return sum / ( std::pow( _bandwidth, static_cast<double>( _tree.dimension() ) ) * static_cast<double>( _tree.size() ) );
+  }
+
+  /** State of the traversal of the tree for a single position */
+  struct Traversal
+  {
+    /**
+      Lower bound for the sum over all points. It is refined during the
+      traversal and determines how much error may be introduced.
+    */
+
+    double lowerBound = 0.0;
+
+    /** Upper bound for the error that has been introduced so far */
+    double error = 0.0;
+
+    /** Number of points whose contribution has been determined */
+    double processed = 0.0;
+  };
+
+  /**
+    Calculates the sum of the kernel values of all points of a node.
+
+    @param x         Position
+    @param node      Index of the node
+    @param bounds    Lower and upper bound for the kernel values
+    @param traversal State of the traversal
+  */
+
+  double evaluate( const double* x, std::size_t node, std::pair<double, double> bounds, Traversal& traversal ) const
+  {
+    auto&& N  = _tree.nodes()[node];
+    auto kMin = bounds.first;
+    auto kMax = bounds.second;
+
+    // Approximating every kernel value by the mean of both bounds has an
+    // error of at most half their difference. Every point may introduce
+    // the same share of the allowed error; shares that have not been used
+    // by previous points may be used by the current node. Since the lower
+    // bound only increases, this guarantees the relative tolerance.
+    auto error = 0.5 * count( N ) * ( kMax - kMin );
+
+    if( traversal.error + error <= _tolerance * traversal.lowerBound * ( traversal.processed + count( N ) ) / static_cast<double>( _tree.size() ) )
+    {
+      traversal.error     += error;
+      traversal.processed += count( N );
+
+      return count( N ) * 0.5 * ( kMin + kMax );
+    }
+
+    if( N.leaf() )
+    {
+      double sum = 0.0;
+
+      for( std::size_t i = N.begin; i < N.end; i++ )
+        sum += _kernel( std::sqrt( _tree.squaredDistance( x, i ) ) / _bandwidth );
+
+      traversal.lowerBound += sum - count( N ) * kMin;
+      traversal.processed  += count( N );
+
+      return sum;
+    }
+
+    auto left   = N.left;
+    auto right  = N.right;
+    auto bLeft  = this->bounds( x, left );
+    auto bRight = this->bounds( x, right );
+
+    traversal.lowerBound += count( _tree.nodes()[left] )  * bLeft.first
+                          + count( _tree.nodes()[right] ) * bRight.first
+                          - count( N ) * kMin;
+
+    // Visiting the closer child first tightens the lower bound faster,
+    // which permits pruning more nodes later on.
+    if( bRight.second > bLeft.second )
+    {
+      std::swap( left, right );
+      std::swap( bLeft, bRight );
+    }
+
+    auto sum  = this->evaluate( x, left,  bLeft,  traversal );
+    sum      += this->evaluate( x, right, bRight, traversal );
+
+    return sum;
+  }
+
+  static double count( const aleph::geometry::KDTree::Node& node ) noexcept
+  {
+    return static_cast<double>( node.size() );
+  }
+
+  double _bandwidth;
+  double _tolerance;
+
+  Kernel _kernel;
+
+  aleph::geometry::KDTree _tree;
+};
+
+} // namespace math
+
+} // namespace aleph
+
+#endif
@@ -4,6 +4,8 @@
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 #include <aleph/persistentHomology/PersistencePairing.hh>
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <algorithm>
 #include <map>
 #include <vector>
@@ -28,6 +30,8 @@ std::vector< PersistenceDiagram<typename SimplicialComplex::ValueType::DataType>
   using Simplex            = typename SimplicialComplex::ValueType;
   using PersistenceDiagram = PersistenceDiagram<typename Simplex::DataType>;
 
+  utilities::instrumentation::ScopedPhase phase( "makePersistenceDiagrams" );
+
   std::map<std::size_t, PersistenceDiagram> persistenceDiagrams;
 
   for( auto&& pair : pairing )
@@ -90,10 +94,13 @@ PersistenceDiagram<DataType> makePersistenceDiagram( const PersistencePairing<In
 
   for( auto&& pair : pairing )
   {
-    auto&& i = pair.first;
-    auto&& j = pair.second;
+    auto&& i = pair.first;    // Index of creator (always valid)
+    auto&& j = pair.second;   // Index of destroyer (may be invalid)
 
-    D.add( functionValues.at(i), functionValues.at(j) );
+    if( j < functionValues.size() )
+      D.add( functionValues.at(i), functionValues.at(j) );
+    else
+      D.add( functionValues.at(i) );
   }
 
   return D;
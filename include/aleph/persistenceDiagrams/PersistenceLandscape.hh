@@ -0,0 +1,898 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_PERSISTENCE_LANDSCAPE_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_PERSISTENCE_LANDSCAPE_HH__
+
+#include <aleph/math/Bootstrap.hh>
+#include <aleph/math/KahanSummation.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace detail
+{
+
+/**
+  Integrates \f$|f|^p\f$ for a linear function \f$f\f$ over an interval
+  of length \p h, where \p a and \p b denote the values of \f$f\f$ at the
+  boundaries of the interval.
+*/
+
+inline double integratePower( double a, double b, double h, double p )
+{
+  if( h <= 0.0 )
+    return 0.0;
+
+  // Split the interval at the root of the function so that the integral
+  // of both parts can be calculated for non-negative values.
+  if( ( a < 0.0 && b > 0.0 ) || ( a > 0.0 && b < 0.0 ) )
+  {
+    auto z = h * a / ( a - b );
+    return integratePower( a, 0.0, z, p ) + integratePower( 0.0, b, h - z, p );
+  }
+
+  a = std::abs( a );
+  b = std::abs( b );
+
+  if( std::abs( b - a ) <= 1e-12 * std::max( a, b ) )
+    return h * std::pow( 0.5 * ( a + b ), p );
+
+  return h * ( std::pow( b, p + 1 ) - std::pow( a, p + 1 ) ) / ( ( p + 1 ) * ( b - a ) );
+}
+
+} // namespace detail
+
+/**
+  @class PersistenceLandscape
+  @brief Exact persistence landscape of a persistence diagram
+
+  The persistence landscape of a persistence diagram is a sequence of
+  piecewise linear functions \f$\lambda_k\f$. Every point \f$(b,d)\f$ of
+  the diagram is replaced by a tent function \f$\max(0, \min(t-b, d-t))\f$,
+  and \f$\lambda_k(t)\f$ is the \f$k\f$-th largest value of all tent
+  functions at \f$t\f$.
+
+  All levels are calculated by the algorithm of Bubenik and Dłotko: the
+  points are sorted once in \f$O(n \log n)\f$ time, and every level is
+  obtained by a single pass over the points that have not been used up
+  by the previous levels. Levels are stored as flat arrays of breakpoints,
+  which permits fast evaluation, averaging, distances, and inner products.
+
+  Points of infinite persistence are ignored because their landscapes are
+  not integrable.
+
+  @see https://arxiv.org/abs/1501.00179 (toolbox paper by Bubenik and Dłotko)
+*/
+
+class PersistenceLandscape
+{
+public:
+
+  /** Creates an empty persistence landscape, i.e. the zero function */
+  PersistenceLandscape()
+    : _offsets( 1, 0 )
+  {
+  }
+
+  /**
+    Calculates the persistence landscape of a persistence diagram.
+
+    @param D Persistence diagram
+  */
+
+  template <class T> explicit PersistenceLandscape( const PersistenceDiagram<T>& D )
+    : _offsets( 1, 0 )
+  {
+    using Point = std::pair<double, double>;
+
+    std::vector<Point> points;
+    points.reserve( D.size() );
+
+    for( auto&& p : D )
+    {
+      auto b = static_cast<double>( p.x() );
+      auto d = static_cast<double>( p.y() );
+
+      if( !std::isfinite( b ) || !std::isfinite( d ) || b == d )
+        continue;
+
+      points.push_back( std::make_pair( std::min( b, d ), std::max( b, d ) ) );
+    }
+
+    // Sort by birth in ascending order and by death in descending order,
+    // so that every point precedes the points whose tents it contains.
+    std::sort( points.begin(), points.end(),
+               [] ( const Point& p, const Point& q )
+               {
+                 if( p.first != q.first )
+                   return p.first < q.first;
+                 else
+                   return p.second > q.second;
+               } );
+
+    std::list<Point> A( points.begin(), points.end() );
+
+    while( !A.empty() )
+    {
+      auto it = A.begin();
+      auto b  = it->first;
+      auto d  = it->second;
+      it      = A.erase( it );
+
+      this->add( b, 0.0 );
+      this->add( 0.5 * ( b + d ), 0.5 * ( d - b ) );
+
+      while( true )
+      {
+        // Find the next point whose tent rises above the current one.
+        // Skipped points belong to the subsequent levels.
+        auto next = std::find_if( it, A.end(),
+                                  [&d] ( const Point& p )
+                                  {
+                                    return p.second > d;
+                                  } );
+
+        if( next == A.end() )
+        {
+          this->add( d, 0.0 );
+          break;
+        }
+
+        auto b1 = next->first;
+        auto d1 = next->second;
+        it      = A.erase( next );
+
+        if( b1 > d )
+          this->add( d, 0.0 );
+
+        if( b1 >= d )
+          this->add( b1, 0.0 );
+        else
+        {
+          this->add( 0.5 * ( b1 + d ), 0.5 * ( d - b1 ) );
+
+          // The part of the new tent that lies below the current one is
+          // part of the next level. It has to be inserted according to
+          // the sort order of the points.
+          auto position = it;
+          while( position != A.end() && position->first == b1 && position->second > d )
+            ++position;
+
+          A.insert( position, std::make_pair( b1, d ) );
+        }
+
+        this->add( 0.5 * ( b1 + d1 ), 0.5 * ( d1 - b1 ) );
+
+        b = b1;
+        d = d1;
+      }
+
+      _offsets.push_back( _x.size() );
+    }
+  }
+
+  /** @returns Number of levels, i.e. non-zero functions, of the landscape */
+  std::size_t numLevels() const noexcept
+  {
+    return _offsets.size() - 1;
+  }
+
+  /** @returns Number of breakpoints of all levels */
+  std::size_t size() const noexcept
+  {
+    return _x.size();
+  }
+
+  /**
+    Evaluates a level of the landscape.
+
+    @param k Level, starting from zero; evaluating levels that exceed the
+             number of levels of the landscape yields zero
+    @param t Parameter
+
+    @returns Value of level \p k at \p t
+  */
+
+  double operator()( std::size_t k, double t ) const
+  {
+    if( k >= this->numLevels() )
+      return 0.0;
+
+    auto first = _x.begin() + std::ptrdiff_t( _offsets[k]   );
+    auto last  = _x.begin() + std::ptrdiff_t( _offsets[k+1] );
+
+    if( first == last || t <= *first || t >= *( last - 1 ) )
+      return 0.0;
+
+    auto it = std::upper_bound( first, last, t );
+    auto j  = static_cast<std::size_t>( std::distance( _x.begin(), it ) );
+    auto i  = j - 1;
+
+    if( _x[j] == _x[i] )
+      return _y[j];
+
+    return _y[i] + ( _y[j] - _y[i] ) * ( t - _x[i] ) / ( _x[j] - _x[i] );
+  }
+
+  /**
+    @returns Breakpoints of a level of the landscape, i.e. a pair of
+    pointers to the parameter values and to the function values
+  */
+
+  std::pair<const double*, const double*> level( std::size_t k ) const
+  {
+    return std::make_pair( _x.data() + _offsets.at(k), _y.data() + _offsets.at(k) );
+  }
+
+  /** @returns Number of breakpoints of a level of the landscape */
+  std::size_t levelSize( std::size_t k ) const
+  {
+    return _offsets.at(k+1) - _offsets.at(k);
+  }
+
+  /** Multiplies the landscape by a scalar */
+  PersistenceLandscape& operator*=( double lambda )
+  {
+    for( auto&& y : _y )
+      y *= lambda;
+
+    return *this;
+  }
+
+  /** Adds another landscape to the current one */
+  PersistenceLandscape& operator+=( const PersistenceLandscape& other )
+  {
+    const PersistenceLandscape* landscapes[] = { this, &other };
+
+    *this = combine( landscapes, landscapes + 2, 1.0 );
+    return *this;
+  }
+
+  /**
+    Calculates the mean of a range of persistence landscapes. The time
+    required is dominated by sorting the breakpoints of all landscapes,
+    so the mean of thousands of landscapes remains cheap.
+
+    @param begin Iterator to begin of range of landscapes
+    @param end   Iterator to end of range of landscapes
+
+    @returns Mean landscape
+  */
+
+  template <class InputIterator> static PersistenceLandscape mean( InputIterator begin, InputIterator end )
+  {
+    std::vector<const PersistenceLandscape*> landscapes;
+
+    for( auto it = begin; it != end; ++it )
+      landscapes.push_back( &( *it ) );
+
+    if( landscapes.empty() )
+      return PersistenceLandscape();
+
+    return combine( landscapes.begin(), landscapes.end(), 1.0 / static_cast<double>( landscapes.size() ) );
+  }
+
+  /**
+    Calculates the inner product of two landscapes, i.e. the sum of the
+    integrals of the products of all levels. The integral is exact.
+  */
+
+  double innerProduct( const PersistenceLandscape& other ) const
+  {
+    aleph::math::KahanSummation<double> result = 0.0;
+
+    auto numLevels = std::min( this->numLevels(), other.numLevels() );
+
+    for( std::size_t k = 0; k < numLevels; k++ )
+    {
+      std::vector<double> X, F, G;
+      this->merge( other, k, X, F, G );
+
+      for( std::size_t i = 0; i + 1 < X.size(); i++ )
+      {
+        auto h  = X[i+1] - X[i];
+        result += h * ( 2*F[i]*G[i] + F[i]*G[i+1] + F[i+1]*G[i] + 2*F[i+1]*G[i+1] ) / 6.0;
+      }
+    }
+
+    return result;
+  }
+
+  /**
+    Calculates the \f$L_p\f$ distance between two landscapes. The
+    integral is exact.
+
+    @param other Other landscape
+    @param p     Exponent; may be infinite, resulting in the supremum
+                 of the differences of all levels
+
+    @returns Distance
+  */
+
+  double distance( const PersistenceLandscape& other, double p = 2.0 ) const
+  {
+    if( !( p >= 1.0 ) )
+      throw std::runtime_error( "Exponent must be at least one" );
+
+    auto numLevels = std::max( this->numLevels(), other.numLevels() );
+
+    if( std::isinf( p ) )
+    {
+      double result = 0.0;
+
+      for( std::size_t k = 0; k < numLevels; k++ )
+      {
+        std::vector<double> X, F, G;
+        this->merge( other, k, X, F, G );
+
+        for( std::size_t i = 0; i < X.size(); i++ )
+          result = std::max( result, std::abs( F[i] - G[i] ) );
+      }
+
+      return result;
+    }
+
+    aleph::math::KahanSummation<double> result = 0.0;
+
+    for( std::size_t k = 0; k < numLevels; k++ )
+    {
+      std::vector<double> X, F, G;
+      this->merge( other, k, X, F, G );
+
+      for( std::size_t i = 0; i + 1 < X.size(); i++ )
+        result += detail::integratePower( F[i] - G[i], F[i+1] - G[i+1], X[i+1] - X[i], p );
+    }
+
+    return std::pow( static_cast<double>( result ), 1.0 / p );
+  }
+
+  /** Calculates the \f$L_p\f$ norm of the landscape */
+  double norm( double p = 2.0 ) const
+  {
+    return this->distance( PersistenceLandscape(), p );
+  }
+
+private:
+
+  void add( double x, double y )
+  {
+    _x.push_back( x );
+    _y.push_back( y );
+  }
+
+  /**
+    Evaluates a level of the landscape at sorted parameter values and
+    adds the weighted values to an output range. The breakpoints of the
+    level are traversed only once.
+  */
+
+  void accumulate( std::size_t k, const std::vector<double>& X, double weight, std::vector<double>& out ) const
+  {
+    if( k >= this->numLevels() )
+      return;
+
+    auto begin = _offsets[k];
+    auto end   = _offsets[k+1];
+
+    if( begin == end )
+      return;
+
+    auto j = begin;
+
+    for( std::size_t i = 0; i < X.size(); i++ )
+    {
+      auto t = X[i];
+
+      if( t <= _x[begin] || t >= _x[end-1] )
+        continue;
+
+      while( j < end && _x[j] <= t )
+        ++j;
+
+      auto l = j - 1;
+
+      double value = _x[j] == _x[l] ? _y[j] : _y[l] + ( _y[j] - _y[l] ) * ( t - _x[l] ) / ( _x[j] - _x[l] );
+      out[i] += weight * value;
+    }
+  }
+
+  /**
+    Evaluates a level of two landscapes at the union of their breakpoints.
+
+    @param other Other landscape
+    @param k     Level
+    @param X     Sorted union of breakpoints
+    @param F     Values of the current landscape
+    @param G     Values of the other landscape
+  */
+
+  void merge( const PersistenceLandscape& other,
+              std::size_t k,
+              std::vector<double>& X,
+              std::vector<double>& F,
+              std::vector<double>& G ) const
+  {
+    const PersistenceLandscape* landscapes[] = { this, &other };
+
+    X = breakpoints( landscapes, landscapes + 2, k );
+
+    F.assign( X.size(), 0.0 );
+    G.assign( X.size(), 0.0 );
+
+    this->accumulate( k, X, 1.0, F );
+    other.accumulate( k, X, 1.0, G );
+  }
+
+  /** @returns Sorted union of the breakpoints of a level of all landscapes */
+  template <class Iterator> static std::vector<double> breakpoints( Iterator begin, Iterator end, std::size_t k )
+  {
+    std::vector<double> X;
+
+    for( auto it = begin; it != end; ++it )
+    {
+      auto&& L = **it;
+
+      if( k < L.numLevels() )
+        X.insert( X.end(), L._x.begin() + std::ptrdiff_t( L._offsets[k] ), L._x.begin() + std::ptrdiff_t( L._offsets[k+1] ) );
+    }
+
+    std::sort( X.begin(), X.end() );
+    X.erase( std::unique( X.begin(), X.end() ), X.end() );
+
+    return X;
+  }
+
+  /**
+    Calculates a weighted sum of landscapes, using the same weight for
+    all of them. Every breakpoint of a level changes the slope of the
+    sum, so every level is obtained by sorting the slope changes of all
+    landscapes and integrating them in a single sweep. This requires
+    \f$O(m \log m)\f$ time for \f$m\f$ breakpoints, regardless of the
+    number of landscapes.
+  */
+
+  template <class Iterator> static PersistenceLandscape combine( Iterator begin, Iterator end, double weight )
+  {
+    std::size_t numLevels = 0;
+
+    for( auto it = begin; it != end; ++it )
+      numLevels = std::max( numLevels, ( *it )->numLevels() );
+
+    PersistenceLandscape result;
+
+    // Position of a breakpoint and change of slope at the breakpoint
+    std::vector< std::pair<double, double> > events;
+
+    for( std::size_t k = 0; k < numLevels; k++ )
+    {
+      events.clear();
+
+      for( auto it = begin; it != end; ++it )
+      {
+        auto&& L = **it;
+
+        if( k >= L.numLevels() || L._offsets[k] == L._offsets[k+1] )
+          continue;
+
+        auto first = L._offsets[k];
+        auto last  = L._offsets[k+1] - 1;
+        auto slope = 0.0;
+
+        for( auto i = first; i < last; i++ )
+        {
+          auto h = L._x[i+1] - L._x[i];
+
+          // Landscapes are continuous, so segments of zero width do not
+          // change the function value.
+          if( h <= 0.0 )
+            continue;
+
+          auto s = ( L._y[i+1] - L._y[i] ) / h;
+
+          events.push_back( std::make_pair( L._x[i], weight * ( s - slope ) ) );
+          slope = s;
+        }
+
+        events.push_back( std::make_pair( L._x[last], -weight * slope ) );
+      }
+
+      std::sort( events.begin(), events.end() );
+
+      double slope = 0.0;
+      double value = 0.0;
+
+      for( std::size_t i = 0; i < events.size(); )
+      {
+        auto x = events[i].first;
+
+        if( !result._x.empty() && result._offsets.back() != result._x.size() )
+          value += slope * ( x - result._x.back() );
+
+        while( i < events.size() && events[i].first == x )
+          slope += events[i++].second;
+
+        result.add( x, value );
+      }
+
+      // Removes rounding errors at the end of the level, which has to be
+      // zero by definition.
+      if( !events.empty() )
+        result._y.back() = 0.0;
+
+      result._offsets.push_back( result._x.size() );
+    }
+
+    return result;
+  }
+
+  // Breakpoints of all levels; the breakpoints of level k are stored in
+  // the range [_offsets[k], _offsets[k+1]).
+  std::vector<double> _x;
+  std::vector<double> _y;
+
+  std::vector<std::size_t> _offsets;
+};
+
+/**
+  @class DiscretePersistenceLandscape
+  @brief Persistence landscape that is sampled on a regular grid
+
+  Stores the first levels of a persistence landscape at equidistant
+  parameter values in a contiguous array. All landscapes on the same grid
+  have the same shape, so sums, means, and distances reduce to simple
+  loops over arrays, which compilers are able to vectorize. This makes
+  the discrete representation suitable for statistics over large sets
+  of landscapes, such as bootstrap confidence bands.
+
+  Values are stored in row-major order, with one row per level.
+*/
+
+class DiscretePersistenceLandscape
+{
+public:
+
+  /**
+    Creates a landscape on a grid whose values are all zero.
+
+    @param tMin      Minimum parameter value
+    @param tMax      Maximum parameter value
+    @param n         Number of samples per level
+    @param numLevels Number of levels
+  */
+
+  DiscretePersistenceLandscape( double tMin, double tMax, unsigned n, unsigned numLevels )
+    : _tMin( tMin )
+    , _tMax( tMax )
+    , _n( n )
+    , _numLevels( numLevels )
+    , _values( std::size_t( n ) * std::size_t( numLevels ) )
+  {
+    if( _n < 2 || !( _tMin < _tMax ) )
+      throw std::runtime_error( "Invalid grid for discrete persistence landscape" );
+  }
+
+  /**
+    Samples a persistence landscape on a grid. Levels that exceed the
+    number of levels of the landscape are zero.
+
+    @param L         Persistence landscape
+    @param tMin      Minimum parameter value
+    @param tMax      Maximum parameter value
+    @param n         Number of samples per level
+    @param numLevels Number of levels
+  */
+
+  DiscretePersistenceLandscape( const PersistenceLandscape& L,
+                                double tMin, double tMax,
+                                unsigned n,
+                                unsigned numLevels )
+    : DiscretePersistenceLandscape( tMin, tMax, n, numLevels )
+  {
+    for( std::size_t k = 0; k < std::min( std::size_t( _numLevels ), L.numLevels() ); k++ )
+    {
+      auto size  = L.levelSize(k);
+      auto level = L.level(k);
+      auto x     = level.first;
+      auto y     = level.second;
+
+      if( size == 0 )
+        continue;
+
+      std::size_t j = 0;
+
+      for( std::size_t i = 0; i < _n; i++ )
+      {
+        auto t = this->parameter(i);
+
+        if( t <= x[0] || t >= x[size-1] )
+          continue;
+
+        while( j < size && x[j] <= t )
+          ++j;
+
+        auto l = j - 1;
+
+        _values[ k*_n + i ] = x[j] == x[l] ? y[j] : y[l] + ( y[j] - y[l] ) * ( t - x[l] ) / ( x[j] - x[l] );
+      }
+    }
+  }
+
+  /** @returns Parameter value of a sample */
+  double parameter( std::size_t i ) const noexcept
+  {
+    return _tMin + static_cast<double>( i ) * ( _tMax - _tMin ) / ( _n - 1 );
+  }
+
+  /** @returns Value of a level at a sample */
+  double operator()( std::size_t k, std::size_t i ) const
+  {
+    return _values.at( k*_n + i );
+  }
+
+  /** @returns Values of all levels in row-major order */
+  const std::vector<double>& values() const noexcept
+  {
+    return _values;
+  }
+
+  unsigned numSamples() const noexcept { return _n;         }
+  unsigned numLevels()  const noexcept { return _numLevels; }
+
+  DiscretePersistenceLandscape& operator+=( const DiscretePersistenceLandscape& other )
+  {
+    this->checkGrid( other );
+
+    auto n = _values.size();
+    auto x = _values.data();
+    auto y = other._values.data();
+
+    for( std::size_t i = 0; i < n; i++ )
+      x[i] += y[i];
+
+    return *this;
+  }
+
+  DiscretePersistenceLandscape& operator-=( const DiscretePersistenceLandscape& other )
+  {
+    this->checkGrid( other );
+
+    auto n = _values.size();
+    auto x = _values.data();
+    auto y = other._values.data();
+
+    for( std::size_t i = 0; i < n; i++ )
+      x[i] -= y[i];
+
+    return *this;
+  }
+
+  /** Adds a constant to all values */
+  DiscretePersistenceLandscape& operator+=( double c )
+  {
+    for( auto&& x : _values )
+      x += c;
+
+    return *this;
+  }
+
+  /** Subtracts a constant from all values */
+  DiscretePersistenceLandscape& operator-=( double c )
+  {
+    return this->operator+=( -c );
+  }
+
+  DiscretePersistenceLandscape& operator*=( double lambda )
+  {
+    for( auto&& x : _values )
+      x *= lambda;
+
+    return *this;
+  }
+
+  /**
+    Calculates the mean of a range of discrete landscapes, which must all
+    use the same grid.
+
+    @param begin Iterator to begin of range of landscapes
+    @param end   Iterator to end of range of landscapes
+
+    @returns Mean landscape
+  */
+
+  template <class InputIterator> static DiscretePersistenceLandscape mean( InputIterator begin, InputIterator end )
+  {
+    if( begin == end )
+      throw std::runtime_error( "Mean requires at least one landscape" );
+
+    DiscretePersistenceLandscape result( begin->_tMin, begin->_tMax, begin->_n, begin->_numLevels );
+    std::size_t n = 0;
+
+    for( auto it = begin; it != end; ++it, ++n )
+      result += *it;
+
+    result *= 1.0 / static_cast<double>( n );
+    return result;
+  }
+
+  /**
+    Calculates the inner product of two discrete landscapes, using the
+    trapezoidal rule for every level.
+  */
+
+  double innerProduct( const DiscretePersistenceLandscape& other ) const
+  {
+    this->checkGrid( other );
+
+    auto x = _values.data();
+    auto y = other._values.data();
+
+    double result = 0.0;
+
+    for( std::size_t i = 0; i < _values.size(); i++ )
+      result += x[i] * y[i] * this->weight( i % _n );
+
+    return result * this->step();
+  }
+
+  /**
+    Calculates the \f$L_p\f$ distance between two discrete landscapes,
+    using the trapezoidal rule for every level.
+
+    @param other Other landscape
+    @param p     Exponent; may be infinite, resulting in the maximum of
+                 the differences of all samples
+  */
+
+  double distance( const DiscretePersistenceLandscape& other, double p = 2.0 ) const
+  {
+    this->checkGrid( other );
+
+    if( !( p >= 1.0 ) )
+      throw std::runtime_error( "Exponent must be at least one" );
+
+    auto x = _values.data();
+    auto y = other._values.data();
+
+    double result = 0.0;
+
+    if( std::isinf( p ) )
+    {
+      for( std::size_t i = 0; i < _values.size(); i++ )
+        result = std::max( result, std::abs( x[i] - y[i] ) );
+
+      return result;
+    }
+
+    for( std::size_t i = 0; i < _values.size(); i++ )
+      result += std::pow( std::abs( x[i] - y[i] ), p ) * this->weight( i % _n );
+
+    return std::pow( result * this->step(), 1.0 / p );
+  }
+
+  /** Calculates the \f$L_p\f$ norm of the discrete landscape */
+  double norm( double p = 2.0 ) const
+  {
+    return this->distance( DiscretePersistenceLandscape( _tMin, _tMax, _n, _numLevels ), p );
+  }
+
+private:
+
+  double step() const noexcept
+  {
+    return ( _tMax - _tMin ) / ( _n - 1 );
+  }
+
+  /** @returns Weight of a sample for the trapezoidal rule */
+  double weight( std::size_t i ) const noexcept
+  {
+    return i == 0 || i + 1 == _n ? 0.5 : 1.0;
+  }
+
+  void checkGrid( const DiscretePersistenceLandscape& other ) const
+  {
+    if( _tMin != other._tMin || _tMax != other._tMax || _n != other._n || _numLevels != other._numLevels )
+      throw std::runtime_error( "Discrete persistence landscapes must use the same grid" );
+  }
+
+  double _tMin;
+  double _tMax;
+
+  unsigned _n;
+  unsigned _numLevels;
+
+  std::vector<double> _values;
+};
+
+namespace detail
+{
+
+/**
+  Bootstrap statistic for confidence bands of persistence landscapes:
+  calculates the maximum deviation between the mean of a replicate and
+  the mean of the original sample.
+*/
+
+class MaximumDeviation
+{
+public:
+  explicit MaximumDeviation( const DiscretePersistenceLandscape& mean )
+    : _mean( mean )
+  {
+  }
+
+  template <class Iterator> double operator()( Iterator begin, Iterator end ) const
+  {
+    return DiscretePersistenceLandscape::mean( begin, end ).distance( _mean, std::numeric_limits<double>::infinity() );
+  }
+
+private:
+  const DiscretePersistenceLandscape& _mean;
+};
+
+} // namespace detail
+
+/**
+  Calculates a bootstrap confidence band for the mean of a set of
+  discrete persistence landscapes, following Chazal et al. Every
+  replicate measures the maximum deviation of its mean from the mean of
+  all landscapes. The band is obtained by moving the mean up and down by
+  the \f$(1-\alpha)\f$ quantile of these deviations, so it contains the
+  mean landscape of the underlying distribution at all parameter values
+  and levels simultaneously with probability \f$1-\alpha\f$.
+
+  @param bootstrap  Bootstrap functor; its seed and parallelization
+                    settings are used for the replicates
+  @param numSamples Number of bootstrap replicates
+  @param alpha      Significance level
+  @param begin      Iterator to begin of range of landscapes
+  @param end        Iterator to end of range of landscapes
+
+  @returns Lower and upper boundary of the confidence band
+
+  @see https://arxiv.org/abs/1311.3681 (original paper by Chazal et al.)
+*/
+
+template <class InputIterator> std::pair<DiscretePersistenceLandscape, DiscretePersistenceLandscape>
+  confidenceBand( aleph::math::Bootstrap& bootstrap,
+                  unsigned numSamples,
+                  double alpha,
+                  InputIterator begin, InputIterator end )
+{
+  if( numSamples == 0 )
+    throw std::runtime_error( "Confidence band requires at least one bootstrap sample" );
+
+  auto mean = DiscretePersistenceLandscape::mean( begin, end );
+
+  std::vector<double> deviations;
+  deviations.reserve( numSamples );
+
+  bootstrap.makeReplicates( numSamples, begin, end,
+                            detail::MaximumDeviation( mean ),
+                            std::back_inserter( deviations ) );
+
+  std::sort( deviations.begin(), deviations.end() );
+
+  auto theta = deviations.at( aleph::math::Bootstrap::index( numSamples, 1 - alpha ) );
+  auto lower = mean;
+  auto upper = mean;
+
+  lower -= theta;
+  upper += theta;
+
+  return std::make_pair( lower, upper );
+}
+
+} // namespace aleph
+
+#endif
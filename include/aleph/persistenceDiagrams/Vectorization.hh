@@ -0,0 +1,401 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_VECTORIZATION_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_VECTORIZATION_HH__
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace detail
+{
+
+/**
+  Default weight function for persistence images. Points are weighted by
+  their persistence, so that points close to the diagonal, which are
+  usually considered to be noise, have a small influence.
+*/
+
+class PersistenceWeight
+{
+public:
+  template <class Point> double operator()( const Point& p ) const
+  {
+    return static_cast<double>( p.persistence() );
+  }
+};
+
+} // namespace detail
+
+/**
+  @class PersistenceImage
+  @brief Persistence image of a persistence diagram
+
+  Maps a persistence diagram to a fixed-size image, following Adams et al.
+  Every point \f$(x,y)\f$ is transformed into \f$(x, y-x)\f$, i.e. birth
+  and persistence, and replaced by a Gaussian with standard deviation
+  \f$\sigma\f$, which is weighted by a weight function. Every pixel
+  contains the integral of the sum of these Gaussians over its area.
+
+  Gaussians are separable, so the contribution of every point is the
+  outer product of two 1D kernels. Only pixels within \f$6\sigma\f$ of
+  a point are updated, and the innermost loop over a row is contiguous,
+  permitting the compiler to vectorize it. Points of infinite persistence
+  are ignored.
+
+  The image is stored in row-major order. Rows correspond to persistence
+  values, columns correspond to birth values, and the first pixel is the
+  one with the smallest birth and persistence values.
+
+  @see https://arxiv.org/abs/1507.06217 (original paper by Adams et al.)
+
+  @tparam T      Data type of persistence diagrams
+  @tparam Weight Functor for calculating weights of persistence points
+*/
+
+template <class T, class Weight = detail::PersistenceWeight> class PersistenceImage
+{
+public:
+
+  /**
+    Creates a new persistence image description.
+
+    @param width  Number of pixels for birth values
+    @param height Number of pixels for persistence values
+    @param xMin   Minimum birth value
+    @param xMax   Maximum birth value
+    @param yMin   Minimum persistence value
+    @param yMax   Maximum persistence value
+    @param sigma  Standard deviation of the Gaussians
+    @param w      Weight function
+  */
+
+  PersistenceImage( unsigned width, unsigned height,
+                    T xMin, T xMax,
+                    T yMin, T yMax,
+                    double sigma,
+                    Weight w = Weight() )
+    : _width( width )
+    , _height( height )
+    , _xMin( static_cast<double>( xMin ) )
+    , _xMax( static_cast<double>( xMax ) )
+    , _yMin( static_cast<double>( yMin ) )
+    , _yMax( static_cast<double>( yMax ) )
+    , _sigma( sigma )
+    , _w( w )
+  {
+    if( _width == 0 || _height == 0 )
+      throw std::runtime_error( "Persistence image must not be empty" );
+
+    if( !( _xMin < _xMax ) || !( _yMin < _yMax ) )
+      throw std::runtime_error( "Invalid range for persistence image" );
+
+    if( !( _sigma > 0.0 ) )
+      throw std::runtime_error( "Standard deviation must be positive" );
+  }
+
+  /** @returns Number of pixels of the image */
+  std::size_t size() const noexcept
+  {
+    return std::size_t( _width ) * std::size_t( _height );
+  }
+
+  unsigned width()  const noexcept { return _width;  }
+  unsigned height() const noexcept { return _height; }
+
+  /**
+    Calculates the persistence image of a persistence diagram and stores
+    it in a buffer, which must have space for size() values.
+
+    @param D   Persistence diagram
+    @param out Output buffer
+  */
+
+  void operator()( const PersistenceDiagram<T>& D, float* out ) const
+  {
+    std::fill( out, out + this->size(), 0.0f );
+
+    std::vector<float> gx( _width );
+    std::vector<float> gy( _height );
+
+    for( auto&& p : D )
+    {
+      auto x = static_cast<double>( p.x() );
+      auto y = static_cast<double>( p.y() );
+
+      if( !std::isfinite( x ) || !std::isfinite( y ) )
+        continue;
+
+      auto w = static_cast<float>( _w(p) );
+      if( w == 0.0f )
+        continue;
+
+      auto columns = splat( x,   _xMin, _xMax, _width,  gx );
+      auto rows    = splat( y-x, _yMin, _yMax, _height, gy );
+
+      for( auto j = rows.first; j < rows.second; j++ )
+      {
+        auto s   = w * gy[j];
+        auto row = out + j * _width;
+
+        for( auto i = columns.first; i < columns.second; i++ )
+          row[i] += s * gx[i];
+      }
+    }
+  }
+
+  /**
+    Calculates the persistence image of a persistence diagram.
+
+    @param D Persistence diagram
+
+    @returns Pixels of the image in row-major order
+  */
+
+  std::vector<float> operator()( const PersistenceDiagram<T>& D ) const
+  {
+    std::vector<float> result( this->size() );
+    this->operator()( D, result.data() );
+
+    return result;
+  }
+
+private:
+
+  /**
+    Integrates a 1D Gaussian over the pixels of one axis of the image and
+    stores the values in a kernel. Only the range of pixels that is close
+    to the center of the Gaussian is updated.
+
+    @returns Range of pixels with non-zero values
+  */
+
+  std::pair<std::size_t, std::size_t> splat( double c, double min, double max, unsigned n, std::vector<float>& kernel ) const
+  {
+    auto h      = ( max - min ) / n;
+    auto radius = 6.0 * _sigma;
+
+    // Rounding outwards ensures that the range covers all pixels within
+    // the radius; it may be empty if the center lies outside the image.
+    auto first = std::floor( ( c - radius - min ) / h );
+    auto last  = std::ceil(  ( c + radius - min ) / h );
+
+    first = std::max( first, 0.0 );
+    last  = std::min( last,  static_cast<double>( n ) );
+
+    if( !( first < last ) )
+      return std::make_pair( std::size_t(0), std::size_t(0) );
+
+    auto begin = static_cast<std::size_t>( first );
+    auto end   = static_cast<std::size_t>( last );
+    auto scale = 1.0 / ( _sigma * std::sqrt( 2.0 ) );
+
+    auto previous = std::erf( ( min + static_cast<double>( begin ) * h - c ) * scale );
+
+    for( auto i = begin; i < end; i++ )
+    {
+      auto next = std::erf( ( min + static_cast<double>( i+1 ) * h - c ) * scale );
+      kernel[i] = static_cast<float>( 0.5 * ( next - previous ) );
+      previous  = next;
+    }
+
+    return std::make_pair( begin, end );
+  }
+
+  unsigned _width;
+  unsigned _height;
+
+  double _xMin;
+  double _xMax;
+  double _yMin;
+  double _yMax;
+
+  double _sigma;
+
+  Weight _w;
+};
+
+/**
+  @class BettiCurve
+  @brief Betti curve of a persistence diagram
+
+  Evaluates the Betti curve of a persistence diagram, i.e. the number of
+  points \f$(x,y)\f$ with \f$x \leq t < y\f$, at equidistant thresholds
+  \f$t\f$. Every point only changes the counts at two thresholds, so the
+  curve is obtained by a prefix sum in linear time. Points of infinite
+  persistence are alive for all thresholds after their birth.
+*/
+
+template <class T> class BettiCurve
+{
+public:
+
+  /**
+    Creates a new Betti curve description.
+
+    @param n    Number of thresholds
+    @param tMin Minimum threshold
+    @param tMax Maximum threshold; if there is only a single threshold,
+                this value is ignored
+  */
+
+  BettiCurve( unsigned n, T tMin, T tMax )
+    : _n( n )
+    , _tMin( static_cast<double>( tMin ) )
+    , _tMax( static_cast<double>( tMax ) )
+  {
+    if( _n == 0 )
+      throw std::runtime_error( "Betti curve requires at least one threshold" );
+
+    if( _n > 1 && !( _tMin < _tMax ) )
+      throw std::runtime_error( "Invalid range for Betti curve" );
+  }
+
+  /** @returns Number of thresholds */
+  std::size_t size() const noexcept
+  {
+    return _n;
+  }
+
+  /** @returns Threshold with the given index */
+  double threshold( std::size_t i ) const noexcept
+  {
+    if( _n == 1 )
+      return _tMin;
+
+    return _tMin + static_cast<double>( i ) * ( _tMax - _tMin ) / ( _n - 1 );
+  }
+
+  /**
+    Calculates the Betti curve of a persistence diagram and stores it in
+    a buffer, which must have space for size() values.
+
+    @param D   Persistence diagram
+    @param out Output buffer
+  */
+
+  void operator()( const PersistenceDiagram<T>& D, float* out ) const
+  {
+    std::vector<long> changes( _n + 1 );
+
+    for( auto&& p : D )
+    {
+      auto birth = this->index( static_cast<double>( p.x() ) );
+      auto death = this->index( static_cast<double>( p.y() ) );
+
+      if( birth < death )
+      {
+        ++changes[birth];
+        --changes[death];
+      }
+    }
+
+    long betti = 0;
+
+    for( std::size_t i = 0; i < _n; i++ )
+    {
+      betti += changes[i];
+      out[i] = static_cast<float>( betti );
+    }
+  }
+
+  /**
+    Calculates the Betti curve of a persistence diagram.
+
+    @param D Persistence diagram
+
+    @returns Values of the Betti curve at all thresholds
+  */
+
+  std::vector<float> operator()( const PersistenceDiagram<T>& D ) const
+  {
+    std::vector<float> result( this->size() );
+    this->operator()( D, result.data() );
+
+    return result;
+  }
+
+private:
+
+  /** @returns Index of the first threshold that is not smaller than a value */
+  std::size_t index( double value ) const
+  {
+    if( std::isnan( value ) || value > this->threshold( _n - 1 ) )
+      return _n;
+    else if( value <= _tMin )
+      return 0;
+
+    // The estimate is corrected afterwards in order to account for any
+    // rounding errors.
+    auto i = static_cast<std::size_t>( std::ceil( ( value - _tMin ) / ( _tMax - _tMin ) * ( _n - 1 ) ) );
+    i      = std::min( i, std::size_t( _n - 1 ) );
+
+    while( i > 0 && this->threshold( i-1 ) >= value )
+      --i;
+
+    while( i < _n && this->threshold( i ) < value )
+      ++i;
+
+    return i;
+  }
+
+  unsigned _n;
+
+  double _tMin;
+  double _tMax;
+};
+
+/**
+  Calculates a feature matrix for a set of persistence diagrams. Every
+  row of the matrix contains the features of one diagram, as calculated
+  by a functor such as PersistenceImage or BettiCurve. The matrix is
+  stored in a contiguous buffer in row-major order, whose size has to be
+  the number of diagrams times the number of features. Diagrams are
+  processed in parallel.
+
+  @param features Functor for calculating features
+  @param diagrams Persistence diagrams
+  @param out      Output buffer
+*/
+
+template <class Features, class T> void calculateFeatureMatrix( const Features& features,
+                                                                const std::vector< PersistenceDiagram<T> >& diagrams,
+                                                                float* out )
+{
+  auto n = diagrams.size();
+  auto m = features.size();
+
+  #pragma omp parallel for schedule(dynamic)
+  for( std::size_t i = 0; i < n; i++ )
+    features( diagrams[i], out + i*m );
+}
+
+/**
+  Calculates a feature matrix for a set of persistence diagrams.
+
+  @param features Functor for calculating features
+  @param diagrams Persistence diagrams
+
+  @returns Feature matrix of shape (number of diagrams, number of
+           features) in row-major order
+*/
+
+template <class Features, class T> std::vector<float> calculateFeatureMatrix( const Features& features,
+                                                                               const std::vector< PersistenceDiagram<T> >& diagrams )
+{
+  std::vector<float> result( diagrams.size() * features.size() );
+  calculateFeatureMatrix( features, diagrams, result.data() );
+
+  return result;
+}
+
+} // namespace aleph
+
+#endif
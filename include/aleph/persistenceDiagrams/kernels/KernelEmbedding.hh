@@ -128,11 +128,13 @@ double pseudoMetric( const PersistenceDiagram<T>& D,
                      Weight w,
                      Kernel k )
 {
-  auto kxx = linearKernel(D, E, w, k);
+  auto kxx = linearKernel(D, D, w, k);
   auto kxy = linearKernel(D, E, w, k);
-  auto kyy = linearKernel(D, E, w, k);
+  auto kyy = linearKernel(E, E, w, k);
 
-  return std::sqrt( kxx + kyy - 2*kxy );
+  // Rounding errors may result in slightly negative values for diagrams
+  // that are (almost) identical.
+  return std::sqrt( std::max( kxx + kyy - 2*kxy, 0.0 ) );
 }
 
 /**
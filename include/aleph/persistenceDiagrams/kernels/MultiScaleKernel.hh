@@ -1,14 +1,21 @@
 #ifndef ALEPH_MULTI_SCALE_KERNEL_HH__
 #define ALEPH_MULTI_SCALE_KERNEL_HH__
 
+#include <aleph/math/FastExponential.hh>
 #include <aleph/math/KahanSummation.hh>
+#include <aleph/math/SymmetricMatrix.hh>
 
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 
 #include <algorithm>
+#include <numeric>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace aleph
 {
@@ -43,17 +50,221 @@ template <class Point> double squaredEuclideanDistance( const Point& p,
   return static_cast<double>( dx*dx + dy*dy );
 }
 
+/**
+  @class MultiScaleGrid
+  @brief Points of a persistence diagram for evaluating the multi-scale kernel
+
+  Stores every finite point \f$q\f$ of a persistence diagram along with
+  its copy \f$\bar{q}\f$ that is mirrored at the diagonal. The points are
+  sorted into the cells of a regular grid, and the coordinates of every
+  cell are contiguous, so sums of Gaussians over a cell can be evaluated
+  with vector instructions. If a cutoff radius is specified, only cells
+  that are sufficiently close to a query point will be visited. Else,
+  all points are stored in a single cell.
+*/
+
+class MultiScaleGrid
+{
+public:
+
+  /**
+    Creates a new grid for a persistence diagram.
+
+    @param D      Persistence diagram
+    @param cutoff Cutoff radius; if it is zero or not finite, the grid only
+                  consists of a single cell
+  */
+
+  template <class T> MultiScaleGrid( const PersistenceDiagram<T>& D, double cutoff = 0.0 )
+    : _cellSize( std::isfinite( cutoff ) && cutoff > 0.0 ? cutoff : 0.0 )
+  {
+    for( auto&& p : D )
+    {
+      auto x = static_cast<double>( p.x() );
+      auto y = static_cast<double>( p.y() );
+
+      if( std::isfinite( x ) && std::isfinite( y ) )
+      {
+        _pointsX.push_back( x );
+        _pointsY.push_back( y );
+      }
+    }
+
+    auto n = _pointsX.size();
+
+    std::vector<Entry> entries;
+    entries.reserve( 2*n );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      entries.push_back( { this->cell( _pointsX[i], _pointsY[i] ), _pointsX[i], _pointsY[i],  1.0 } );
+      entries.push_back( { this->cell( _pointsY[i], _pointsX[i] ), _pointsY[i], _pointsX[i], -1.0 } );
+    }
+
+    std::stable_sort( entries.begin(), entries.end(),
+                      [] ( const Entry& a, const Entry& b )
+                      {
+                        return a.cell < b.cell;
+                      } );
+
+    _x.reserve( entries.size() );
+    _y.reserve( entries.size() );
+    _s.reserve( entries.size() );
+
+    for( std::size_t i = 0; i < entries.size(); i++ )
+    {
+      if( i == 0 || entries[i].cell != entries[i-1].cell )
+      {
+        _cells.push_back( entries[i].cell );
+        _offsets.push_back( i );
+      }
+
+      _x.push_back( entries[i].x );
+      _y.push_back( entries[i].y );
+      _s.push_back( entries[i].sign );
+    }
+
+    _offsets.push_back( entries.size() );
+  }
+
+  /**
+    Evaluates the kernel sum of all points of another grid with respect
+    to the points of this grid, i.e.
+
+    \f[
+      \sum_{p} \sum_{q} \exp(-\gamma\|p-q\|^2) - \exp(-\gamma\|p-\bar{q}\|^2)
+    \f]
+
+    where \f$p\f$ ranges over the points of \p other. Pairs of points in
+    cells that are not adjacent are skipped.
+
+    @param other Grid whose (non-mirrored) points are used as queries
+    @param gamma Scale factor of the exponent
+  */
+
+  double operator()( const MultiScaleGrid& other, double gamma ) const
+  {
+    aleph::math::KahanSummation<double> result = 0.0;
+
+    for( std::size_t i = 0; i < other._pointsX.size(); i++ )
+    {
+      auto x = other._pointsX[i];
+      auto y = other._pointsY[i];
+
+      if( _cellSize == 0.0 )
+        result += this->sum( x, y, gamma, 0, _x.size() );
+      else
+      {
+        auto c = this->cell( x, y );
+
+        for( std::int64_t dx = -1; dx <= 1; dx++ )
+        {
+          for( std::int64_t dy = -1; dy <= 1; dy++ )
+          {
+            auto key   = std::make_pair( c.first + dx, c.second + dy );
+            auto range = std::equal_range( _cells.begin(), _cells.end(), key );
+
+            if( range.first != range.second )
+            {
+              auto index = static_cast<std::size_t>( std::distance( _cells.begin(), range.first ) );
+              result    += this->sum( x, y, gamma, _offsets[index], _offsets[index+1] );
+            }
+          }
+        }
+      }
+    }
+
+    return result;
+  }
+
+  /** @returns Number of finite points of the persistence diagram */
+  std::size_t size() const noexcept
+  {
+    return _pointsX.size();
+  }
+
+private:
+  using Cell = std::pair<std::int64_t, std::int64_t>;
+
+  struct Entry
+  {
+    Cell cell;
+
+    double x;
+    double y;
+    double sign;
+  };
+
+  Cell cell( double x, double y ) const
+  {
+    if( _cellSize == 0.0 )
+      return Cell( 0, 0 );
+
+    return Cell( static_cast<std::int64_t>( std::floor( x / _cellSize ) ),
+                 static_cast<std::int64_t>( std::floor( y / _cellSize ) ) );
+  }
+
+  /** Evaluates the signed Gaussians of a contiguous range of points */
+  double sum( double x, double y, double gamma, std::size_t begin, std::size_t end ) const
+  {
+    const double* X = _x.data();
+    const double* Y = _y.data();
+    const double* S = _s.data();
+
+    double result = 0.0;
+
+    #pragma omp simd reduction(+:result)
+    for( std::size_t j = begin; j < end; j++ )
+    {
+      auto dx = x - X[j];
+      auto dy = y - Y[j];
+
+      result += S[j] * aleph::math::fastExp( -gamma * ( dx*dx + dy*dy ) );
+    }
+
+    return result;
+  }
+
+  double _cellSize = 0.0;
+
+  // Finite points of the persistence diagram; they are used whenever the
+  // grid serves as the source of query points.
+  std::vector<double> _pointsX;
+  std::vector<double> _pointsY;
+
+  // Coordinates and signs of all points and their mirrored copies, sorted
+  // by their cells
+  std::vector<double> _x;
+  std::vector<double> _y;
+  std::vector<double> _s;
+
+  /** Non-empty cells in lexicographical order */
+  std::vector<Cell> _cells;
+
+  /** Offset of the first point of every cell, plus the total number of points */
+  std::vector<std::size_t> _offsets;
+};
+
 } // namespace detail
 
 /**
   Calculates the multi-scale kernel between two persistence diagrams,
   using a pre-defined smoothing parameter \p sigma. The data types of
   the involved diagrams are converted to `double`, and the *Euclidean
-  distance* is used to calculate differences between points.
+  distance* is used to calculate differences between points. Following
+  the original paper, the kernel is defined as
+
+  \f[
+    k_\sigma(F, G) = \frac{1}{8\pi\sigma} \sum_{p \in F} \sum_{q \in G}
+      \exp\left(-\frac{\|p-q\|^2}{8\sigma}\right) - \exp\left(-\frac{\|p-\bar{q}\|^2}{8\sigma}\right),
+  \f]
+
+  where \f$\bar{q}\f$ denotes the point \f$q\f$ mirrored at the diagonal.
+  Hence, \p sigma determines the width of the Gaussians.
 
   @param D1    First persistence diagram
   @param D2    Second persistence diagram
-  @param sigma Smoothing parameter
+  @param sigma Smoothing parameter; must be positive
 
   @returns Kernel value
 
@@ -64,6 +275,9 @@ template <class T> double multiScaleKernel( const PersistenceDiagram<T>& D1,
                                             const PersistenceDiagram<T>& D2,
                                             double sigma )
 {
+  if( sigma <= 0.0 )
+    throw std::runtime_error( "Smoothing parameter must be positive" );
+
   aleph::math::KahanSummation<double> sum = 0.0;
 
   for( auto&& p : D1 )
@@ -73,8 +287,8 @@ template <class T> double multiScaleKernel( const PersistenceDiagram<T>& D1,
       auto d1 = detail::squaredEuclideanDistance( p, q );
       auto d2 = detail::squaredEuclideanDistance( p, q, true );
 
-      sum += std::exp( -d1 / ( 8.0*M_PI ) );
-      sum -= std::exp( -d2 / ( 8.0*M_PI ) );
+      sum += std::exp( -d1 / ( 8.0*sigma ) );
+      sum -= std::exp( -d2 / ( 8.0*sigma ) );
     }
   }
 
@@ -84,6 +298,9 @@ template <class T> double multiScaleKernel( const PersistenceDiagram<T>& D1,
 template <class T> double multiScaleFeatureMap( const PersistenceDiagram<T>& D,
                                                 double sigma )
 {
+  if( sigma <= 0.0 )
+    throw std::runtime_error( "Smoothing parameter must be positive" );
+
   aleph::math::KahanSummation<double> result = 0.0;
 
   for( auto&& p : D )
@@ -93,8 +310,8 @@ template <class T> double multiScaleFeatureMap( const PersistenceDiagram<T>& D,
       auto d1 = detail::squaredEuclideanDistance( p, q );
       auto d2 = detail::squaredEuclideanDistance( p, q, true );
 
-      result += std::exp( -d1 / (4.0*M_PI) );
-      result -= std::exp( -d2 / (4.0*M_PI) );
+      result += std::exp( -d1 / ( 4.0*sigma ) );
+      result -= std::exp( -d2 / ( 4.0*sigma ) );
     }
   }
 
@@ -123,6 +340,114 @@ template <class T> double multiScalePseudoMetric( const PersistenceDiagram<T>& D
   return std::sqrt( kxx + kyy - 2*kxy );
 }
 
+/**
+  Calculates the Gram matrix of the multi-scale kernel for a set of
+  persistence diagrams, using a smoothing parameter of \p sigma. The
+  kernel values coincide with the ones of multiScaleKernel(), except for
+  points of infinite persistence, which are ignored.
+
+  Every diagram is prepared only once, and all sums of Gaussians are
+  evaluated with vector instructions. Pairs of diagrams are processed
+  in parallel. If \p epsilon is positive, all pairs of points whose
+  distance exceeds a cutoff radius \f$r\f$ are skipped. With \f$n\f$
+  being the maximum number of points in a diagram, \f$r\f$ is chosen
+  such that
+
+  \f[
+    \frac{2n^2}{8\pi\sigma} \exp\left(-\frac{r^2}{8\sigma}\right) \leq \epsilon,
+  \f]
+
+  which bounds the absolute error of every kernel value by \p epsilon.
+  This only saves time if the points of a diagram are spread out over
+  a region that is larger than the cutoff radius.
+
+  @param diagrams Persistence diagrams
+  @param sigma    Smoothing parameter; must be positive
+  @param epsilon  Maximum absolute error of every kernel value; if set to
+                  zero, all pairs of points are evaluated
+
+  @returns Symmetric matrix of kernel values
+*/
+
+template <class T> aleph::math::SymmetricMatrix<double> multiScaleKernelMatrix( const std::vector< PersistenceDiagram<T> >& diagrams,
+                                                                                double sigma,
+                                                                                double epsilon = 0.0 )
+{
+  if( sigma <= 0.0 )
+    throw std::runtime_error( "Smoothing parameter must be positive" );
+
+  if( epsilon < 0.0 )
+    throw std::runtime_error( "Error bound must not be negative" );
+
+  auto n = diagrams.size();
+
+  double cutoff = 0.0;
+
+  if( epsilon > 0.0 )
+  {
+    std::size_t maxSize = 0;
+
+    for( auto&& D : diagrams )
+      maxSize = std::max( maxSize, D.size() );
+
+    auto m   = static_cast<double>( maxSize );
+    auto arg = 2*m*m / ( 8.0*M_PI*sigma*epsilon );
+
+    // If the bound is satisfied for any radius, a radius of one bandwidth
+    // is used nonetheless, because the grid would be too fine otherwise.
+    cutoff = std::sqrt( 8.0*sigma * std::max( std::log( arg ), 1.0 ) );
+  }
+
+  std::vector<detail::MultiScaleGrid> grids;
+  grids.reserve( n );
+
+  for( auto&& D : diagrams )
+    grids.emplace_back( D, cutoff );
+
+  aleph::math::SymmetricMatrix<double> K( n );
+
+  #pragma omp parallel for schedule(dynamic)
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    for( std::size_t j = i; j < n; j++ )
+      K(i,j) = 1.0 / ( 8.0*M_PI*sigma ) * grids[j]( grids[i], 1.0 / ( 8.0*sigma ) );
+  }
+
+  return K;
+}
+
+/**
+  Calculates the matrix of pseudo-metric values based on the multi-scale
+  kernel for a set of persistence diagrams. The self-similarity of every
+  diagram is only calculated once, as opposed to multiScalePseudoMetric(),
+  which calculates it for every pair.
+
+  @param diagrams Persistence diagrams
+  @param sigma    Smoothing parameter; must be positive
+  @param epsilon  Maximum absolute error of every kernel value; see
+                  multiScaleKernelMatrix() for more details
+
+  @returns Symmetric matrix of pseudo-metric values
+*/
+
+template <class T> aleph::math::SymmetricMatrix<double> multiScalePseudoMetricMatrix( const std::vector< PersistenceDiagram<T> >& diagrams,
+                                                                                      double sigma,
+                                                                                      double epsilon = 0.0 )
+{
+  auto K = multiScaleKernelMatrix( diagrams, sigma, epsilon );
+  auto n = K.numRows();
+
+  aleph::math::SymmetricMatrix<double> D( n );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    for( std::size_t j = i+1; j < n; j++ )
+      D(i,j) = std::sqrt( std::max( K(i,i) + K(j,j) - 2*K(i,j), 0.0 ) );
+  }
+
+  return D;
+}
+
 } // namespace aleph
 
 #endif
@@ -0,0 +1,246 @@
+#ifndef ALEPH_PERSISTENCE_DIAGRAMS_KERNELS_RANDOM_FOURIER_FEATURES_HH__
+#define ALEPH_PERSISTENCE_DIAGRAMS_KERNELS_RANDOM_FOURIER_FEATURES_HH__
+
+#include <aleph/math/KahanSummation.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/kernels/KernelEmbedding.hh>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+/**
+  @class RandomFourierFeatures
+  @brief Explicit feature map for the persistence-weighted Gaussian kernel
+
+  Approximates the persistence-weighted Gaussian kernel by a finite
+  number of random Fourier features. The subordinate Gaussian kernel with
+  smoothing parameter \f$\sigma\f$ is the expected value of
+  \f$2\cos(\omega^T x + b)\cos(\omega^T y + b)\f$, where \f$\omega\f$ is
+  drawn from a normal distribution with covariance \f$\sigma^{-2} I\f$ and
+  \f$b\f$ is drawn uniformly from \f$[0, 2\pi]\f$. Every diagram \f$D\f$ is
+  thus embedded into a vector of dimension \f$M\f$ with entries
+
+  \f[
+    \Phi_m(D) = \sqrt{\frac{2}{M}} \sum_{x \in D} w(x) \cos(\omega_m^T x + b_m)
+  \f]
+
+  and the linear kernel between two diagrams is approximated by the dot
+  product of their embeddings. Embedding a diagram requires \f$O(M|D|)\f$
+  time, so kernel matrices of many diagrams can be calculated without
+  comparing every pair of points. The same seed always results in the same
+  features, so embeddings that have been calculated separately remain
+  comparable.
+
+  Points of infinite persistence are ignored because their features are
+  undefined.
+
+  @see http://proceedings.mlr.press/v48/kusano16.pdf (original paper by Kusano et al.)
+
+  @tparam Weight Functor for calculating weights of persistence points
+*/
+
+template <class Weight = detail::DefaultWeightFunction> class RandomFourierFeatures
+{
+public:
+
+  /**
+    Draws a new set of random features.
+
+    @param dimension Number of features, i.e. the dimension of the embedding
+    @param sigma     Smoothing parameter for subordinate Gaussian kernel
+    @param w         Weight function for persistence points
+    @param seed      Seed for the random number generator
+  */
+
+  RandomFourierFeatures( std::size_t dimension,
+                         double sigma,
+                         Weight w,
+                         unsigned seed = 0 )
+    : _w( w )
+  {
+    if( dimension == 0 )
+      throw std::runtime_error( "Dimension of random Fourier features must be positive" );
+
+    if( sigma <= 0.0 )
+      throw std::runtime_error( "Smoothing parameter must be positive" );
+
+    std::mt19937 rng( seed );
+    std::normal_distribution<double> frequency( 0.0, 1.0 / sigma );
+    std::uniform_real_distribution<double> phase( 0.0, 2*M_PI );
+
+    _omegaX.reserve( dimension );
+    _omegaY.reserve( dimension );
+    _b.reserve( dimension );
+
+    for( std::size_t m = 0; m < dimension; m++ )
+    {
+      _omegaX.push_back( frequency( rng ) );
+      _omegaY.push_back( frequency( rng ) );
+      _b.push_back( phase( rng ) );
+    }
+  }
+
+  /**
+    Convenience constructor for the default weight function based on
+    `atan`.
+
+    @param dimension Number of features, i.e. the dimension of the embedding
+    @param sigma     Smoothing parameter for subordinate Gaussian kernel
+    @param C         Scaling parameter for `atan`
+    @param p         Power parameter for `atan`
+    @param seed      Seed for the random number generator
+  */
+
+  RandomFourierFeatures( std::size_t dimension,
+                         double sigma,
+                         double C,
+                         double p,
+                         unsigned seed = 0 )
+    : RandomFourierFeatures( dimension, sigma, Weight( C, p ), seed )
+  {
+  }
+
+  /**
+    Embeds a persistence diagram into the feature space.
+
+    @param D Persistence diagram
+
+    @returns Feature vector of the diagram
+  */
+
+  template <class T> std::vector<double> operator()( const PersistenceDiagram<T>& D ) const
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> w;
+
+    x.reserve( D.size() );
+    y.reserve( D.size() );
+    w.reserve( D.size() );
+
+    for( auto&& p : D )
+    {
+      if( !std::isfinite( static_cast<double>( p.x() ) ) || !std::isfinite( static_cast<double>( p.y() ) ) )
+        continue;
+
+      x.push_back( static_cast<double>( p.x() ) );
+      y.push_back( static_cast<double>( p.y() ) );
+      w.push_back( _w(p) );
+    }
+
+    auto M     = this->dimension();
+    auto scale = std::sqrt( 2.0 / static_cast<double>( M ) );
+
+    std::vector<double> features( M );
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+      aleph::math::KahanSummation<double> sum = 0.0;
+
+      for( std::size_t i = 0; i < x.size(); i++ )
+        sum += w[i] * std::cos( _omegaX[m] * x[i] + _omegaY[m] * y[i] + _b[m] );
+
+      features[m] = scale * sum;
+    }
+
+    return features;
+  }
+
+  /** @returns Dimension of the embedding */
+  std::size_t dimension() const noexcept
+  {
+    return _b.size();
+  }
+
+private:
+  Weight _w;
+
+  // Frequencies and phases of the features; the frequencies are stored
+  // separately for both coordinates of persistence points.
+  std::vector<double> _omegaX;
+  std::vector<double> _omegaY;
+  std::vector<double> _b;
+};
+
+/**
+  Calculates the approximate linear kernel between two embedded
+  persistence diagrams, i.e. the dot product of their features.
+
+  @param x Features of first persistence diagram
+  @param y Features of second persistence diagram
+
+  @returns Kernel value
+*/
+
+inline double linearKernel( const std::vector<double>& x,
+                            const std::vector<double>& y )
+{
+  if( x.size() != y.size() )
+    throw std::runtime_error( "Feature vectors must have the same dimension" );
+
+  aleph::math::KahanSummation<double> result = 0.0;
+
+  for( std::size_t i = 0; i < x.size(); i++ )
+    result += x[i] * y[i];
+
+  return result;
+}
+
+/**
+  Calculates the approximate pseudo-metric based on the persistence-weighted
+  Gaussian kernel for two embedded persistence diagrams. This corresponds
+  to the Euclidean distance between their features.
+
+  @param x Features of first persistence diagram
+  @param y Features of second persistence diagram
+
+  @returns Pseudo-metric value
+*/
+
+inline double pseudoMetric( const std::vector<double>& x,
+                            const std::vector<double>& y )
+{
+  if( x.size() != y.size() )
+    throw std::runtime_error( "Feature vectors must have the same dimension" );
+
+  aleph::math::KahanSummation<double> result = 0.0;
+
+  for( std::size_t i = 0; i < x.size(); i++ )
+    result += ( x[i] - y[i] ) * ( x[i] - y[i] );
+
+  return std::sqrt( static_cast<double>( result ) );
+}
+
+/**
+  Calculates the approximate Gaussian kernel value based on the
+  persistence-weighted Gaussian kernel for two embedded persistence
+  diagrams, using a smoothing parameter \p tau.
+
+  @param x   Features of first persistence diagram
+  @param y   Features of second persistence diagram
+  @param tau Smoothing parameter
+
+  @returns Gaussian kernel value
+*/
+
+inline double gaussianKernel( const std::vector<double>& x,
+                              const std::vector<double>& y,
+                              double tau )
+{
+  auto d = pseudoMetric( x, y );
+  return std::exp( -1/(2*tau*tau) * d );
+}
+
+} // namespace aleph
+
+#endif
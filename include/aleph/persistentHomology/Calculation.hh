@@ -7,16 +7,22 @@
 #include <aleph/persistenceDiagrams/Calculation.hh>
 
 #include <aleph/persistentHomology/PersistencePairing.hh>
+#include <aleph/persistentHomology/RepresentativeCycles.hh>
 
 #include <aleph/topology/Conversions.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <algorithm>
 #include <limits>
+#include <stdexcept>
 #include <tuple>
 #include <unordered_set>
 #include <vector>
 
+#include <cstdint>
+
 namespace aleph
 {
 
@@ -44,6 +50,11 @@ namespace aleph
                                     will not be considered in the pairing. All simplices
                                     are used by default.
 
+  @param recorder                   Optional recorder for representative cycles. If set, the
+                                    cycles of all pairs that satisfy its predicate are recorded
+                                    from the reduced matrix, which does not require a second
+                                    reduction. The boundary matrix must not be dualized.
+
   @tparam ReductionAlgorithm Specifies a reduction algorithm to use for reducing
                              the input matrix. Aleph provides a default value in
                              order to simplify the usage of this function.
@@ -58,17 +69,55 @@ template <
   class Representation = aleph::defaults::Representation
 > PersistencePairing<typename Representation::Index> calculatePersistencePairing( const topology::BoundaryMatrix<Representation>& M,
                                                                                   bool includeAllUnpairedCreators    = false,
-                                                                                  typename Representation::Index max = std::numeric_limits<typename Representation::Index>::max() )
+                                                                                  typename Representation::Index max = std::numeric_limits<typename Representation::Index>::max(),
+                                                                                  RepresentativeCycleRecorder<typename Representation::Index>* recorder = nullptr )
 {
   using namespace topology;
 
   using Index              = typename Representation::Index;
   using PersistencePairing = PersistencePairing<Index>;
 
+  if( recorder && M.isDualized() )
+    throw std::runtime_error( "Representative cycles require a boundary matrix that is not dualized" );
+
   BoundaryMatrix<Representation> B = M;
 
-  ReductionAlgorithm reductionAlgorithm;
-  reductionAlgorithm( B );
+  {
+    utilities::instrumentation::ScopedPhase phase( "reduction" );
+
+    ReductionAlgorithm reductionAlgorithm;
+    reductionAlgorithm( B );
+  }
+
+  // Statistics about the reduced matrix are only calculated if they are
+  // recorded because they require a pass over all columns. The delta of
+  // entries is the *net* change caused by the reduction: column additions
+  // increase the number of entries, whereas cleared or cancelled columns
+  // decrease it. With clearing, the delta is thus usually negative, so it
+  // must not be mistaken for the fill-in of the reduction.
+  if( utilities::instrumentation::enabled() )
+  {
+    std::int64_t numEntries        = 0;
+    std::int64_t numReducedEntries = 0;
+    std::int64_t maxColumnLength   = 0;
+
+    for( Index j = Index(0); j < B.getNumColumns(); j++ )
+    {
+      auto n             = static_cast<std::int64_t>( B.getColumn(j).size() );
+      numEntries        += static_cast<std::int64_t>( M.getColumn(j).size() );
+      numReducedEntries += n;
+      maxColumnLength    = std::max( maxColumnLength, n );
+    }
+
+    utilities::instrumentation::count( "boundary_matrix_columns", static_cast<std::int64_t>( B.getNumColumns() ) );
+    utilities::instrumentation::count( "boundary_matrix_entries", numEntries );
+    utilities::instrumentation::count( "reduced_matrix_entries" , numReducedEntries );
+    utilities::instrumentation::count( "reduction_entry_delta"  , numReducedEntries - numEntries );
+
+    utilities::instrumentation::maximum( "reduced_column_length", maxColumnLength );
+  }
+
+  utilities::instrumentation::ScopedPhase phase( "pairing" );
 
   PersistencePairing pairing;           // resulting pairing
   std::unordered_set<Index> creators;   // keeps track of (potential) creators
@@ -106,7 +155,12 @@ template <
       // a simplex with respect to its simplicial complex. Even for
       // a dualized matrix, this index is correctly transformed.
       if( max > numColumns || u < max )
+      {
         pairing.add( u, v );
+
+        if( recorder )
+          ( *recorder )( B, u, v );
+      }
     }
 
     // An invalid maximum index indicates that the corresponding column
@@ -158,6 +212,14 @@ template <
                                     is clear that the simplicial complex models a topological object for
                                     which top-level simplices are meaningful. For Vietoris--Rips complex
                                     calculations, this is usually *not* the case.
+  @param cycles                     Optional output for representative cycles. If set, the cycles of
+                                    all persistence pairs are recorded during the same reduction and
+                                    mapped back to the simplicial complex. This requires that the
+                                    boundary matrix is not dualized.
+  @param threshold                  Persistence threshold for recording representative cycles. Only
+                                    pairs whose persistence is at least as large are recorded. By
+                                    default, every pair, including the ones with zero persistence,
+                                    will be recorded.
 
   @tparam ReductionAlgorithm Algorithm for reducing the boundary matrix
   @tparam Representation     Representation of the boundary matrix
@@ -168,12 +230,45 @@ template <
   class ReductionAlgorithm = defaults::ReductionAlgorithm,
   class Representation     = defaults::Representation,
   class Simplex
-> std::vector< PersistenceDiagram<typename Simplex::DataType> > calculatePersistenceDiagrams( const topology::SimplicialComplex<Simplex>& K, bool dualize = true, bool includeAllUnpairedCreators = false )
+> std::vector< PersistenceDiagram<typename Simplex::DataType> > calculatePersistenceDiagrams( const topology::SimplicialComplex<Simplex>& K,
+                                                                                              bool dualize = true,
+                                                                                              bool includeAllUnpairedCreators = false,
+                                                                                              std::vector< RepresentativeCycle<Simplex> >* cycles = nullptr,
+                                                                                              typename Simplex::DataType threshold = typename Simplex::DataType() )
 {
   using namespace topology;
 
+  using Index = typename Representation::Index;
+
+  utilities::instrumentation::ScopedPhase phase( "calculatePersistenceDiagrams" );
+
   auto boundaryMatrix = makeBoundaryMatrix<Representation>( K );
-  auto pairing        = calculatePersistencePairing<ReductionAlgorithm>( dualize ? boundaryMatrix.dualize() : boundaryMatrix, includeAllUnpairedCreators );
+
+  if( cycles )
+  {
+    if( dualize )
+      throw std::runtime_error( "Representative cycles require a boundary matrix that is not dualized" );
+
+    RepresentativeCycleRecorder<Index> recorder(
+      [&K, &threshold] ( Index i, Index j )
+      {
+        // Using the absolute difference ensures that superlevel set
+        // filtrations are handled correctly. It is calculated without
+        // std::abs() in order to support unsigned data types.
+        auto a = K.at(i).data();
+        auto b = K.at(j).data();
+
+        return ( a < b ? b - a : a - b ) >= threshold;
+      }
+    );
+
+    auto pairing = calculatePersistencePairing<ReductionAlgorithm>( boundaryMatrix, includeAllUnpairedCreators, std::numeric_limits<Index>::max(), &recorder );
+    *cycles      = makeRepresentativeCycles( recorder.cycles(), K );
+
+    return makePersistenceDiagrams( pairing, K );
+  }
+
+  auto pairing = calculatePersistencePairing<ReductionAlgorithm>( dualize ? boundaryMatrix.dualize() : boundaryMatrix, includeAllUnpairedCreators );
 
   return makePersistenceDiagrams( pairing, K );
 }
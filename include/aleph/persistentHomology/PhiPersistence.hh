@@ -10,7 +10,6 @@
 #include <aleph/topology/SimplicialComplex.hh>
 
 #include <initializer_list>
-#include <map>
 #include <ostream>
 #include <stdexcept>
 #include <type_traits>
@@ -283,34 +282,53 @@ auto calculateIntersectionHomology( const aleph::topology::SimplicialComplex<Sim
   }
 
   // Check whether simplex is allowable --------------------------------
+  //
+  // Every stratum that imposes a condition is indexed once, so that the
+  // dimension of the intersection with a simplex can be determined
+  // without enumerating all of its faces. Simplices are checked in
+  // parallel, and the results are stored in a flat array that follows
+  // the order of the simplicial complex.
+
+  using Vertex = typename Simplex::VertexType;
+
+  auto d     = K.dimension();
+  auto first = useOriginalIndexing ? std::size_t(2) : std::size_t(1);
 
-  std::map<Simplex, bool> phi;
+  std::vector< aleph::topology::StratumIndex<Vertex> > strata( d + 1 );
 
+  for( std::size_t k = first; k <= d; k++ )
   {
-    auto d = K.dimension();
+    // Since the dimension of the intersection cannot be larger than the
+    // dimension of the simplex, we know that it shall be *always*
+    // admissible if the perversity does not impose any condition here.
+    if( long( p(k) ) - long(k) < 0 )
+      strata[k] = aleph::topology::StratumIndex<Vertex>( X.at( d - k ) );
+  }
+
+  std::vector<char> phi( K.size() );
 
-    for( auto&& s : K )
+  {
+    auto n = K.size();
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for( std::size_t j = 0; j < n; j++ )
     {
+      auto&& s        = K[j];
       bool admissible = true;
 
       // Note that I am letting the index start at $k = 2$ because this
       // is in consistent with the original definition given by Goresky
       // and MacPherson. By default, this behaviour is *not* active.
-      for( std::size_t k = useOriginalIndexing ? 2 : 1; k <= d; k++ )
+      for( std::size_t k = first; k <= d; k++ )
       {
-        // Since the dimension of the intersection cannot be larger
-        // than the dimension of the simplex, we know that it shall
-        // be *always* admissible if the perversity does not impose
-        // any condition here.
         if( long( p(k) ) - long(k) >= 0 )
           continue;
 
         // The notation follows Bendich and Harer, so $i$ is actually
         // referring to a dimension instead of an index. Beware!
-        auto i            = s.dimension();
-        auto intersection = aleph::topology::lastLexicographicalIntersection( X.at( d - k ), s );
-        auto dimension    = intersection.empty() ? -1 : static_cast<long>( intersection.dimension() );
-        admissible        = admissible && ( intersection.empty() ? true : static_cast<long>( dimension ) <= ( long(i) - long(k) + long( p(k) ) ) );
+        auto i         = s.dimension();
+        auto dimension = strata[k].maximumIntersectionDimension( s );
+        admissible     = admissible && ( dimension < 0 ? true : dimension <= ( long(i) - long(k) + long( p(k) ) ) );
 
         // Early abort as soon as we are sure that the simplex cannot
         // become admissible again.
@@ -318,20 +336,38 @@ auto calculateIntersectionHomology( const aleph::topology::SimplicialComplex<Sim
           break;
       }
 
-      phi[s] = admissible;
+      phi[j] = admissible;
     }
   }
 
   // Partition according to allowable simplices ------------------------
+  //
+  // This follows `partition()`, but uses the indices of simplices in
+  // order to look up whether they are allowable.
 
   aleph::topology::SimplicialComplex<Simplex> L;
   std::size_t s = 0;
 
-  std::tie( L, s ) =
-    aleph::partition( K, [&phi] ( const Simplex& s )
-                         {
-                           return phi.at(s);
-                         } );
+  {
+    std::vector<Simplex> simplices;
+    simplices.reserve( K.size() );
+
+    for( std::size_t j = 0; j < K.size(); j++ )
+    {
+      if( phi[j] )
+        simplices.push_back( K[j] );
+    }
+
+    s = simplices.size();
+
+    for( std::size_t j = 0; j < K.size(); j++ )
+    {
+      if( !phi[j] )
+        simplices.push_back( K[j] );
+    }
+
+    L = aleph::topology::SimplicialComplex<Simplex>( simplices.begin(), simplices.end() );
+  }
 
   // Calculate persistent intersection homology ------------------------
 
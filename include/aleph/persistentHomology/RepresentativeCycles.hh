@@ -0,0 +1,131 @@
+#ifndef ALEPH_PERSISTENT_HOMOLOGY_REPRESENTATIVE_CYCLES_HH__
+#define ALEPH_PERSISTENT_HOMOLOGY_REPRESENTATIVE_CYCLES_HH__
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace aleph
+{
+
+/**
+  @class RepresentativeCycle
+  @brief Representative cycle of a persistence pair
+
+  Stores the creator and the destroyer of a persistence pair along with
+  the simplices of a cycle that represents the corresponding homology
+  class. Depending on the function that was used for the calculation,
+  simplices are either described by their index in the filtration or by
+  the simplices themselves.
+*/
+
+template <class T> struct RepresentativeCycle
+{
+  T creator;
+  T destroyer;
+
+  /** Simplices of the cycle, sorted by their index in the filtration */
+  std::vector<T> simplices;
+};
+
+/**
+  @class RepresentativeCycleRecorder
+  @brief Records representative cycles while reading off a pairing
+
+  Passing an instance of this class to calculatePersistencePairing()
+  records a representative cycle for every persistence pair that
+  satisfies a predicate. After the reduction, the column of the
+  destroyer of every pair is a cycle whose lowest entry is the creator.
+  It represents the homology class that is created and destroyed by the
+  pair, so no transformation matrix and no second reduction is required.
+  Only the columns of the selected pairs are copied.
+
+  Essential classes have no destroyer, so no cycles are recorded for
+  them.
+*/
+
+template <class Index> class RepresentativeCycleRecorder
+{
+public:
+  using Predicate = std::function<bool( Index, Index )>;
+
+  /** Records the cycles of all persistence pairs */
+  RepresentativeCycleRecorder()
+    : _predicate( [] ( Index, Index ) { return true; } )
+  {
+  }
+
+  /**
+    Records the cycles of all persistence pairs that satisfy a predicate,
+    which is called with the creator and the destroyer of every pair.
+  */
+
+  explicit RepresentativeCycleRecorder( Predicate predicate )
+    : _predicate( predicate )
+  {
+  }
+
+  /**
+    Records the cycle of a pair if it satisfies the predicate.
+
+    @param B Reduced boundary matrix; it must not be dualized
+    @param i Creator of the pair
+    @param j Destroyer of the pair
+  */
+
+  template <class Representation> void operator()( const topology::BoundaryMatrix<Representation>& B, Index i, Index j )
+  {
+    if( !_predicate( i, j ) )
+      return;
+
+    auto column = B.getColumn( j );
+    std::sort( column.begin(), column.end() );
+
+    _cycles.push_back( { i, j, column } );
+  }
+
+  /** @returns Recorded cycles, sorted by their destroyers */
+  const std::vector< RepresentativeCycle<Index> >& cycles() const noexcept
+  {
+    return _cycles;
+  }
+
+private:
+  Predicate _predicate;
+  std::vector< RepresentativeCycle<Index> > _cycles;
+};
+
+/**
+  Maps representative cycles that are described by indices back to the
+  simplices of a simplicial complex.
+
+  @param cycles Representative cycles, described by indices
+  @param K      Simplicial complex whose boundary matrix was reduced
+*/
+
+template <class Index, class Simplex> std::vector< RepresentativeCycle<Simplex> > makeRepresentativeCycles( const std::vector< RepresentativeCycle<Index> >& cycles,
+                                                                                                           const topology::SimplicialComplex<Simplex>& K )
+{
+  std::vector< RepresentativeCycle<Simplex> > result;
+  result.reserve( cycles.size() );
+
+  for( auto&& c : cycles )
+  {
+    RepresentativeCycle<Simplex> cycle = { K.at( c.creator ), K.at( c.destroyer ), {} };
+    cycle.simplices.reserve( c.simplices.size() );
+
+    for( auto&& index : c.simplices )
+      cycle.simplices.push_back( K.at( index ) );
+
+    result.push_back( cycle );
+  }
+
+  return result;
+}
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,512 @@
+#ifndef ALEPH_PERSISTENT_HOMOLOGY_TIME_SERIES_HH__
+#define ALEPH_PERSISTENT_HOMOLOGY_TIME_SERIES_HH__
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace detail
+{
+
+/**
+  Persistence pair of a 1D function. In addition to the values, the
+  index of the creator is stored in order to be able to tell which of
+  the samples do not create a non-trivial pair.
+*/
+
+template <class T> struct TimeSeriesPair
+{
+  std::size_t creator;
+
+  T birth;
+  T death;
+};
+
+/**
+  @class TurningPointStack
+  @brief Incremental pairing of the samples of a 1D function
+
+  Stores the turning points, i.e. the alternating local minima and local
+  maxima, of a sequence of samples. Whenever a pair of adjacent turning
+  points is enclosed by its neighbours, the pair is removed from the
+  stack and reported as a persistence pair. The neighbours serve as
+  witnesses for the merge of the corresponding component with an older
+  component, so the pair remains valid regardless of any samples that
+  are added before or after the current sequence. This is the pairing
+  that is also used for rainflow counting.
+
+  The remaining turning points form the *residue* of the sequence. For
+  a concatenation of sequences, it is sufficient to concatenate their
+  residues in order to calculate the remaining pairs.
+
+  @tparam T       Data type of the samples
+  @tparam Compare Comparison functor; samples that compare smaller are
+                  added to the filtration first
+*/
+
+template <class T, class Compare> class TurningPointStack
+{
+public:
+  struct Point
+  {
+    std::size_t index;
+    T value;
+  };
+
+  /**
+    Adds a new sample to the stack and reports all persistence pairs
+    that could be determined.
+
+    @param index Global index of the sample
+    @param value Function value of the sample
+    @param pairs Output vector for persistence pairs
+  */
+
+  void push( std::size_t index, T value, std::vector< TimeSeriesPair<T> >& pairs )
+  {
+    auto n = _points.size();
+
+    if( n >= 1 && !_compare( value, _points[n-1].value ) && !_compare( _points[n-1].value, value ) )
+      return;
+
+    // Continuing the current monotone run only moves the last turning
+    // point. Samples that are skipped here are never creators. Since the
+    // turning point becomes more extreme, it may enclose more pairs.
+    bool continuesRun = false;
+
+    if( n >= 2 )
+    {
+      auto&& p = _points[n-2].value;
+      auto&& q = _points[n-1].value;
+
+      continuesRun = ( _compare( p, q ) && _compare( q, value ) ) || ( _compare( q, p ) && _compare( value, q ) );
+    }
+
+    if( continuesRun )
+      _points.back() = { index, value };
+    else
+      _points.push_back( { index, value } );
+
+    while( _points.size() >= 4 )
+    {
+      n = _points.size();
+
+      auto&& a = _points[n-4];
+      auto&& b = _points[n-3];
+      auto&& c = _points[n-2];
+      auto&& d = _points[n-1];
+
+      // The inner pair consists of b and c. Its creator is the point that
+      // is added to the filtration first. The neighbour of the destroyer
+      // must not be added later than the creator, whereas the neighbour
+      // of the creator must not be added earlier than the destroyer.
+      bool creatorFirst = _compare( b.value, c.value );
+
+      auto&& creator   = creatorFirst ? b : c;
+      auto&& destroyer = creatorFirst ? c : b;
+      auto&& u         = creatorFirst ? a : d; // neighbour of creator
+      auto&& v         = creatorFirst ? d : a; // neighbour of destroyer
+
+      if( _compare( u.value, destroyer.value ) || _compare( creator.value, v.value ) )
+        break;
+
+      pairs.push_back( { creator.index, creator.value, destroyer.value } );
+
+      _points[n-3] = d;
+      _points.resize( n-2 );
+    }
+  }
+
+  const std::vector<Point>& points() const noexcept
+  {
+    return _points;
+  }
+
+  void clear()
+  {
+    _points.clear();
+  }
+
+private:
+  std::vector<Point> _points;
+  Compare _compare;
+};
+
+/**
+  Pairs the residue of a sequence by a union--find sweep. Turning points
+  are added to the filtration in order; every turning point merges with
+  its neighbours if they are already present. Components are intervals,
+  so it is sufficient to store the creator of every interval at both of
+  its ends.
+
+  @param points    Residue of a sequence
+  @param pairs     Output vector for persistence pairs
+  @param essential Output for the creator of the essential class
+
+  @returns false if the residue is empty and no essential class exists
+*/
+
+template <class T, class Compare> bool pairResidue( const std::vector< typename TurningPointStack<T, Compare>::Point >& points,
+                                                    std::vector< TimeSeriesPair<T> >& pairs,
+                                                    typename TurningPointStack<T, Compare>::Point& essential )
+{
+  auto n = points.size();
+
+  if( n == 0 )
+    return false;
+
+  Compare compare;
+
+  std::vector<std::size_t> order( n );
+  std::iota( order.begin(), order.end(), std::size_t(0) );
+
+  std::stable_sort( order.begin(), order.end(),
+                    [&points, &compare] ( std::size_t i, std::size_t j )
+                    {
+                      return compare( points[i].value, points[j].value );
+                    } );
+
+  // Stores the creator of the interval that contains a point; this is
+  // only kept up to date at the boundaries of every interval.
+  auto invalid = n;
+  std::vector<std::size_t> creator( n, invalid );
+  std::vector<std::size_t> left( n );
+  std::vector<std::size_t> right( n );
+
+  for( auto&& i : order )
+  {
+    auto c = i;
+    auto l = i;
+    auto r = i;
+
+    if( i > 0 && creator[i-1] != invalid )
+    {
+      c = creator[i-1];
+      l = left[i-1];
+    }
+
+    if( i + 1 < n && creator[i+1] != invalid )
+    {
+      auto d = creator[i+1];
+      r      = right[i+1];
+
+      // Elder rule: the younger component is destroyed by the current
+      // point. If the current point did not join a component on its
+      // left, it joins the one on its right and creates nothing.
+      if( c != i )
+      {
+        if( compare( points[d].value, points[c].value ) )
+          std::swap( c, d );
+
+        pairs.push_back( { points[d].index, points[d].value, points[i].value } );
+      }
+      else
+        c = d;
+    }
+
+    creator[l] = creator[r] = creator[i] = c;
+    left[r]    = l;
+    right[l]   = r;
+  }
+
+  // All points belong to a single interval now, whose creator is stored
+  // at its boundaries.
+  essential = points[ creator.front() ];
+  return true;
+}
+
+/**
+  Creates a persistence diagram from a set of pairs of a sequence of
+  samples. Samples that do not create a pair or the essential class are
+  destroyed upon creation; they are added to the diagonal if desired.
+*/
+
+template <class T, class InputIterator> PersistenceDiagram<T> makeDiagram( const std::vector< TimeSeriesPair<T> >& pairs,
+                                                                           const T& essential,
+                                                                           std::size_t essentialCreator,
+                                                                           std::size_t offset,
+                                                                           InputIterator begin, InputIterator end,
+                                                                           bool includeDiagonal )
+{
+  PersistenceDiagram<T> D;
+  D.setDimension( 0 );
+
+  for( auto&& pair : pairs )
+    D.add( pair.birth, pair.death );
+
+  D.add( essential );
+
+  if( includeDiagonal )
+  {
+    std::vector<bool> creators( static_cast<std::size_t>( std::distance( begin, end ) ) );
+
+    creators.at( essentialCreator - offset ) = true;
+
+    for( auto&& pair : pairs )
+      creators.at( pair.creator - offset ) = true;
+
+    std::size_t i = 0;
+    for( auto it = begin; it != end; ++it, ++i )
+    {
+      if( !creators[i] )
+        D.add( *it, *it );
+    }
+  }
+
+  return D;
+}
+
+template <class T, class Compare, class InputIterator> PersistenceDiagram<T> calculatePersistenceDiagram( InputIterator begin, InputIterator end,
+                                                                                                          bool includeDiagonal )
+{
+  using Stack = TurningPointStack<T, Compare>;
+
+  Stack S;
+  std::vector< TimeSeriesPair<T> > pairs;
+
+  std::size_t index = 0;
+  for( auto it = begin; it != end; ++it )
+    S.push( index++, static_cast<T>( *it ), pairs );
+
+  typename Stack::Point essential;
+  if( !pairResidue<T, Compare>( S.points(), pairs, essential ) )
+    return PersistenceDiagram<T>();
+
+  return makeDiagram( pairs, essential.value, essential.index, 0,
+                                 begin, end,
+                                 includeDiagonal );
+}
+
+} // namespace detail
+
+/**
+  Calculates the zero-dimensional persistence diagram of the sublevel
+  set filtration of a 1D function, e.g. a time series. The function is
+  given as a sequence of samples; subsequent samples are connected by
+  an edge whose weight is the maximum of its vertex weights.
+
+  The calculation does not create a boundary matrix or a simplicial
+  complex. Instead, it uses a single pass over the samples that pairs
+  local minima with local maxima, followed by a union--find sweep over
+  the remaining turning points. The resulting diagram coincides with
+  the one obtained from the matrix reduction.
+
+  @param begin           Input iterator to the begin of the samples
+  @param end             Input iterator to the end of the samples
+
+  @param includeDiagonal Flag indicating whether samples that are not
+                         local minima should contribute points on the
+                         diagonal, just as for the matrix reduction
+
+  @returns Persistence diagram; if no samples are given, the diagram
+           will be empty
+*/
+
+template <class InputIterator> PersistenceDiagram<typename std::iterator_traits<InputIterator>::value_type>
+  calculateSublevelSetPersistenceDiagram( InputIterator begin, InputIterator end,
+                                          bool includeDiagonal = true )
+{
+  using T = typename std::iterator_traits<InputIterator>::value_type;
+  return detail::calculatePersistenceDiagram<T, std::less<T> >( begin, end, includeDiagonal );
+}
+
+/**
+  Calculates the zero-dimensional persistence diagram of the superlevel
+  set filtration of a 1D function. Edges are assigned the minimum of
+  their vertex weights. See calculateSublevelSetPersistenceDiagram()
+  for more details.
+*/
+
+template <class InputIterator> PersistenceDiagram<typename std::iterator_traits<InputIterator>::value_type>
+  calculateSuperlevelSetPersistenceDiagram( InputIterator begin, InputIterator end,
+                                            bool includeDiagonal = true )
+{
+  using T = typename std::iterator_traits<InputIterator>::value_type;
+  return detail::calculatePersistenceDiagram<T, std::greater<T> >( begin, end, includeDiagonal );
+}
+
+/**
+  @class SlidingWindowPersistence
+  @brief Persistence diagrams of a sliding window over a time series
+
+  Maintains the zero-dimensional persistence diagram of the most recent
+  samples of a stream. The stream is partitioned into blocks of a fixed
+  size. Pairs that are determined within a block remain valid as long
+  as the block is part of the window, so they are only calculated once,
+  while samples arrive. Calculating a diagram requires pairing the
+  residues of all blocks and recalculating the pairs of the oldest one
+  if it has been partially shifted out of the window.
+
+  @tparam T       Data type of the samples
+  @tparam Compare Comparison functor; use std::less<T> for sublevel set
+                  filtrations, and std::greater<T> for superlevel set
+                  filtrations
+*/
+
+template <class T, class Compare = std::less<T> > class SlidingWindowPersistence
+{
+public:
+  using DataType = T;
+
+  /**
+    Creates a new sliding window.
+
+    @param windowSize Maximum number of samples in the window
+    @param blockSize  Number of samples per block; if zero, a block size
+                      proportional to the square root of the window size
+                      will be used
+  */
+
+  explicit SlidingWindowPersistence( std::size_t windowSize, std::size_t blockSize = 0 )
+    : _windowSize( windowSize )
+    , _blockSize( blockSize )
+  {
+    if( _windowSize == 0 )
+      throw std::runtime_error( "Window size must be positive" );
+
+    if( _blockSize == 0 )
+    {
+      _blockSize = 1;
+      while( _blockSize * _blockSize < _windowSize )
+        _blockSize *= 2;
+    }
+
+    _blockSize = std::min( _blockSize, _windowSize );
+  }
+
+  /** Adds a new sample, shifting the oldest one out of the window if necessary */
+  void push( T value )
+  {
+    _tail.push( _end, value, _tailPairs );
+    _samples.push_back( value );
+
+    ++_end;
+
+    if( _end % _blockSize == 0 )
+    {
+      Block block;
+      block.begin   = _end - _blockSize;
+      block.pairs   = std::move( _tailPairs );
+      block.residue = _tail.points();
+
+      _blocks.push_back( std::move( block ) );
+
+      _tail.clear();
+      _tailPairs.clear();
+    }
+
+    if( _samples.size() > _windowSize )
+    {
+      _samples.pop_front();
+      ++_begin;
+
+      if( !_blocks.empty() && _blocks.front().begin + _blockSize <= _begin )
+        _blocks.pop_front();
+    }
+  }
+
+  /**
+    Calculates the persistence diagram of the current window.
+
+    @param includeDiagonal Flag indicating whether samples that are not
+                           local minima should contribute points on the
+                           diagonal
+  */
+
+  PersistenceDiagram<T> diagram( bool includeDiagonal = true ) const
+  {
+    using Stack = detail::TurningPointStack<T, Compare>;
+
+    Stack S;
+    std::vector< detail::TimeSeriesPair<T> > pairs;
+
+    auto feed = [&S, &pairs] ( const std::vector<typename Stack::Point>& points )
+    {
+      for( auto&& p : points )
+        S.push( p.index, p.value, pairs );
+    };
+
+    for( auto&& block : _blocks )
+    {
+      // The pairs of the oldest block are only valid if the block is
+      // still completely contained in the window.
+      if( block.begin < _begin )
+      {
+        Stack H;
+
+        for( auto i = _begin; i < block.begin + _blockSize; i++ )
+          H.push( i, _samples[i - _begin], pairs );
+
+        feed( H.points() );
+      }
+      else
+      {
+        pairs.insert( pairs.end(), block.pairs.begin(), block.pairs.end() );
+        feed( block.residue );
+      }
+    }
+
+    pairs.insert( pairs.end(), _tailPairs.begin(), _tailPairs.end() );
+    feed( _tail.points() );
+
+    typename Stack::Point essential;
+    if( !detail::pairResidue<T, Compare>( S.points(), pairs, essential ) )
+      return PersistenceDiagram<T>();
+
+    return detail::makeDiagram( pairs, essential.value, essential.index, _begin,
+                                           _samples.begin(), _samples.end(),
+                                           includeDiagonal );
+  }
+
+  /** @returns Number of samples in the window */
+  std::size_t size() const noexcept
+  {
+    return _samples.size();
+  }
+
+  std::size_t windowSize() const noexcept { return _windowSize; }
+  std::size_t blockSize()  const noexcept { return _blockSize;  }
+
+private:
+
+  /** Pairs and residue of a complete block of samples */
+  struct Block
+  {
+    std::size_t begin;
+
+    std::vector< detail::TimeSeriesPair<T> > pairs;
+    std::vector< typename detail::TurningPointStack<T, Compare>::Point > residue;
+  };
+
+  std::size_t _windowSize;
+  std::size_t _blockSize;
+
+  /** Global index of the first sample in the window */
+  std::size_t _begin = 0;
+
+  /** Global index after the last sample in the window */
+  std::size_t _end   = 0;
+
+  std::deque<T> _samples;
+  std::deque<Block> _blocks;
+
+  // Block that is currently being filled with samples; its pairs are
+  // updated whenever a new sample arrives.
+  detail::TurningPointStack<T, Compare> _tail;
+  std::vector< detail::TimeSeriesPair<T> > _tailPairs;
+};
+
+} // namespace aleph
+
+#endif
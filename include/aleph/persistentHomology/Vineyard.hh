@@ -0,0 +1,443 @@
+#ifndef ALEPH_PERSISTENT_HOMOLOGY_VINEYARD_HH__
+#define ALEPH_PERSISTENT_HOMOLOGY_VINEYARD_HH__
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+/**
+  @class Vineyard
+  @brief Incremental persistent homology for changing filtration values
+
+  Maintains a decomposition \f$R = DV\f$ of the boundary matrix \f$D\f$
+  of a simplicial complex, where \f$R\f$ is reduced and \f$V\f$ is upper
+  triangular. If the weights of the simplices change, the filtration is
+  sorted again by transpositions of adjacent simplices. Every one of them
+  is mirrored by the decomposition, following the vineyard algorithm of
+  Cohen-Steiner, Edelsbrunner, and Morozov. Updating the persistence
+  pairs thus requires time proportional to the number of transpositions
+  instead of a complete reduction of the boundary matrix.
+
+  Columns of both matrices are stored with respect to the indices of the
+  simplices in the original simplicial complex, which never change. The
+  position of a simplex in the current filtration is only required for
+  determining the pivot of a column.
+
+  @tparam Simplex    Simplex data type
+  @tparam Filtration Functor for sorting simplices; it must ensure that
+                     faces precede their cofaces
+*/
+
+template <
+  class Simplex,
+  class Filtration = topology::filtrations::Data<Simplex>
+> class Vineyard
+{
+public:
+  using DataType          = typename Simplex::DataType;
+  using SimplicialComplex = topology::SimplicialComplex<Simplex>;
+
+  /**
+    Creates a new vineyard for a simplicial complex. The complex is sorted
+    according to the filtration, and its boundary matrix is reduced once.
+    Subsequent updates refer to simplices by their index in \p K.
+
+    @param K Simplicial complex
+  */
+
+  explicit Vineyard( const SimplicialComplex& K )
+    : _simplices( K.begin(), K.end() )
+  {
+    auto n = _simplices.size();
+
+    _boundaries.resize( n );
+
+    for( std::size_t id = 0; id < n; id++ )
+    {
+      auto&& s = _simplices[id];
+
+      for( auto itFace = s.begin_boundary(); itFace != s.end_boundary(); ++itFace )
+        _boundaries[id].push_back( K.index( *itFace ) );
+
+      std::sort( _boundaries[id].begin(), _boundaries[id].end() );
+    }
+
+    _order.resize( n );
+    std::iota( _order.begin(), _order.end(), std::size_t(0) );
+
+    Filtration filtration;
+
+    std::stable_sort( _order.begin(), _order.end(),
+                      [this, &filtration] ( std::size_t i, std::size_t j )
+                      {
+                        return filtration( _simplices[i], _simplices[j] );
+                      } );
+
+    _position.resize( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+      _position[ _order[i] ] = i;
+
+    this->reduce();
+  }
+
+  /**
+    Assigns new weights to all simplices and updates the persistence
+    pairs accordingly.
+
+    @param values New weights, indexed by the position of the simplices
+                  in the original simplicial complex
+
+    @returns Number of transpositions that were required
+  */
+
+  std::size_t update( const std::vector<DataType>& values )
+  {
+    if( values.size() != _simplices.size() )
+      throw std::runtime_error( "Number of weights does not match number of simplices" );
+
+    for( std::size_t id = 0; id < values.size(); id++ )
+      _simplices[id].setData( values[id] );
+
+    return this->sort();
+  }
+
+  /**
+    Takes new weights from another simplicial complex, e.g. the result of
+    recalculating the weights of the original complex, and updates the
+    persistence pairs accordingly.
+
+    @param L Simplicial complex; it must contain the same simplices as
+             the original simplicial complex
+
+    @returns Number of transpositions that were required
+  */
+
+  std::size_t update( const SimplicialComplex& L )
+  {
+    if( L.size() != _simplices.size() )
+      throw std::runtime_error( "Simplicial complexes must contain the same simplices" );
+
+    std::vector<DataType> values;
+    values.reserve( _simplices.size() );
+
+    for( auto&& s : _simplices )
+    {
+      auto it = L.find( s );
+      if( it == L.end() )
+        throw std::runtime_error( "Simplicial complexes must contain the same simplices" );
+
+      values.push_back( it->data() );
+    }
+
+    return this->update( values );
+  }
+
+  /**
+    Exchanges two adjacent simplices in the filtration and updates the
+    decomposition. The weights of the simplices remain unchanged, so the
+    next update may choose a different order again.
+
+    @param i Position of the first simplex; it is exchanged with the
+             simplex at position \f$i+1\f$
+  */
+
+  void transpose( std::size_t i )
+  {
+    if( i + 1 >= _order.size() )
+      throw std::out_of_range( "Invalid position for transposition" );
+
+    auto a = _order[i];
+    auto b = _order[i+1];
+
+    if( std::binary_search( _boundaries[b].begin(), _boundaries[b].end(), a ) )
+      throw std::runtime_error( "Transposition would precede a coface by its face" );
+
+    // The only columns whose pivots may change are the ones of the two
+    // simplices and of their partners. All other columns have a pivot
+    // that is not affected by exchanging the two rows.
+    std::vector<std::size_t> affected = { a, b };
+
+    for( auto&& id : { a, b } )
+    {
+      if( _pairs[id] != invalid() )
+        affected.push_back( _pairs[id] );
+    }
+
+    bool positiveA = _R[a].empty();
+    bool positiveB = _R[b].empty();
+
+    // Ensure that V remains upper triangular, which requires removing the
+    // entry of a in the column of b. Depending on the types of simplices,
+    // this is followed by another column operation after the exchange in
+    // order to keep R reduced.
+    bool addAfterExchange = false;
+
+    if( std::binary_search( _V[b].begin(), _V[b].end(), a ) )
+    {
+      if( positiveA )
+        add( _V[a], _V[b] );
+      else if( positiveB )
+      {
+        this->addColumn( a, b );
+        addAfterExchange = true;
+      }
+      else
+      {
+        auto lowA = _position[ _pairs[a] ];
+        auto lowB = _position[ _pairs[b] ];
+
+        this->addColumn( a, b );
+        addAfterExchange = lowA > lowB;
+      }
+    }
+
+    _order[i]    = b;
+    _order[i+1]  = a;
+    _position[a] = i+1;
+    _position[b] = i;
+
+    if( addAfterExchange )
+      this->addColumn( b, a );
+
+    // If both simplices are paired creators, exchanging the rows causes
+    // both of their partners to have the same pivot if the partner of b
+    // also contains a. The younger partner is reduced with respect to the
+    // older one.
+    if( positiveA && positiveB && _pairs[a] != invalid() && _pairs[b] != invalid() )
+    {
+      auto k = _pairs[a];
+      auto l = _pairs[b];
+
+      if( std::binary_search( _R[l].begin(), _R[l].end(), a ) )
+      {
+        if( _position[k] < _position[l] )
+          this->addColumn( k, l );
+        else
+          this->addColumn( l, k );
+      }
+    }
+
+    for( auto&& id : affected )
+      _pairs[id] = invalid();
+
+    for( auto&& id : affected )
+    {
+      if( !_R[id].empty() )
+      {
+        auto low     = this->low( id );
+        _pairs[id]   = low;
+        _pairs[low]  = id;
+      }
+    }
+
+    ++_transpositions;
+  }
+
+  /**
+    Calculates the persistence diagrams of the current filtration. The
+    diagrams are ordered by dimension and coincide with the ones that
+    are obtained by a complete reduction of the boundary matrix.
+
+    @param includeAllUnpairedCreators Indicates that unpaired creators of
+                                      the largest dimension should also
+                                      be reported
+  */
+
+  std::vector< PersistenceDiagram<DataType> > persistenceDiagrams( bool includeAllUnpairedCreators = false ) const
+  {
+    std::size_t maxDimension = 0;
+
+    for( auto&& s : _simplices )
+      maxDimension = std::max( maxDimension, s.dimension() );
+
+    std::map<std::size_t, PersistenceDiagram<DataType> > diagrams;
+
+    for( auto&& id : _order )
+    {
+      if( !_R[id].empty() )
+        continue;
+
+      auto&& s = _simplices[id];
+      auto d   = s.dimension();
+
+      if( _pairs[id] != invalid() )
+        diagrams[d].add( s.data(), _simplices[ _pairs[id] ].data() );
+      else if( d != maxDimension || includeAllUnpairedCreators )
+        diagrams[d].add( s.data() );
+    }
+
+    std::vector< PersistenceDiagram<DataType> > result;
+    result.reserve( diagrams.size() );
+
+    for( auto&& pair : diagrams )
+    {
+      auto&& diagram = pair.second;
+      diagram.setDimension( pair.first );
+
+      result.push_back( diagram );
+    }
+
+    return result;
+  }
+
+  /** @returns Simplicial complex in the current filtration order */
+  SimplicialComplex complex() const
+  {
+    std::vector<Simplex> simplices;
+    simplices.reserve( _order.size() );
+
+    for( auto&& id : _order )
+      simplices.push_back( _simplices[id] );
+
+    return SimplicialComplex( simplices.begin(), simplices.end() );
+  }
+
+  /** @returns Index of the simplex at a position of the current filtration */
+  std::size_t index( std::size_t position ) const
+  {
+    return _order.at( position );
+  }
+
+  /** @returns Position of a simplex in the current filtration */
+  std::size_t position( std::size_t index ) const
+  {
+    return _position.at( index );
+  }
+
+  std::size_t size() const noexcept { return _simplices.size(); }
+
+  /** @returns Total number of transpositions since the initial reduction */
+  std::size_t transpositions() const noexcept { return _transpositions; }
+
+private:
+
+  static constexpr std::size_t invalid() noexcept
+  {
+    return std::numeric_limits<std::size_t>::max();
+  }
+
+  /** Adds a sorted column to another one over \f$Z_2\f$ */
+  static void add( const std::vector<std::size_t>& source, std::vector<std::size_t>& target )
+  {
+    std::vector<std::size_t> result;
+    result.reserve( source.size() + target.size() );
+
+    std::set_symmetric_difference( source.begin(), source.end(),
+                                   target.begin(), target.end(),
+                                   std::back_inserter( result ) );
+
+    target.swap( result );
+  }
+
+  /** Adds column s to column t in both matrices */
+  void addColumn( std::size_t s, std::size_t t )
+  {
+    add( _R[s], _R[t] );
+    add( _V[s], _V[t] );
+  }
+
+  /** @returns Index of the simplex that forms the pivot of a non-empty column */
+  std::size_t low( std::size_t id ) const
+  {
+    return *std::max_element( _R[id].begin(), _R[id].end(),
+                              [this] ( std::size_t i, std::size_t j )
+                              {
+                                return _position[i] < _position[j];
+                              } );
+  }
+
+  /** Reduces the boundary matrix with respect to the current filtration */
+  void reduce()
+  {
+    auto n = _simplices.size();
+
+    _R      = _boundaries;
+    _V.assign( n, {} );
+    _pairs.assign( n, invalid() );
+
+    for( auto&& id : _order )
+    {
+      _V[id].push_back( id );
+
+      while( !_R[id].empty() )
+      {
+        auto low = this->low( id );
+
+        if( _pairs[low] == invalid() )
+        {
+          _pairs[low] = id;
+          _pairs[id]  = low;
+          break;
+        }
+
+        this->addColumn( _pairs[low], id );
+      }
+    }
+  }
+
+  /**
+    Sorts the filtration by insertion sort, which only exchanges adjacent
+    simplices, and updates the decomposition for every transposition.
+  */
+
+  std::size_t sort()
+  {
+    Filtration filtration;
+
+    auto transpositions = _transpositions;
+
+    for( std::size_t i = 1; i < _order.size(); i++ )
+    {
+      for( auto j = i; j > 0 && filtration( _simplices[ _order[j] ], _simplices[ _order[j-1] ] ); j-- )
+        this->transpose( j-1 );
+    }
+
+    return _transpositions - transpositions;
+  }
+
+  /** Simplices, indexed by their position in the original complex */
+  std::vector<Simplex> _simplices;
+
+  /** Sorted indices of the faces of every simplex */
+  std::vector< std::vector<std::size_t> > _boundaries;
+
+  /** Maps positions in the filtration to simplex indices */
+  std::vector<std::size_t> _order;
+
+  /** Maps simplex indices to positions in the filtration */
+  std::vector<std::size_t> _position;
+
+  // Columns of the reduced matrix and of the transformation matrix; all
+  // entries are simplex indices, sorted in ascending order.
+  std::vector< std::vector<std::size_t> > _R;
+  std::vector< std::vector<std::size_t> > _V;
+
+  /**
+    Partner of every simplex in the persistence pairing, or an invalid
+    index for unpaired creators
+  */
+
+  std::vector<std::size_t> _pairs;
+
+  std::size_t _transpositions = 0;
+};
+
+} // namespace aleph
+
+#endif
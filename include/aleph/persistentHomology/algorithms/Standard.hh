@@ -3,6 +3,8 @@
 
 #include <aleph/topology/BoundaryMatrix.hh>
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <tuple>
 #include <vector>
 
@@ -27,6 +29,8 @@ public:
     std::vector< std::pair<Index, bool> > lut( static_cast<std::size_t>( numColumns ),
                                                std::make_pair(0, false) );
 
+    utilities::instrumentation::Counter numAdditions( "column_additions" );
+
     for( Index j = 0; j < numColumns; j++ )
     {
       Index i;
@@ -37,6 +41,8 @@ public:
       {
         M.addColumns( lut[ static_cast<std::size_t>(i) ].first, j );
         std::tie( i, valid ) = M.getMaximumIndex( j );
+
+        ++numAdditions;
       }
 
       if( valid )
@@ -57,6 +63,8 @@ public:
     std::vector< std::pair<Index, bool> > lut( static_cast<std::size_t>( numColumns ),
                                                std::make_pair(0, false) );
 
+    utilities::instrumentation::Counter numAdditions( "column_additions" );
+
     for( Index j = 0; j < numColumns; j++ )
     {
       Index i;
@@ -71,6 +79,8 @@ public:
       {
         M.addColumns( lut[ static_cast<std::size_t>(i) ].first, j );
         std::tie( i, valid ) = M.getMaximumIndex( j );
+
+        ++numAdditions;
       }
 
       if( valid )
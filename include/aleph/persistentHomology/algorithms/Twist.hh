@@ -3,6 +3,8 @@
 
 #include <aleph/topology/BoundaryMatrix.hh>
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <tuple>
 #include <vector>
 
@@ -28,6 +30,9 @@ public:
     std::vector< std::pair<Index, bool> > lut( std::size_t(numColumns),
                                                std::make_pair(0, false) );
 
+    utilities::instrumentation::Counter numAdditions( "column_additions" );
+    utilities::instrumentation::Counter numClearings( "column_clearings" );
+
     for( Index d = dimension; d >= 1; d-- )
     {
       for( Index j = 0; j < numColumns; j++ )
@@ -42,12 +47,16 @@ public:
           {
             M.addColumns( lut[ std::size_t(i) ].first, j );
             std::tie( i, valid ) = M.getMaximumIndex( j );
+
+            ++numAdditions;
           }
 
           if( valid )
           {
             lut[ std::size_t(i) ] = std::make_pair( j, true );
             M.clearColumn( i );
+
+            ++numClearings;
           }
         }
       }
@@ -1,6 +1,8 @@
 #ifndef ALEPH_BOUNDARY_MATRIX_HH__
 #define ALEPH_BOUNDARY_MATRIX_HH__
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <algorithm>
 #include <fstream>
 #include <istream>
@@ -112,6 +114,8 @@ public:
 
   BoundaryMatrix dualize() const
   {
+    utilities::instrumentation::ScopedPhase phase( "dualize" );
+
     auto&& numColumns = this->getNumColumns();
 
     std::vector< std::vector<Index> > dualMatrix( numColumns );
@@ -0,0 +1,566 @@
+#ifndef ALEPH_TOPOLOGY_COMPACT_MESH_HH__
+#define ALEPH_TOPOLOGY_COMPACT_MESH_HH__
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+/**
+  @class CompactMesh
+  @brief Index-based half-edge mesh data structure
+
+  This class represents the same two-dimensional piecewise linear
+  manifolds as the half-edge mesh, but stores vertices, faces, and
+  half-edges in contiguous arrays. All elements are addressed by 32-bit
+  indices instead of pointers, so traversals do not require reference
+  counting and the whole mesh is stored in a handful of allocations.
+
+  The mesh is created in bulk from a list of faces, e.g. the face block
+  of a PLY file. Vertex IDs are the indices of the vertices in the input
+  data, i.e. they are contiguous and start at zero. Half-edges that bound
+  a face are stored in the order of the faces; the half-edges of face
+  \f$f\f$ are thus contiguous. Half-edges on the boundary of the mesh do
+  not belong to any face and are stored afterwards.
+
+  The mesh offers the same queries as the pointer-based half-edge mesh,
+  so algorithms such as the Morse--Smale complex may use both of them.
+*/
+
+template <class Position = float, class Data = float> class CompactMesh
+{
+public:
+  using Index = std::uint32_t;
+
+  /** Marks a missing element, e.g. the face of a boundary half-edge */
+  static constexpr Index invalid() noexcept { return std::numeric_limits<Index>::max(); }
+
+  struct HalfEdge
+  {
+    Index face   = invalid();
+    Index vertex = invalid(); // Target vertex
+
+    Index next   = invalid(); // Next half-edge (counter-clockwise)
+    Index prev   = invalid(); // Previous half-edge
+    Index pair   = invalid(); // Opposite half-edge
+  };
+
+  struct Vertex
+  {
+    Position x    = Position();
+    Position y    = Position();
+    Position z    = Position();
+    Data     data = Data();
+
+    Index edge    = invalid(); // Outgoing half-edge
+  };
+
+  /** Creates an empty mesh */
+  CompactMesh() = default;
+
+  /**
+    Creates a new mesh from vertex coordinates and faces. Faces are given
+    as a flat list of vertex IDs together with offsets into the list, so
+    that face \f$f\f$ consists of the vertices in the half-open range
+    \f$[o_f, o_{f+1})\f$. The vertices of every face need to be sorted
+    such that the orientation of the mesh is consistent.
+
+    @param coordinates Coordinates of all vertices, stored as consecutive
+                       \f$(x,y,z)\f$ triples
+
+    @param data        Data values of all vertices; may be empty, in which
+                       case every vertex is assigned a default value
+
+    @param indices     Vertex IDs of all faces
+    @param offsets     Offsets of all faces, followed by the size of the
+                       list of vertex IDs
+  */
+
+  CompactMesh( const std::vector<Position>& coordinates,
+               const std::vector<Data>& data,
+               const std::vector<Index>& indices,
+               const std::vector<Index>& offsets )
+  {
+    this->build( coordinates, data, indices, offsets );
+  }
+
+  /**
+    Creates a new mesh from vertex coordinates and triangles, which are
+    given as consecutive triples of vertex IDs. See the general
+    constructor for a description of the remaining parameters.
+  */
+
+  CompactMesh( const std::vector<Position>& coordinates,
+               const std::vector<Data>& data,
+               const std::vector<Index>& triangles )
+  {
+    if( triangles.size() % 3 != 0 )
+      throw std::runtime_error( "Number of vertex IDs must be a multiple of three" );
+
+    std::vector<Index> offsets( triangles.size() / 3 + 1 );
+
+    for( std::size_t i = 0; i < offsets.size(); i++ )
+      offsets[i] = static_cast<Index>( 3 * i );
+
+    this->build( coordinates, data, triangles, offsets );
+  }
+
+  // Mesh attributes ---------------------------------------------------
+
+  std::vector<Index> vertices() const
+  {
+    std::vector<Index> result( _vertices.size() );
+    std::iota( result.begin(), result.end(), Index(0) );
+
+    return result;
+  }
+
+  std::size_t numVertices() const noexcept
+  {
+    return _vertices.size();
+  }
+
+  /**
+    Collects the vertices of all faces. Vertex IDs are reported in the
+    order in which they have been specified for every face.
+  */
+
+  std::vector< std::vector<Index> > faces() const
+  {
+    std::vector< std::vector<Index> > result;
+    result.reserve( _faces.size() );
+
+    for( Index f = 0; f < static_cast<Index>( _faces.size() ); f++ )
+      result.push_back( this->face( f ) );
+
+    return result;
+  }
+
+  /** Returns the vertices of a single face, in traversal order */
+  std::vector<Index> face( Index f ) const
+  {
+    std::vector<Index> result;
+
+    auto first = _faces.at( f );
+    auto e     = first;
+
+    do
+    {
+      result.push_back( this->source( e ) );
+      e = _edges[e].next;
+    }
+    while( e != first );
+
+    return result;
+  }
+
+  std::size_t numFaces() const noexcept
+  {
+    return _faces.size();
+  }
+
+  /** Returns the number of undirected edges of the mesh */
+  std::size_t numEdges() const noexcept
+  {
+    return _edges.size() / 2;
+  }
+
+  const std::vector<HalfEdge>& halfEdges() const noexcept { return _edges;    }
+  const Vertex& vertex( Index id )         const          { return _vertices.at( id ); }
+
+  /** Returns the source vertex of a half-edge */
+  Index source( Index e ) const noexcept
+  {
+    return _edges[ _edges[e].pair ].vertex;
+  }
+
+  /** Returns the target vertex of a half-edge */
+  Index target( Index e ) const noexcept
+  {
+    return _edges[e].vertex;
+  }
+
+  // Mesh queries ------------------------------------------------------
+
+  /** Returns data stored at a certain vertex */
+  Data data( Index id ) const
+  {
+    return _vertices.at( id ).data;
+  }
+
+  /**
+    The star of a vertex is defined as the mesh that contains all the
+    triangles and edges of which the vertex is a face.
+
+    Since vertex IDs are contiguous, the vertices of the star are
+    renumbered. Their order is preserved, though.
+  */
+
+  CompactMesh star( Index id ) const
+  {
+    std::vector<Index> faces;
+
+    this->forEachOutgoingEdge( id, [this, &faces] ( Index e )
+    {
+      if( _edges[e].face != invalid() )
+        faces.push_back( _edges[e].face );
+    } );
+
+    std::vector<Index> vertices;
+
+    for( auto&& f : faces )
+    {
+      auto&& v = this->face( f );
+      vertices.insert( vertices.end(), v.begin(), v.end() );
+    }
+
+    std::sort( vertices.begin(), vertices.end() );
+    vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+    std::vector<Position> coordinates;
+    std::vector<Data> data;
+
+    coordinates.reserve( 3 * vertices.size() );
+    data.reserve( vertices.size() );
+
+    for( auto&& v : vertices )
+    {
+      auto&& V = _vertices[v];
+
+      coordinates.push_back( V.x );
+      coordinates.push_back( V.y );
+      coordinates.push_back( V.z );
+      data.push_back( V.data );
+    }
+
+    std::vector<Index> indices;
+    std::vector<Index> offsets( 1, 0 );
+
+    for( auto&& f : faces )
+    {
+      for( auto&& v : this->face( f ) )
+      {
+        auto it = std::lower_bound( vertices.begin(), vertices.end(), v );
+        indices.push_back( static_cast<Index>( std::distance( vertices.begin(), it ) ) );
+      }
+
+      offsets.push_back( static_cast<Index>( indices.size() ) );
+    }
+
+    return CompactMesh( coordinates, data, indices, offsets );
+  }
+
+  /**
+    The link of a vertex is defined as all simplices in the closed star
+    that are disjoint from the vertex. For 2-manifolds, this will yield
+    a cycle of edges and vertices.
+
+    This function will represent the cycle by returning all vertex IDs,
+    in an order that is consistent with the orientation of the mesh.
+  */
+
+  std::vector<Index> link( Index id ) const
+  {
+    std::vector<Index> result;
+
+    this->forEachOutgoingEdge( id, [this, &result] ( Index e )
+    {
+      result.push_back( _edges[e].vertex );
+    } );
+
+    return result;
+  }
+
+  std::vector<Index> getLowerNeighbours( Index id ) const
+  {
+    auto data = _vertices.at( id ).data;
+
+    std::vector<Index> result;
+
+    this->forEachOutgoingEdge( id, [this, &data, &result] ( Index e )
+    {
+      auto v = _edges[e].vertex;
+      if( _vertices[v].data < data )
+        result.push_back( v );
+    } );
+
+    return result;
+  }
+
+  std::vector<Index> getHigherNeighbours( Index id ) const
+  {
+    auto data = _vertices.at( id ).data;
+
+    std::vector<Index> result;
+
+    this->forEachOutgoingEdge( id, [this, &data, &result] ( Index e )
+    {
+      auto v = _edges[e].vertex;
+      if( _vertices[v].data > data )
+        result.push_back( v );
+    } );
+
+    return result;
+  }
+
+  /**
+    Checks whether an edge between two vertices that are identified by
+    their index exists.
+  */
+
+  bool hasEdge( Index u, Index v ) const
+  {
+    bool found = false;
+
+    this->forEachOutgoingEdge( u, [this, &found, &v] ( Index e )
+    {
+      found = found || _edges[e].vertex == v;
+    } );
+
+    return found;
+  }
+
+  /** Counts the number of connected components */
+  std::size_t numConnectedComponents() const
+  {
+    std::vector<Index> parent( _vertices.size() );
+    std::iota( parent.begin(), parent.end(), Index(0) );
+
+    auto find = [&parent] ( Index u )
+    {
+      while( parent[u] != u )
+      {
+        parent[u] = parent[ parent[u] ];
+        u         = parent[u];
+      }
+
+      return u;
+    };
+
+    for( auto&& edge : _edges )
+    {
+      auto u = find( edge.vertex );
+      auto v = find( _edges[ edge.pair ].vertex );
+
+      if( u != v )
+        parent[u] = v;
+    }
+
+    std::size_t numComponents = 0;
+
+    for( Index u = 0; u < static_cast<Index>( parent.size() ); u++ )
+    {
+      if( parent[u] == u )
+        ++numComponents;
+    }
+
+    return numComponents;
+  }
+
+  /**
+    Enumerates all outgoing half-edges of a vertex without allocating
+    any memory. The half-edges are reported in an order that is
+    consistent with the orientation of the mesh. For a vertex on the
+    boundary, the traversal starts and ends at a boundary half-edge.
+
+    @param id Vertex ID
+    @param f  Functor that is called with the index of every half-edge
+  */
+
+  template <class Functor> void forEachOutgoingEdge( Index id, Functor f ) const
+  {
+    auto first = _vertices.at( id ).edge;
+    auto e     = first;
+
+    if( e == invalid() )
+      return;
+
+    do
+    {
+      f( e );
+
+      // The half-edge does not belong to a face, so the vertex is on
+      // the boundary and all of its half-edges have been traversed.
+      if( _edges[e].face == invalid() )
+        break;
+
+      e = _edges[ _edges[e].prev ].pair;
+    }
+    while( e != first );
+  }
+
+private:
+
+  void build( const std::vector<Position>& coordinates,
+              const std::vector<Data>& data,
+              const std::vector<Index>& indices,
+              const std::vector<Index>& offsets )
+  {
+    if( coordinates.size() % 3 != 0 )
+      throw std::runtime_error( "Number of coordinates must be a multiple of three" );
+
+    auto n = coordinates.size() / 3;
+
+    if( !data.empty() && data.size() != n )
+      throw std::runtime_error( "Number of data values must match number of vertices" );
+
+    if( offsets.empty() || offsets.front() != 0 || offsets.back() != indices.size() )
+      throw std::runtime_error( "Face offsets must cover all vertex IDs" );
+
+    // The boundary may double the number of half-edges in the worst
+    // case, which still has to fit into an index.
+    if( n >= invalid() || indices.size() >= invalid() / 2 )
+      throw std::runtime_error( "Mesh is too large to be addressed by 32-bit indices" );
+
+    // Vertices ----------------------------------------------------------
+
+    _vertices.resize( n );
+
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      _vertices[i].x = coordinates[3*i  ];
+      _vertices[i].y = coordinates[3*i+1];
+      _vertices[i].z = coordinates[3*i+2];
+
+      if( !data.empty() )
+        _vertices[i].data = data[i];
+    }
+
+    // Faces -------------------------------------------------------------
+    //
+    // Every face creates one half-edge per vertex. The half-edge with the
+    // same position as a vertex ID starts at this vertex, so the first
+    // half-edge of a face reports its vertices in the original order.
+
+    auto numFaces = offsets.size() - 1;
+
+    _faces.resize( numFaces );
+    _edges.resize( indices.size() );
+
+    for( std::size_t f = 0; f < numFaces; f++ )
+    {
+      auto begin = offsets[f];
+      auto end   = offsets[f+1];
+
+      if( end < begin || end - begin < 3 )
+        throw std::runtime_error( "Every face must have at least three vertices" );
+
+      _faces[f] = begin;
+
+      for( auto e = begin; e < end; e++ )
+      {
+        auto next = e + 1 < end ? e + 1 : begin;
+        auto prev = e > begin   ? e - 1 : end - 1;
+
+        if( indices[e] >= n )
+          throw std::runtime_error( "Unknown vertex ID" );
+
+        _edges[e].face   = static_cast<Index>( f );
+        _edges[e].vertex = indices[next];
+        _edges[e].next   = next;
+        _edges[e].prev   = prev;
+      }
+    }
+
+    // Pairing -----------------------------------------------------------
+    //
+    // Half-edges are sorted by their undirected edge. Equal edges are then
+    // adjacent, and every edge may be shared by at most two faces, which
+    // need to traverse it in opposite directions.
+
+    auto key = [&indices, this] ( Index e )
+    {
+      auto u = indices[e];
+      auto v = _edges[e].vertex;
+
+      if( u > v )
+        std::swap( u, v );
+
+      return ( std::uint64_t( u ) << 32 ) | v;
+    };
+
+    std::vector< std::pair<std::uint64_t, Index> > keys( indices.size() );
+
+    for( std::size_t e = 0; e < indices.size(); e++ )
+      keys[e] = std::make_pair( key( static_cast<Index>( e ) ), static_cast<Index>( e ) );
+
+    std::sort( keys.begin(), keys.end() );
+
+    for( std::size_t i = 0; i < keys.size(); )
+    {
+      auto e = keys[i].second;
+
+      if( indices[e] == _edges[e].vertex )
+        throw std::runtime_error( "Faces must not contain degenerate edges" );
+
+      if( i + 1 < keys.size() && keys[i+1].first == keys[i].first )
+      {
+        auto p = keys[i+1].second;
+
+        if( i + 2 < keys.size() && keys[i+2].first == keys[i].first )
+          throw std::runtime_error( "Every edge must be shared by at most two faces" );
+
+        if( indices[e] == indices[p] )
+          throw std::runtime_error( "Faces must be oriented consistently" );
+
+        _edges[e].pair = p;
+        _edges[p].pair = e;
+
+        i += 2;
+      }
+      else
+      {
+        // Boundary edge: the new half-edge points back to the source of
+        // the existing one and does not belong to any face.
+        HalfEdge boundary;
+        boundary.vertex = indices[e];
+        boundary.pair   = e;
+
+        _edges[e].pair  = static_cast<Index>( _edges.size() );
+        _edges.push_back( boundary );
+
+        i += 1;
+      }
+    }
+
+    // Outgoing half-edges -----------------------------------------------
+    //
+    // Traversing the half-edges around a vertex stops at the boundary, so
+    // boundary vertices need to start with the outgoing half-edge whose
+    // pair does not belong to any face.
+
+    for( Index e = 0; e < static_cast<Index>( indices.size() ); e++ )
+    {
+      auto&& vertex = _vertices[ indices[e] ];
+
+      if( vertex.edge == invalid() || _edges[ _edges[e].pair ].face == invalid() )
+        vertex.edge = e;
+    }
+  }
+
+  /** Stores all vertices; the index of a vertex is its ID */
+  std::vector<Vertex> _vertices;
+
+  /** Stores the first half-edge of every face */
+  std::vector<Index> _faces;
+
+  /** Stores all half-edges, followed by all boundary half-edges */
+  std::vector<HalfEdge> _edges;
+};
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
@@ -5,6 +5,8 @@
 
 #include <aleph/topology/BoundaryMatrix.hh>
 
+#include <aleph/utilities/Instrumentation.hh>
+
 #include <algorithm>
 #include <unordered_map>
 
@@ -33,6 +35,8 @@ template <
   using Simplex = typename SimplicialComplex::ValueType;
   using Index   = typename BoundaryMatrix<Representation>::Index;
 
+  utilities::instrumentation::ScopedPhase phase( "makeBoundaryMatrix" );
+
   BoundaryMatrix<Representation> M;
   M.setNumColumns( static_cast<Index>( K.size() ) );
 
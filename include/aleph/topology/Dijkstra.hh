@@ -0,0 +1,293 @@
+#ifndef ALEPH_TOPOLOGY_DIJKSTRA_HH__
+#define ALEPH_TOPOLOGY_DIJKSTRA_HH__
+
+#include <aleph/math/SymmetricMatrix.hh>
+
+#include <aleph/topology/FloydWarshall.hh>
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+namespace detail
+{
+
+/**
+  @class PairingHeap
+  @brief Indexed pairing heap with support for decreasing keys
+
+  This heap stores a subset of the indices \f$0,\dots,n-1\f$ along with
+  their keys. Nodes are stored in contiguous arrays and linked via
+  indices, so no allocations are required after construction. The heap
+  is reusable: after it has been emptied, it may be filled again.
+*/
+
+template <class T> class PairingHeap
+{
+public:
+  using IndexType = std::size_t;
+
+  explicit PairingHeap( IndexType n )
+    : _keys( n )
+    , _child( n, none() )
+    , _sibling( n, none() )
+    , _previous( n, none() )
+    , _contained( n, false )
+  {
+  }
+
+  bool empty() const noexcept         { return _root == none();   }
+  bool contains( IndexType i ) const  { return _contained[i];     }
+  T key( IndexType i ) const          { return _keys[i];          }
+
+  /** Inserts a new index with a given key */
+  void push( IndexType i, T key )
+  {
+    _keys[i]      = key;
+    _child[i]     = none();
+    _sibling[i]   = none();
+    _previous[i]  = none();
+    _contained[i] = true;
+
+    _root = _root == none() ? i : this->link( _root, i );
+  }
+
+  /** Decreases the key of an index that is already stored in the heap */
+  void decrease( IndexType i, T key )
+  {
+    _keys[i] = key;
+
+    if( i == _root )
+      return;
+
+    // Cut the sub-tree of the node and merge it with the root again.
+    auto p = _previous[i];
+
+    if( _child[p] == i )
+      _child[p] = _sibling[i];
+    else
+      _sibling[p] = _sibling[i];
+
+    if( _sibling[i] != none() )
+      _previous[ _sibling[i] ] = p;
+
+    _sibling[i]  = none();
+    _previous[i] = none();
+
+    _root = this->link( _root, i );
+  }
+
+  /** Removes the index with the minimum key and returns it */
+  IndexType pop()
+  {
+    if( this->empty() )
+      throw std::runtime_error( "Unable to remove element from empty heap" );
+
+    auto r         = _root;
+    _contained[r]  = false;
+
+    // Two-pass merging: first, children are linked in pairs from left
+    // to right. Afterwards, the resulting trees are linked from right
+    // to left.
+    _trees.clear();
+
+    for( auto c = _child[r]; c != none(); )
+    {
+      auto next      = _sibling[c];
+      _sibling[c]    = none();
+      _previous[c]   = none();
+
+      _trees.push_back( c );
+      c = next;
+    }
+
+    _child[r] = none();
+
+    std::size_t m = 0;
+    for( std::size_t k = 0; k + 1 < _trees.size(); k += 2 )
+      _trees[m++] = this->link( _trees[k], _trees[k+1] );
+
+    if( _trees.size() % 2 == 1 )
+      _trees[m++] = _trees.back();
+
+    _root = none();
+
+    while( m > 0 )
+    {
+      --m;
+      _root = _root == none() ? _trees[m] : this->link( _trees[m], _root );
+    }
+
+    return r;
+  }
+
+private:
+
+  static constexpr IndexType none() { return std::numeric_limits<IndexType>::max(); }
+
+  /**
+    Links two trees by making the root with the larger key the leftmost
+    child of the other root. Returns the new root.
+  */
+
+  IndexType link( IndexType a, IndexType b )
+  {
+    if( _keys[b] < _keys[a] )
+      std::swap( a, b );
+
+    _sibling[b]  = _child[a];
+    _previous[b] = a;
+
+    if( _child[a] != none() )
+      _previous[ _child[a] ] = b;
+
+    _child[a] = b;
+    return a;
+  }
+
+  std::vector<T> _keys;
+
+  std::vector<IndexType> _child;
+  std::vector<IndexType> _sibling;
+
+  /** Parent for the leftmost child; left sibling for all other nodes */
+  std::vector<IndexType> _previous;
+
+  std::vector<bool> _contained;
+  std::vector<IndexType> _trees;
+
+  IndexType _root = none();
+};
+
+} // namespace detail
+
+/**
+  Calculates the matrix of pairwise distances between *all* vertices of
+  a weighted simplicial complex by running Dijkstra's algorithm from
+  every vertex. This is preferable to the Floyd--Warshall algorithm for
+  sparse graphs. Individual sources are processed in parallel if OpenMP
+  is available.
+
+  Edge weights must be non-negative.
+
+  @param K Simplicial complex
+
+  @param w Default weight to assign if a 1-simplex does not have a
+           weight assigned already.
+
+  @returns Matrix of distances. The indexing of the matrix follows
+           the order in which the *vertices* of the simplicial complex
+           are encountered.
+*/
+
+template <class SimplicialComplex> auto dijkstra( const SimplicialComplex& K, typename SimplicialComplex::ValueType::DataType w = 0 )
+  -> aleph::math::SymmetricMatrix<
+      typename SimplicialComplex::ValueType::DataType,
+      typename SimplicialComplex::ValueType::VertexType>
+{
+  using Simplex    = typename SimplicialComplex::ValueType;
+  using DataType   = typename Simplex::DataType;
+  using VertexType = typename Simplex::VertexType;
+  using Matrix     = aleph::math::SymmetricMatrix<DataType, VertexType>;
+
+  auto graph   = detail::weightedEdges( K, w );
+  auto n       = graph.first;
+  auto&& edges = graph.second;
+
+  // Compressed adjacency lists ----------------------------------------
+
+  std::vector<std::size_t> offsets( n + 1, 0 );
+  std::vector< std::pair<std::size_t, DataType> > neighbours( 2 * edges.size() );
+
+  for( auto&& edge : edges )
+  {
+    if( edge.second < DataType() )
+      throw std::runtime_error( "Dijkstra's algorithm requires non-negative weights" );
+
+    offsets[ edge.first.first  + 1 ]++;
+    offsets[ edge.first.second + 1 ]++;
+  }
+
+  for( std::size_t i = 0; i < n; i++ )
+    offsets[i+1] += offsets[i];
+
+  {
+    auto position = offsets;
+
+    for( auto&& edge : edges )
+    {
+      auto u = edge.first.first;
+      auto v = edge.first.second;
+
+      neighbours[ position[u]++ ] = std::make_pair( v, edge.second );
+      neighbours[ position[v]++ ] = std::make_pair( u, edge.second );
+    }
+  }
+
+  Matrix M( static_cast<VertexType>( n ) );
+
+  // Every source only writes the entries of the upper triangular part
+  // of its row, so sources may be processed independently.
+  #pragma omp parallel
+  {
+    detail::PairingHeap<DataType> heap( n );
+    std::vector<DataType> distances( n );
+    std::vector<bool> settled( n );
+
+    #pragma omp for schedule(dynamic)
+    for( std::size_t s = 0; s < n; s++ )
+    {
+      std::fill( distances.begin(), distances.end(), detail::unreachable<DataType>() );
+      std::fill( settled.begin(), settled.end(), false );
+
+      distances[s] = DataType(0);
+      heap.push( s, DataType(0) );
+
+      while( !heap.empty() )
+      {
+        auto u     = heap.pop();
+        settled[u] = true;
+
+        for( auto i = offsets[u]; i < offsets[u+1]; i++ )
+        {
+          auto v = neighbours[i].first;
+
+          if( settled[v] )
+            continue;
+
+          auto d = detail::addDistances( distances[u], neighbours[i].second );
+
+          if( d < distances[v] )
+          {
+            distances[v] = d;
+
+            if( heap.contains(v) )
+              heap.decrease( v, d );
+            else
+              heap.push( v, d );
+          }
+        }
+      }
+
+      for( std::size_t t = s; t < n; t++ )
+        M( VertexType(s), VertexType(t) ) = distances[t];
+    }
+  }
+
+  return M;
+}
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef ALEPH_TOPOLOGY_EDGE_COLLAPSE_HH__
+#define ALEPH_TOPOLOGY_EDGE_COLLAPSE_HH__
+
+#include <aleph/utilities/Instrumentation.hh>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+namespace detail
+{
+
+/**
+  @class EdgeCollapser
+  @brief Auxiliary class for collapsing the edges of a filtered graph
+
+  Stores the closed neighbourhood of every vertex of a filtered graph
+  as a list of neighbours that is sorted by vertex index. Every entry
+  contains the rank of the corresponding edge in the filtration, i.e.
+  the index of its weight among all distinct weights. The neighbour
+  lists always describe the *current* filtration, so they are updated
+  whenever an edge is being moved or removed.
+*/
+
+class EdgeCollapser
+{
+public:
+  using Neighbour = std::pair<std::size_t, std::size_t>;
+
+  /** Rank that is used to indicate that an edge has been removed */
+  static constexpr std::size_t removed = std::numeric_limits<std::size_t>::max();
+
+  explicit EdgeCollapser( std::size_t n )
+    : _neighbours( n )
+  {
+    // Every vertex is part of its own closed neighbourhood from the
+    // very beginning of the filtration.
+    for( std::size_t u = 0; u < n; u++ )
+      _neighbours[u].push_back( std::make_pair( u, std::size_t(0) ) );
+  }
+
+  void addEdge( std::size_t u, std::size_t v, std::size_t rank )
+  {
+    _neighbours[u].push_back( std::make_pair( v, rank ) );
+    _neighbours[v].push_back( std::make_pair( u, rank ) );
+  }
+
+  /** Prepares the neighbour lists after all edges have been added */
+  void finalize()
+  {
+    for( auto&& neighbours : _neighbours )
+      std::sort( neighbours.begin(), neighbours.end() );
+  }
+
+  /**
+    Collapses an edge of the filtration, starting from its current rank.
+    The edge is delayed as long as it is dominated by a vertex, i.e. as
+    long as there is a common neighbour whose closed neighbourhood
+    contains the neighbourhood of the edge. This does not change the
+    persistent homology of the flag filtration. If the edge remains
+    dominated until the end of the filtration, it is removed.
+
+    @returns New rank of the edge, or #removed
+  */
+
+  std::size_t collapse( std::size_t u, std::size_t v, std::size_t rank )
+  {
+    std::vector<std::size_t> common;
+    std::vector<Neighbour> later;
+
+    this->commonNeighbours( u, v, rank, common, later );
+
+    // Common neighbours that appear later in the filtration are handled
+    // in the order of their appearance.
+    std::sort( later.begin(), later.end() );
+
+    auto itLater = later.begin();
+
+    while( true )
+    {
+      auto itDominator = std::find_if( common.begin(), common.end(),
+        [&] ( std::size_t w )
+        {
+          return this->isDominatedBy( common, w, rank );
+        }
+      );
+
+      if( itDominator == common.end() )
+        break;
+
+      auto dominator = *itDominator;
+      bool dominated = true;
+
+      // The neighbourhood of the dominator only grows, so the edge stays
+      // dominated until a new common neighbour appears that is not also
+      // a neighbour of the dominator.
+      while( dominated )
+      {
+        if( itLater == later.end() )
+        {
+          this->remove( u, v );
+          return removed;
+        }
+
+        rank = itLater->first;
+
+        for( ; itLater != later.end() && itLater->first == rank; ++itLater )
+        {
+          auto w = itLater->second;
+
+          if( !this->isNeighbour( dominator, w, rank ) )
+            dominated = false;
+
+          common.insert( std::lower_bound( common.begin(), common.end(), w ), w );
+        }
+      }
+    }
+
+    this->update( u, v, rank );
+    return rank;
+  }
+
+private:
+
+  /**
+    Calculates the common neighbours of two vertices. The neighbours that
+    are present at the given rank are stored in a sorted list, while all
+    other neighbours are stored along with the rank at which they become
+    common neighbours.
+  */
+
+  void commonNeighbours( std::size_t u, std::size_t v, std::size_t rank,
+                         std::vector<std::size_t>& common,
+                         std::vector<Neighbour>& later ) const
+  {
+    auto itU = _neighbours[u].begin();
+    auto itV = _neighbours[v].begin();
+
+    while( itU != _neighbours[u].end() && itV != _neighbours[v].end() )
+    {
+      if( itU->first < itV->first )
+        ++itU;
+      else if( itV->first < itU->first )
+        ++itV;
+      else
+      {
+        auto w = itU->first;
+
+        if( w != u && w != v )
+        {
+          auto r = std::max( itU->second, itV->second );
+
+          if( r <= rank )
+            common.push_back( w );
+          else
+            later.push_back( std::make_pair( r, w ) );
+        }
+
+        ++itU;
+        ++itV;
+      }
+    }
+  }
+
+  /**
+    Checks whether all vertices of a sorted list are contained in the
+    closed neighbourhood of a vertex at the given rank.
+  */
+
+  bool isDominatedBy( const std::vector<std::size_t>& common, std::size_t w, std::size_t rank ) const
+  {
+    auto&& neighbours = _neighbours[w];
+    auto itNeighbour  = neighbours.begin();
+
+    for( auto&& x : common )
+    {
+      while( itNeighbour != neighbours.end() && itNeighbour->first < x )
+        ++itNeighbour;
+
+      if( itNeighbour == neighbours.end() || itNeighbour->first != x || itNeighbour->second > rank )
+        return false;
+    }
+
+    return true;
+  }
+
+  bool isNeighbour( std::size_t u, std::size_t v, std::size_t rank ) const
+  {
+    auto it = this->find( u, v );
+    return it != _neighbours[u].end() && it->second <= rank;
+  }
+
+  void update( std::size_t u, std::size_t v, std::size_t rank )
+  {
+    this->find( u, v )->second = rank;
+    this->find( v, u )->second = rank;
+  }
+
+  void remove( std::size_t u, std::size_t v )
+  {
+    _neighbours[u].erase( this->find( u, v ) );
+    _neighbours[v].erase( this->find( v, u ) );
+  }
+
+  std::vector<Neighbour>::iterator find( std::size_t u, std::size_t v )
+  {
+    auto it = std::lower_bound( _neighbours[u].begin(), _neighbours[u].end(), std::make_pair( v, std::size_t(0) ) );
+    return it != _neighbours[u].end() && it->first == v ? it : _neighbours[u].end();
+  }
+
+  std::vector<Neighbour>::const_iterator find( std::size_t u, std::size_t v ) const
+  {
+    auto it = std::lower_bound( _neighbours[u].begin(), _neighbours[u].end(), std::make_pair( v, std::size_t(0) ) );
+    return it != _neighbours[u].end() && it->first == v ? it : _neighbours[u].end();
+  }
+
+  std::vector< std::vector<Neighbour> > _neighbours;
+};
+
+} // namespace detail
+
+/**
+  Collapses the edges of a filtered graph, i.e. a 1-dimensional
+  simplicial complex in filtration order, without changing the
+  persistent homology of its flag filtration. This is meant to be
+  used *before* expanding the graph with a Vietoris--Rips expander,
+  which is considerably faster for the smaller graph.
+
+  Edges are processed in the reverse order of the filtration. An edge
+  that is dominated by one of its common neighbours is moved to a later
+  weight of the filtration, or removed altogether if it is dominated in
+  the full graph. The weights of all remaining edges are taken from the
+  weights of the original filtration. Vertices are never removed.
+
+  The implementation follows the papers:
+
+  > Edge Collapse and Persistence of Flag Complexes
+  > Jean-Daniel Boissonnat and Siddharth Pritam
+  > Proceedings of the 36th International Symposium on Computational Geometry, 2020
+
+  > Swap, Shift and Trim to Edge Collapse a Filtration
+  > Marc Glisse and Siddharth Pritam
+  > Proceedings of the 38th International Symposium on Computational Geometry, 2022
+
+  @param K Filtered graph; the simplicial complex must be sorted
+  according to a filtration, which may be either ascending or
+  descending
+
+  @returns Filtered graph whose flag filtration has the same persistent
+  homology as the flag filtration of the original graph. The graph is
+  sorted in filtration order.
+*/
+
+template <class SimplicialComplex> SimplicialComplex collapseEdges( const SimplicialComplex& K )
+{
+  using Simplex    = typename SimplicialComplex::ValueType;
+  using DataType   = typename Simplex::DataType;
+  using VertexType = typename Simplex::VertexType;
+
+  utilities::instrumentation::ScopedPhase phase( "edgeCollapse" );
+
+  std::vector<Simplex> simplices( K.begin(), K.end() );
+
+  // Use the ranks of all weights instead of the weights themselves, so
+  // that the filtration order does not have to be known.
+  std::vector<std::size_t> ranks( simplices.size() );
+  std::vector<DataType> values;
+
+  for( std::size_t i = 0; i < simplices.size(); i++ )
+  {
+    if( simplices[i].dimension() > 1 )
+      throw std::runtime_error( "Edge collapses require a 1-dimensional simplicial complex" );
+
+    if( i == 0 || simplices[i].data() != simplices[i-1].data() )
+      values.push_back( simplices[i].data() );
+
+    ranks[i] = values.size() - 1;
+  }
+
+  std::unordered_map<VertexType, std::size_t> vertexToIndex;
+
+  {
+    std::set<VertexType> vertices;
+    K.vertices( std::inserter( vertices, vertices.begin() ) );
+
+    std::size_t index = 0;
+    for( auto&& vertex : vertices )
+      vertexToIndex[vertex] = index++;
+  }
+
+  detail::EdgeCollapser collapser( vertexToIndex.size() );
+  std::vector<std::size_t> edges;
+
+  for( std::size_t i = 0; i < simplices.size(); i++ )
+  {
+    if( simplices[i].dimension() == 1 )
+    {
+      auto&& s = simplices[i];
+
+      collapser.addEdge( vertexToIndex.at( s[0] ), vertexToIndex.at( s[1] ), ranks[i] );
+      edges.push_back( i );
+    }
+  }
+
+  collapser.finalize();
+
+  std::int64_t numRemovedEdges = 0;
+
+  for( auto it = edges.rbegin(); it != edges.rend(); ++it )
+  {
+    auto&& s = simplices[*it];
+    ranks[*it]
+      = collapser.collapse( vertexToIndex.at( s[0] ), vertexToIndex.at( s[1] ), ranks[*it] );
+
+    if( ranks[*it] == detail::EdgeCollapser::removed )
+      ++numRemovedEdges;
+  }
+
+  utilities::instrumentation::count( "edge_collapse_removed_edges", numRemovedEdges );
+
+  // Sort the remaining simplices by their new ranks. Vertices precede
+  // edges of the same rank, while the original order is retained for
+  // all other ties.
+  std::vector<std::size_t> indices;
+  indices.reserve( simplices.size() );
+
+  for( std::size_t i = 0; i < simplices.size(); i++ )
+    if( ranks[i] != detail::EdgeCollapser::removed )
+      indices.push_back( i );
+
+  std::stable_sort( indices.begin(), indices.end(),
+    [&] ( std::size_t i, std::size_t j )
+    {
+      if( ranks[i] == ranks[j] )
+        return simplices[i].dimension() < simplices[j].dimension();
+      else
+        return ranks[i] < ranks[j];
+    }
+  );
+
+  std::vector<Simplex> result;
+  result.reserve( indices.size() );
+
+  for( auto&& i : indices )
+  {
+    auto s = simplices[i];
+    s.setData( values[ ranks[i] ] );
+
+    result.push_back( s );
+  }
+
+  return SimplicialComplex( result.begin(), result.end() );
+}
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
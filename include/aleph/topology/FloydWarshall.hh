@@ -1,8 +1,13 @@
 #ifndef ALEPH_TOPOLOGY_FLOYD_WARSHALL_HH__
 #define ALEPH_TOPOLOGY_FLOYD_WARSHALL_HH__
 
+#include <algorithm>
 #include <limits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
 
 #include <aleph/math/SymmetricMatrix.hh>
 
@@ -12,22 +17,149 @@ namespace aleph
 namespace topology
 {
 
+namespace detail
+{
+
+/**
+  Returns the value that is used to represent the distance between two
+  unconnected vertices. This is either infinity or, if the data type
+  does not support it, the maximum value.
+*/
+
+template <class T> constexpr T unreachable()
+{
+  return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+}
+
+/**
+  Adds two distances. If the data type does not support infinity, the
+  addition saturates in order to prevent overflows for unreachable
+  vertices.
+*/
+
+template <class T> inline T addDistances( T a, T b )
+{
+  if( std::numeric_limits<T>::has_infinity )
+    return a + b;
+
+  if( a == unreachable<T>() || b == unreachable<T>() )
+    return unreachable<T>();
+
+  return a + b;
+}
+
+/**
+  Extracts the weighted edges of a simplicial complex. Vertices are
+  mapped to indices following the order in which the *vertices* of
+  the simplicial complex are encountered.
+
+  @param K Simplicial complex
+
+  @param w Default weight to assign if a 1-simplex does not have a
+           weight assigned already.
+
+  @returns Number of vertices and the list of weighted edges
+*/
+
+template <class SimplicialComplex> auto weightedEdges( const SimplicialComplex& K, typename SimplicialComplex::ValueType::DataType w )
+  -> std::pair<
+      std::size_t,
+      std::vector< std::pair< std::pair<std::size_t, std::size_t>, typename SimplicialComplex::ValueType::DataType > > >
+{
+  using Simplex    = typename SimplicialComplex::ValueType;
+  using DataType   = typename Simplex::DataType;
+  using VertexType = typename Simplex::VertexType;
+
+  std::unordered_map<VertexType, std::size_t> vertex_to_index;
+
+  {
+    std::size_t index = 0;
+    for( auto&& s : K )
+    {
+      if( s.dimension() == 0 )
+        vertex_to_index[ s[0] ] = index++;
+    }
+  }
+
+  std::vector< std::pair< std::pair<std::size_t, std::size_t>, DataType > > edges;
+
+  for( auto&& s : K )
+  {
+    if( s.dimension() == 1 )
+    {
+      auto iu = vertex_to_index.at( s[0] );
+      auto iv = vertex_to_index.at( s[1] );
+
+      edges.push_back( std::make_pair( std::make_pair( iu, iv ), s.data() != DataType() ? s.data() : w ) );
+    }
+  }
+
+  return std::make_pair( vertex_to_index.size(), edges );
+}
+
+/**
+  Performs the Floyd--Warshall update of block \f$C\f$ with the help of
+  blocks \f$A\f$ and \f$B\f$. All blocks are part of a dense row-major
+  matrix with \f$n\f$ columns. The update uses all pivot indices of the
+  block that starts at \f$k_0\f$.
+*/
+
+template <class T> void updateBlock( T* D, std::size_t n,
+                                     std::size_t i0, std::size_t i1,
+                                     std::size_t j0, std::size_t j1,
+                                     std::size_t k0, std::size_t k1 )
+{
+  for( std::size_t k = k0; k < k1; k++ )
+  {
+    const T* __restrict Dk = D + k * n;
+
+    for( std::size_t i = i0; i < i1; i++ )
+    {
+      // Row k cannot change when being updated with itself because the
+      // diagonal is zero. Skipping it ensures that both rows are always
+      // disjoint, which permits vectorizing the inner loop.
+      if( i == k )
+        continue;
+
+      T* __restrict Di = D + i * n;
+      auto dik         = Di[k];
+
+      if( dik == unreachable<T>() )
+        continue;
+
+      for( std::size_t j = j0; j < j1; j++ )
+        Di[j] = std::min( Di[j], addDistances( dik, Dk[j] ) );
+    }
+  }
+}
+
+} // namespace detail
+
 /**
   Implements the Floyd--Warshall algorithm for a weighted simplicial
   complex. The algorithm calculates the matrix of pairwise distances
   between *all* nodes.
 
+  This implementation uses a blocked variant of the algorithm, which
+  operates on tiles of the distance matrix that fit into the cache.
+  Every round consists of three phases: the diagonal tile is updated
+  first, followed by the tiles in the same row and column, and finally
+  the remaining tiles. Tiles of the last two phases are independent of
+  each other and will be updated in parallel if OpenMP is available.
+
   @param K Simplicial complex
 
   @param w Default weight to assign in a 1-simplex does not have a
            weight assigned already.
 
+  @param blockSize Size of the tiles of the distance matrix
+
   @returns Matrix of distances. The indexing of the matrix follows
            the order in which the *vertices* of the simplicial are
            encountered.
 */
 
-template <class SimplicialComplex> auto floydWarshall( const SimplicialComplex& K, typename SimplicialComplex::ValueType::DataType w = 0 )
+template <class SimplicialComplex> auto floydWarshall( const SimplicialComplex& K, typename SimplicialComplex::ValueType::DataType w = 0, std::size_t blockSize = 64 )
   -> aleph::math::SymmetricMatrix<
       typename SimplicialComplex::ValueType::DataType,
       typename SimplicialComplex::ValueType::VertexType>
@@ -38,61 +170,83 @@ template <class SimplicialComplex> auto floydWarshall( const SimplicialComplex&
   using VertexType = typename Simplex::VertexType;
   using Matrix     = aleph::math::SymmetricMatrix<DataType, VertexType>;
 
-  // Set up vertex-to-index lookup table -------------------------------
-
-  std::unordered_map<Simplex, VertexType> vertex_to_index;
+  auto graph  = detail::weightedEdges( K, w );
+  auto n      = graph.first;
+  auto&& edges = graph.second;
 
-  {
-    VertexType index = VertexType();
-    for( auto&& s : K )
-    {
-      if( s.dimension() == 0 )
-        vertex_to_index[s] = index++;
-    }
-  }
-
-  // Set up matrix -----------------------------------------------------
+  // Set up dense matrix -----------------------------------------------
   //
   // First, all distances are initialized to either zero (self) or
   // infinity (all others). Next, edge weights of the complex will
   // be added to the matrix.
 
-  auto n = vertex_to_index.size();
+  std::vector<DataType> D( n * n, detail::unreachable<DataType>() );
 
-  Matrix M( static_cast<VertexType>( n ) );
+  for( std::size_t i = 0; i < n; i++ )
+    D[i * n + i] = DataType(0);
 
-  for( VertexType i = VertexType(0); i < VertexType(n); i++ )
+  for( auto&& edge : edges )
   {
-    M(i,i) = DataType(0);
-    for( auto j = i+1; j < VertexType(n); j++ )
-      M(i,j) = std::numeric_limits<DataType>::has_infinity ? std::numeric_limits<DataType>::infinity() : std::numeric_limits<DataType>::max();
+    auto u = edge.first.first;
+    auto v = edge.first.second;
+
+    D[u * n + v] = edge.second;
+    D[v * n + u] = edge.second;
   }
 
-  for( auto&& s : K )
+  // Blocked Floyd--Warshall -------------------------------------------
+
+  blockSize = std::max( blockSize, std::size_t(1) );
+
+  auto numBlocks = ( n + blockSize - 1 ) / blockSize;
+  auto data      = D.data();
+
+  auto first = [&] ( std::size_t b ) { return b * blockSize; };
+  auto last  = [&] ( std::size_t b ) { return std::min( ( b + 1 ) * blockSize, n ); };
+
+  for( std::size_t kb = 0; kb < numBlocks; kb++ )
   {
-    if( s.dimension() == 1 )
+    auto k0 = first( kb );
+    auto k1 = last( kb );
+
+    // Phase 1: diagonal tile
+    detail::updateBlock( data, n, k0, k1, k0, k1, k0, k1 );
+
+    // Phase 2: tiles in the same row and in the same column as the
+    // diagonal tile
+    #pragma omp parallel for schedule(dynamic)
+    for( std::size_t b = 0; b < numBlocks; b++ )
     {
-      auto&& u  = s[0];
-      auto&& v  = s[1];
-      auto&& iu = vertex_to_index.at(u);
-      auto&& iv = vertex_to_index.at(v);
+      if( b == kb )
+        continue;
 
-      M(iu, iv) = s.data() != DataType() ? s.data() : w;
+      detail::updateBlock( data, n, k0, k1, first(b), last(b), k0, k1 );
+      detail::updateBlock( data, n, first(b), last(b), k0, k1, k0, k1 );
     }
-  }
 
-  for( VertexType k = VertexType(0); k < VertexType(n); k++ )
-  {
-    for( VertexType i = VertexType(0); i < VertexType(n); i++ )
+    // Phase 3: all remaining tiles
+    #pragma omp parallel for schedule(dynamic)
+    for( std::size_t ib = 0; ib < numBlocks; ib++ )
     {
-      for( auto j = i+1; j < VertexType(n); j++ )
+      if( ib == kb )
+        continue;
+
+      for( std::size_t jb = 0; jb < numBlocks; jb++ )
       {
-        if( M(i,j) > M(i,k) + M(k,j) )
-          M(i,j) = M(i,k) + M(k,j);
+        if( jb == kb )
+          continue;
+
+        detail::updateBlock( data, n, first(ib), last(ib), first(jb), last(jb), k0, k1 );
       }
     }
   }
 
+  Matrix M( static_cast<VertexType>( n ) );
+
+  for( std::size_t i = 0; i < n; i++ )
+    for( std::size_t j = i; j < n; j++ )
+      M( VertexType(i), VertexType(j) ) = D[i * n + j];
+
   return M;
 }
 
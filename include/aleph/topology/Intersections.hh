@@ -7,8 +7,11 @@
 #include <iterator>
 #include <set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <cstddef>
+
 namespace aleph
 {
 
@@ -191,6 +194,182 @@ template <class SimplicialComplex, class Simplex> Simplex lastLexicographicalInt
   return result;
 }
 
+/**
+  @class StratumIndex
+  @brief Answers intersection queries with a fixed simplicial complex
+
+  Stores the simplices of a simplicial complex, e.g. a stratum of a
+  stratification, in a trie over their sorted vertex tuples. Children
+  of every node are stored contiguously and sorted by their vertex, so
+  the trie consists of a few flat arrays only.
+
+  Given a simplex, the index determines the dimension of its largest
+  face that is contained in the complex. This is the dimension of the
+  last lexicographical intersection, but it does not require creating
+  and hashing all subsets of the simplex. Since the trie only contains
+  paths that belong to simplices of the complex, the search visits at
+  most all faces of the simplex that are part of the complex.
+
+  @tparam Vertex Vertex type of the simplices
+*/
+
+template <class Vertex> class StratumIndex
+{
+public:
+
+  /** Creates an empty index */
+  StratumIndex() = default;
+
+  /** Creates an index of all simplices of a simplicial complex */
+  template <class SimplicialComplex> explicit StratumIndex( const SimplicialComplex& K )
+  {
+    std::vector< std::vector<Vertex> > tuples;
+    tuples.reserve( K.size() );
+
+    for( auto&& s : K )
+    {
+      std::vector<Vertex> tuple( s.begin(), s.end() );
+      std::sort( tuple.begin(), tuple.end() );
+
+      tuples.push_back( tuple );
+    }
+
+    // Since the tuples are sorted lexicographically, the children of
+    // every node are created in ascending order, and a vertex can only
+    // be shared with the last child that has been created.
+    std::sort( tuples.begin(), tuples.end() );
+
+    std::vector< std::vector< std::pair<Vertex, std::size_t> > > children( 1 );
+    _terminal.assign( 1, false );
+
+    for( auto&& tuple : tuples )
+    {
+      std::size_t node = 0;
+
+      for( auto&& v : tuple )
+      {
+        if( children[node].empty() || children[node].back().first != v )
+        {
+          children[node].push_back( std::make_pair( v, children.size() ) );
+          children.push_back( {} );
+          _terminal.push_back( false );
+        }
+
+        node = children[node].back().second;
+      }
+
+      _terminal[node] = true;
+    }
+
+    _offsets.reserve( children.size() + 1 );
+    _offsets.push_back( 0 );
+
+    for( auto&& c : children )
+    {
+      for( auto&& pair : c )
+      {
+        _vertices.push_back( pair.first );
+        _nodes.push_back( pair.second );
+      }
+
+      _offsets.push_back( _vertices.size() );
+    }
+  }
+
+  /** Checks whether a simplex is contained in the indexed complex */
+  template <class Simplex> bool contains( const Simplex& s ) const
+  {
+    std::vector<Vertex> vertices( s.begin(), s.end() );
+    std::sort( vertices.begin(), vertices.end() );
+
+    std::size_t node = 0;
+
+    for( auto&& v : vertices )
+    {
+      node = this->child( node, v );
+
+      if( node == 0 )
+        return false;
+    }
+
+    return !vertices.empty() && _terminal[node];
+  }
+
+  /**
+    Calculates the dimension of the largest face of a simplex that is
+    contained in the indexed complex.
+
+    @param s Simplex
+
+    @returns Dimension of the intersection, or -1 if it is empty
+  */
+
+  template <class Simplex> long maximumIntersectionDimension( const Simplex& s ) const
+  {
+    if( _offsets.empty() )
+      return -1;
+
+    std::vector<Vertex> vertices( s.begin(), s.end() );
+    std::sort( vertices.begin(), vertices.end() );
+
+    std::size_t best = 0;
+    this->search( vertices, 0, 0, 0, best );
+
+    return static_cast<long>( best ) - 1;
+  }
+
+private:
+
+  /** Returns the child of a node for a given vertex, or zero if it does not exist */
+  std::size_t child( std::size_t node, Vertex v ) const
+  {
+    auto begin = _vertices.begin() + static_cast<std::ptrdiff_t>( _offsets[node]   );
+    auto end   = _vertices.begin() + static_cast<std::ptrdiff_t>( _offsets[node+1] );
+    auto it    = std::lower_bound( begin, end, v );
+
+    if( it != end && *it == v )
+      return _nodes[ static_cast<std::size_t>( std::distance( _vertices.begin(), it ) ) ];
+    else
+      return 0;
+  }
+
+  /**
+    Searches the largest subset of the vertices, starting from a given
+    position, that extends the current node to a simplex of the complex.
+    The search stops as soon as the remaining vertices cannot improve the
+    best size found so far.
+  */
+
+  void search( const std::vector<Vertex>& vertices, std::size_t node, std::size_t position, std::size_t depth, std::size_t& best ) const
+  {
+    if( _terminal[node] )
+      best = std::max( best, depth );
+
+    for( auto i = position; i < vertices.size(); i++ )
+    {
+      if( depth + vertices.size() - i <= best )
+        break;
+
+      auto next = this->child( node, vertices[i] );
+
+      if( next != 0 )
+        this->search( vertices, next, i + 1, depth + 1, best );
+    }
+  }
+
+  /** Offsets of the children of every node */
+  std::vector<std::size_t> _offsets;
+
+  /** Vertices of all children, sorted for every node */
+  std::vector<Vertex> _vertices;
+
+  /** Indices of all children */
+  std::vector<std::size_t> _nodes;
+
+  /** Indicates whether the path to a node is a simplex of the complex */
+  std::vector<bool> _terminal;
+};
+
 } // namespace topology
 
 } // namespace aleph
@@ -1,12 +1,18 @@
 #ifndef ALEPH_TOPOLOGY_MAXIMAL_CLIQUES_HH__
 #define ALEPH_TOPOLOGY_MAXIMAL_CLIQUES_HH__
 
+#include <algorithm>
+#include <bitset>
 #include <iterator>
 #include <set>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <cstddef>
+#include <cstdint>
+
 #include <aleph/math/SparseMatrix.hh>
 
 #include <aleph/utilities/UnorderedSetOperations.hh>
@@ -19,6 +25,144 @@ namespace aleph
 namespace topology
 {
 
+/**
+  @class Cliques
+  @brief Flat, contiguous storage of a collection of cliques
+
+  Stores the vertices of all cliques in a single array, along with the
+  offsets at which the individual cliques start. This is considerably
+  more efficient than storing every clique as a separate container,
+  in particular for graphs with millions of cliques.
+
+  Iterating over the collection yields lightweight ranges that can be
+  used just like any other container of vertices.
+*/
+
+template <class VertexType> class Cliques
+{
+public:
+  using size_type      = std::size_t;
+  using VertexIterator = typename std::vector<VertexType>::const_iterator;
+
+  /** Lightweight view of a single clique */
+  class Range
+  {
+  public:
+    Range( VertexIterator begin, VertexIterator end )
+      : _begin( begin )
+      , _end( end )
+    {
+    }
+
+    VertexIterator begin() const noexcept { return _begin; }
+    VertexIterator end()   const noexcept { return _end;   }
+
+    size_type size() const noexcept
+    {
+      return size_type( std::distance( _begin, _end ) );
+    }
+
+  private:
+    VertexIterator _begin;
+    VertexIterator _end;
+  };
+
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Range;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const Range*;
+    using reference         = Range;
+
+    const_iterator( const Cliques* cliques, size_type index )
+      : _cliques( cliques )
+      , _index( index )
+    {
+    }
+
+    Range operator*() const { return ( *_cliques )[_index]; }
+
+    const_iterator& operator++()
+    {
+      ++_index;
+      return *this;
+    }
+
+    const_iterator operator++( int )
+    {
+      auto it = *this;
+      ++_index;
+      return it;
+    }
+
+    bool operator==( const const_iterator& other ) const noexcept { return _cliques == other._cliques && _index == other._index; }
+    bool operator!=( const const_iterator& other ) const noexcept { return !this->operator==( other ); }
+
+  private:
+    const Cliques* _cliques;
+    size_type _index;
+  };
+
+  Cliques()
+    : _offsets( 1, size_type() )
+  {
+  }
+
+  /** Adds a new clique, specified by a range of vertices */
+  template <class InputIterator> void add( InputIterator begin, InputIterator end )
+  {
+    _vertices.insert( _vertices.end(), begin, end );
+    _offsets.push_back( _vertices.size() );
+  }
+
+  /** Appends all cliques of another collection */
+  void add( const Cliques& other )
+  {
+    for( auto&& clique : other )
+      this->add( clique.begin(), clique.end() );
+  }
+
+  Range operator[]( size_type i ) const
+  {
+    return Range( _vertices.begin() + std::ptrdiff_t( _offsets[i] ),
+                  _vertices.begin() + std::ptrdiff_t( _offsets[i+1] ) );
+  }
+
+  const_iterator begin() const { return const_iterator( this, 0 );            }
+  const_iterator end()   const { return const_iterator( this, this->size() ); }
+
+  size_type size() const noexcept { return _offsets.size() - 1; }
+  bool empty()     const noexcept { return this->size() == 0;   }
+
+  /** Returns the vertices of all cliques, stored contiguously */
+  const std::vector<VertexType>& vertices() const noexcept { return _vertices; }
+
+  /** Returns the offsets of all cliques; the last one is a sentinel */
+  const std::vector<size_type>& offsets() const noexcept { return _offsets; }
+
+  /**
+    Converts the collection into the representation that is used by
+    the other clique enumeration functions.
+  */
+
+  std::vector< std::set<VertexType> > toSets() const
+  {
+    std::vector< std::set<VertexType> > result;
+    result.reserve( this->size() );
+
+    for( auto&& clique : *this )
+      result.emplace_back( clique.begin(), clique.end() );
+
+    return result;
+  }
+
+private:
+  std::vector<VertexType> _vertices;
+  std::vector<size_type>  _offsets;
+};
+
 namespace detail
 {
 
@@ -204,6 +348,506 @@ void enumerateBronKerbosch( std::unordered_set<VertexType>& C,
   }
 }
 
+
+/**
+  Adjacency structure for the enumeration of cliques with degeneracy
+  ordering. Vertices are mapped to contiguous indices. The neighbours
+  of every vertex are stored as a sorted array.
+*/
+
+template <class VertexType> struct CompactGraph
+{
+  using IndexType = std::uint32_t;
+
+  std::vector<VertexType> vertices;
+  std::vector<std::size_t> offsets;
+  std::vector<IndexType> neighbours;
+
+  std::size_t degree( IndexType v ) const noexcept
+  {
+    return offsets[v+1] - offsets[v];
+  }
+
+  const IndexType* begin( IndexType v ) const noexcept { return neighbours.data() + offsets[v];   }
+  const IndexType* end( IndexType v )   const noexcept { return neighbours.data() + offsets[v+1]; }
+
+  bool adjacent( IndexType u, IndexType v ) const
+  {
+    return std::binary_search( this->begin(u), this->end(u), v );
+  }
+};
+
+template <class Simplex> auto makeCompactGraph( const SimplicialComplex<Simplex>& K ) -> CompactGraph<typename Simplex::VertexType>
+{
+  using VertexType = typename Simplex::VertexType;
+  using Graph      = CompactGraph<VertexType>;
+  using IndexType  = typename Graph::IndexType;
+
+  Graph G;
+
+  K.vertices( std::back_inserter( G.vertices ) );
+
+  std::sort( G.vertices.begin(), G.vertices.end() );
+  G.vertices.erase( std::unique( G.vertices.begin(), G.vertices.end() ), G.vertices.end() );
+
+  auto index = [&G] ( VertexType v )
+  {
+    return IndexType( std::lower_bound( G.vertices.begin(), G.vertices.end(), v ) - G.vertices.begin() );
+  };
+
+  std::vector< std::pair<IndexType, IndexType> > edges;
+
+  for( auto itPair = K.range(1); itPair.first != itPair.second; ++itPair.first )
+  {
+    auto u = index( ( *itPair.first )[0] );
+    auto v = index( ( *itPair.first )[1] );
+
+    if( u == v )
+      continue;
+
+    edges.emplace_back( u, v );
+    edges.emplace_back( v, u );
+  }
+
+  std::sort( edges.begin(), edges.end() );
+  edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+
+  auto n = G.vertices.size();
+
+  G.offsets.assign( n + 1, 0 );
+  G.neighbours.reserve( edges.size() );
+
+  for( auto&& edge : edges )
+  {
+    G.offsets[ edge.first + 1 ]++;
+    G.neighbours.push_back( edge.second );
+  }
+
+  for( std::size_t i = 0; i < n; i++ )
+    G.offsets[i+1] += G.offsets[i];
+
+  return G;
+}
+
+/**
+  Calculates a degeneracy ordering of a graph, i.e. an ordering in
+  which every vertex has at most \f$d\f$ neighbours that come later,
+  where \f$d\f$ denotes the degeneracy of the graph. The ordering is
+  calculated in linear time using a bucket queue.
+
+  @returns Position of every vertex in the ordering
+*/
+
+template <class Graph> std::vector<std::size_t> degeneracyOrdering( const Graph& G )
+{
+  using IndexType = typename Graph::IndexType;
+
+  auto n = G.vertices.size();
+
+  std::vector<std::size_t> degrees( n );
+  std::size_t maxDegree = 0;
+
+  for( std::size_t v = 0; v < n; v++ )
+  {
+    degrees[v] = G.degree( IndexType(v) );
+    maxDegree  = std::max( maxDegree, degrees[v] );
+  }
+
+  // Bucket sort of all vertices by their degree. Vertices are stored in
+  // one array, with `bucketStart` pointing to the first vertex of each
+  // degree.
+  std::vector<std::size_t> bucketStart( maxDegree + 2, 0 );
+
+  for( auto&& d : degrees )
+    bucketStart[d+1]++;
+
+  for( std::size_t d = 0; d <= maxDegree; d++ )
+    bucketStart[d+1] += bucketStart[d];
+
+  std::vector<IndexType> sorted( n );
+  std::vector<std::size_t> position( n );
+
+  {
+    auto next = bucketStart;
+
+    for( std::size_t v = 0; v < n; v++ )
+    {
+      position[v]       = next[ degrees[v] ]++;
+      sorted[position[v]] = IndexType(v);
+    }
+  }
+
+  // Repeatedly remove a vertex of minimum degree. Decreasing the degree
+  // of a neighbour amounts to swapping it with the first vertex of its
+  // bucket and moving the bucket boundary.
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto v = sorted[i];
+
+    for( auto it = G.begin(v); it != G.end(v); ++it )
+    {
+      auto u = *it;
+
+      if( position[u] <= i || degrees[u] <= degrees[v] )
+        continue;
+
+      auto du    = degrees[u];
+      auto first = std::max( bucketStart[du], i + 1 );
+      auto w     = sorted[first];
+
+      if( u != w )
+      {
+        std::swap( sorted[ position[u] ], sorted[ first ] );
+        std::swap( position[u], position[w] );
+      }
+
+      bucketStart[du] = first + 1;
+      degrees[u]--;
+    }
+  }
+
+  return position;
+}
+
+/** Counts the number of bits that are set in a word */
+inline std::size_t popCount( std::uint64_t word ) noexcept
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+  return std::size_t( __builtin_popcountll( word ) );
+#else
+  return std::bitset<64>( word ).count();
+#endif
+}
+
+/** Counts the number of trailing zero bits of a non-zero word */
+inline std::size_t countTrailingZeros( std::uint64_t word ) noexcept
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+  return std::size_t( __builtin_ctzll( word ) );
+#else
+  // Isolating the lowest bit and subtracting one results in a word whose
+  // bits below the lowest bit are set.
+  return popCount( ( word & ( ~word + 1 ) ) - 1 );
+#endif
+}
+
+/**
+  Minimal dynamic bit set for candidate sets in the clique enumeration.
+  Using words directly is much faster than hash sets for intersections
+  with dense neighbourhoods.
+*/
+
+class BitSet
+{
+public:
+  using WordType = std::uint64_t;
+
+  explicit BitSet( std::size_t n = 0 )
+    : _words( ( n + 63 ) / 64, WordType() )
+  {
+  }
+
+  void set( std::size_t i )         { _words[i / 64] |=  ( WordType(1) << ( i % 64 ) );      }
+  void reset( std::size_t i )       { _words[i / 64] &= ~( WordType(1) << ( i % 64 ) );      }
+  bool test( std::size_t i ) const  { return ( _words[i / 64] >> ( i % 64 ) ) & WordType(1); }
+
+  bool none() const noexcept
+  {
+    for( auto&& word : _words )
+      if( word )
+        return false;
+
+    return true;
+  }
+
+  /** Counts the number of bits that are set in the intersection */
+  std::size_t intersectionSize( const BitSet& other ) const noexcept
+  {
+    std::size_t count = 0;
+    for( std::size_t i = 0; i < _words.size(); i++ )
+      count += popCount( _words[i] & other._words[i] );
+
+    return count;
+  }
+
+  /** Stores the intersection of two bit sets */
+  void assignIntersection( const BitSet& a, const BitSet& b ) noexcept
+  {
+    _words.resize( a._words.size() );
+
+    for( std::size_t i = 0; i < _words.size(); i++ )
+      _words[i] = a._words[i] & b._words[i];
+  }
+
+  /** Enumerates all bits that are set in `this`, but not in `other` */
+  template <class OutputIterator> void difference( const BitSet& other, OutputIterator result ) const
+  {
+    for( std::size_t i = 0; i < _words.size(); i++ )
+    {
+      auto word = _words[i] & ~other._words[i];
+
+      while( word )
+      {
+        auto bit = countTrailingZeros( word );
+        *result++ = i * 64 + bit;
+        word &= word - 1;
+      }
+    }
+  }
+
+  /** Enumerates all bits that are set */
+  template <class OutputIterator> void indices( OutputIterator result ) const
+  {
+    for( std::size_t i = 0; i < _words.size(); i++ )
+    {
+      auto word = _words[i];
+
+      while( word )
+      {
+        auto bit = countTrailingZeros( word );
+        *result++ = i * 64 + bit;
+        word &= word - 1;
+      }
+    }
+  }
+
+private:
+  std::vector<WordType> _words;
+};
+
+/**
+  Bron--Kerbosch recursion with Tomita pivoting on bit sets. All vertex
+  indices are *local*, i.e. they refer to the neighbourhood for which
+  the adjacency bit sets have been created.
+*/
+
+inline void enumerateBitSet( std::vector<std::size_t>& R,
+                             BitSet& P,
+                             BitSet& X,
+                             const std::vector<BitSet>& A,
+                             std::vector< std::vector<std::size_t> >& cliques )
+{
+  if( P.none() )
+  {
+    if( X.none() )
+      cliques.push_back( R );
+
+    return;
+  }
+
+  // Pivot selection: choose a vertex from P or X that maximizes the
+  // number of neighbours in P.
+  std::size_t pivot      = 0;
+  std::size_t maxCount   = 0;
+  bool        havePivot  = false;
+
+  std::vector<std::size_t> candidates;
+  P.indices( std::back_inserter( candidates ) );
+  X.indices( std::back_inserter( candidates ) );
+
+  for( auto&& u : candidates )
+  {
+    auto count = P.intersectionSize( A[u] );
+    if( !havePivot || count > maxCount )
+    {
+      pivot     = u;
+      maxCount  = count;
+      havePivot = true;
+    }
+  }
+
+  candidates.clear();
+  P.difference( A[pivot], std::back_inserter( candidates ) );
+
+  BitSet newP;
+  BitSet newX;
+
+  for( auto&& v : candidates )
+  {
+    newP.assignIntersection( P, A[v] );
+    newX.assignIntersection( X, A[v] );
+
+    R.push_back( v );
+    enumerateBitSet( R, newP, newX, A, cliques );
+    R.pop_back();
+
+    P.reset( v );
+    X.set( v );
+  }
+}
+
+/**
+  Bron--Kerbosch recursion with Tomita pivoting on sorted arrays. This
+  variant is used for large neighbourhoods, for which bit sets would
+  require too much memory.
+*/
+
+template <class Graph> void enumerateSorted( std::vector<typename Graph::IndexType>& R,
+                                             std::vector<typename Graph::IndexType>& P,
+                                             std::vector<typename Graph::IndexType>& X,
+                                             const Graph& G,
+                                             std::vector< std::vector<typename Graph::IndexType> >& cliques )
+{
+  using IndexType = typename Graph::IndexType;
+
+  if( P.empty() )
+  {
+    if( X.empty() )
+      cliques.push_back( R );
+
+    return;
+  }
+
+  // Pivot selection ---------------------------------------------------
+
+  auto countNeighbours = [&G, &P] ( IndexType u )
+  {
+    std::size_t count = 0;
+
+    auto it1 = P.begin();
+    auto it2 = G.begin(u);
+
+    while( it1 != P.end() && it2 != G.end(u) )
+    {
+      if( *it1 < *it2 )
+        ++it1;
+      else if( *it2 < *it1 )
+        ++it2;
+      else
+      {
+        ++count;
+        ++it1;
+        ++it2;
+      }
+    }
+
+    return count;
+  };
+
+  IndexType pivot    = P.front();
+  std::size_t maxCount = 0;
+
+  for( auto&& S : { &P, &X } )
+  {
+    for( auto&& u : *S )
+    {
+      auto count = countNeighbours( u );
+      if( count > maxCount )
+      {
+        pivot    = u;
+        maxCount = count;
+      }
+    }
+  }
+
+  std::vector<IndexType> candidates;
+
+  std::set_difference( P.begin(), P.end(),
+                       G.begin(pivot), G.end(pivot),
+                       std::back_inserter( candidates ) );
+
+  std::vector<IndexType> newP;
+  std::vector<IndexType> newX;
+
+  for( auto&& v : candidates )
+  {
+    newP.clear();
+    newX.clear();
+
+    std::set_intersection( P.begin(), P.end(), G.begin(v), G.end(v), std::back_inserter( newP ) );
+    std::set_intersection( X.begin(), X.end(), G.begin(v), G.end(v), std::back_inserter( newX ) );
+
+    R.push_back( v );
+    enumerateSorted( R, newP, newX, G, cliques );
+    R.pop_back();
+
+    P.erase( std::lower_bound( P.begin(), P.end(), v ) );
+    X.insert( std::lower_bound( X.begin(), X.end(), v ), v );
+  }
+}
+
+/**
+  Enumerates all maximal cliques that contain a given vertex \f$v\f$
+  as their first vertex with respect to the degeneracy ordering. The
+  cliques are stored as sorted arrays of compact vertex indices.
+*/
+
+template <class Graph> void enumerateFromVertex( typename Graph::IndexType v,
+                                                 const Graph& G,
+                                                 const std::vector<std::size_t>& position,
+                                                 std::size_t maxBitSetSize,
+                                                 std::vector< std::vector<typename Graph::IndexType> >& cliques )
+{
+  using IndexType = typename Graph::IndexType;
+
+  std::vector<IndexType> P;
+  std::vector<IndexType> X;
+
+  for( auto it = G.begin(v); it != G.end(v); ++it )
+  {
+    if( position[*it] > position[v] )
+      P.push_back( *it );
+    else
+      X.push_back( *it );
+  }
+
+  auto n = P.size() + X.size();
+
+  if( n <= maxBitSetSize )
+  {
+    // Local indices: the vertices of P come first, followed by the
+    // vertices of X. Adjacency is restricted to the neighbourhood.
+    std::vector<IndexType> local;
+    local.reserve( n );
+    local.insert( local.end(), P.begin(), P.end() );
+    local.insert( local.end(), X.begin(), X.end() );
+
+    std::vector<BitSet> A( n, BitSet( n ) );
+
+    for( std::size_t i = 0; i < n; i++ )
+      for( std::size_t j = i + 1; j < n; j++ )
+        if( G.adjacent( local[i], local[j] ) )
+        {
+          A[i].set(j);
+          A[j].set(i);
+        }
+
+    BitSet localP( n );
+    BitSet localX( n );
+
+    for( std::size_t i = 0; i < P.size(); i++ )
+      localP.set(i);
+
+    for( std::size_t i = P.size(); i < n; i++ )
+      localX.set(i);
+
+    std::vector<std::size_t> R;
+    std::vector< std::vector<std::size_t> > localCliques;
+
+    enumerateBitSet( R, localP, localX, A, localCliques );
+
+    for( auto&& localClique : localCliques )
+    {
+      std::vector<IndexType> clique;
+      clique.reserve( localClique.size() + 1 );
+      clique.push_back( v );
+
+      for( auto&& i : localClique )
+        clique.push_back( local[i] );
+
+      cliques.push_back( clique );
+    }
+  }
+  else
+  {
+    std::sort( P.begin(), P.end() );
+    std::sort( X.begin(), X.end() );
+
+    std::vector<IndexType> R = { v };
+    enumerateSorted( R, P, X, G, cliques );
+  }
+}
+
 } // namespace detail
 
 /**
@@ -243,6 +887,96 @@ template <class Simplex> auto maximalCliquesBronKerbosch( const SimplicialComple
   return cliques;
 }
 
+/**
+  Enumerates all maximal cliques in the given simplicial complex by
+  using the algorithm of Eppstein, Löffler, and Strash. This variant
+  of the Bron--Kerbosch algorithm uses pivoting and processes the
+  vertices in a degeneracy ordering, making it suitable for large,
+  sparse graphs. Candidate sets of small neighbourhoods are stored
+  as bit sets.
+
+  The outer loop over all vertices is parallelized if OpenMP is
+  available. The order of the cliques is deterministic, regardless
+  of the number of threads.
+
+  @param K             Simplicial complex; only its 1-skeleton is used
+  @param maxBitSetSize Maximum size of a neighbourhood for which bit
+                       sets are used for the candidate sets
+
+  @returns Maximal cliques in flat representation; vertices of every
+           clique are sorted in ascending order
+*/
+
+template <class Simplex> auto maximalCliquesEppstein( const SimplicialComplex<Simplex>& K, std::size_t maxBitSetSize = 2048 ) -> Cliques<typename Simplex::VertexType>
+{
+  using VertexType = typename Simplex::VertexType;
+  using Graph      = detail::CompactGraph<VertexType>;
+  using IndexType  = typename Graph::IndexType;
+  using Clique     = std::vector<IndexType>;
+
+  auto G        = detail::makeCompactGraph( K );
+  auto position = detail::degeneracyOrdering( G );
+  auto n        = G.vertices.size();
+
+  // Collects cliques per thread, along with the vertex that was used to
+  // generate them. This permits a deterministic ordering afterwards.
+  std::vector< std::vector<Clique> > threadCliques;
+  std::vector< std::vector<std::size_t> > threadOrigins;
+
+  #pragma omp parallel
+  {
+    std::vector<Clique> localCliques;
+    std::vector<std::size_t> localOrigins;
+    std::vector<Clique> cliques;
+
+    #pragma omp for schedule(dynamic, 16) nowait
+    for( std::size_t v = 0; v < n; v++ )
+    {
+      cliques.clear();
+
+      detail::enumerateFromVertex( IndexType(v), G, position, maxBitSetSize, cliques );
+
+      for( auto&& clique : cliques )
+      {
+        localCliques.push_back( std::move( clique ) );
+        localOrigins.push_back( v );
+      }
+    }
+
+    #pragma omp critical
+    {
+      threadCliques.push_back( std::move( localCliques ) );
+      threadOrigins.push_back( std::move( localOrigins ) );
+    }
+  }
+
+  std::vector< std::tuple<std::size_t, std::size_t, std::size_t> > order;
+
+  for( std::size_t t = 0; t < threadOrigins.size(); t++ )
+    for( std::size_t i = 0; i < threadOrigins[t].size(); i++ )
+      order.emplace_back( threadOrigins[t][i], t, i );
+
+  std::sort( order.begin(), order.end() );
+
+  Cliques<VertexType> result;
+  std::vector<VertexType> vertices;
+
+  for( auto&& tuple : order )
+  {
+    auto&& clique = threadCliques[ std::get<1>( tuple ) ][ std::get<2>( tuple ) ];
+
+    vertices.clear();
+
+    for( auto&& index : clique )
+      vertices.push_back( G.vertices[index] );
+
+    std::sort( vertices.begin(), vertices.end() );
+    result.add( vertices.begin(), vertices.end() );
+  }
+
+  return result;
+}
+
 } // namespace topology
 
 } // namespace aleph
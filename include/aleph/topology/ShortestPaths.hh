@@ -0,0 +1,99 @@
+#ifndef ALEPH_TOPOLOGY_SHORTEST_PATHS_HH__
+#define ALEPH_TOPOLOGY_SHORTEST_PATHS_HH__
+
+#include <aleph/math/SymmetricMatrix.hh>
+
+#include <aleph/topology/Dijkstra.hh>
+#include <aleph/topology/FloydWarshall.hh>
+
+#include <algorithm>
+
+#include <cmath>
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace topology
+{
+
+/** Available strategies for calculating all-pairs shortest paths */
+enum class ShortestPathStrategy
+{
+  Automatic,
+  Dijkstra,
+  FloydWarshall
+};
+
+/**
+  Calculates the matrix of pairwise distances between *all* vertices of
+  a weighted simplicial complex. By default, the strategy is selected
+  automatically based on the density of the graph: sparse graphs use
+  Dijkstra's algorithm from every vertex, whereas dense graphs, as well
+  as graphs with negative weights, use the Floyd--Warshall algorithm.
+
+  The selection compares the asymptotic costs of both algorithms, i.e.
+  \f$O(n (m + n) \log n)\f$ versus \f$O(n^3)\f$. The constant factor
+  accounts for the vectorized inner loop of the blocked Floyd--Warshall
+  algorithm, which is considerably cheaper than a heap operation.
+
+  @param K Simplicial complex
+
+  @param w Default weight to assign if a 1-simplex does not have a
+           weight assigned already.
+
+  @param strategy Strategy for calculating the distances
+
+  @returns Matrix of distances. The indexing of the matrix follows
+           the order in which the *vertices* of the simplicial complex
+           are encountered.
+*/
+
+template <class SimplicialComplex> auto allPairsShortestPaths( const SimplicialComplex& K,
+                                                               typename SimplicialComplex::ValueType::DataType w = 0,
+                                                               ShortestPathStrategy strategy = ShortestPathStrategy::Automatic )
+  -> aleph::math::SymmetricMatrix<
+      typename SimplicialComplex::ValueType::DataType,
+      typename SimplicialComplex::ValueType::VertexType>
+{
+  using DataType = typename SimplicialComplex::ValueType::DataType;
+
+  if( strategy == ShortestPathStrategy::Automatic )
+  {
+    std::size_t n = 0;
+    std::size_t m = 0;
+    bool negative = false;
+
+    for( auto&& s : K )
+    {
+      if( s.dimension() == 0 )
+        ++n;
+      else if( s.dimension() == 1 )
+      {
+        ++m;
+
+        auto weight = s.data() != DataType() ? s.data() : w;
+        negative    = negative || weight < DataType();
+      }
+    }
+
+    auto costDijkstra      = 20.0 * double( m + n ) * std::log2( double( std::max( n, std::size_t(2) ) ) );
+    auto costFloydWarshall = double( n ) * double( n );
+
+    if( !negative && costDijkstra < costFloydWarshall )
+      strategy = ShortestPathStrategy::Dijkstra;
+    else
+      strategy = ShortestPathStrategy::FloydWarshall;
+  }
+
+  if( strategy == ShortestPathStrategy::Dijkstra )
+    return dijkstra( K, w );
+  else
+    return floydWarshall( K, w );
+}
+
+} // namespace topology
+
+} // namespace aleph
+
+#endif
@@ -4,6 +4,8 @@
 #include <aleph/topology/Intersections.hh>
 
 #include <algorithm>
+#include <deque>
+#include <numeric>
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
@@ -318,91 +320,157 @@ template <class SimplicialComplex> std::unordered_map<typename SimplicialComplex
   return admissible;
 }
 
+namespace detail
+{
+
+/**
+  Stores the face and coface relations of a simplicial complex in two
+  tables in compressed sparse row format. Simplices are identified by
+  their index in the simplicial complex, so the tables only consist of
+  integers and may be traversed without any hashing.
+*/
+
+struct CofaceTable
+{
+  /** Offsets of the faces of every simplex */
+  std::vector<std::size_t> faceOffsets;
+
+  /** Indices of all faces; the faces of a simplex are contiguous */
+  std::vector<std::size_t> faces;
+
+  /** Offsets of the cofaces of every simplex */
+  std::vector<std::size_t> cofaceOffsets;
+
+  /** Indices of all cofaces; the cofaces of a simplex are contiguous */
+  std::vector<std::size_t> cofaces;
+
+  template <class SimplicialComplex> explicit CofaceTable( const SimplicialComplex& K )
+  {
+    auto n = K.size();
+
+    faceOffsets.reserve( n + 1 );
+    faceOffsets.push_back( 0 );
+
+    for( auto&& s : K )
+    {
+      for( auto itFace = s.begin_boundary(); itFace != s.end_boundary(); ++itFace )
+        faces.push_back( K.index( *itFace ) );
+
+      faceOffsets.push_back( faces.size() );
+    }
+
+    // Count the cofaces of every simplex first; afterwards, the offsets
+    // are used as insertion positions and restored later on.
+    cofaceOffsets.assign( n + 1, 0 );
+
+    for( auto&& face : faces )
+      ++cofaceOffsets[ face + 1 ];
+
+    std::partial_sum( cofaceOffsets.begin(), cofaceOffsets.end(), cofaceOffsets.begin() );
+
+    cofaces.resize( faces.size() );
+
+    for( std::size_t s = 0; s < n; s++ )
+    {
+      for( auto i = faceOffsets[s]; i < faceOffsets[s+1]; i++ )
+        cofaces[ cofaceOffsets[ faces[i] ]++ ] = s;
+    }
+
+    for( std::size_t s = n; s > 0; s-- )
+      cofaceOffsets[s] = cofaceOffsets[s-1];
+
+    cofaceOffsets[0] = 0;
+  }
+};
+
+} // namespace detail
+
 /**
   Performs an iterated elementary simplicial collapse until *all* of the
   admissible simplices have been collapsed. This leads to the *spine* of
   the simplicial complex.
 
+  The calculation uses integer indices for all simplices. For every
+  simplex, the number of cofaces that have not been collapsed yet is
+  stored. A face is free if and only if this number is one, in which case
+  its coface is necessarily principal. Whenever a counter drops to one,
+  the corresponding face is added to a work queue, so every simplex is
+  only visited a constant number of times per coface and no search over
+  the whole complex is required.
+
   @see S. Matveev, "Algorithmic Topology and Classification of 3-Manifolds"
 */
 
 template <class SimplicialComplex> SimplicialComplex spine( const SimplicialComplex& K )
 {
-  auto L          = K;
-  auto cofaces    = buildCofaceMap( L );
-  auto admissible = getPrincipalFaces( cofaces, L );
+  using Simplex = typename SimplicialComplex::ValueType;
 
-  while( !admissible.empty() )
+  detail::CofaceTable table( K );
+
+  auto n = K.size();
+
+  std::vector<bool> alive( n, true );
+  std::vector<std::size_t> numCofaces( n );
+
+  // Work queue of free faces. Since entries may become invalid due to
+  // other collapses, they are checked again once they are processed.
+  std::deque<std::size_t> queue;
+
+  for( std::size_t s = 0; s < n; s++ )
   {
-    auto s = admissible.begin()->first;
-    auto t = admissible.begin()->second;
+    numCofaces[s] = table.cofaceOffsets[s+1] - table.cofaceOffsets[s];
 
-    L.remove_without_validation( s );
-    L.remove_without_validation( t );
+    if( numCofaces[s] == 1 )
+      queue.push_back( s );
+  }
 
-    admissible.erase( s );
+  auto removeFrom = [&table, &numCofaces, &alive, &queue] ( std::size_t s )
+  {
+    alive[s] = false;
 
-    // Predicate for removing s and t, the principal simplex with its
-    // free face, from the coface data structure. This is required in
-    // order to keep the coface relation up-to-date.
-    using Simplex        = typename SimplicialComplex::ValueType;
-    auto removeSimplices = [&cofaces,&s,&t] ( const Simplex& sigma )
+    for( auto i = table.faceOffsets[s]; i < table.faceOffsets[s+1]; i++ )
     {
-      cofaces.at(sigma).erase(s);
-      cofaces.at(sigma).erase(t);
-    };
+      auto face = table.faces[i];
 
-    std::for_each( s.begin_boundary(), s.end_boundary(), removeSimplices );
-    std::for_each( t.begin_boundary(), t.end_boundary(), removeSimplices );
+      if( --numCofaces[ face ] == 1 && alive[ face ] )
+        queue.push_back( face );
+    }
+  };
 
-    // Both s and t do not have to be stored any more because they
-    // should not be queried again.
-    cofaces.erase(s);
-    cofaces.erase(t);
+  while( !queue.empty() )
+  {
+    auto t = queue.front();
+    queue.pop_front();
 
-    // New simplices ---------------------------------------------------
-    //
-    // Add new admissible simplices that may potentially have been
-    // spawned by the removal of s.
+    if( !alive[t] || numCofaces[t] != 1 )
+      continue;
 
-    // 1. Add all faces of the principal simplex, as they may
-    //    potentially become admissible again.
-    std::vector<Simplex> faces( s.begin_boundary(), s.end_boundary() );
+    // The free face has exactly one remaining coface, which is the
+    // principal simplex that is collapsed along with it.
+    auto s = table.cofaces[ table.cofaceOffsets[t] ];
 
-    std::for_each( faces.begin(), faces.end(),
-      [&t, &admissible, &cofaces] ( const Simplex& s )
+    for( auto i = table.cofaceOffsets[t]; i < table.cofaceOffsets[t+1]; i++ )
+    {
+      if( alive[ table.cofaces[i] ] )
       {
-        if( t != s )
-        {
-          auto face = getFreeFace( cofaces, s );
-          if( face )
-            admissible.insert( std::make_pair( s, face ) );
-        }
+        s = table.cofaces[i];
+        break;
       }
-    );
+    }
 
-    // 2. Add all faces of the free face, as they may now themselves
-    //    become admissible.
-    faces.assign( t.begin_boundary(), t.end_boundary() );
+    removeFrom( s );
+    removeFrom( t );
+  }
 
-    std::for_each( faces.begin(), faces.end(),
-      [&admissible, &cofaces] ( const Simplex& s )
-      {
-        auto face = getFreeFace( cofaces, s );
-        if( face )
-          admissible.insert( std::make_pair( s, face ) );
-      }
-    );
-
-    // The heuristic above is incapable of detecting *all* principal
-    // faces of the complex because this may involve searching *all*
-    // co-faces. Instead, it is easier to fill up the admissible set
-    // here.
-    if( admissible.empty() )
-      admissible = getPrincipalFaces( cofaces, L );
+  std::vector<Simplex> simplices;
+
+  for( std::size_t s = 0; s < n; s++ )
+  {
+    if( alive[s] )
+      simplices.push_back( K[s] );
   }
 
-  return L;
+  return SimplicialComplex( simplices.begin(), simplices.end() );
 }
 
 } // namespace topology
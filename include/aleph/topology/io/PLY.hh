@@ -1,24 +1,30 @@
 #ifndef ALEPH_TOPOLOGY_IO_PLY_HH__
 #define ALEPH_TOPOLOGY_IO_PLY_HH__
 
+#include <aleph/utilities/MappedFile.hh>
 #include <aleph/utilities/String.hh>
 
+#include <aleph/topology/CompactMesh.hh>
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
 #include <aleph/topology/filtrations/Data.hh>
 
-#include <cassert>
-
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <limits>
 #include <map>
-#include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 namespace aleph
 {
 
@@ -38,81 +44,131 @@ namespace detail
 
 std::map<std::string, unsigned short> TypeSizeMap = {
   { "double" , 8 },
+  { "float64", 8 },
   { "float"  , 4 },
+  { "float32", 4 },
   { "int"    , 4 },
   { "int32"  , 4 },
   { "uint"   , 4 },
   { "uint32" , 4 },
   { "short"  , 2 },
+  { "int16"  , 2 },
   { "ushort" , 2 },
+  { "uint16" , 2 },
   { "char"   , 1 },
+  { "int8"   , 1 },
   { "uchar"  , 1 },
   { "uint8"  , 1 }
 };
 
-/*
-  Maps PLY data types to their 'signedness'. This is required for
-  parsing binary files later on.
+/* Checks whether the current machine stores values in little endian order */
+inline bool isLittleEndian() noexcept
+{
+  std::uint16_t value = 1;
+  unsigned char first = 0;
 
-  TODO: Use this to extend parser
+  std::memcpy( &first, &value, 1 );
+  return first == 1;
+}
+
+/*
+  Reverses the storage order of unsigned integers. The functions only
+  use shifts, so loops over them are vectorised by the compiler.
 */
 
-std::map<std::string, bool> TypeSignednessMap = {
-  { "double" , true },
-  { "float"  , true },
-  { "int"    , true },
-  { "int32"  , true },
-  { "uint"   , false },
-  { "uint32" , false },
-  { "short"  , true },
-  { "ushort" , false },
-  { "char"   , true },
-  { "uchar"  , false },
-  { "uint8"  , false }
-};
+inline std::uint8_t  byteSwap( std::uint8_t x )  noexcept { return x; }
+inline std::uint16_t byteSwap( std::uint16_t x ) noexcept { return std::uint16_t( ( x >> 8 ) | ( x << 8 ) ); }
 
-/* Describes an arbitrary value of a PLY file */
-union PLYValue
+inline std::uint32_t byteSwap( std::uint32_t x ) noexcept
 {
-  double         d;
-  float          f;
-  int            i;
-  short          s;
-  char           c;
-  unsigned       u;
-  unsigned short us;
-  unsigned char  uc;
-};
+  return   ( ( x >> 24 ) & 0x000000FFu )
+         | ( ( x >>  8 ) & 0x0000FF00u )
+         | ( ( x <<  8 ) & 0x00FF0000u )
+         | ( ( x << 24 ) & 0xFF000000u );
+}
+
+inline std::uint64_t byteSwap( std::uint64_t x ) noexcept
+{
+  return   ( std::uint64_t( byteSwap( std::uint32_t( x ) ) ) << 32 )
+         |   std::uint64_t( byteSwap( std::uint32_t( x >> 32 ) ) );
+}
+
+/* Maps a type to the unsigned integer type of the same size */
+template <std::size_t N> struct RawType;
+
+template <> struct RawType<1> { using Type = std::uint8_t;  };
+template <> struct RawType<2> { using Type = std::uint16_t; };
+template <> struct RawType<4> { using Type = std::uint32_t; };
+template <> struct RawType<8> { using Type = std::uint64_t; };
 
 /*
-  Reads a single value from a binary input stream, reversing the storage
-  order if necessary.
+  Decodes values of type `T` that are stored at regular intervals in
+  a buffer. The values are first gathered into a contiguous array, so
+  the reversal of their storage order and the conversion are performed
+  in bulk.
 */
 
-template <class T> void readValue( std::ifstream& stream,
-                                   std::size_t bytes,
-                                   bool littleEndian,
-                                   T* target )
+template <class T, class U> void decodeValues( const char* data,
+                                               std::size_t n,
+                                               std::size_t stride,
+                                               bool swap,
+                                               U* output )
 {
-  if( !littleEndian || bytes == 1 )
-    stream.read( reinterpret_cast<char*>( target ), static_cast<std::streamsize>( bytes ) );
+  using Raw = typename RawType<sizeof(T)>::Type;
+
+  std::vector<Raw> raw( n );
+
+  if( stride == sizeof(T) )
+    std::memcpy( raw.data(), data, n * sizeof(T) );
   else
   {
-    char* buffer         = new char[bytes];
-    char* reversedBuffer = new char[bytes];
-
-    stream.read( buffer, static_cast<std::streamsize>( bytes ) );
+    for( std::size_t i = 0; i < n; i++ )
+      std::memcpy( &raw[i], data + i * stride, sizeof(T) );
+  }
 
-    for( std::size_t i = 0; i < bytes; i++ )
-      reversedBuffer[i] = buffer[ bytes - 1 - i ];
+  if( swap )
+  {
+    for( std::size_t i = 0; i < n; i++ )
+      raw[i] = byteSwap( raw[i] );
+  }
 
-    std::copy( reversedBuffer, reversedBuffer + bytes, target );
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    T value;
+    std::memcpy( &value, &raw[i], sizeof(T) );
 
-    delete[] reversedBuffer;
-    delete[] buffer;
+    output[i] = static_cast<U>( value );
   }
 }
 
+/* Decodes values of a type that is specified by its PLY name */
+template <class U> void decodeValues( const std::string& type,
+                                      const char* data,
+                                      std::size_t n,
+                                      std::size_t stride,
+                                      bool swap,
+                                      U* output )
+{
+  if( type == "double" || type == "float64" )
+    decodeValues<double>( data, n, stride, swap, output );
+  else if( type == "float" || type == "float32" )
+    decodeValues<float>( data, n, stride, swap, output );
+  else if( type == "int" || type == "int32" )
+    decodeValues<std::int32_t>( data, n, stride, swap, output );
+  else if( type == "uint" || type == "uint32" )
+    decodeValues<std::uint32_t>( data, n, stride, swap, output );
+  else if( type == "short" || type == "int16" )
+    decodeValues<std::int16_t>( data, n, stride, swap, output );
+  else if( type == "ushort" || type == "uint16" )
+    decodeValues<std::uint16_t>( data, n, stride, swap, output );
+  else if( type == "char" || type == "int8" )
+    decodeValues<std::int8_t>( data, n, stride, swap, output );
+  else if( type == "uchar" || type == "uint8" )
+    decodeValues<std::uint8_t>( data, n, stride, swap, output );
+  else
+    throw std::runtime_error( "Format error: Unknown data type \"" + type + "\"" );
+}
+
 } // namespace detail
 
 /**
@@ -123,6 +179,12 @@ template <class T> void readValue( std::ifstream& stream,
   reading PLY files with an arbitrary number of vertex properties. A
   user may specify which property to use in order to assign the data
   stored for each simplex.
+
+  Binary files are memory-mapped and decoded in bulk, i.e. every block
+  of vertices or faces is converted at once, rather than value by value.
+  Edges of the resulting simplicial complex are deduplicated by sorting.
+
+  Besides simplicial complexes, the reader can also create meshes.
 */
 
 class PLYReader
@@ -133,45 +195,222 @@ public:
   // elements is somewhat superfluous when parsing ASCII files.
   struct PropertyDescriptor
   {
-    std::string name;     // Property name (or list name)
-    unsigned index;       // Offset of attribute for ASCII data
-    unsigned bytesOffset; // Offset of attribute for binary data
-    unsigned bytes;       // Number of bytes
+    std::string name;         // Property name (or list name)
+    std::string type;         // Data type (or entry type of a list)
+    unsigned index       = 0; // Offset of attribute for ASCII data
+    unsigned bytesOffset = 0; // Offset of attribute for binary data
+    unsigned bytes       = 0; // Number of bytes
 
     // Only used for lists: Here, both the length parameter and the
     // entry parameter of a list usually have different lengths.
-    unsigned bytesListSize;
-    unsigned bytesListEntry;
+    std::string sizeType;
+    unsigned bytesListSize  = 0;
+    unsigned bytesListEntry = 0;
+
+    bool isList() const noexcept { return !sizeType.empty(); }
+  };
+
+  // Describes a single element of a PLY file, such as the vertices or
+  // the faces, along with all of its properties.
+  struct ElementDescriptor
+  {
+    std::string name;
+    std::size_t count = 0;
+
+    std::vector<PropertyDescriptor> properties;
+
+    /* Number of bytes of every entry; zero if entries contain lists */
+    std::size_t bytes() const noexcept
+    {
+      std::size_t result = 0;
+
+      for( auto&& property : properties )
+      {
+        if( property.isList() )
+          return 0;
+
+        result += property.bytes;
+      }
+
+      return result;
+    }
   };
 
   template <class SimplicialComplex> void operator()( const std::string& filename, SimplicialComplex& K )
   {
-    std::ifstream in( filename );
+    this->createComplex( this->read( filename ), K );
+  }
+
+  template <class SimplicialComplex> void operator()( std::ifstream& in, SimplicialComplex& K )
+  {
+    this->createComplex( this->read( in ), K );
+  }
+
+  /** Reads a mesh, whose faces may be arbitrary polygons, from a file */
+  template <class Position, class Data> void operator()( const std::string& filename, CompactMesh<Position, Data>& M )
+  {
+    auto&& surface = this->read( filename );
+
+    std::vector<Position> coordinates( surface.coordinates.begin(), surface.coordinates.end() );
+    std::vector<Data> data( surface.values.begin(), surface.values.end() );
+
+    M = CompactMesh<Position, Data>( coordinates, data, surface.indices, surface.offsets );
+  }
+
+  /* Sets the property to read for every simplex */
+  void setDataProperty( const std::string& property )
+  {
+    _property = property;
+  }
+
+private:
+
+  // Contents of a PLY file, independent of its format. Faces are stored
+  // as a flat list of vertex IDs with offsets, as in the compact mesh.
+  struct Surface
+  {
+    std::vector<double> coordinates;   // Consecutive (x,y,z) triples
+    std::vector<double> values;        // Data property; empty if missing
+
+    std::vector<std::uint32_t> indices;
+    std::vector<std::uint32_t> offsets = { 0 };
+  };
+
+  struct Header
+  {
+    bool binary       = false;
+    bool littleEndian = false;
+
+    std::vector<ElementDescriptor> elements;
+  };
+
+  Surface read( const std::string& filename )
+  {
+    std::ifstream in( filename, std::ios::binary );
     if( !in )
       throw std::runtime_error( "Unable to read input file" );
 
-    this->operator()( in, K );
+    auto header = this->parseHeader( in );
+
+    if( !header.binary )
+      return this->parseASCII( in, header );
+
+    auto offset = static_cast<std::size_t>( in.tellg() );
+    in.close();
+
+    utilities::MappedFile file( filename );
+
+    if( offset > file.size() )
+      throw std::runtime_error( "Format error: Unexpected end of file" );
+
+    return this->parseBinary( file.data() + offset, file.data() + file.size(), header );
   }
 
-  template <class SimplicialComplex> void operator()( std::ifstream& in, SimplicialComplex& K )
+  Surface read( std::ifstream& in )
+  {
+    auto header = this->parseHeader( in );
+
+    if( !header.binary )
+    {
+      auto surface = this->parseASCII( in, header );
+      in.close();
+
+      return surface;
+    }
+
+    // Streams cannot be mapped, so the remainder of the file is read into
+    // a buffer instead, which is then decoded in the same manner.
+    std::vector<char> buffer( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+    in.close();
+
+    return this->parseBinary( buffer.data(), buffer.data() + buffer.size(), header );
+  }
+
+  template <class SimplicialComplex> void createComplex( const Surface& surface, SimplicialComplex& K )
+  {
+    using Simplex    = typename SimplicialComplex::ValueType;
+    using DataType   = typename Simplex::DataType;
+    using VertexType = typename Simplex::VertexType;
+
+    auto numVertices = surface.coordinates.size() / 3;
+    auto numFaces    = surface.offsets.size() - 1;
+
+    // Keep track of all edges that are encountered. This ensures that the
+    // simplicial complex is valid upon construction and does not have any
+    // missing simplices. Every edge is stored with its larger vertex first
+    // and duplicates are removed by sorting.
+    std::vector< std::pair<std::uint32_t, std::uint32_t> > edges;
+    edges.reserve( 3 * numFaces );
+
+    for( std::size_t f = 0; f < numFaces; f++ )
+    {
+      // I can make a simplex out of a triangle, but every other shape would
+      // get complicated.
+      if( surface.offsets[f+1] - surface.offsets[f] != 3 )
+        throw std::runtime_error( "Format error: Expecting triangular faces only" );
+
+      auto face = surface.indices.data() + surface.offsets[f];
+
+      for( std::size_t i = 0; i < 3; i++ )
+      {
+        auto u = face[i];
+        auto v = face[ ( i + 1 ) % 3 ];
+
+        if( u >= numVertices || v >= numVertices )
+          throw std::runtime_error( "Format error: Unknown vertex index" );
+
+        if( u < v )
+          std::swap( u, v );
+
+        edges.push_back( std::make_pair( u, v ) );
+      }
+    }
+
+    std::sort( edges.begin(), edges.end() );
+    edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+
+    std::vector<Simplex> simplices;
+    simplices.reserve( numVertices + edges.size() + numFaces );
+
+    // No property for reading weights specified, or the specified
+    // property could not be found; just use the default weight of
+    // the simplex class.
+    for( std::size_t i = 0; i < numVertices; i++ )
+    {
+      if( surface.values.empty() )
+        simplices.push_back( Simplex( VertexType( i ) ) );
+      else
+        simplices.push_back( Simplex( VertexType( i ), DataType( surface.values[i] ) ) );
+    }
+
+    for( auto&& edge : edges )
+      simplices.push_back( Simplex( { VertexType( edge.first ), VertexType( edge.second ) } ) );
+
+    for( std::size_t f = 0; f < numFaces; f++ )
+    {
+      auto face = surface.indices.data() + surface.offsets[f];
+      simplices.push_back( Simplex( { VertexType( face[0] ), VertexType( face[1] ), VertexType( face[2] ) } ) );
+    }
+
+    K = SimplicialComplex( simplices.begin(), simplices.end() );
+    K.recalculateWeights();
+    K.sort( filtrations::Data<Simplex>() );
+  }
+
+  Header parseHeader( std::ifstream& in )
   {
     // Header ------------------------------------------------------------
     //
     // The header needs to consist of the word "ply", followed by a "format"
     // description.
 
-    std::size_t numVertices       = 0; // Number of edges
-    std::size_t vertexSizeInBytes = 0; // Only relevant for binary files
-    std::size_t numFaces          = 0; // Number of faces
-    std::size_t faceSizeInBytes   = 0; // Only relevant for binary files
+    Header header;
 
     // Current line in file. This is required because I prefer reading the
     // file line by line via `std::getline`.
     std::string line;
 
     bool headerParsed = false;
-    bool parseBinary  = false;
-    bool littleEndian = false;
 
     std::getline( in, line );
     line = utilities::trim( line );
@@ -190,32 +429,21 @@ public:
       format = utilities::trim( format );
 
       if( format == "ascii 1.0" )
-        parseBinary = false;
+        header.binary = false;
       else if( format == "binary_little_endian 1.0" )
       {
-        parseBinary  = true;
-        littleEndian = true;
+        header.binary       = true;
+        header.littleEndian = true;
       }
       else if( format == "binary_big_endian 1.0" )
       {
-        parseBinary  = true;
-        littleEndian = false;
+        header.binary       = true;
+        header.littleEndian = false;
       }
       else
         throw std::runtime_error( "Format error: Expecting \"ascii 1.0\" or \"binary_little_endian 1.0\" or \"binary_big_endian 1.0\" " );
     }
 
-    // All properties stored in the PLY file in the order in which they
-    // were discovered. The parse requires the existence of some of the
-    // properties, e.g. "x", "y", and "z" in order to work correctly.
-    std::vector<PropertyDescriptor> properties;
-
-    unsigned propertyIndex  = 0; // Offset for properties in ASCII files
-    unsigned propertyOffset = 0; // Offset for properties in binary files
-
-    bool readingVertexProperties = false;
-    bool readingFaceProperties   = false;
-
     // Parse the rest of the header, taking care to skip any comment lines.
     do
     {
@@ -225,7 +453,7 @@ public:
       if( !in )
         break;
 
-      if( line.substr( 0, 7 ) == "comment" )
+      if( line.substr( 0, 7 ) == "comment" || line.substr( 0, 8 ) == "obj_info" )
         continue;
       else if( line.substr( 0, 7) == "element" )
       {
@@ -234,30 +462,23 @@ public:
 
         std::istringstream converter( element );
 
-        std::string name;
-        std::size_t numElements = 0;
+        ElementDescriptor descriptor;
 
-        converter >> name
-                  >> numElements;
+        converter >> descriptor.name
+                  >> descriptor.count;
 
         if( !converter )
           throw std::runtime_error( "Element conversion error: Expecting number of elements" );
 
-        name = utilities::trim( name );
-
-        if( name == "vertex" )
-        {
-          numVertices             = numElements;
-          readingVertexProperties = true;
-        }
-        else if( name == "face" )
-        {
-          numFaces              = numElements;
-          readingFaceProperties = true;
-        }
+        header.elements.push_back( descriptor );
       }
       else if( line.substr( 0, 8) == "property" )
       {
+        if( header.elements.empty() )
+          throw std::runtime_error( "Format error: Expecting \"element\" before \"property\"" );
+
+        auto&& element = header.elements.back();
+
         std::string property = line.substr( 8 );
         property = utilities::trim( property );
 
@@ -269,11 +490,8 @@ public:
         converter >> dataType
                   >> name;
 
-        dataType = utilities::trim( dataType );
-        name     = utilities::trim( name );
-
         PropertyDescriptor descriptor;
-        descriptor.index = propertyIndex;
+        descriptor.index = static_cast<unsigned>( element.properties.size() );
 
         // List of properties require a special handling. The syntax is
         // "property list SIZE_TYPE ENTRY_TYPE NAME", e.g. "property
@@ -287,32 +505,24 @@ public:
           converter >> entryType
                     >> listName;
 
-          utilities::trim( entryType );
-          utilities::trim( listName );
-
+          descriptor.sizeType       = sizeType;
+          descriptor.type           = entryType;
           descriptor.bytesListSize  = detail::TypeSizeMap.at( sizeType );
           descriptor.bytesListEntry = detail::TypeSizeMap.at( entryType );
           descriptor.name           = listName;
         }
         else
         {
+          descriptor.type        = dataType;
           descriptor.bytes       = detail::TypeSizeMap.at( dataType );
-          descriptor.bytesOffset = propertyOffset;
+          descriptor.bytesOffset = static_cast<unsigned>( element.bytes() );
           descriptor.name        = name;
         }
 
         if( !converter )
           throw std::runtime_error( "Property conversion error: Expecting data type and name of property" );
 
-        if( readingFaceProperties )
-          faceSizeInBytes += descriptor.bytes;
-        else if( readingVertexProperties )
-          vertexSizeInBytes += descriptor.bytes;
-
-        propertyOffset += descriptor.bytes;
-        propertyIndex  += 1;
-
-        properties.push_back( descriptor );
+        element.properties.push_back( descriptor );
       }
 
       if( line == "end_header" )
@@ -323,239 +533,282 @@ public:
     }
     while( !headerParsed && in );
 
-    assert( numVertices > 0 );
-    assert( numFaces    > 0 );
+    if( !headerParsed )
+      throw std::runtime_error( "Format error: Expecting \"end_header\"" );
 
-    using Simplex = typename SimplicialComplex::ValueType;
-
-    // Container for storing all simplices that are created while reading
-    // the mesh data structure.
-    std::vector<Simplex> simplices;
+    return header;
+  }
 
-    if( parseBinary )
-    {
-      simplices = this->parseBinary<Simplex>( in,
-                                              numVertices, numFaces,
-                                              littleEndian,
-                                              properties );
-    }
+  /* Returns the index of a property, or the maximum index if it does not exist */
+  static std::size_t getPropertyIndex( const ElementDescriptor& element, const std::string& property )
+  {
+    auto it = std::find_if( element.properties.begin(), element.properties.end(),
+                            [&property] ( const PropertyDescriptor& descriptor )
+                            {
+                              return descriptor.name == property;
+                            } );
+
+    if( it != element.properties.end() )
+      return static_cast<std::size_t>( std::distance( element.properties.begin(), it ) );
     else
-    {
-      simplices = this->parseASCII<Simplex>( in,
-                                             numVertices, numFaces,
-                                             properties );
-    }
-
-    in.close();
-
-    K = SimplicialComplex( simplices.begin(), simplices.end() );
-    K.recalculateWeights();
-    K.sort( filtrations::Data<Simplex>() );
+      return std::numeric_limits<std::size_t>::max();
   }
 
-  /* Sets the property to read for every simplex */
-  void setDataProperty( const std::string& property )
+  /* Returns the index of the property that stores the vertices of faces */
+  static std::size_t getFaceIndicesIndex( const ElementDescriptor& element )
   {
-    _property = property;
-  }
+    auto index = getPropertyIndex( element, "vertex_indices" );
 
-private:
+    if( index == std::numeric_limits<std::size_t>::max() )
+      index = getPropertyIndex( element, "vertex_index" );
 
-  template <class Simplex> std::vector<Simplex> parseBinary( std::ifstream& in,
-                                                             std::size_t numVertices,
-                                                             std::size_t numFaces,
-                                                             bool littleEndian,
-                                                             const std::vector<PropertyDescriptor>& properties )
-  {
-    using DataType   = typename Simplex::DataType;
-    using VertexType = typename Simplex::VertexType;
+    if( index == std::numeric_limits<std::size_t>::max() || !element.properties[index].isList() )
+      throw std::runtime_error( "Format error: Expecting list of vertex indices for faces" );
 
-    // FIXME: this is just to placate the compiler
-    {
-      (void) numFaces;
+    return index;
+  }
 
-      VertexType v = VertexType();
-      (void) v;
+  Surface parseBinary( const char* begin, const char* end, const Header& header )
+  {
+    Surface surface;
 
-      DataType weight = DataType();
-      (void) weight;
-    }
+    bool swap = header.littleEndian != detail::isLittleEndian();
+    auto p    = begin;
 
-    for( std::size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++ )
+    for( auto&& element : header.elements )
     {
-      std::vector<double> coordinates;
+      // Elements without properties do not occupy any bytes, so there is
+      // nothing to read, regardless of their count. Vertices still need
+      // their coordinates, though.
 
-      for( auto&& descriptor : properties )
+      if( element.properties.empty() )
       {
-        // Only faces may have lists for now...
-        if( descriptor.bytesListSize + descriptor.bytesListEntry != 0 )
-          continue;
+        if( element.name == "vertex" && element.count > 0 )
+          throw std::runtime_error( "Format error: Expecting vertex coordinate \"x\"" );
+
+        continue;
+      }
 
-        detail::PLYValue pv;
+      auto bytes = element.bytes();
 
-        switch( descriptor.bytes )
+      // Fixed-size entries: The block is decoded column by column ---------
+
+      if( bytes > 0 )
+      {
+        if( static_cast<std::size_t>( end - p ) / bytes < element.count )
+          throw std::runtime_error( "Format error: Unexpected end of file" );
+
+        if( element.name == "vertex" )
         {
-          case 8:
-            detail::readValue( in, descriptor.bytes, littleEndian, &pv.d );
-            break;
-          case 4:
-            detail::readValue( in, descriptor.bytes, littleEndian, &pv.f );
-            break;
-          case 2:
-            detail::readValue( in, descriptor.bytes, littleEndian, &pv.s );
-            break;
-          case 1:
-            detail::readValue( in, descriptor.bytes, littleEndian, &pv.c );
-            break;
+          auto n = element.count;
+
+          std::vector<double> column( n );
+
+          surface.coordinates.resize( 3 * n );
+
+          for( std::size_t k = 0; k < 3; k++ )
+          {
+            auto name  = std::string( 1, char( 'x' + k ) );
+            auto index = getPropertyIndex( element, name );
+
+            if( index == std::numeric_limits<std::size_t>::max() )
+              throw std::runtime_error( "Format error: Expecting vertex coordinate \"" + name + "\"" );
+
+            auto&& property = element.properties[index];
+
+            detail::decodeValues( property.type, p + property.bytesOffset, n, bytes, swap, column.data() );
+
+            for( std::size_t i = 0; i < n; i++ )
+              surface.coordinates[3*i+k] = column[i];
+          }
+
+          auto index = _property.empty() ? std::numeric_limits<std::size_t>::max() : getPropertyIndex( element, _property );
+
+          if( index != std::numeric_limits<std::size_t>::max() )
+          {
+            auto&& property = element.properties[index];
+
+            surface.values.resize( n );
+            detail::decodeValues( property.type, p + property.bytesOffset, n, bytes, swap, surface.values.data() );
+          }
         }
 
-        // FIXME: Not sure whether this is legal...
-        if( descriptor.name == "x" || descriptor.name == "y" || descriptor.name == "z" )
-          coordinates.push_back( pv.d );
+        p += element.count * bytes;
+        continue;
       }
-    }
 
-    for( std::size_t faceIndex = 0; faceIndex < numVertices; faceIndex++ )
-    {
-    }
+      // Variable-size entries ---------------------------------------------
+      //
+      // Entries need to be traversed one after the other. For faces, the
+      // vertex indices are collected in a contiguous buffer, which is then
+      // decoded at once.
 
-    return {};
-  }
+      if( element.name == "vertex" )
+        throw std::runtime_error( "Format error: Expecting vertices without list properties" );
 
+      bool isFace       = element.name == "face";
+      auto indicesIndex = isFace ? getFaceIndicesIndex( element ) : 0;
 
-  template <class Simplex> std::vector<Simplex> parseASCII( std::ifstream& in,
-                                                            std::size_t numVertices, std::size_t numFaces,
-                                                            const std::vector<PropertyDescriptor>& properties )
-  {
-    using DataType   = typename Simplex::DataType;
-    using VertexType = typename Simplex::VertexType;
+      std::vector<char> raw;
 
-    std::vector<Simplex> simplices;
-    std::string line;
+      if( isFace )
+      {
+        surface.offsets.reserve( element.count + 1 );
+        raw.reserve( 3 * element.count * element.properties[indicesIndex].bytesListEntry );
+      }
 
-    auto getPropertyIndex = [&properties] ( const std::string& property )
-    {
-      auto it = std::find_if( properties.begin(), properties.end(),
-                              [&property] ( const PropertyDescriptor& descriptor )
-                              {
-                                return descriptor.name == property;
-                              } );
-
-      if( it != properties.end() )
-        return it->index;
-      else
-        return std::numeric_limits<unsigned>::max();
-    };
+      for( std::size_t i = 0; i < element.count; i++ )
+      {
+        for( std::size_t j = 0; j < element.properties.size(); j++ )
+        {
+          auto&& property = element.properties[j];
 
-    // Read vertices -----------------------------------------------------
+          if( !property.isList() )
+          {
+            if( static_cast<std::size_t>( end - p ) < property.bytes )
+              throw std::runtime_error( "Format error: Unexpected end of file" );
 
-    for( std::size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++ )
-    {
-      std::vector<double> vertexCoordinates( 3 );
+            p += property.bytes;
+            continue;
+          }
 
-      std::getline( in, line );
+          if( static_cast<std::size_t>( end - p ) < property.bytesListSize )
+            throw std::runtime_error( "Format error: Unexpected end of file" );
 
-      line        = utilities::trim( line );
-      auto tokens = utilities::split( line );
+          std::size_t size = 0;
+          detail::decodeValues( property.sizeType, p, 1, property.bytesListSize, swap, &size );
 
-      auto ix     = getPropertyIndex( "x" );
-      auto iy     = getPropertyIndex( "y" );
-      auto iz     = getPropertyIndex( "z" );
-      auto iw     = getPropertyIndex( _property );
+          p += property.bytesListSize;
 
-      auto x      = std::stod( tokens.at( ix ) );
-      auto y      = std::stod( tokens.at( iy ) );
-      auto z      = std::stod( tokens.at( iz ) );
+          auto length = size * property.bytesListEntry;
 
-      _coordinates.push_back( {x,y,z} );
+          if( static_cast<std::size_t>( end - p ) < length )
+            throw std::runtime_error( "Format error: Unexpected end of file" );
 
-      // No property for reading weights specified, or the specified
-      // property could not be found; just use the default weight of
-      // the simplex class.
-      if( _property.empty() || iw == std::numeric_limits<unsigned>::max() )
-        simplices.push_back( { VertexType( vertexIndex ) } );
-      else
+          if( isFace && j == indicesIndex )
+          {
+            raw.insert( raw.end(), p, p + length );
+            surface.offsets.push_back( static_cast<std::uint32_t>( surface.offsets.back() + size ) );
+          }
+
+          p += length;
+        }
+      }
+
+      if( isFace )
       {
-        DataType w = aleph::utilities::convert<DataType>( tokens.at(iw) );
-        simplices.push_back( Simplex( VertexType( vertexIndex ), w ) );
+        auto&& property = element.properties[indicesIndex];
+        auto n          = raw.size() / property.bytesListEntry;
+
+        surface.indices.resize( n );
+        detail::decodeValues( property.type, raw.data(), n, property.bytesListEntry, swap, surface.indices.data() );
       }
     }
 
-    // Read faces --------------------------------------------------------
+    return surface;
+  }
 
-    // Keep track of all edges that are encountered. This ensures that the
-    // simplicial complex is valid upon construction and does not have any
-    // missing simplices.
-    std::set< std::pair<VertexType, VertexType> > edges;
+  Surface parseASCII( std::ifstream& in, const Header& header )
+  {
+    Surface surface;
+    std::string line;
 
-    for( std::size_t faceIndex = 0; faceIndex < numFaces; faceIndex++ )
+    for( auto&& element : header.elements )
     {
-      std::getline( in, line );
-      std::istringstream converter( line );
+      // Read vertices ---------------------------------------------------
 
-      unsigned numEntries = 0;
+      if( element.name == "vertex" )
+      {
+        auto ix = getPropertyIndex( element, "x" );
+        auto iy = getPropertyIndex( element, "y" );
+        auto iz = getPropertyIndex( element, "z" );
+        auto iw = _property.empty() ? std::numeric_limits<std::size_t>::max() : getPropertyIndex( element, _property );
 
-      converter >> numEntries;
-      if( !converter )
-        throw std::runtime_error( "Face conversion error: Expecting number of entries" );
+        surface.coordinates.reserve( 3 * element.count );
 
-      // I can make a simplex out of a triangle, but every other shape would
-      // get complicated.
-      if( numEntries == 3 )
-      {
-        VertexType i1 = 0;
-        VertexType i2 = 0;
-        VertexType i3 = 0;
+        if( iw != std::numeric_limits<std::size_t>::max() )
+          surface.values.reserve( element.count );
 
-        converter >> i1
-                  >> i2
-                  >> i3;
+        for( std::size_t vertexIndex = 0; vertexIndex < element.count; vertexIndex++ )
+        {
+          std::getline( in, line );
 
-        if( !converter )
-          throw std::runtime_error( "Unable to parse vertex indices" );
+          line        = utilities::trim( line );
+          auto tokens = utilities::splitByWhitespace( line );
 
-        Simplex triangle( {i1,i2,i3} );
+          surface.coordinates.push_back( std::stod( tokens.at( ix ) ) );
+          surface.coordinates.push_back( std::stod( tokens.at( iy ) ) );
+          surface.coordinates.push_back( std::stod( tokens.at( iz ) ) );
+
+          // No property for reading weights specified, or the specified
+          // property could not be found; the values remain empty.
+          if( iw != std::numeric_limits<std::size_t>::max() )
+            surface.values.push_back( std::stod( tokens.at( iw ) ) );
+        }
+      }
 
-        // Create edges ----------------------------------------------
+      // Read faces ------------------------------------------------------
+      //
+      // Only the list of vertex indices is used; any other property of the
+      // faces is ignored.
 
-        for( auto itEdge = triangle.begin_boundary();
-             itEdge != triangle.end_boundary();
-             ++itEdge )
+      else if( element.name == "face" )
+      {
+        auto indicesIndex = getFaceIndicesIndex( element );
+
+        surface.offsets.reserve( element.count + 1 );
+        surface.indices.reserve( 3 * element.count );
+
+        for( std::size_t faceIndex = 0; faceIndex < element.count; faceIndex++ )
         {
-          // As the boundary iterator works as a filtered iterator only,
-          // I need this copy.
-          //
-          // Else, different calls to `begin()` and `end()` will result in
-          // two different copies of the simplex. The copies, in turn,
-          // will then not be usable as a source for vertices.
-          Simplex edge = *itEdge;
+          std::getline( in, line );
+          std::istringstream converter( line );
 
-          auto u = *( edge.begin() );
-          auto v = *( edge.begin() + 1 );
+          for( std::size_t j = 0; j < element.properties.size(); j++ )
+          {
+            auto&& property = element.properties[j];
 
-          if( u < v )
-            std::swap( u, v );
+            std::size_t numEntries = 1;
 
-          auto pair = edges.insert( std::make_pair( u,v ) );
+            if( property.isList() )
+            {
+              converter >> numEntries;
+              if( !converter )
+                throw std::runtime_error( "Face conversion error: Expecting number of entries" );
+            }
 
-          if( pair.second )
-            simplices.push_back( Simplex( edge.begin(), edge.end() ) );
-        }
+            for( std::size_t k = 0; k < numEntries; k++ )
+            {
+              double value = 0.0;
+
+              converter >> value;
+
+              if( !converter )
+                throw std::runtime_error( "Unable to parse vertex indices" );
+
+              if( j == indicesIndex )
+                surface.indices.push_back( static_cast<std::uint32_t>( value ) );
+            }
+          }
 
-        simplices.push_back( triangle );
+          surface.offsets.push_back( static_cast<std::uint32_t>( surface.indices.size() ) );
+        }
       }
+
+      // Skip all other elements -----------------------------------------
+
       else
-        throw std::runtime_error( "Format error: Expecting triangular faces only" );
+      {
+        for( std::size_t i = 0; i < element.count; i++ )
+          std::getline( in, line );
+      }
     }
 
-    return simplices;
+    return surface;
   }
 
   /** Data property to assign to new simplices */
   std::string _property = "z";
-
-  /** Coordinates stored by the current run of the reader */
-  std::vector< std::vector<double> > _coordinates;
 };
 
 } // namespace io
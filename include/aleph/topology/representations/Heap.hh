@@ -32,26 +32,14 @@ public:
 
   std::pair<Index, bool> getMaximumIndex( Index column ) const
   {
-    if( _data.at( static_cast<std::size_t>( column ) ).empty() )
+    auto&& column_ = _data.at( static_cast<std::size_t>( column ) );
+
+    // Every modification of a column ensures that its maximum is valid,
+    // so the query does not have to change the column.
+    if( column_.empty() )
       return std::make_pair( Index(0), false );
     else
-    {
-      auto&& column_ = _data.at( static_cast<std::size_t>( column ) );
-      auto index     = column_.front();
-
-      std::pop_heap( column_.begin(), column_.end() );
-
-      while( !column_.empty() && column_.front() == index )
-      {
-        std::pop_heap( column_.begin(), column_.end() );
-        column_.pop_back();
-
-        if( column_.empty() )
-          return std::make_pair( Index(0), false );
-      }
-
-      return std::make_pair( index, true );
-    }
+      return std::make_pair( column_.front(), true );
   }
 
   void addColumns( Index source, Index target )
@@ -66,6 +54,8 @@ public:
       targetColumn.push_back( value );
       std::push_heap( targetColumn.begin(), targetColumn.end() );
     }
+
+    this->prune( targetColumn );
   }
 
   template <class InputIterator> void setColumn( Index column,
@@ -76,6 +66,7 @@ public:
     // Ensures proper heap order. Else, the reduction algorithm will
     // not be able to reduce the matrix.
     std::make_heap( _data.at( static_cast<std::size_t>( column ) ).begin(), _data.at( static_cast<std::size_t>( column ) ).end() );
+    this->prune( _data.at( static_cast<std::size_t>( column ) ) );
 
     // Upon initialization, the column must by necessity have the dimension
     // that is indicated by the amount of indices in its boundary. The case
@@ -87,7 +78,23 @@ public:
 
   std::vector<Index> getColumn( Index column ) const
   {
-    return _data.at( static_cast<std::size_t>( column ) );
+    auto column_ = _data.at( static_cast<std::size_t>( column ) );
+    std::sort( column_.begin(), column_.end() );
+
+    // Removes all pairs of identical indices, which cancel each other,
+    // in order to obtain the actual entries of the column.
+    std::vector<Index> result;
+    result.reserve( column_.size() );
+
+    for( auto&& index : column_ )
+    {
+      if( !result.empty() && result.back() == index )
+        result.pop_back();
+      else
+        result.push_back( index );
+    }
+
+    return result;
   }
 
   void clearColumn( Index column )
@@ -119,6 +126,37 @@ public:
   }
 
 private:
+
+  /**
+    Columns are stored lazily: adding a column only pushes its indices
+    onto the heap. Since coefficients are in Z/2Z, pairs of identical
+    indices cancel each other. This function removes them from the top
+    of the heap until the maximum occurs exactly once, which ensures that
+    the maximum of a column is valid without querying the whole column.
+  */
+
+  static void prune( std::vector<Index>& column )
+  {
+    while( !column.empty() )
+    {
+      auto index = column.front();
+
+      std::pop_heap( column.begin(), column.end() );
+      column.pop_back();
+
+      if( column.empty() || column.front() != index )
+      {
+        column.push_back( index );
+        std::push_heap( column.begin(), column.end() );
+
+        return;
+      }
+
+      std::pop_heap( column.begin(), column.end() );
+      column.pop_back();
+    }
+  }
+
   std::vector< std::vector<Index> > _data;
   std::vector<Index> _dimensions;
 };
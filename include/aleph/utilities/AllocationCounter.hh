@@ -0,0 +1,227 @@
+#ifndef ALEPH_UTILITIES_ALLOCATION_COUNTER_HH__
+#define ALEPH_UTILITIES_ALLOCATION_COUNTER_HH__
+
+#include <aleph/utilities/Instrumentation.hh>
+
+#include <atomic>
+#include <new>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+/*
+  Replaces the global allocation functions in order to count allocations.
+  Every allocation is reported to the instrumentation, which permits it to
+  report the number of allocations of every phase, and to global heap
+  statistics, which track the number of bytes in use. Since this header
+  *defines* functions, it must be included in exactly one translation
+  unit of a program, usually the one containing `main()`.
+
+  The allocation functions are only replaced if instrumentation is
+  available or if `ALEPH_WITH_HEAP_STATISTICS` has been defined prior to
+  including this header, as is done by the benchmarks. Otherwise, this
+  header does nothing.
+*/
+
+namespace aleph
+{
+
+namespace utilities
+{
+
+/**
+  @class HeapStatistics
+  @brief Global statistics about heap allocations
+
+  Tracks the number of allocations as well as the current and the peak
+  number of bytes on the heap. The peak may be reset before running a
+  calculation in order to measure its memory requirements. All values
+  remain zero unless the allocation functions have been replaced.
+*/
+
+class HeapStatistics
+{
+public:
+  static HeapStatistics& instance()
+  {
+    static HeapStatistics statistics;
+    return statistics;
+  }
+
+  void allocate( std::size_t size ) noexcept
+  {
+    _allocations.fetch_add( 1, std::memory_order_relaxed );
+
+    auto current = _current.fetch_add( size, std::memory_order_relaxed ) + size;
+    auto peak    = _peak.load( std::memory_order_relaxed );
+
+    while( current > peak && !_peak.compare_exchange_weak( peak, current, std::memory_order_relaxed ) )
+    {
+    }
+  }
+
+  void deallocate( std::size_t size ) noexcept
+  {
+    _current.fetch_sub( size, std::memory_order_relaxed );
+  }
+
+  /** Resets the peak to the number of bytes that are currently in use */
+  void resetPeak() noexcept
+  {
+    _peak.store( _current.load() );
+  }
+
+  std::uint64_t allocations() const noexcept { return _allocations.load(); }
+  std::uint64_t current()     const noexcept { return _current.load();     }
+  std::uint64_t peak()        const noexcept { return _peak.load();        }
+
+private:
+  HeapStatistics() = default;
+
+  std::atomic<std::uint64_t> _allocations{ 0 };
+  std::atomic<std::uint64_t> _current{ 0 };
+  std::atomic<std::uint64_t> _peak{ 0 };
+};
+
+} // namespace utilities
+
+} // namespace aleph
+
+#if defined( ALEPH_WITH_INSTRUMENTATION ) || defined( ALEPH_WITH_HEAP_STATISTICS )
+
+namespace aleph
+{
+
+namespace utilities
+{
+
+namespace detail
+{
+
+// Every allocation is preceded by a header that stores its size, which
+// is required for tracking deallocations. The header size preserves the
+// alignment guaranteed by `std::malloc()`.
+constexpr std::size_t allocationHeaderSize = alignof( std::max_align_t );
+
+// The functions must not be inlined into the allocation functions, and
+// thus into their callers. Else, the compiler is able to see a call of
+// `std::free()` on memory obtained from `operator new` and warns about
+// a mismatched deallocation, even though the memory has been obtained
+// from `std::malloc()`.
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+  __attribute__((noinline))
+#elif defined( _MSC_VER )
+  __declspec(noinline)
+#endif
+void* allocate( std::size_t size ) noexcept
+{
+  if( size == 0 )
+    size = 1;
+
+  auto p = static_cast<char*>( std::malloc( size + allocationHeaderSize ) );
+  if( !p )
+    return nullptr;
+
+  *reinterpret_cast<std::size_t*>( p ) = size;
+
+  ++instrumentation::detail::numAllocations();
+  HeapStatistics::instance().allocate( size );
+
+  return p + allocationHeaderSize;
+}
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+  __attribute__((noinline))
+#elif defined( _MSC_VER )
+  __declspec(noinline)
+#endif
+void deallocate( void* ptr ) noexcept
+{
+  if( !ptr )
+    return;
+
+  auto p = static_cast<char*>( ptr ) - allocationHeaderSize;
+
+  HeapStatistics::instance().deallocate( *reinterpret_cast<std::size_t*>( p ) );
+  std::free( p );
+}
+
+} // namespace detail
+
+} // namespace utilities
+
+} // namespace aleph
+
+// Some versions of GCC still warn about mismatched deallocations if the
+// replacement functions are inlined into their callers, so the warning
+// is disabled for them.
+#if defined( __GNUC__ ) && !defined( __clang__ ) && __GNUC__ >= 11
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new( std::size_t size )
+{
+  if( void* p = aleph::utilities::detail::allocate( size ) )
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void* operator new[]( std::size_t size )
+{
+  if( void* p = aleph::utilities::detail::allocate( size ) )
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+  return aleph::utilities::detail::allocate( size );
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+  return aleph::utilities::detail::allocate( size );
+}
+
+void operator delete( void* p ) noexcept
+{
+  aleph::utilities::detail::deallocate( p );
+}
+
+void operator delete[]( void* p ) noexcept
+{
+  aleph::utilities::detail::deallocate( p );
+}
+
+void operator delete( void* p, const std::nothrow_t& ) noexcept
+{
+  aleph::utilities::detail::deallocate( p );
+}
+
+void operator delete[]( void* p, const std::nothrow_t& ) noexcept
+{
+  aleph::utilities::detail::deallocate( p );
+}
+
+void operator delete( void* p, std::size_t ) noexcept
+{
+  aleph::utilities::detail::deallocate( p );
+}
+
+void operator delete[]( void* p, std::size_t ) noexcept
+{
+  aleph::utilities::detail::deallocate( p );
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ ) && __GNUC__ >= 11
+  #pragma GCC diagnostic pop
+#endif
+
+#endif
+
+#endif
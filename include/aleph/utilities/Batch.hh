@@ -0,0 +1,155 @@
+#ifndef ALEPH_UTILITIES_BATCH_HH__
+#define ALEPH_UTILITIES_BATCH_HH__
+
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace utilities
+{
+
+/**
+  Processes a batch of independent work items, such as the input files
+  of a tool, in parallel and consumes their results in order.
+
+  Every item is processed by calling \p process with its index. These
+  calls run in parallel if OpenMP is available. The results are passed
+  to \p consume in the order of their indices, and the calls to \p
+  consume never overlap, so they may write to output streams or update
+  shared state without any synchronization. The output of a tool thus
+  does not depend on the number of jobs.
+
+  A thread that has finished processing an item waits until its result
+  has been consumed before it starts processing another item. Hence, at
+  most one result per job is kept in memory at any time, regardless of
+  the number of items.
+
+  If processing or consuming an item throws an exception, no further
+  items are processed, and the first exception, with respect to the
+  order of the items, is rethrown once all threads have finished.
+
+  @param n       Number of items
+  @param jobs    Number of jobs, i.e. threads; zero uses the default
+                 number of threads of OpenMP
+  @param process Functor for processing an item; it receives the index
+                 of the item and returns a result of some type, which
+                 must be default-constructible and movable
+  @param consume Functor for consuming a result; it receives the index
+                 of the item and its result
+*/
+
+template <class Process, class Consume> void processBatch( std::size_t n,
+                                                           unsigned jobs,
+                                                           Process process,
+                                                           Consume consume )
+{
+  using Result = decltype( process( std::size_t() ) );
+
+  std::atomic<bool> failed( false );
+  std::exception_ptr error;
+
+  auto run = [&] ( std::size_t i, Result& result, std::exception_ptr& itemError )
+  {
+    if( failed.load() )
+      return;
+
+    try
+    {
+      result = process( i );
+    }
+    catch( ... )
+    {
+      itemError = std::current_exception();
+    }
+  };
+
+  auto finish = [&] ( std::size_t i, Result& result, std::exception_ptr& itemError )
+  {
+    if( error )
+      return;
+
+    if( !itemError )
+    {
+      try
+      {
+        consume( i, std::move( result ) );
+      }
+      catch( ... )
+      {
+        itemError = std::current_exception();
+      }
+    }
+
+    if( itemError )
+    {
+      error = itemError;
+      failed.store( true );
+    }
+  };
+
+  // The ordered region forces every thread to wait until the results of
+  // all previous items have been consumed, which bounds the number of
+  // results that are kept in memory.
+  if( jobs == 0 )
+  {
+    #pragma omp parallel for ordered schedule(dynamic)
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      Result result;
+      std::exception_ptr itemError;
+
+      run( i, result, itemError );
+
+      #pragma omp ordered
+      finish( i, result, itemError );
+    }
+  }
+  else
+  {
+    #pragma omp parallel for ordered schedule(dynamic) num_threads(jobs)
+    for( std::size_t i = 0; i < n; i++ )
+    {
+      Result result;
+      std::exception_ptr itemError;
+
+      run( i, result, itemError );
+
+      #pragma omp ordered
+      finish( i, result, itemError );
+    }
+  }
+
+  if( error )
+    std::rethrow_exception( error );
+}
+
+/**
+  Parses the number of jobs for batch processing, as specified by the
+  `--jobs` option of a tool.
+
+  @param value Command-line argument
+  @returns Number of jobs; zero indicates the default number of threads
+*/
+
+inline unsigned parseJobs( const std::string& value )
+{
+  auto jobs = std::stol( value );
+
+  if( jobs < 0 )
+    throw std::runtime_error( "Number of jobs must not be negative" );
+
+  return static_cast<unsigned>( jobs );
+}
+
+} // namespace utilities
+
+} // namespace aleph
+
+#endif
@@ -0,0 +1,409 @@
+#ifndef ALEPH_UTILITIES_INSTRUMENTATION_HH__
+#define ALEPH_UTILITIES_INSTRUMENTATION_HH__
+
+#include <aleph/config/Instrumentation.hh>
+
+#include <aleph/utilities/Timer.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace aleph
+{
+
+namespace utilities
+{
+
+/*
+  Instrumentation of persistent homology calculations. Performance-critical
+  functions of the library, such as the calculation of persistence diagrams
+  or the reduction of boundary matrices, report the wall time of their
+  phases as well as statistics about their work to a global recorder.
+
+  Instrumentation is opt-in at two levels: it has to be enabled when the
+  library is configured, using `ALEPH_WITH_INSTRUMENTATION`, and it has to
+  be enabled at runtime, using `Recorder::enable()`. If the macro is not
+  defined, all classes in this namespace are empty and all functions do
+  nothing, so the compiler removes them entirely.
+*/
+
+namespace instrumentation
+{
+
+namespace detail
+{
+
+/**
+  @returns Number of allocations that have been performed by the current
+  thread. The value is only updated if the program includes the header
+  `AllocationCounter.hh` in one of its translation units.
+*/
+
+inline std::uint64_t& numAllocations() noexcept
+{
+  thread_local std::uint64_t n = 0;
+  return n;
+}
+
+} // namespace detail
+
+/**
+  @class Recorder
+  @brief Global collection of instrumentation data
+
+  Collects the wall time of phases as well as counters and maxima of
+  statistics. All functions are thread-safe, so phases that run in
+  different threads are accumulated.
+*/
+
+class Recorder
+{
+public:
+
+  /** Accumulated information about all calls of a phase */
+  struct Phase
+  {
+    std::uint64_t calls       = 0;
+    double seconds            = 0.0;
+    std::uint64_t allocations = 0;
+  };
+
+  /** @returns Global instance of the recorder */
+  static Recorder& instance()
+  {
+    static Recorder recorder;
+    return recorder;
+  }
+
+  void enable()  noexcept { _enabled.store( true  ); }
+  void disable() noexcept { _enabled.store( false ); }
+
+  bool enabled() const noexcept
+  {
+    return _enabled.load( std::memory_order_relaxed );
+  }
+
+  /** Removes all data that has been recorded so far */
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    _phases.clear();
+    _counters.clear();
+    _maxima.clear();
+  }
+
+  void addPhase( const std::string& name, double seconds, std::uint64_t allocations )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    auto&& phase        = _phases[name];
+    phase.calls        += 1;
+    phase.seconds      += seconds;
+    phase.allocations  += allocations;
+  }
+
+  void addCount( const std::string& name, std::int64_t n )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    _counters[name] += n;
+  }
+
+  void updateMaximum( const std::string& name, std::int64_t n )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    auto it = _maxima.find( name );
+    if( it == _maxima.end() )
+      _maxima[name] = n;
+    else
+      it->second = std::max( it->second, n );
+  }
+
+  std::map<std::string, Phase> phases() const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _phases;
+  }
+
+  std::map<std::string, std::int64_t> counters() const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _counters;
+  }
+
+  std::map<std::string, std::int64_t> maxima() const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _maxima;
+  }
+
+  /**
+    Writes all recorded data as a JSON object with the keys `phases`,
+    `counters`, and `maxima`. Every phase reports the number of calls,
+    its total wall time in seconds, and the number of allocations.
+  */
+
+  void writeJSON( std::ostream& out ) const
+  {
+    auto phases   = this->phases();
+    auto counters = this->counters();
+    auto maxima   = this->maxima();
+
+    auto writeValues = [&out] ( const std::map<std::string, std::int64_t>& values )
+    {
+      out << "{";
+
+      for( auto it = values.begin(); it != values.end(); ++it )
+      {
+        if( it != values.begin() )
+          out << ",";
+
+        out << "\n    \"" << it->first << "\": " << it->second;
+      }
+
+      out << ( values.empty() ? "}" : "\n  }" );
+    };
+
+    out << "{\n"
+        << "  \"phases\": {";
+
+    for( auto it = phases.begin(); it != phases.end(); ++it )
+    {
+      if( it != phases.begin() )
+        out << ",";
+
+      out << "\n    \"" << it->first << "\": {"
+          << "\"calls\": "       << it->second.calls       << ", "
+          << "\"seconds\": "     << it->second.seconds     << ", "
+          << "\"allocations\": " << it->second.allocations << "}";
+    }
+
+    out << ( phases.empty() ? "}" : "\n  }" ) << ",\n"
+        << "  \"counters\": ";
+
+    writeValues( counters );
+
+    out << ",\n"
+        << "  \"maxima\": ";
+
+    writeValues( maxima );
+
+    out << "\n}\n";
+  }
+
+  /** @returns JSON representation of all recorded data */
+  std::string toJSON() const
+  {
+    std::ostringstream stream;
+    this->writeJSON( stream );
+
+    return stream.str();
+  }
+
+private:
+  Recorder() = default;
+
+  std::atomic<bool> _enabled{ false };
+
+  mutable std::mutex _mutex;
+
+  std::map<std::string, Phase> _phases;
+  std::map<std::string, std::int64_t> _counters;
+  std::map<std::string, std::int64_t> _maxima;
+};
+
+/**
+  @returns true if instrumentation is available and has been enabled at
+  runtime. This is a compile-time constant if instrumentation is not
+  available, so any code that depends on it is removed.
+*/
+
+inline bool enabled() noexcept
+{
+#ifdef ALEPH_WITH_INSTRUMENTATION
+  return Recorder::instance().enabled();
+#else
+  return false;
+#endif
+}
+
+/** Adds a value to a counter if instrumentation is enabled */
+inline void count( const char* name, std::int64_t n )
+{
+  if( enabled() )
+    Recorder::instance().addCount( name, n );
+}
+
+/** Updates a maximum if instrumentation is enabled */
+inline void maximum( const char* name, std::int64_t n )
+{
+  if( enabled() )
+    Recorder::instance().updateMaximum( name, n );
+}
+
+/**
+  @class ScopedPhase
+  @brief Measures the wall time and allocations of a phase
+
+  Measures the time between its construction and its destruction and
+  reports it to the recorder under the given name. The name must refer
+  to a string that outlives the object.
+*/
+
+class ScopedPhase
+{
+public:
+
+#ifdef ALEPH_WITH_INSTRUMENTATION
+
+  explicit ScopedPhase( const char* name )
+    : _name( name )
+    , _active( enabled() )
+    , _allocations( detail::numAllocations() )
+  {
+  }
+
+  ~ScopedPhase()
+  {
+    if( _active )
+      Recorder::instance().addPhase( _name, _timer.elapsed_s(), detail::numAllocations() - _allocations );
+  }
+
+#else
+
+  explicit ScopedPhase( const char* )
+  {
+  }
+
+#endif
+
+  ScopedPhase( const ScopedPhase& )            = delete;
+  ScopedPhase& operator=( const ScopedPhase& ) = delete;
+
+#ifdef ALEPH_WITH_INSTRUMENTATION
+
+private:
+  const char* _name;
+  bool _active;
+  std::uint64_t _allocations;
+  Timer _timer;
+
+#endif
+};
+
+/**
+  @class Counter
+  @brief Local counter for statistics in hot loops
+
+  Counts events locally, without any synchronization, and adds the
+  total to the recorder upon destruction. If instrumentation is not
+  available, incrementing the counter does nothing.
+*/
+
+class Counter
+{
+public:
+
+#ifdef ALEPH_WITH_INSTRUMENTATION
+
+  explicit Counter( const char* name )
+    : _name( name )
+  {
+  }
+
+  ~Counter()
+  {
+    count( _name, _n );
+  }
+
+  Counter& operator++() noexcept
+  {
+    ++_n;
+    return *this;
+  }
+
+#else
+
+  explicit Counter( const char* )
+  {
+  }
+
+  Counter& operator++() noexcept
+  {
+    return *this;
+  }
+
+#endif
+
+  Counter( const Counter& )            = delete;
+  Counter& operator=( const Counter& ) = delete;
+
+#ifdef ALEPH_WITH_INSTRUMENTATION
+
+private:
+  const char* _name;
+  std::int64_t _n = 0;
+
+#endif
+};
+
+/**
+  @class ProfileWriter
+  @brief Exports instrumentation data of a tool
+
+  If the environment variable `ALEPH_PROFILE` contains a filename, this
+  class enables the recorder upon construction and writes all recorded
+  data in JSON format to the file upon destruction. Tools create an
+  instance at the beginning of `main()`. If instrumentation is not
+  available, the variable is ignored.
+*/
+
+class ProfileWriter
+{
+public:
+  ProfileWriter()
+  {
+#ifdef ALEPH_WITH_INSTRUMENTATION
+    auto filename = std::getenv( "ALEPH_PROFILE" );
+
+    if( filename && *filename )
+    {
+      _filename = filename;
+      Recorder::instance().enable();
+    }
+#endif
+  }
+
+  ~ProfileWriter()
+  {
+    if( !_filename.empty() )
+    {
+      std::ofstream out( _filename );
+      Recorder::instance().writeJSON( out );
+    }
+  }
+
+  ProfileWriter( const ProfileWriter& )            = delete;
+  ProfileWriter& operator=( const ProfileWriter& ) = delete;
+
+private:
+  std::string _filename;
+};
+
+} // namespace instrumentation
+
+} // namespace utilities
+
+} // namespace aleph
+
+#endif
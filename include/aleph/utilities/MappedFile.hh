@@ -0,0 +1,122 @@
+#ifndef ALEPH_UTILITIES_MAPPED_FILE_HH__
+#define ALEPH_UTILITIES_MAPPED_FILE_HH__
+
+// If either one of these is defined, there is a good chance that POSIX
+// concepts are available under the current architecture.
+#if defined(__unix__) || defined(__unix) || ( defined(__APPLE__) && defined(__MACH__) )
+  #define ALEPH_MAPPED_FILE_USE_MMAP
+#endif
+
+#ifdef ALEPH_MAPPED_FILE_USE_MMAP
+  #include <fcntl.h>
+  #include <unistd.h>
+
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace aleph
+{
+
+namespace utilities
+{
+
+/**
+  @class MappedFile
+  @brief Read-only view of the contents of a file
+
+  Maps a file into memory, so that its contents may be decoded in bulk
+  without copying them into intermediate buffers first. The operating
+  system takes care of loading pages on demand. If memory mapping is not
+  available on the current platform, the file is read into a buffer.
+*/
+
+class MappedFile
+{
+public:
+
+  explicit MappedFile( const std::string& filename )
+  {
+#ifdef ALEPH_MAPPED_FILE_USE_MMAP
+    _descriptor = ::open( filename.c_str(), O_RDONLY );
+    if( _descriptor < 0 )
+      throw std::runtime_error( "Unable to read input file" );
+
+    struct stat info;
+    if( ::fstat( _descriptor, &info ) != 0 )
+    {
+      ::close( _descriptor );
+      throw std::runtime_error( "Unable to determine size of input file" );
+    }
+
+    _size = static_cast<std::size_t>( info.st_size );
+
+    // Mapping an empty file is not permitted, but there is nothing to be
+    // read anyway.
+    if( _size > 0 )
+    {
+      auto address = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, _descriptor, 0 );
+      if( address == MAP_FAILED )
+      {
+        ::close( _descriptor );
+        throw std::runtime_error( "Unable to map input file" );
+      }
+
+      // The file is mostly decoded from the front to the back, which is
+      // worth telling the kernel about.
+      ::madvise( address, _size, MADV_SEQUENTIAL );
+
+      _data = static_cast<const char*>( address );
+    }
+#else
+    std::ifstream in( filename, std::ios::binary );
+    if( !in )
+      throw std::runtime_error( "Unable to read input file" );
+
+    _buffer.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+#endif
+  }
+
+  ~MappedFile()
+  {
+#ifdef ALEPH_MAPPED_FILE_USE_MMAP
+    if( _data )
+      ::munmap( const_cast<char*>( _data ), _size );
+
+    ::close( _descriptor );
+#endif
+  }
+
+  MappedFile( const MappedFile& )            = delete;
+  MappedFile& operator=( const MappedFile& ) = delete;
+
+  const char* data() const noexcept { return _data; }
+  std::size_t size() const noexcept { return _size; }
+
+private:
+  const char* _data = nullptr;
+  std::size_t _size = 0;
+
+#ifdef ALEPH_MAPPED_FILE_USE_MMAP
+  int _descriptor   = -1;
+#else
+  std::vector<char> _buffer;
+#endif
+};
+
+} // namespace utilities
+
+} // namespace aleph
+
+#endif
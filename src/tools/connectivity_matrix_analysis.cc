@@ -20,7 +20,10 @@
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
+#include <aleph/utilities/AllocationCounter.hh>
+#include <aleph/utilities/Batch.hh>
 #include <aleph/utilities/Filesystem.hh>
+#include <aleph/utilities/Instrumentation.hh>
 
 #include <cmath>
 
@@ -28,6 +31,7 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -35,7 +39,7 @@
 
 void usage()
 {
-  std::cerr << "Usage: connectivity_matrix_analysis [--dimension DIMENSION] [--infinity INF] FILENAMES\n"
+  std::cerr << "Usage: connectivity_matrix_analysis [--dimension DIMENSION] [--infinity INF] [--jobs N] FILENAMES\n"
             << "\n"
             << "Analyses a set of connectivity matrices. The matrices are optionally\n"
             << "expanded to a pre-defined dimension. By default, only information of\n"
@@ -44,6 +48,9 @@ void usage()
             << "The value INF will be used to replace infinite values in the diagram\n"
             << "in order to facilitate the subsequent analysis.\n"
             << "\n"
+            << "Matrices are processed in parallel by N jobs. By default, the number\n"
+            << "of available processors is used.\n"
+            << "\n"
             << "Flags:\n"
             << "  -k: keep & report unpaired simplices (infinite values)\n"
             << "  -v: verbose output\n"
@@ -52,10 +59,15 @@ void usage()
 
 int main( int argc, char** argv )
 {
+  // Writes instrumentation data to the file given by `ALEPH_PROFILE`,
+  // provided that the library has been configured accordingly.
+  aleph::utilities::instrumentation::ProfileWriter profileWriter;
+
   static option commandLineOptions[] =
   {
     { "dimension"     , required_argument, nullptr, 'd' },
     { "infinity"      , required_argument, nullptr, 'i' },
+    { "jobs"          , required_argument, nullptr, 'j' },
     { "keep-unpaired" , no_argument      , nullptr, 'k' },
     { "verbose"       , no_argument      , nullptr, 'v' },
     { nullptr         , 0                , nullptr,  0  }
@@ -65,11 +77,12 @@ int main( int argc, char** argv )
   double infinity    = std::numeric_limits<double>::infinity();
   bool keepUnpaired  = false;
   bool verbose       = false;
+  unsigned jobs      = 0;
 
   {
     int option = 0;
 
-    while( ( option = getopt_long( argc, argv, "d:i:kv", commandLineOptions, nullptr ) ) != -1 )
+    while( ( option = getopt_long( argc, argv, "d:i:j:kv", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( option )
       {
@@ -79,9 +92,15 @@ int main( int argc, char** argv )
       case 'i':
         infinity = static_cast<double>( std::stod(optarg) );
         break;
+      case 'j':
+        jobs = aleph::utilities::parseJobs( optarg );
+        break;
       case 'k':
         keepUnpaired = true;
         break;
+      case 'v':
+        verbose = true;
+        break;
       }
     }
   }
@@ -117,64 +136,79 @@ int main( int argc, char** argv )
   std::cout << "{\n"
             << "\"diagrams\": [\n";
 
-  for( auto&& filename : filenames )
-  {
-    if( verbose )
-      std::cerr << "* Processing " << filename << "...";
+  // Matrices are processed in parallel, but the diagrams are reported
+  // in the order of the input files.
+  aleph::utilities::processBatch( filenames.size(), jobs,
+    [&] ( std::size_t i )
+    {
+      auto&& filename = filenames[i];
 
-    SimplicialComplex K;
-    reader( filename, K,
-      [] ( DataType maxWeight, DataType /* minWeight */, DataType weight )
-      {
-        // Transform the weight into a *distance* by negating it; this
-        // ignores all other scaling mechanisms applied to the data.
-        return maxWeight - weight;
-      }
-    );
+      // The reader stores information about the current matrix, so every
+      // job requires its own copy.
+      auto matrixReader = reader;
 
-    K.sort();
+      SimplicialComplex K;
+      matrixReader( filename, K,
+        [] ( DataType maxWeight, DataType /* minWeight */, DataType weight )
+        {
+          // Transform the weight into a *distance* by negating it; this
+          // ignores all other scaling mechanisms applied to the data.
+          return maxWeight - weight;
+        }
+      );
 
-    bool dualize                    = true;
-    bool includeAllUnpairedCreators = keepUnpaired;
+      K.sort();
 
-    auto diagrams
-      = aleph::calculatePersistenceDiagrams( K,
-                                             dualize,
-                                             includeAllUnpairedCreators );
+      bool dualize                    = true;
+      bool includeAllUnpairedCreators = keepUnpaired;
 
-    if( verbose )
-      std::cerr << "finished\n";
+      auto diagrams
+        = aleph::calculatePersistenceDiagrams( K,
+                                               dualize,
+                                               includeAllUnpairedCreators );
 
-    auto basename
-      = aleph::utilities::basename( filename );
+      auto basename
+        = aleph::utilities::basename( filename );
 
-    for( auto&& diagram : diagrams )
-    {
-      if( std::isfinite( infinity ) )
+      std::ostringstream stream;
+
+      for( auto&& diagram : diagrams )
       {
-        std::transform( diagram.begin(), diagram.end(), diagram.begin(),
-            [&infinity] ( const Point& p )
-            {
-              if( p.isUnpaired() )
-                return Point( p.x(), infinity );
-              else
-                return Point( p.x(), p.y() );
-            }
-        );
+        if( std::isfinite( infinity ) )
+        {
+          std::transform( diagram.begin(), diagram.end(), diagram.begin(),
+              [&infinity] ( const Point& p )
+              {
+                if( p.isUnpaired() )
+                  return Point( p.x(), infinity );
+                else
+                  return Point( p.x(), p.y() );
+              }
+          );
+        }
+
+        // Stores additional data about each persistence diagram in order
+        // to make it easier to keep track of information.
+        std::map<std::string, std::string> kvs;
+
+        kvs["total_persistence_1"] = std::to_string( aleph::totalPersistence( diagram, 1.0 ) );
+        kvs["total_persistence_2"] = std::to_string( aleph::totalPersistence( diagram, 2.0 ) );
+
+        kvs["persistent_entropy"]  = std::to_string( aleph::persistentEntropy( diagram ) );
+
+        aleph::io::writeJSON( stream, diagram, basename, kvs );
       }
 
-      // Stores additional data about each persistence diagram in order
-      // to make it easier to keep track of information.
-      std::map<std::string, std::string> kvs;
-
-      kvs["total_persistence_1"] = std::to_string( aleph::totalPersistence( diagram, 1.0 ) );
-      kvs["total_persistence_2"] = std::to_string( aleph::totalPersistence( diagram, 2.0 ) );
-
-      kvs["persistent_entropy"]  = std::to_string( aleph::persistentEntropy( diagram ) );
+      return stream.str();
+    },
+    [&] ( std::size_t i, std::string&& json )
+    {
+      if( verbose )
+        std::cerr << "* Processed " << filenames[i] << "\n";
 
-      aleph::io::writeJSON( std::cout, diagram, basename, kvs );
+      std::cout << json;
     }
-  }
+  );
 
   std::cout << "\n"
             << "]\n"
@@ -22,7 +22,10 @@
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
+#include <aleph/utilities/AllocationCounter.hh>
+#include <aleph/utilities/Batch.hh>
 #include <aleph/utilities/Filesystem.hh>
+#include <aleph/utilities/Instrumentation.hh>
 
 #include <cassert>
 #include <cmath>
@@ -31,7 +34,6 @@
 #include <iostream>
 #include <fstream>
 #include <limits>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -47,56 +49,9 @@ using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
 using Point              = typename PersistenceDiagram::Point;
 using RipsExpander       = aleph::geometry::RipsExpander<SimplicialComplex>;
 
-/*
-  Class for collecting persistence diagrams for a set of input
-  filenames. The class is capable of merging the diagrams that
-  correspond to the same filename automatically. Diagrams will
-  be merged by taking a union of their points.
-*/
-
-class DiagramCollection
-{
-public:
-
-  // Slightly verbose, but makes for readable code later on
-  using Diagrams = std::vector<PersistenceDiagram>;
-  using Value    = Diagrams;
-  using Key      = std::string;
-  using Map      = std::map<Key, Value>;
-
-  template <class InputIterator> DiagramCollection( unsigned numDiagrams, InputIterator begin, InputIterator end )
-  {
-    // Fill collection with empty diagrams
-    for( auto it = begin; it != end; ++it )
-      _diagrams[ *it ] = Diagrams( numDiagrams );
-  }
-
-  template <class InputIterator> void update( const Key& key,
-                                              InputIterator begin,
-                                              InputIterator end )
-  {
-    // Let's not check for existence here but gamble a little bit ;-)
-    auto&& diagrams = _diagrams.at( key );
-    unsigned index  = 0;
-
-    // Again, no checking bounds because I am a little bit lazy.
-    for( auto it = begin; it != end; ++it )
-      diagrams.at( index++ ).merge( *it );
-  }
-
-  Diagrams& operator[]( const Key& key )
-  {
-    return _diagrams[ key ];
-  }
-
-private:
-
-  Map _diagrams;
-};
-
 void usage()
 {
-  std::cerr << "Usage: ephemeral [--dimension DIMENSION] [--infinity INF] FILENAMES\n"
+  std::cerr << "Usage: ephemeral [--dimension DIMENSION] [--infinity INF] [--jobs N] FILENAMES\n"
             << "\n"
             << "Analyses a set of connectivity matrices. The matrices are optionally\n"
             << "expanded to a pre-defined dimension. By default, only information of\n"
@@ -105,6 +60,9 @@ void usage()
             << "The value INF will be used to replace infinite values in the diagram\n"
             << "in order to facilitate the subsequent analysis.\n"
             << "\n"
+            << "Matrices are processed in parallel by N jobs. By default, the number\n"
+            << "of available processors is used.\n"
+            << "\n"
             << "Flags:\n"
             << "  -k: keep & report unpaired simplices (infinite values)\n"
             << "  -v: verbose output\n"
@@ -115,15 +73,11 @@ std::vector<PersistenceDiagram> processFilename( const std::string& filename,
                                                  double infinity,
                                                  unsigned dimension,
                                                  bool keepUnpaired,
-                                                 bool verbose,
                                                  bool reverse,
                                                  bool distance,
                                                  unsigned numDiagrams,
                                                  aleph::topology::io::AdjacencyMatrixReader reader )
 {
-  if( verbose )
-    std::cerr << "* Processing " << filename << "...";
-
   SimplicialComplex K;
 
   if( distance )
@@ -186,12 +140,6 @@ std::vector<PersistenceDiagram> processFilename( const std::string& filename,
       assert( D.dimension() == i );
   }
 
-  if( verbose )
-    std::cerr << "finished\n";
-
-  auto basename
-    = aleph::utilities::basename( filename );
-
   // Negate any finite values supplied by the user to ensure symmetry of
   // the reverse filtration.
   if( reverse && std::isfinite( infinity ) )
@@ -218,10 +166,15 @@ std::vector<PersistenceDiagram> processFilename( const std::string& filename,
 
 int main( int argc, char** argv )
 {
+  // Writes instrumentation data to the file given by `ALEPH_PROFILE`,
+  // provided that the library has been configured accordingly.
+  aleph::utilities::instrumentation::ProfileWriter profileWriter;
+
   static option commandLineOptions[] =
   {
     { "dimension"     , required_argument, nullptr, 'd' },
     { "infinity"      , required_argument, nullptr, 'i' },
+    { "jobs"          , required_argument, nullptr, 'j' },
     { "keep-unpaired" , no_argument      , nullptr, 'k' },
     { "verbose"       , no_argument      , nullptr, 'v' },
     { "distance"      , no_argument      , nullptr, 'D' },
@@ -233,11 +186,12 @@ int main( int argc, char** argv )
   bool keepUnpaired  = false;
   bool verbose       = false;
   bool distance      = false;
+  unsigned jobs      = 0;
 
   {
     int option = 0;
 
-    while( ( option = getopt_long( argc, argv, "d:i:kvD", commandLineOptions, nullptr ) ) != -1 )
+    while( ( option = getopt_long( argc, argv, "d:i:j:kvD", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( option )
       {
@@ -247,9 +201,15 @@ int main( int argc, char** argv )
       case 'i':
         infinity = static_cast<double>( std::stod(optarg) );
         break;
+      case 'j':
+        jobs = aleph::utilities::parseJobs( optarg );
+        break;
       case 'k':
         keepUnpaired = true;
         break;
+      case 'v':
+        verbose = true;
+        break;
       case 'D':
         distance = true;
         break;
@@ -273,134 +233,108 @@ int main( int argc, char** argv )
   // unpaired features. This is required for bookkeeping.
   unsigned numDiagrams = keepUnpaired + dimension + 1;
 
-  DiagramCollection diagramCollection(
-      numDiagrams,
-      filenames.begin(),
-      filenames.end()
-  );
-
   aleph::topology::io::AdjacencyMatrixReader reader;
   reader.setIgnoreNaNs();
   reader.setIgnoreZeroWeights();
 
-  // No distance calculations are desired; calculate dual filtration and
-  // store them.
-  if( !distance )
-  {
-    // Ascending filtration ----------------------------------------------
-    //
-    // This filtration goes from *negatively* correlated features of the
-    // graphs to positively correlated ones.
+  // Ascending filtration: goes from *negatively* correlated features of
+  // the graphs to positively correlated ones.
+  auto ascendingReader = reader;
+  ascendingReader.setVertexWeightAssignmentStrategy(
+      aleph::topology::io::AdjacencyMatrixReader::VertexWeightAssignmentStrategy::AssignGlobalMinimum
+  );
 
-    bool reverse = false;
+  // Descending filtration: goes from *positively* correlated features of
+  // the graphs to negatively correlated ones.
+  auto descendingReader = reader;
+  descendingReader.setVertexWeightAssignmentStrategy(
+      aleph::topology::io::AdjacencyMatrixReader::VertexWeightAssignmentStrategy::AssignGlobalMaximum
+  );
 
-    // Whew, is there *really* no better way of specifying this strategy
-    // here as a qualified name?
-    reader.setVertexWeightAssignmentStrategy(
-        aleph::topology::io::AdjacencyMatrixReader::VertexWeightAssignmentStrategy::AssignGlobalMinimum
-    );
+  // Distance calculations: rephrase the expansion and creation of
+  // simplicial complexes accordingly.
+  auto distanceReader = reader;
+  distanceReader.setVertexWeightAssignmentStrategy(
+      aleph::topology::io::AdjacencyMatrixReader::VertexWeightAssignmentStrategy::AssignZero
+  );
 
-    for( auto&& filename : filenames )
+  // Every file is processed independently, and its diagrams are written
+  // as soon as all previous files have been handled. Hence, at most one
+  // set of diagrams per job is kept in memory.
+  aleph::utilities::processBatch( filenames.size(), jobs,
+    [&] ( std::size_t i )
     {
-      auto diagrams = processFilename( filename,
-                                       infinity,
-                                       dimension,
-                                       keepUnpaired,
-                                       verbose,
-                                       reverse,
-                                       distance,
-                                       numDiagrams,
-                                       reader
-      );
+      auto&& filename = filenames[i];
 
-      diagramCollection.update( filename, diagrams.begin(), diagrams.end() );
-    }
+      // No distance calculations are desired; calculate dual filtration
+      // and merge the diagrams of corresponding dimensions.
+      if( !distance )
+      {
+        auto diagrams = processFilename( filename,
+                                         infinity,
+                                         dimension,
+                                         keepUnpaired,
+                                         false, // ascending filtration
+                                         false, // no distance
+                                         numDiagrams,
+                                         ascendingReader
+        );
+
+        auto reverseDiagrams = processFilename( filename,
+                                                infinity,
+                                                dimension,
+                                                keepUnpaired,
+                                                true,  // descending filtration
+                                                false, // no distance
+                                                numDiagrams,
+                                                descendingReader
+        );
+
+        for( std::size_t d = 0; d < diagrams.size(); d++ )
+          diagrams[d].merge( reverseDiagrams[d] );
+
+        return diagrams;
+      }
+      else
+      {
+        return processFilename( filename,
+                                infinity,
+                                dimension,
+                                keepUnpaired,
+                                false, // no reverse filtration
+                                true,  // distance
+                                numDiagrams,
+                                distanceReader
+        );
+      }
+    },
 
-    // Descending filtration ---------------------------------------------
+    // Output ------------------------------------------------------------
     //
-    // This filtration goes from *positively* correlated features of the
-    // graphs to negatively correlated ones.
-
-    reverse = true;
-
-    // Whew, is there *really* no better way of specifying this strategy
-    // here as a qualified name?
-    reader.setVertexWeightAssignmentStrategy(
-        aleph::topology::io::AdjacencyMatrixReader::VertexWeightAssignmentStrategy::AssignGlobalMaximum
-    );
-
-    for( auto&& filename : filenames )
+    // After merging diagrams of corresponding dimensions, output all of
+    // them in text format. Again, this is not the most efficient format
+    // but it simplifies the remainder of the pipeline.
+    [&] ( std::size_t i, std::vector<PersistenceDiagram>&& diagrams )
     {
-      auto diagrams = processFilename( filename,
-                                       infinity,
-                                       dimension,
-                                       keepUnpaired,
-                                       verbose,
-                                       reverse,
-                                       distance,
-                                       numDiagrams,
-                                       reader
-      );
-
-      diagramCollection.update( filename, diagrams.begin(), diagrams.end() );
-    }
-  }
-
-  // Distance calculations are desired, rephrase the expansion and
-  // creation of simplicial complexes accordingly.
-  else
-  {
-    reader.setVertexWeightAssignmentStrategy(
-        aleph::topology::io::AdjacencyMatrixReader::VertexWeightAssignmentStrategy::AssignZero
-    );
+      auto&& filename = filenames[i];
 
-    for( auto&& filename : filenames )
-    {
-      auto diagrams = processFilename( filename,
-                                       infinity,
-                                       dimension,
-                                       keepUnpaired,
-                                       verbose,
-                                       false, // no reverse filtration
-                                       true,  // distance
-                                       numDiagrams,
-                                       reader
-      );
-
-      diagramCollection.update( filename, diagrams.begin(), diagrams.end() );
-    }
-
-    for( auto&& filename : filenames )
-    {
       if( verbose )
-        std::cerr << "* Processing " << filename << "...";
-
-      SimplicialComplex K;
-    }
-  }
-
-  // Output ------------------------------------------------------------
-  //
-  // After merging diagrams of corresponding dimensions, output all of
-  // them in text format. Again, this is not the most efficient format
-  // but it simplifies the remainder of the pipeline.
+        std::cerr << "* Processed " << filename << "\n";
 
-  for( auto&& filename : filenames )
-  {
-    auto&& diagrams = diagramCollection[ filename ];
-    auto basename   = aleph::utilities::basename( filename );
-    basename        = aleph::utilities::stem( basename );
-    unsigned index  = 0;
+      auto basename   = aleph::utilities::basename( filename );
+      basename        = aleph::utilities::stem( basename );
+      unsigned index  = 0;
 
-    for( auto&& D : diagrams )
-    {
-      auto output = "/tmp/"
-                  + basename
-                  + "_d" + std::to_string( index++ )
-                  + ".txt";
+      for( auto&& D : diagrams )
+      {
+        auto output = "/tmp/"
+                    + basename
+                    + "_d" + std::to_string( index++ )
+                    + ".txt";
 
-      std::ofstream out( output );
-      out << D;
+        std::ofstream out( output );
+        out << D;
+      }
     }
-  }
+  );
 }
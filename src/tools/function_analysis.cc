@@ -12,12 +12,16 @@
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
+#include <aleph/utilities/AllocationCounter.hh>
+#include <aleph/utilities/Batch.hh>
+#include <aleph/utilities/Instrumentation.hh>
 #include <aleph/utilities/String.hh>
 
 #include <fstream>
 #include <istream>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -88,35 +92,36 @@ std::pair<DataType, DataType> minmaxData( const SimplicialComplex& K )
   return std::make_pair( min, max );
 }
 
-std::vector<SimplicialComplex> readData( std::istream& in, bool useSublevelSetFiltration )
-{
-  std::vector<SimplicialComplex> complexes;
-  std::string line;
+/**
+  Creates a simplicial complex from a line of the input data, which
+  contains the values of a function, and establishes the filtration
+  order of the complex.
+*/
 
-  while( std::getline( in, line ) )
-  {
-    auto tokens
-      = aleph::utilities::split(
-          line,
-          std::string( "[:;,[:space:]]+" )
-    );
+SimplicialComplex makeComplex( const std::string& line, bool useSublevelSetFiltration )
+{
+  auto tokens
+    = aleph::utilities::split(
+        line,
+        std::string( "[:;,[:space:]]+" )
+  );
 
-    std::vector<DataType> values;
-    values.reserve( tokens.size() );
+  std::vector<DataType> values;
+  values.reserve( tokens.size() );
 
-    for( auto&& token : tokens )
-    {
-      bool success = false;
-      auto value   = aleph::utilities::convert<DataType>( token, success );
+  for( auto&& token : tokens )
+  {
+    bool success = false;
+    auto value   = aleph::utilities::convert<DataType>( token, success );
 
-      if( !success )
-        throw std::runtime_error( "Unable to convert token to expected data type" );
+    if( !success )
+      throw std::runtime_error( "Unable to convert token to expected data type" );
 
-      values.emplace_back( value );
-    }
+    values.emplace_back( value );
+  }
 
-    complexes.push_back(
-      aleph::topology::io::loadFunction<SimplicialComplex>(
+  auto K
+    = aleph::topology::io::loadFunction<SimplicialComplex>(
         values.begin(), values.end(),
         [&useSublevelSetFiltration] ( DataType x, DataType y )
         {
@@ -125,30 +130,26 @@ std::vector<SimplicialComplex> readData( std::istream& in, bool useSublevelSetFi
           else
             return std::min(x,y);
         }
-      )
-    );
+  );
 
-    auto&& K = complexes.back();
-
-    // Establish filtration order of the simplicial complex. For the
-    // sublevel set filtration, regular sorting is sufficient, while
-    // for the superlevel set filtration, the comparison functor has
-    // to be swapped out.
-    if( useSublevelSetFiltration )
-    {
-      K.sort(
-        aleph::topology::filtrations::Data< Simplex, std::less<DataType> >()
-      );
-    }
-    else
-    {
-      K.sort(
-        aleph::topology::filtrations::Data< Simplex, std::greater<DataType> >()
-      );
-    }
+  // Establish filtration order of the simplicial complex. For the
+  // sublevel set filtration, regular sorting is sufficient, while
+  // for the superlevel set filtration, the comparison functor has
+  // to be swapped out.
+  if( useSublevelSetFiltration )
+  {
+    K.sort(
+      aleph::topology::filtrations::Data< Simplex, std::less<DataType> >()
+    );
+  }
+  else
+  {
+    K.sort(
+      aleph::topology::filtrations::Data< Simplex, std::greater<DataType> >()
+    );
   }
 
-  return complexes;
+  return K;
 }
 
 void usage()
@@ -157,6 +158,10 @@ void usage()
 
 int main( int argc, char** argv )
 {
+  // Writes instrumentation data to the file given by `ALEPH_PROFILE`,
+  // provided that the library has been configured accordingly.
+  aleph::utilities::instrumentation::ProfileWriter profileWriter;
+
   // Options parsing ---------------------------------------------------
   //
   // By default, a sublevel set filtration is being calculated for the
@@ -166,12 +171,14 @@ int main( int argc, char** argv )
   bool condense                 = false;
   bool normalize                = false;
   bool useSublevelSetFiltration = true;
+  unsigned jobs                 = 0;
   std::string output;
 
   {
     static option commandLineOptions[] =
     {
       { "condense"   , no_argument      , nullptr, 'c' },
+      { "jobs"       , required_argument, nullptr, 'j' },
       { "normalize"  , no_argument      , nullptr, 'n' },
       { "sublevels"  , no_argument      , nullptr, 's' },
       { "superlevels", no_argument      , nullptr, 'S' },
@@ -180,7 +187,7 @@ int main( int argc, char** argv )
     };
 
     int option = 0;
-    while( ( option = getopt_long( argc, argv, "cno:sS", commandLineOptions, nullptr ) ) != -1 )
+    while( ( option = getopt_long( argc, argv, "cj:no:sS", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( option )
       {
@@ -188,6 +195,10 @@ int main( int argc, char** argv )
         condense = true;
         break;
 
+      case 'j':
+        jobs = aleph::utilities::parseJobs( optarg );
+        break;
+
       case 'n':
         normalize = true;
         break;
@@ -216,7 +227,10 @@ int main( int argc, char** argv )
     return -1;
   }
 
-  std::vector<SimplicialComplex> complexes;
+  // Every line of the input data describes a single function. Lines are
+  // only converted to simplicial complexes when they are processed, so
+  // at most one complex per job is kept in memory.
+  std::vector<std::string> lines;
 
   for( int i = optind; i < argc; i++ )
   {
@@ -232,17 +246,14 @@ int main( int argc, char** argv )
       in = &fin;
     }
 
-    auto localComplexes
-      = readData( *in, useSublevelSetFiltration );
+    std::string line;
+    while( std::getline( *in, line ) )
+      lines.push_back( line );
 
     std::cerr << "finished\n";
-
-    complexes.insert( complexes.end(),
-      localComplexes.begin(), localComplexes.end()
-    );
   }
 
-  std::cerr << "* Read " << complexes.size() << " simplicial complexes\n";
+  std::cerr << "* Read " << lines.size() << " functions\n";
 
   // Persistent homology calculation -----------------------------------
   //
@@ -259,75 +270,86 @@ int main( int argc, char** argv )
     out = &fout;
   }
 
-  for( auto&& K : complexes )
-  {
-    auto diagrams = aleph::calculatePersistenceDiagrams( K );
-    auto minmax   = minmaxData( K );
+  aleph::utilities::processBatch( lines.size(), jobs,
+    [&] ( std::size_t i )
+    {
+      auto K        = makeComplex( lines[i], useSublevelSetFiltration );
+      auto diagrams = aleph::calculatePersistenceDiagrams( K );
+      auto minmax   = minmaxData( K );
 
-    if( diagrams.size() != 1 )
-      throw std::runtime_error( "Unexpected number of persistence diagrams" );
+      if( diagrams.size() != 1 )
+        throw std::runtime_error( "Unexpected number of persistence diagrams" );
 
-    auto&& D    = diagrams.front();
-    using Point = typename PersistenceDiagram::Point;
+      auto&& D    = diagrams.front();
+      using Point = typename PersistenceDiagram::Point;
 
-    if( D.betti() != 1 )
-      throw std::runtime_error( "Unexpected Betti number" );
+      if( D.betti() != 1 )
+        throw std::runtime_error( "Unexpected Betti number" );
 
-    std::transform( D.begin(), D.end(), D.begin(),
-      [&minmax, &useSublevelSetFiltration] ( const Point& p )
-      {
-        if( !std::isfinite( p.y() ) )
+      std::transform( D.begin(), D.end(), D.begin(),
+        [&minmax, &useSublevelSetFiltration] ( const Point& p )
         {
-          // Use the *maximum* weight for the sublevel set filtration so
-          // that all points are *above* the diagonal, and vice versa in
-          // case of the superlevel set filtration.
-          auto y = useSublevelSetFiltration
-            ? minmax.second
-            : minmax.first;
-
-          return Point( p.x(), y );
+          if( !std::isfinite( p.y() ) )
+          {
+            // Use the *maximum* weight for the sublevel set filtration so
+            // that all points are *above* the diagonal, and vice versa in
+            // case of the superlevel set filtration.
+            auto y = useSublevelSetFiltration
+              ? minmax.second
+              : minmax.first;
+
+            return Point( p.x(), y );
+          }
+
+          // Just copy the original point; this is not highly efficient
+          // but the amount of data should not be too large
+          else
+            return Point( p );
         }
+      );
 
-        // Just copy the original point; this is not highly efficient
-        // but the amount of data should not be too large
-        else
-          return Point( p );
+      // Check the suitability prior to performing normalization of all
+      // persistence diagrams.
+      if( normalize and minmax.first != minmax.second )
+      {
+        auto range = minmax.second - minmax.first;
+
+        std::transform( D.begin(), D.end(), D.begin(),
+          [&minmax, &range] ( const Point& p )
+          {
+            return Point(
+              (p.x() - minmax.first ) / range,
+              (p.y() - minmax.first ) / range
+            );
+          }
+        );
       }
-    );
 
-    // Check the suitability prior to performing normalization of all
-    // persistence diagrams.
-    if( normalize and minmax.first != minmax.second )
-    {
-      auto range = minmax.second - minmax.first;
+      std::ostringstream stream;
 
-      std::transform( D.begin(), D.end(), D.begin(),
-        [&minmax, &range] ( const Point& p )
+      if( condense )
+      {
+        auto values = condensePersistenceDiagram( D );
+        for( auto it = values.begin(); it != values.end(); ++it )
         {
-          return Point(
-            (p.x() - minmax.first ) / range,
-            (p.y() - minmax.first ) / range
-          );
-        }
-      );
-    }
+          if( it != values.begin() )
+            stream << " ";
 
-    if( condense )
-    {
-      auto values = condensePersistenceDiagram( D );
-      for( auto it = values.begin(); it != values.end(); ++it )
-      {
-        if( it != values.begin() )
-          *out << " ";
+          stream << *it;
+        }
 
-        *out << *it;
+        stream << "\n";
       }
+      else
+        stream << D << "\n\n";
 
-      *out << "\n";
+      return stream.str();
+    },
+    [&out] ( std::size_t, std::string&& text )
+    {
+      *out << text;
     }
-    else
-      *out << D << "\n\n";
-  }
+  );
 
   std::cerr << "finished\n";
 }
@@ -15,11 +15,13 @@
 
 #include <aleph/persistenceDiagrams/io/Raw.hh>
 
+#include <aleph/utilities/Batch.hh>
 #include <aleph/utilities/Filesystem.hh>
 
 #include <iostream>
 #include <limits>
 #include <numeric>
+#include <sstream>
 #include <string>
 #include <regex>
 #include <vector>
@@ -31,15 +33,6 @@
 using DataType           = double;
 using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
 
-struct Input
-{
-  std::string filename;
-  PersistenceDiagram persistenceDiagram;
-
-  std::string name;   // data set name
-  unsigned dimension; // dimension of diagram
-};
-
 void usage()
 {
   std::cerr << "Usage: persistence_diagram_statistics FILES\n"
@@ -54,6 +47,10 @@ void usage()
             << "\n"
             << "Optional arguments:\n"
             << "\n"
+            << " --jobs   : Use the specified number of jobs for processing files in\n"
+            << "            parallel. By default, the number of available processors\n"
+            << "            is used. Output is always reported in input order.\n"
+            << "\n"
             << " --invalid: Use the specified value to ignore certain values in every\n"
             << "            persistence diagram. This is useful if invalid values are\n"
             << "            encoded in the data.\n"
@@ -97,16 +94,18 @@ int main( int argc, char** argv )
   static option commandLineOptions[] =
   {
     { "invalid"       , required_argument, nullptr, 'i' },
+    { "jobs"          , required_argument, nullptr, 'j' },
     { "power"         , required_argument, nullptr, 'p' },
     { nullptr         , 0                , nullptr,  0  }
   };
 
   DataType invalid = std::numeric_limits<DataType>::has_quiet_NaN ? std::numeric_limits<DataType>::quiet_NaN() : std::numeric_limits<DataType>::max();
   double p         = 2.0;
+  unsigned jobs    = 0;
 
   {
     int option = 0;
-    while( ( option = getopt_long( argc, argv, "i:p:", commandLineOptions, nullptr ) ) != -1 )
+    while( ( option = getopt_long( argc, argv, "i:j:p:", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( option )
       {
@@ -114,6 +113,10 @@ int main( int argc, char** argv )
         invalid = static_cast<DataType>( std::stod( optarg ) );
         break;
 
+      case 'j':
+        jobs = aleph::utilities::parseJobs( optarg );
+        break;
+
       default:
         p = std::stod( optarg );
         break;
@@ -127,8 +130,8 @@ int main( int argc, char** argv )
     return -1;
   }
 
-  std::vector<Input> inputs;
-  inputs.reserve( static_cast<std::size_t>( argc - optind ) );
+  std::vector<std::string> filenames( argv + optind, argv + argc );
+  bool filter = !std::isnan( invalid ) && invalid != std::numeric_limits<DataType>::max();
 
   std::vector<std::string> columns = {
     "file",
@@ -142,29 +145,6 @@ int main( int argc, char** argv )
     "average_persistence"
   };
 
-  for( int i = optind; i < argc; i++ )
-  {
-    std::string filename = argv[i];
-
-    std::cerr << "* Loading '" << filename << "'...";
-
-    std::string name;
-    unsigned dimension;
-
-    std::tie( name, dimension ) = parseFilename( filename );
-
-    Input input = {
-      filename,
-      aleph::io::load<DataType>( filename ),
-      name,
-      dimension
-    };
-
-    inputs.push_back( input );
-
-    std::cerr << "finished\n";
-  }
-
   // Header ------------------------------------------------------------
 
   {
@@ -178,46 +158,68 @@ int main( int argc, char** argv )
     std::cout << "\n";
   }
 
-  for( auto&& input : inputs )
-  {
-    if( !std::isnan( invalid ) && invalid != std::numeric_limits<DataType>::max() )
+  // Diagrams are processed in parallel, but every row is reported in
+  // the order of the input files.
+  aleph::utilities::processBatch( filenames.size(), jobs,
+    [&] ( std::size_t i )
     {
-      std::cerr << "* Filtering all persistence pairs that contain '" << invalid << "'...";
+      auto&& filename = filenames[i];
 
-      using Point = typename PersistenceDiagram::Point;
+      std::string name;
+      unsigned dimension;
 
-      std::transform( input.persistenceDiagram.begin(), input.persistenceDiagram.end(),
-                      input.persistenceDiagram.begin(),
-                      [&invalid] ( const Point& p )
-                      {
-                        if( p.x() == invalid || p.y() == invalid )
-                          return Point( DataType(), DataType() );
-                        else
-                          return Point( p );
-                      } );
+      std::tie( name, dimension ) = parseFilename( filename );
 
-      input.persistenceDiagram.removeDiagonal();
+      auto persistenceDiagram = aleph::io::load<DataType>( filename );
 
-      std::cerr << "\n";
-    }
+      if( filter )
+      {
+        using Point = typename PersistenceDiagram::Point;
+
+        std::transform( persistenceDiagram.begin(), persistenceDiagram.end(),
+                        persistenceDiagram.begin(),
+                        [&invalid] ( const Point& p )
+                        {
+                          if( p.x() == invalid || p.y() == invalid )
+                            return Point( DataType(), DataType() );
+                          else
+                            return Point( p );
+                        } );
+
+        persistenceDiagram.removeDiagonal();
+      }
 
-    auto totalPersistence           = aleph::totalPersistence( input.persistenceDiagram, p, false );
-    auto totalPersistenceNormalized = totalPersistence / static_cast<decltype(totalPersistence)>( input.persistenceDiagram.size() );
-    auto infinityNorm               = aleph::infinityNorm( input.persistenceDiagram );
+      auto totalPersistence           = aleph::totalPersistence( persistenceDiagram, p, false );
+      auto totalPersistenceNormalized = totalPersistence / static_cast<decltype(totalPersistence)>( persistenceDiagram.size() );
+      auto infinityNorm               = aleph::infinityNorm( persistenceDiagram );
 
-    std::vector<DataType> persistence;
-    aleph::persistence( input.persistenceDiagram, std::back_inserter( persistence ) );
+      std::vector<DataType> persistence;
+      aleph::persistence( persistenceDiagram, std::back_inserter( persistence ) );
 
-    auto averagePersistence         = std::accumulate( persistence.begin(), persistence.end(), 0.0 ) / static_cast<double>( input.persistenceDiagram.size() );
+      auto averagePersistence         = std::accumulate( persistence.begin(), persistence.end(), 0.0 ) / static_cast<double>( persistenceDiagram.size() );
 
-    std::cout << "'" << input.filename           << "'" << ","
-              << input.name                      << ","
-              << input.dimension                 << ","
-              << input.persistenceDiagram.size() << ","
-              << p                               << ","
-              << totalPersistence                << ","
-              << totalPersistenceNormalized      << ","
-              << infinityNorm                    << ","
-              << averagePersistence              << "\n";
-  }
+      std::ostringstream row;
+
+      row << "'" << filename                << "'" << ","
+          << name                           << ","
+          << dimension                      << ","
+          << persistenceDiagram.size()      << ","
+          << p                              << ","
+          << totalPersistence               << ","
+          << totalPersistenceNormalized     << ","
+          << infinityNorm                   << ","
+          << averagePersistence             << "\n";
+
+      return row.str();
+    },
+    [&] ( std::size_t i, std::string&& row )
+    {
+      std::cerr << "* Processed '" << filenames[i] << "'\n";
+
+      if( filter )
+        std::cerr << "* Filtered all persistence pairs that contain '" << invalid << "'\n";
+
+      std::cout << row;
+    }
+  );
 }
@@ -11,6 +11,7 @@
 */
 
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -25,6 +26,7 @@
 
 #include <aleph/persistenceDiagrams/io/Raw.hh>
 
+#include <aleph/utilities/Batch.hh>
 #include <aleph/utilities/Filesystem.hh>
 
 using DataType           = double;
@@ -32,7 +34,7 @@ using PersistenceDiagram = aleph::PersistenceDiagram<DataType>;
 
 void usage()
 {
-  std::cerr << "Usage: persistence_indicator_function [--mean] [--output=OUT] [--prefix=PRE] FILES\n"
+  std::cerr << "Usage: persistence_indicator_function [--jobs=N] [--mean] [--output=OUT] [--prefix=PRE] FILES\n"
             << "\n"
             << "Calculates persistence indicator functions from a set of persistence\n"
             << "diagrams, stored in FILES. Output will be written to '/tmp' and will\n"
@@ -41,6 +43,9 @@ void usage()
             << "Optionally, the mean indicator function is calculated as well, along\n"
             << "with information about the sample variance.\n"
             << "\n"
+            << "Files are processed in parallel by N jobs. By default, the number of\n"
+            << "available processors is used.\n"
+            << "\n"
             << "Flags:\n"
             << "  -m: calculate mean persistence diagram\n"
             << "\n";
@@ -50,6 +55,7 @@ int main( int argc, char** argv )
 {
   static option commandLineOptions[] =
   {
+    { "jobs"  , required_argument, nullptr, 'j' },
     { "mean"  , no_argument      , nullptr, 'm' },
     { "output", required_argument, nullptr, 'o' },
     { "prefix", required_argument, nullptr, 'p' },
@@ -65,13 +71,17 @@ int main( int argc, char** argv )
   std::string outputDirectory = "/tmp";
   std::string prefix          = "PIF_";
   bool calculateMean = false;
+  unsigned jobs      = 0;
 
   {
     int option = 0;
-    while( ( option = getopt_long( argc, argv, "mo:p:", commandLineOptions, nullptr ) ) != -1 )
+    while( ( option = getopt_long( argc, argv, "j:mo:p:", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( option )
       {
+      case 'j':
+        jobs = aleph::utilities::parseJobs( optarg );
+        break;
       case 'm':
         calculateMean = true;
         break;
@@ -106,65 +116,59 @@ int main( int argc, char** argv )
   for( int i = optind; i < argc; i++ )
     filenames.push_back( argv[i] );
 
-  // Load persistence diagrams -----------------------------------------
-
-  std::vector<PersistenceDiagram> persistenceDiagrams;
-  persistenceDiagrams.reserve( filenames.size() );
-
-  for( auto&& filename : filenames )
-  {
-    std::cerr << "* Processing '" << filename << "'...";
-
-    PersistenceDiagram persistenceDiagram = aleph::io::load<DataType>( filename );
-
-    // FIXME: This is only required in order to ensure that the
-    // persistence indicator function has a finite integral; it
-    // can be solved more elegantly by using a special value to
-    // indicate infinite intervals.
-    persistenceDiagram.removeUnpaired();
-
-    persistenceDiagrams.push_back( persistenceDiagram );
-
-    std::cerr << "finished\n";
-  }
-
   // Calculate persistence indicator functions -------------------------
+  //
+  // Diagrams are loaded and converted in parallel, but the functions are
+  // written in the order of the input files. Only their integrals are
+  // kept in memory for the variance calculation.
 
   using PersistenceIndicatorFunction = decltype( aleph::persistenceIndicatorFunction( PersistenceDiagram() ) );
 
-  std::vector<PersistenceIndicatorFunction> persistenceIndicatorFunctions;
-  persistenceIndicatorFunctions.reserve( persistenceDiagrams.size() );
+  std::vector<double> integrals;
+  integrals.reserve( filenames.size() );
 
   PersistenceIndicatorFunction mean;
 
-  unsigned i = 0;
-  for( auto&& D : persistenceDiagrams )
-  {
-    auto f        = aleph::persistenceIndicatorFunction( D );
-    auto filename = filenames.at(i);
+  aleph::utilities::processBatch( filenames.size(), jobs,
+    [&filenames] ( std::size_t i )
+    {
+      PersistenceDiagram persistenceDiagram = aleph::io::load<DataType>( filenames[i] );
 
-    if( calculateMean )
-      mean += f;
+      // FIXME: This is only required in order to ensure that the
+      // persistence indicator function has a finite integral; it
+      // can be solved more elegantly by using a special value to
+      // indicate infinite intervals.
+      persistenceDiagram.removeUnpaired();
 
-    using namespace aleph::utilities;
+      return aleph::persistenceIndicatorFunction( persistenceDiagram );
+    },
+    [&] ( std::size_t i, PersistenceIndicatorFunction&& f )
+    {
+      auto&& filename = filenames[i];
 
-    auto outputFilename = outputDirectory
-                        + prefix
-                        + stem( basename( filename ) ) + ".txt";
+      std::cerr << "* Processed '" << filename << "'\n";
 
-    std::cerr << "* Writing persistence indicator function to '" << outputFilename << "'...\n";
+      if( calculateMean )
+        mean += f;
 
-    std::ofstream out( outputFilename );
-    out << f << "\n";
+      using namespace aleph::utilities;
 
-    persistenceIndicatorFunctions.emplace_back( f );
+      auto outputFilename = outputDirectory
+                          + prefix
+                          + stem( basename( filename ) ) + ".txt";
 
-    ++i;
-  }
+      std::cerr << "* Writing persistence indicator function to '" << outputFilename << "'...\n";
+
+      std::ofstream out( outputFilename );
+      out << f << "\n";
+
+      integrals.push_back( f.integral() );
+    }
+  );
 
   if( calculateMean )
   {
-    mean                /= static_cast<DataType>( persistenceDiagrams.size() );
+    mean                /= static_cast<DataType>( filenames.size() );
     auto outputFilename  = outputDirectory
                          + prefix
                          + "mean.txt";
@@ -180,13 +184,12 @@ int main( int argc, char** argv )
 
     std::cerr << "* Norm of the mean persistence indicator function: " << Y << "\n";
 
-    std::vector<double> squaredDifferences( persistenceDiagrams.size() );
+    std::vector<double> squaredDifferences( integrals.size() );
 
-    std::transform( persistenceIndicatorFunctions.begin(), persistenceIndicatorFunctions.end(),
+    std::transform( integrals.begin(), integrals.end(),
                     squaredDifferences.begin(),
-                      [&Y] ( const PersistenceIndicatorFunction& f )
+                      [&Y] ( double Z )
                       {
-                        auto Z = f.integral();
                         return (Z-Y) * (Z-Y);
                       }
                     );
@@ -196,8 +199,8 @@ int main( int argc, char** argv )
                                               squaredDifferences.end(),
                                               0.0 );
 
-    if( persistenceDiagrams.size() > 1 )
-      s /= static_cast<double>( persistenceDiagrams.size() - 1 );
+    if( filenames.size() > 1 )
+      s /= static_cast<double>( filenames.size() - 1 );
     else
       s = std::numeric_limits<double>::infinity();
 
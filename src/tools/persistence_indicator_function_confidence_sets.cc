@@ -16,6 +16,7 @@
 #include <vector>
 
 #include <cmath>
+#include <cstdint>
 
 #include <getopt.h>
 
@@ -49,6 +50,8 @@ int main( int argc, char** argv )
   auto alpha                   = 0.05;
   unsigned numBootstrapSamples = 50;
   bool readStepFunctions       = false;
+  bool useSeed                 = false;
+  std::uint64_t seed           = 0;
 
   {
     static option commandLineOptions[] =
@@ -56,11 +59,12 @@ int main( int argc, char** argv )
       { "alpha"              , required_argument, nullptr, 'a' },
       { "bootstrap"          , required_argument, nullptr, 'b' },
       { "read-step-functions", no_argument      , nullptr, 's' },
+      { "seed"               , required_argument, nullptr, 'S' },
       { nullptr              , 0                , nullptr,  0  }
     };
 
     int c = 0;
-    while( ( c = getopt_long( argc, argv, "a:b:s", commandLineOptions, nullptr ) ) != -1 )
+    while( ( c = getopt_long( argc, argv, "a:b:sS:", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( c )
       {
@@ -76,6 +80,11 @@ int main( int argc, char** argv )
         readStepFunctions = true;
         break;
 
+      case 'S':
+        seed    = static_cast<std::uint64_t>( std::stoull( optarg ) );
+        useSeed = true;
+        break;
+
       default:
         throw std::runtime_error( "Unknown command-line parameter" );
       }
@@ -126,10 +135,15 @@ int main( int argc, char** argv )
 
   aleph::math::Bootstrap bootstrap;
 
-  bootstrap.makeReplicates( numBootstrapSamples,
-                            persistenceIndicatorFunctions.begin(), persistenceIndicatorFunctions.end(),
-                            meanCalculation,
-                            std::back_inserter( meanReplicates ) );
+  if( useSeed )
+    bootstrap.setSeed( seed );
+
+  // The replicates are reproducible for a given seed, regardless of the
+  // number of threads that are being used.
+  bootstrap.makeReplicatesParallel( numBootstrapSamples,
+                                    persistenceIndicatorFunctions.begin(), persistenceIndicatorFunctions.end(),
+                                    meanCalculation,
+                                    std::back_inserter( meanReplicates ) );
 
   auto empiricalMean = meanCalculation( persistenceIndicatorFunctions.begin(), persistenceIndicatorFunctions.end() );
 
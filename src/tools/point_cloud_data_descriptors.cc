@@ -80,7 +80,7 @@ void invertValues( std::vector<DataType>& values )
     value = max - value;
 }
 
-std::vector<DataType> calculateDataDescriptor( const std::string& name, const PointCloud& pointCloud, unsigned k, double h, unsigned p )
+std::vector<DataType> calculateDataDescriptor( const std::string& name, const PointCloud& pointCloud, unsigned k, double h, unsigned p, double tolerance )
 {
   if( name == "density" )
   {
@@ -96,6 +96,8 @@ std::vector<DataType> calculateDataDescriptor( const std::string& name, const Po
     return aleph::containers::eccentricities<Distance>( pointCloud, p );
   else if( name == "gaussian" )
     return aleph::containers::estimateDensityTruncatedGaussian( pointCloud, h );
+  else if( name == "kde" )
+    return aleph::containers::estimateDensityGaussian( pointCloud, h, tolerance );
 
   return {};
 }
@@ -106,7 +108,7 @@ void usage()
             << "                                    [--descriptor=DESC]\n"
             << "                                    [--epsilon=EPS] [--k=k]\n"
             << "                                    [--invert] [--normalize]\n"
-            << "                                    [--power=p]\n"
+            << "                                    [--power=p] [--tolerance=TOL]\n"
             << "                                    [--remove-unpaired] FILENAME\n"
             << "\n"
             << "Performs Vietoris--Rips expansion on the specified point cloud and\n"
@@ -129,6 +131,11 @@ void usage()
             << "- gaussian: uses a truncated Gaussian density estimator with a\n"
             << "            bandwidth of h. By default, h=0.01.\n"
             << "\n"
+            << "- kde: uses a Gaussian kernel density estimator with a bandwidth\n"
+            << "       of h. The estimates are accurate up to a relative error\n"
+            << "       of TOL, with TOL=0.001 by default. Use TOL=0 in order to\n"
+            << "       obtain exact estimates.\n"
+            << "\n"
             << "Several flags permit some control over the calculations:\n"
             << "--invert: inverts data descriptor values. This is useful for the\n"
             << "          eccentricity descriptor, for example, because it uses\n"
@@ -151,6 +158,7 @@ void usage()
             << "  -n: normalize values (no argument)\n"
             << "  -p: power for eccentricity calculation\n"
             << "  -r: remove unpaired simplices (no argument)\n"
+            << "  -t: tolerance for kernel density estimation\n"
             << "\n";
 }
 
@@ -167,6 +175,7 @@ int main( int argc, char** argv )
     { "normalize"      , no_argument      , nullptr, 'n' },
     { "power"          , required_argument, nullptr, 'p' },
     { "remove-unpaired", no_argument      , nullptr, 'r' },
+    { "tolerance"      , required_argument, nullptr, 't' },
     { nullptr          , 0                , nullptr,  0  }
   };
 
@@ -174,6 +183,7 @@ int main( int argc, char** argv )
   double h               = 0.01;        // default bandwidth (Gaussian estimator)
   unsigned k             = 10;          // default number of neighbours (density estimator)
   unsigned p             = 2;           // default power (eccentricity estimator)
+  double tolerance       = 1e-3;        // default tolerance (kernel density estimator)
   DataType epsilon       = DataType();  // default epsilon (point cloud expansion)
   std::string descriptor = "density";   // default data descriptor
 
@@ -183,7 +193,7 @@ int main( int argc, char** argv )
 
   {
     int option = 0;
-    while( ( option = getopt_long( argc, argv, "b:D:d:e:k:inp:r", commandLineOptions, nullptr ) ) != -1 )
+    while( ( option = getopt_long( argc, argv, "b:D:d:e:k:inp:rt:", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( option )
       {
@@ -214,6 +224,9 @@ int main( int argc, char** argv )
       case 'r':
         removeUnpairedSimplices = true;
         break;
+      case 't':
+        tolerance = std::stod( optarg );
+        break;
       }
     }
   }
@@ -237,7 +250,8 @@ int main( int argc, char** argv )
                                pointCloud,
                                k,
                                h,
-                               p );
+                               p,
+                               tolerance );
 
   if( invertDataDescriptorValues )
     invertValues( dataDescriptorValues );
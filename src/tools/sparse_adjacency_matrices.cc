@@ -16,7 +16,7 @@
 
 #include <aleph/persistentHomology/Calculation.hh>
 
-#include <aleph/topology/FloydWarshall.hh>
+#include <aleph/topology/ShortestPaths.hh>
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
@@ -26,7 +26,10 @@
 #include <aleph/topology/io/GML.hh>
 #include <aleph/topology/io/SparseAdjacencyMatrix.hh>
 
+#include <aleph/utilities/AllocationCounter.hh>
+#include <aleph/utilities/Batch.hh>
 #include <aleph/utilities/Format.hh>
+#include <aleph/utilities/Instrumentation.hh>
 #include <aleph/utilities/String.hh>
 
 #include <getopt.h>
@@ -48,7 +51,7 @@ using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
 
 std::vector<DataType> closenessCentrality( const SimplicialComplex& K )
 {
-  auto M = aleph::topology::floydWarshall( K, 1 );
+  auto M = aleph::topology::allPairsShortestPaths( K, 1 );
   auto n = M.numRows();
 
   std::vector<DataType> result;
@@ -82,6 +85,7 @@ void usage()
             << "\n"
             << " --dimension D: Expand simplicial complexes up to dimension D\n"
             << " --infinity I:  Use factor I for unpaired points in a diagram\n"
+            << " --jobs N:      Process graphs in parallel using N jobs\n"
             << "\n"
             << "Flags:\n"
             << "\n"
@@ -95,10 +99,15 @@ void usage()
 
 int main( int argc, char** argv )
 {
+  // Writes instrumentation data to the file given by `ALEPH_PROFILE`,
+  // provided that the library has been configured accordingly.
+  aleph::utilities::instrumentation::ProfileWriter profileWriter;
+
   static option commandLineOptions[] =
   {
     { "dimension"           , required_argument, nullptr, 'd' },
     { "infinity"            , required_argument, nullptr, 'f' },
+    { "jobs"                , required_argument, nullptr, 'j' },
     { "output"              , required_argument, nullptr, 'o' },
     { "attributes"          , no_argument      , nullptr, 'a' },
     { "closeness-centrality", no_argument      , nullptr, 'c' },
@@ -119,11 +128,12 @@ int main( int argc, char** argv )
   bool useSuperlevelSets            = false;
   bool normalise                    = false;
   DataType infinity                 = DataType(2);
+  unsigned jobs                     = 0;
   std::string output                = "/tmp";
 
   {
     int option = 0;
-    while( ( option = getopt_long( argc, argv, "d:f:o:acgnNsS", commandLineOptions, nullptr ) ) != -1 )
+    while( ( option = getopt_long( argc, argv, "d:f:j:o:acgnNsS", commandLineOptions, nullptr ) ) != -1 )
     {
       switch( option )
       {
@@ -133,6 +143,9 @@ int main( int argc, char** argv )
       case 'f':
         infinity = aleph::utilities::convert<DataType>( optarg );
         break;
+      case 'j':
+        jobs = aleph::utilities::parseJobs( optarg );
+        break;
       case 'o':
         output = optarg;
         break;
@@ -212,103 +225,102 @@ int main( int argc, char** argv )
 
   if( calculateClosenessCentrality )
   {
-    std::size_t index = 0;
-
-    for( auto&& K : simplicialComplexes )
-    {
-      K.sort();
-      auto cc         = closenessCentrality( K );
-      auto outputPath = output
-                      + aleph::utilities::format( index, simplicialComplexes.size() )
-                      + "_closeness_centrality.txt";
+    aleph::utilities::processBatch( simplicialComplexes.size(), jobs,
+      [&simplicialComplexes] ( std::size_t i )
+      {
+        auto&& K = simplicialComplexes[i];
 
-      std::cerr << "* Storing closeness centrality values in '" << outputPath << "'\n";
+        K.sort();
+        return closenessCentrality( K );
+      },
+      [&] ( std::size_t i, std::vector<DataType>&& cc )
+      {
+        auto outputPath = output
+                        + aleph::utilities::format( i, simplicialComplexes.size() )
+                        + "_closeness_centrality.txt";
 
-      std::ofstream out( outputPath );
-      for( auto&& value : cc )
-        out << value << "\n";
+        std::cerr << "* Storing closeness centrality values in '" << outputPath << "'\n";
 
-      ++index;
-    }
+        std::ofstream out( outputPath );
+        for( auto&& value : cc )
+          out << value << "\n";
+      }
+    );
   }
 
-  // Expand simplicial complexes ---------------------------------------
+  // Expand simplicial complexes & calculate degrees -------------------
+  //
+  // Every complex is handled independently; only the maximum degree and
+  // the maximum dimension are collected from all of them.
 
   aleph::geometry::RipsExpander<SimplicialComplex> expander;
 
   if( dimension != 0 )
-  {
-    std::cerr << "* Expanding simplicial complexes to dimension " << dimension << "...";
+    std::cerr << "* Expanding simplicial complexes to dimension " << dimension << "\n";
 
-    for( auto&& K : simplicialComplexes )
-      expander( K, dimension );
-
-    std::cerr << "finished\n";
-  }
+  std::cerr << "* Calculating degree-based filtration...";
 
   std::size_t maxDimension = 0;
+  DataType maxDegree       = 0;
 
-  // Determine maximum dimension; this will be required later on to
-  // ensure that we store persistence diagrams for each complex.
-  for( auto&& K : simplicialComplexes )
-    maxDimension = std::max( K.dimension(), maxDimension );
+  aleph::utilities::processBatch( simplicialComplexes.size(), jobs,
+    [&] ( std::size_t i )
+    {
+      auto&& K = simplicialComplexes[i];
 
-  // Calculate degrees -------------------------------------------------
+      if( dimension != 0 )
+        expander( K, dimension );
 
-  DataType maxDegree = 0;
+      // Determine maximum dimension; this will be required later on to
+      // ensure that we store persistence diagrams for each complex.
+      auto maxComplexDimension = K.dimension();
 
-  std::cerr << "* Calculating degree-based filtration...";
+      std::vector<unsigned> degrees_;
+      aleph::topology::filtrations::degrees( K, std::back_inserter( degrees_ ) );
 
-  for( auto&& K : simplicialComplexes )
-  {
-    std::vector<unsigned> degrees_;
-    aleph::topology::filtrations::degrees( K, std::back_inserter( degrees_ ) );
+      std::vector<DataType> degrees( degrees_.begin(), degrees_.end() );
 
-    std::vector<DataType> degrees( degrees_.begin(), degrees_.end() );
+      DataType maxComplexDegree = 0;
 
-    if( !degrees.empty() )
-    {
-      maxDegree
-        = std::max( maxDegree,
-                    *std::max_element( degrees.begin(), degrees.end() ) );
-    }
+      if( !degrees.empty() )
+        maxComplexDegree = *std::max_element( degrees.begin(), degrees.end() );
 
-    if( normalise )
-    {
-      std::transform( degrees.begin(), degrees.end(), degrees.begin(),
-                      [&maxDegree] ( DataType degree )
-                      {
-                        return degree / maxDegree;
-                      }
-      );
-
-      // The output will make more sense in case normalisation has been
-      // requested by the user.
-      maxDegree = 1.0;
-    }
+      // Every complex is normalised by its own maximum degree. Complexes
+      // without any edges keep their degrees of zero.
+      if( normalise )
+      {
+        auto divisor = std::max( maxComplexDegree, DataType(1) );
+
+        std::transform( degrees.begin(), degrees.end(), degrees.begin(),
+                        [&divisor] ( DataType degree )
+                        {
+                          return degree / divisor;
+                        }
+        );
+      }
 
-    if( useSumOfDegrees )
-      K = expander.assignData( K, degrees.begin(), degrees.end(), DataType(0), [] ( DataType a, DataType b ) { return a+b; } );
-    else
-    {
-      // Degrees are either use in a sublevel set fashion, or in
-      // a superlevel set one. For both filtrations, each vertex
-      // of the complex gets assigned its *original* degree. The
-      // edges of the complex are then handled using the functor
-      // specified below.
-      if( useSuperlevelSets )
+      if( useSumOfDegrees )
+        K = expander.assignData( K, degrees.begin(), degrees.end(), DataType(0), [] ( DataType a, DataType b ) { return a+b; } );
+      else
       {
-        auto init    = std::numeric_limits<DataType>::max();
-        auto functor = [] ( const DataType& a, const DataType& b )
+        // Degrees are either use in a sublevel set fashion, or in
+        // a superlevel set one. For both filtrations, each vertex
+        // of the complex gets assigned its *original* degree. The
+        // edges of the complex are then handled using the functor
+        // specified below.
+        if( useSuperlevelSets )
         {
-          return std::min( a, b );
-        };
+          auto init    = std::numeric_limits<DataType>::max();
+          auto functor = [] ( const DataType& a, const DataType& b )
+          {
+            return std::min( a, b );
+          };
 
-        K = expander.assignData( K, degrees.begin(), degrees.end(), init, functor );
+          K = expander.assignData( K, degrees.begin(), degrees.end(), init, functor );
+        }
+        else
+          K = expander.assignMaximumData( K, degrees.begin(), degrees.end() );
       }
-      else
-        K = expander.assignMaximumData( K, degrees.begin(), degrees.end() );
-    }
 
       // The normal sorting order is inverted when using a superlevel
       // set filtration.
@@ -320,7 +332,20 @@ int main( int argc, char** argv )
       }
       else
         K.sort( aleph::topology::filtrations::Data<Simplex>() );
-  }
+
+      return std::make_pair( maxComplexDimension, maxComplexDegree );
+    },
+    [&] ( std::size_t, std::pair<std::size_t, DataType>&& maxima )
+    {
+      maxDimension = std::max( maxDimension, maxima.first );
+      maxDegree    = std::max( maxDegree, maxima.second );
+    }
+  );
+
+  // The output will make more sense in case normalisation has been
+  // requested by the user.
+  if( normalise && !simplicialComplexes.empty() )
+    maxDegree = 1.0;
 
   std::cerr << "finished\n"
             << "* Identified maximum degree as D=" << maxDegree << "\n";
@@ -350,20 +375,30 @@ int main( int argc, char** argv )
   }
 
   // Calculate persistent homology -------------------------------------
+  //
+  // Complexes are released as soon as their diagrams have been
+  // calculated because they are not required any more.
 
-  {
-    std::size_t index = 0;
-
-    for( auto&& K : simplicialComplexes )
+  aleph::utilities::processBatch( simplicialComplexes.size(), jobs,
+    [&simplicialComplexes] ( std::size_t i )
     {
       bool dualize                    = true;
       bool includeAllUnpairedCreators = true;
 
       auto diagrams
-        = aleph::calculatePersistenceDiagrams( K,
+        = aleph::calculatePersistenceDiagrams( simplicialComplexes[i],
                                                dualize,
                                                includeAllUnpairedCreators );
 
+      simplicialComplexes[i] = SimplicialComplex();
+
+      for( auto&& diagram : diagrams )
+        diagram.removeDiagonal();
+
+      return diagrams;
+    },
+    [&] ( std::size_t index, std::vector< aleph::PersistenceDiagram<DataType> >&& diagrams )
+    {
       // Creates all potential diagrams for each simplicial complex; if
       // some of them are empty, it is a feature of the data. This will
       // ensure that the cardinality of all diagrams is the same.
@@ -380,8 +415,6 @@ int main( int argc, char** argv )
 
       for( auto&& diagram : diagrams )
       {
-        diagram.removeDiagonal();
-
         auto outputPath = output
                         + aleph::utilities::format( index, simplicialComplexes.size() )
                         + "_d"
@@ -398,10 +431,8 @@ int main( int argc, char** argv )
             out << point.x() << "\t" << point.y() << "\n";
         }
       }
-
-      ++index;
     }
-  }
+  );
 
   // Store labels ------------------------------------------------------
 
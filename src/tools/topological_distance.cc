@@ -42,6 +42,7 @@
 #include <limits>
 #include <map>
 #include <regex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -62,11 +63,14 @@
 #include <aleph/persistenceDiagrams/io/JSON.hh>
 #include <aleph/persistenceDiagrams/io/Raw.hh>
 
+#include <aleph/math/FlatStepFunction.hh>
+#include <aleph/math/SymmetricMatrix.hh>
+
 #include <aleph/utilities/Filesystem.hh>
 
 using DataType                     = double;
 using PersistenceDiagram           = aleph::PersistenceDiagram<DataType>;
-using PersistenceIndicatorFunction = aleph::math::StepFunction<DataType>;
+using PersistenceIndicatorFunction = aleph::math::FlatStepFunction<DataType>;
 using EnvelopeFunction             = aleph::math::PiecewiseLinearFunction<DataType>;
 
 /*
@@ -113,6 +117,8 @@ void usage()
             << "each file contains a suffix with digits that is preceded by either\n"
             << "a 'd' (for dimension) or a 'k' (for clique dimension).\n"
             << "\n"
+            << "At most one of the distances may be selected.\n"
+            << "\n"
             << "Flags:\n"
             << "  -b: calculate bottleneck distance\n"
             << "  -c: clean persistence diagrams (remove unpaired points)\n"
@@ -125,6 +131,7 @@ void usage()
             << "  -n: normalize the persistence indicator function\n"
             << "  -r: remove duplicate points in each diagram\n"
             << "  -s: use sigma as a scale parameter for the kernel\n"
+            << "  -S: calculate scale-space kernel values\n"
             << "  -v: verbose output\n"
             << "  -w: calculate Wasserstein distances\n"
             << "\n";
@@ -201,11 +208,12 @@ double distancePIF( const std::vector<DataSet>& dataSet1,
       g = aleph::math::normalize( g );
     }
 
-    g = -g;
+    // The distance is calculated in a single pass over both functions,
+    // without creating their difference explicitly.
     if( power == 1.0 )
-      d = d + (f+g).abs().integral();
+      d = d + aleph::math::lpDistance( f, g );
     else
-      d = d + (f+g).abs().pow( power ).integral();
+      d = d + std::pow( aleph::math::lpDistance( f, g, power ), power );
   }
 
   return d;
@@ -424,6 +432,10 @@ int main( int argc, char** argv )
   bool removeDuplicates             = false;
   bool verbose                      = false;
 
+  // Options that select a distance; they are mutually exclusive because
+  // the tool only calculates a single type of distance.
+  std::set<int> distanceOptions;
+
   int option = 0;
   while( ( option = getopt_long( argc, argv, "f:p:s:bceEhinklrvSw", commandLineOptions, nullptr ) ) != -1 )
   {
@@ -439,6 +451,7 @@ int main( int argc, char** argv )
       sigma = std::stod( optarg );
       break;
     case 'b':
+      distanceOptions.insert( option );
       useBottleneckDistance        = true;
       useEnvelopeFunctionDistance  = false;
       useIndicatorFunctionDistance = false;
@@ -449,6 +462,7 @@ int main( int argc, char** argv )
       cleanPersistenceDiagrams = true;
       break;
     case 'E':
+      distanceOptions.insert( option );
       useEnvelopeFunctionDistance  = true;
       useBottleneckDistance        = false;
       useWassersteinDistance       = false;
@@ -458,12 +472,14 @@ int main( int argc, char** argv )
       useExponentialFunction = true;
       break;
     case 'h':
+      distanceOptions.insert( option );
       useWassersteinDistance       = false;
       useIndicatorFunctionDistance = false;
       useScaleSpaceKernel          = false;
       useEnvelopeFunctionDistance  = false;
       break;
     case 'i':
+      distanceOptions.insert( option );
       useIndicatorFunctionDistance = true;
       useEnvelopeFunctionDistance  = false;
       useScaleSpaceKernel          = false;
@@ -482,6 +498,7 @@ int main( int argc, char** argv )
       removeDuplicates = true;
       break;
     case 'S':
+      distanceOptions.insert( option );
       useEnvelopeFunctionDistance  = false;
       useScaleSpaceKernel          = true;
       useIndicatorFunctionDistance = false;
@@ -492,6 +509,7 @@ int main( int argc, char** argv )
       calculateKernel = true;
       break;
     case 'w':
+      distanceOptions.insert( option );
       useEnvelopeFunctionDistance  = false;
       useIndicatorFunctionDistance = false;
       useScaleSpaceKernel          = false;
@@ -505,6 +523,18 @@ int main( int argc, char** argv )
     }
   }
 
+  if( distanceOptions.size() > 1 )
+  {
+    std::cerr << "* Only one of --bottleneck, --envelope, --hausdorff, --indicator, --scale-space, and --wasserstein may be specified\n";
+    return -1;
+  }
+
+  if( useScaleSpaceKernel && sigma <= 0.0 )
+  {
+    std::cerr << "* Sigma must be positive for the scale-space kernel\n";
+    return -1;
+  }
+
   if( ( argc - optind ) < 1 )
   {
     usage();
@@ -617,7 +647,7 @@ int main( int argc, char** argv )
             pd.removeUnpaired();
 
             if( useIndicatorFunctionDistance )
-              dataSet.persistenceIndicatorFunction = aleph::persistenceIndicatorFunction( pd );
+              dataSet.persistenceIndicatorFunction = PersistenceIndicatorFunction( aleph::persistenceIndicatorFunction( pd ) );
 
             if( useEnvelopeFunctionDistance  )
               dataSet.envelopeFunction = aleph::Envelope()( pd );
@@ -666,7 +696,7 @@ int main( int argc, char** argv )
           EnvelopeFunction ef;
 
           if( useIndicatorFunctionDistance )
-            pif = aleph::persistenceIndicatorFunction( pd );
+            pif = PersistenceIndicatorFunction( aleph::persistenceIndicatorFunction( pd ) );
 
           if( useEnvelopeFunctionDistance )
             ef = aleph::Envelope()( pd );
@@ -707,12 +737,34 @@ int main( int argc, char** argv )
              return 0.0;
            };
 
+  // Kernel matrices of the scale-space kernel are calculated for all
+  // data sets at once, one per dimension, which permits re-using the
+  // prepared persistence diagrams.
+  std::vector< aleph::math::SymmetricMatrix<double> > scaleSpaceKernels;
+
   if( useScaleSpaceKernel )
   {
-    functor = [&sigma]( const PersistenceDiagram& D1, const PersistenceDiagram& D2, double /* p */ )
-              {
-                return aleph::multiScaleKernel( D1, D2, sigma );
-              };
+    for( unsigned dimension = minDimension; dimension <= maxDimension; dimension++ )
+    {
+      std::vector<PersistenceDiagram> diagrams;
+      diagrams.reserve( dataSets.size() );
+
+      for( auto&& dataSet : dataSets )
+      {
+        auto it = std::find_if( dataSet.begin(), dataSet.end(),
+                                [&dimension] ( const DataSet& dataSet )
+                                {
+                                  return dataSet.dimension == dimension;
+                                } );
+
+        if( it != dataSet.end() )
+          diagrams.push_back( it->persistenceDiagram );
+        else
+          diagrams.push_back( PersistenceDiagram() );
+      }
+
+      scaleSpaceKernels.push_back( aleph::multiScaleKernelMatrix( diagrams, sigma ) );
+    }
   }
 
   // Calculate all distances -------------------------------------------
@@ -751,7 +803,14 @@ int main( int argc, char** argv )
 
       double d = 0.0;
 
-      if( useIndicatorFunctionDistance )
+      if( useScaleSpaceKernel )
+      {
+        for( auto&& K : scaleSpaceKernels )
+          d += K(row,col);
+
+        d = std::pow( d, 1.0 / power );
+      }
+      else if( useIndicatorFunctionDistance )
         d = distancePIF( dataSets.at(row), dataSets.at(col), minDimension, maxDimension, power, normalize );
       else if( useEnvelopeFunctionDistance )
         d = distanceEnvelopeFunctions( dataSets.at(row), dataSets.at(col), minDimension, maxDimension, power );
@@ -0,0 +1,338 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/AlphaComplex.hh>
+#include <aleph/geometry/CechComplex.hh>
+#include <aleph/geometry/DelaunayTriangulation.hh>
+#include <aleph/geometry/Predicates.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/topology/Simplex.hh>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+
+template <std::size_t D> std::array<const double*, D+1> coordinates( const std::vector< std::array<double, D> >& points,
+                                                                     const std::array<std::size_t, D+1>& vertices )
+{
+  std::array<const double*, D+1> result;
+
+  for( std::size_t i = 0; i <= D; i++ )
+    result[i] = points[ vertices[i] ].data();
+
+  return result;
+}
+
+/**
+  Checks that all cells of a Delaunay triangulation are positively
+  oriented and that their circumspheres are empty.
+*/
+
+template <std::size_t D> void checkTriangulation( const std::vector< std::array<double, D> >& points )
+{
+  aleph::geometry::DelaunayTriangulation<D> triangulation( points );
+
+  auto cells = triangulation.cells();
+
+  ALEPH_ASSERT_THROW( !cells.empty() );
+
+  for( auto&& cell : cells )
+  {
+    auto vertices = coordinates<D>( points, cell );
+
+    ALEPH_ASSERT_EQUAL( aleph::geometry::orientation<D>( vertices ), 1 );
+
+    for( auto&& p : points )
+      ALEPH_ASSERT_THROW( aleph::geometry::inSphere<D>( vertices, p.data() ) <= 0 );
+  }
+}
+
+void testPredicates()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex: exact predicates" );
+
+  using namespace aleph::geometry;
+
+  double a[2] = { 0.0, 0.0 };
+  double b[2] = { 1.0, 0.0 };
+  double c[2] = { 0.0, 1.0 };
+  double d[2] = { 1.0, 1.0 };
+  double e[2] = { 0.5, 0.5 };
+  double f[2] = { 2.0, 2.0 };
+
+  ALEPH_ASSERT_EQUAL( orientation<2>( { a, b, c } ),  1 );
+  ALEPH_ASSERT_EQUAL( orientation<2>( { a, c, b } ), -1 );
+  ALEPH_ASSERT_EQUAL( orientation<2>( { a, e, f } ),  0 );
+
+  ALEPH_ASSERT_EQUAL( inSphere<2>( { a, b, c }, e ),  1 );
+  ALEPH_ASSERT_EQUAL( inSphere<2>( { a, c, b }, e ),  1 );
+  ALEPH_ASSERT_EQUAL( inSphere<2>( { a, b, c }, d ),  0 );
+  ALEPH_ASSERT_EQUAL( inSphere<2>( { a, b, c }, f ), -1 );
+
+  // A point that is moved away from a line by the smallest possible
+  // amount still results in the correct orientation.
+  double g[2] = { 0.1, 0.1 };
+  double h[2] = { 0.3, std::nextafter( 0.3, 1.0 ) };
+  double k[2] = { 0.3, std::nextafter( 0.3, 0.0 ) };
+
+  ALEPH_ASSERT_EQUAL( orientation<2>( { a, g, h } ),  1 );
+  ALEPH_ASSERT_EQUAL( orientation<2>( { a, g, k } ), -1 );
+
+  double p[3] = { 0.0, 0.0, 0.0 };
+  double q[3] = { 1.0, 0.0, 0.0 };
+  double r[3] = { 0.0, 1.0, 0.0 };
+  double s[3] = { 0.0, 0.0, 1.0 };
+  double t[3] = { 1.0, 1.0, 1.0 };
+  double u[3] = { 0.2, 0.2, 0.2 };
+
+  ALEPH_ASSERT_EQUAL( orientation<3>( { p, q, r, s } ),  1 );
+  ALEPH_ASSERT_EQUAL( orientation<3>( { p, r, q, s } ), -1 );
+
+  ALEPH_ASSERT_EQUAL( inSphere<3>( { p, q, r, s }, u ),  1 );
+  ALEPH_ASSERT_EQUAL( inSphere<3>( { p, r, q, s }, u ),  1 );
+  ALEPH_ASSERT_EQUAL( inSphere<3>( { p, q, r, s }, t ),  0 );
+
+  ALEPH_TEST_END();
+}
+
+void testDelaunayTriangulation()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex: Delaunay triangulation" );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<double> coordinate( 0.0, 1.0 );
+
+  // Integer coordinates result in many degenerate configurations, such
+  // as co-circular and co-spherical points.
+  std::uniform_int_distribution<int> integer( 0, 3 );
+
+  for( unsigned n : std::vector<unsigned>( { 4, 10, 50, 200 } ) )
+  {
+    std::vector< std::array<double, 2> > A;
+    std::vector< std::array<double, 2> > B;
+    std::vector< std::array<double, 3> > C;
+    std::vector< std::array<double, 3> > D;
+
+    for( unsigned i = 0; i < n; i++ )
+    {
+      A.push_back( { { coordinate( rng ), coordinate( rng ) } } );
+      B.push_back( { { double( integer( rng ) ), double( integer( rng ) ) } } );
+      C.push_back( { { coordinate( rng ), coordinate( rng ), coordinate( rng ) } } );
+      D.push_back( { { double( integer( rng ) ), double( integer( rng ) ), double( integer( rng ) ) } } );
+    }
+
+    // Ensure that the integer points are not contained in a hyperplane
+    B.push_back( { { 0.0, 0.0 } } );
+    B.push_back( { { 1.0, 0.0 } } );
+    B.push_back( { { 0.0, 1.0 } } );
+
+    D.push_back( { { 0.0, 0.0, 0.0 } } );
+    D.push_back( { { 1.0, 0.0, 0.0 } } );
+    D.push_back( { { 0.0, 1.0, 0.0 } } );
+    D.push_back( { { 0.0, 0.0, 1.0 } } );
+
+    checkTriangulation<2>( A );
+    checkTriangulation<2>( B );
+    checkTriangulation<3>( C );
+    checkTriangulation<3>( D );
+  }
+
+  std::vector< std::array<double, 2> > collinear = { { { 0.0, 0.0 } }, { { 1.0, 1.0 } }, { { 2.0, 2.0 } } };
+  std::vector< std::array<double, 3> > coplanar  = { { { 0.0, 0.0, 0.0 } }, { { 1.0, 0.0, 0.0 } }, { { 0.0, 1.0, 0.0 } }, { { 1.0, 1.0, 0.0 } } };
+
+  ALEPH_EXPECT_EXCEPTION( aleph::geometry::DelaunayTriangulation<2>{ collinear }, std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::geometry::DelaunayTriangulation<3>{ coplanar },  std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testGrid()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex: grid" );
+
+  using PointCloud = aleph::containers::PointCloud<T>;
+
+  PointCloud A( 25, 2 );
+  PointCloud B( 27, 3 );
+
+  for( unsigned i = 0; i < 25; i++ )
+    A.set( i, { T( i % 5 ), T( i / 5 ) } );
+
+  for( unsigned i = 0; i < 27; i++ )
+    B.set( i, { T( i % 3 ), T( ( i / 3 ) % 3 ), T( i / 9 ) } );
+
+  for( auto&& pc : { A, B } )
+  {
+    auto K = aleph::geometry::buildAlphaComplex( pc );
+
+    // The complex is a triangulation of the convex hull of the points,
+    // so it is contractible.
+    long eulerCharacteristic = 0;
+
+    for( auto&& s : K )
+      eulerCharacteristic += s.dimension() % 2 == 0 ? 1 : -1;
+
+    ALEPH_ASSERT_EQUAL( eulerCharacteristic, 1 );
+
+    // Every face of a simplex has to precede the simplex
+    for( auto&& s : K )
+      for( auto it = s.begin_boundary(); it != s.end_boundary(); ++it )
+        ALEPH_ASSERT_THROW( K.find( *it )->data() <= s.data() );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testCechComplex()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex: comparison with Čech complex" );
+
+  using PointCloud = aleph::containers::PointCloud<T>;
+
+  std::mt19937 rng( 23 );
+  std::uniform_real_distribution<T> coordinate( T(0), T(1) );
+
+  auto tolerance = T( std::is_same<T, float>::value ? 1e-4 : 1e-9 );
+
+  for( unsigned round = 0; round < 5; round++ )
+  {
+    PointCloud A( 10, 2 );
+    PointCloud B( 9, 3 );
+
+    for( unsigned i = 0; i < A.size(); i++ )
+      A.set( i, { coordinate( rng ), coordinate( rng ) } );
+
+    for( unsigned i = 0; i < B.size(); i++ )
+      B.set( i, { coordinate( rng ), coordinate( rng ), coordinate( rng ) } );
+
+    for( auto&& pc : { A, B } )
+    {
+      auto K = aleph::geometry::buildAlphaComplex( pc );
+      auto L = aleph::geometry::buildCechComplex( pc, std::numeric_limits<T>::max() );
+
+      ALEPH_ASSERT_THROW( K.size() < L.size() );
+
+      auto D = aleph::calculatePersistenceDiagrams( K, true, true );
+      auto E = aleph::calculatePersistenceDiagrams( L, true, true );
+
+      using PersistenceDiagram = typename decltype( D )::value_type;
+      using Point              = typename PersistenceDiagram::Point;
+
+      // Rounding errors of the smallest enclosing balls of the Čech
+      // complex may create additional points close to the diagonal.
+      auto get = [&tolerance] ( const std::vector<PersistenceDiagram>& diagrams, std::size_t d )
+      {
+        std::vector<Point> points;
+
+        for( auto&& diagram : diagrams )
+        {
+          if( diagram.dimension() == d )
+          {
+            for( auto&& p : diagram )
+              if( !( std::abs( p.x() - p.y() ) < tolerance ) )
+                points.push_back( p );
+          }
+        }
+
+        std::sort( points.begin(), points.end() );
+        return points;
+      };
+
+      // The Čech complex contains simplices of all dimensions, whereas
+      // the alpha complex is restricted to the dimension of the space.
+      for( std::size_t d = 0; d < pc.dimension(); d++ )
+      {
+        auto X = get( D, d );
+        auto Y = get( E, d );
+
+        ALEPH_ASSERT_EQUAL( X.size(), Y.size() );
+
+        for( std::size_t i = 0; i < X.size(); i++ )
+        {
+          ALEPH_ASSERT_THROW( std::abs( X[i].x() - Y[i].x() ) < tolerance );
+
+          if( std::isfinite( X[i].y() ) || std::isfinite( Y[i].y() ) )
+            ALEPH_ASSERT_THROW( std::abs( X[i].y() - Y[i].y() ) < tolerance );
+        }
+      }
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testSpecialCases()
+{
+  ALEPH_TEST_BEGIN( "Alpha complex: special cases" );
+
+  using PointCloud = aleph::containers::PointCloud<T>;
+  using Simplex    = aleph::topology::Simplex<T, typename PointCloud::IndexType>;
+
+  PointCloud A( 4, 2 );
+
+  A.set( 0, { T(0), T(0) } );
+  A.set( 1, { T(4), T(0) } );
+  A.set( 2, { T(2), T(1) } );
+  A.set( 3, { T(4), T(0) } );
+
+  auto K = aleph::geometry::buildAlphaComplex( A );
+
+  // The duplicate point is connected to the original one at the
+  // beginning of the filtration.
+  ALEPH_ASSERT_THROW( K.contains( Simplex( 3 ) ) );
+  ALEPH_ASSERT_THROW( K.contains( Simplex( {1,3} ) ) );
+  ALEPH_ASSERT_EQUAL( K.find( Simplex( {1,3} ) )->data(), T(0) );
+
+  // The triangle is obtuse, so its long edge is attached to it and
+  // obtains the diameter of its circumcircle instead of its length.
+  ALEPH_ASSERT_THROW( std::abs( K.find( Simplex( {0,1,2} ) )->data() - T(5) )            < T( 1e-5 ) );
+  ALEPH_ASSERT_THROW( std::abs( K.find( Simplex( {0,1} ) )->data()   - T(5) )            < T( 1e-5 ) );
+  ALEPH_ASSERT_THROW( std::abs( K.find( Simplex( {0,2} ) )->data()   - std::sqrt( T(5) ) ) < T( 1e-5 ) );
+
+  auto L = aleph::geometry::buildAlphaComplex( A, T(3) );
+
+  for( auto&& s : L )
+    ALEPH_ASSERT_THROW( s.data() <= T(3) );
+
+  ALEPH_ASSERT_THROW(  L.contains( Simplex( {0,2} ) ) );
+  ALEPH_ASSERT_THROW( !L.contains( Simplex( {0,1} ) ) );
+
+  PointCloud B( 3, 2 );
+
+  B.set( 0, { T(0), T(0) } );
+  B.set( 1, { T(1), T(1) } );
+  B.set( 2, { T(2), T(2) } );
+
+  ALEPH_EXPECT_EXCEPTION( aleph::geometry::buildAlphaComplex( B ), std::runtime_error );
+
+  PointCloud C( 5, 4 );
+
+  ALEPH_EXPECT_EXCEPTION( aleph::geometry::buildAlphaComplex( C ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testPredicates();
+  testDelaunayTriangulation();
+
+  testGrid<double>();
+  testGrid<float> ();
+
+  testCechComplex<double>();
+  testCechComplex<float> ();
+
+  testSpecialCases<double>();
+  testSpecialCases<float> ();
+}
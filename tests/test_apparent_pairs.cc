@@ -0,0 +1,104 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/ApparentPairs.hh>
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/topology/Conversions.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+template <class T> void testTriangle()
+{
+  ALEPH_TEST_BEGIN( "Apparent pairs: triangle" );
+
+  using Simplex           = aleph::topology::Simplex<T, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  SimplicialComplex K = {
+    Simplex( 0, T(0) ), Simplex( 1, T(0) ), Simplex( 2, T(0) ),
+    Simplex( {0,1}, T(1) ),
+    Simplex( {0,2}, T(2) ),
+    Simplex( {1,2}, T(3) ),
+    Simplex( {0,1,2}, T(3) )
+  };
+
+  K.sort( aleph::topology::filtrations::Data<Simplex>() );
+
+  auto M     = aleph::topology::makeBoundaryMatrix<aleph::defaults::Representation>( K );
+  auto pairs = aleph::calculateApparentPairs( M );
+
+  // The vertex {1} is the youngest face of {0,1}, which in turn is its
+  // oldest coface. The same holds for {2} and {0,2}, as well as for the
+  // last edge and the triangle.
+  ALEPH_ASSERT_EQUAL( pairs.size(), 3 );
+
+  ALEPH_ASSERT_THROW( K.at( pairs[0].first ) == Simplex( 1 ) );
+  ALEPH_ASSERT_THROW( K.at( pairs[0].second ) == Simplex( {0,1} ) );
+  ALEPH_ASSERT_THROW( K.at( pairs[2].first ) == Simplex( {1,2} ) );
+  ALEPH_ASSERT_THROW( K.at( pairs[2].second ) == Simplex( {0,1,2} ) );
+
+  ALEPH_EXPECT_EXCEPTION( aleph::calculateApparentPairs( M.dualize() ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testVietorisRips()
+{
+  ALEPH_TEST_BEGIN( "Apparent pairs: Vietoris--Rips complex" );
+
+  using PointCloud        = aleph::containers::PointCloud<T>;
+  using Distance          = aleph::geometry::distances::Euclidean<T>;
+  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> coordinate( T(0), T(1) );
+
+  unsigned n = 60;
+
+  PointCloud pc( n, 3 );
+
+  for( unsigned i = 0; i < n; i++ )
+    pc.set( i, { coordinate( rng ), coordinate( rng ), coordinate( rng ) } );
+
+  auto K
+    = aleph::geometry::buildVietorisRipsComplex(
+      NearestNeighbours( pc ),
+      T( 0.4 ),
+      3
+  );
+
+  auto M       = aleph::topology::makeBoundaryMatrix<aleph::defaults::Representation>( K );
+  auto pairs   = aleph::calculateApparentPairs( M );
+  auto pairing = aleph::calculatePersistencePairing( M );
+
+  ALEPH_ASSERT_THROW( !pairs.empty() );
+
+  // Every apparent pair must be a persistence pair
+  for( auto&& pair : pairs )
+    ALEPH_ASSERT_THROW( pairing.contains( pair.first, pair.second ) );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testTriangle<double>();
+  testTriangle<float> ();
+
+  testVietorisRips<double>();
+  testVietorisRips<float> ();
+}
@@ -0,0 +1,85 @@
+#include <tests/Base.hh>
+
+#include <aleph/utilities/Batch.hh>
+
+#include <stdexcept>
+#include <vector>
+
+#include <cstddef>
+
+void testOrder()
+{
+  ALEPH_TEST_BEGIN( "Batch processing: Order of results" );
+
+  for( unsigned jobs : { 0u, 1u, 4u } )
+  {
+    std::vector<std::size_t> indices;
+    std::vector<double> results;
+
+    aleph::utilities::processBatch( 1000, jobs,
+      [] ( std::size_t i )
+      {
+        // Uneven amounts of work ensure that items finish out of order
+        // if multiple threads are available.
+        double x = 0.0;
+        for( std::size_t j = 0; j < ( i % 7 ) * 1000; j++ )
+          x += 1e-6;
+
+        return std::vector<double>( { static_cast<double>( i ), x } );
+      },
+      [&] ( std::size_t i, std::vector<double>&& result )
+      {
+        indices.push_back( i );
+        results.push_back( result.front() );
+      }
+    );
+
+    ALEPH_ASSERT_EQUAL( indices.size(), 1000 );
+
+    for( std::size_t i = 0; i < indices.size(); i++ )
+    {
+      ALEPH_ASSERT_EQUAL( indices[i], i );
+      ALEPH_ASSERT_EQUAL( results[i], static_cast<double>( i ) );
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
+void testExceptions()
+{
+  ALEPH_TEST_BEGIN( "Batch processing: Exceptions" );
+
+  std::vector<std::size_t> indices;
+
+  auto process = [] ( std::size_t i )
+  {
+    if( i == 10 )
+      throw std::runtime_error( "Failure" );
+
+    return i;
+  };
+
+  auto consume = [&] ( std::size_t i, std::size_t&& )
+  {
+    indices.push_back( i );
+  };
+
+  ALEPH_EXPECT_EXCEPTION( aleph::utilities::processBatch( 100, 4, process, consume ), std::runtime_error );
+
+  // All items before the failure must have been consumed, and no item
+  // after it.
+  ALEPH_ASSERT_EQUAL( indices.size(), 10 );
+  ALEPH_ASSERT_EQUAL( indices.back(),  9 );
+
+  ALEPH_EXPECT_EXCEPTION( aleph::utilities::parseJobs( "-1" ), std::runtime_error );
+  ALEPH_ASSERT_EQUAL( aleph::utilities::parseJobs( "8" ), 8 );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testOrder();
+  testExceptions();
+}
@@ -1,11 +1,16 @@
 #include <tests/Base.hh>
 
 #include <aleph/math/Bootstrap.hh>
+#include <aleph/math/Philox.hh>
 
+#include <array>
 #include <iterator>
+#include <list>
 #include <numeric>
 #include <vector>
 
+#include <cmath>
+
 auto meanCalculation = [] ( auto begin, auto end )
 {
   using T  = typename std::iterator_traits<decltype(begin)>::value_type;
@@ -110,8 +115,101 @@ void testStandardError()
   ALEPH_TEST_END();
 }
 
+void testPhilox()
+{
+  ALEPH_TEST_BEGIN( "Philox: Known answers" );
+
+  // Known answer test of the reference implementation for a counter
+  // and a key that are zero.
+  auto block = aleph::math::Philox4x32::encrypt( { { 0, 0, 0, 0 } }, { { 0, 0 } } );
+
+  ALEPH_ASSERT_EQUAL( block[0], 0x6627e8d5 );
+  ALEPH_ASSERT_EQUAL( block[1], 0xe169c58d );
+  ALEPH_ASSERT_EQUAL( block[2], 0xbc57ac4c );
+  ALEPH_ASSERT_EQUAL( block[3], 0x9b00dbd8 );
+
+  aleph::math::Philox4x32 rng;
+
+  for( auto&& value : block )
+    ALEPH_ASSERT_EQUAL( rng(), value );
+
+  aleph::math::Philox4x32 rng1( 23, 0 );
+  aleph::math::Philox4x32 rng2( 23, 1 );
+
+  ALEPH_ASSERT_THROW( rng1() != rng2() );
+
+  for( unsigned i = 0; i < 1000; i++ )
+    ALEPH_ASSERT_THROW( rng1.uniform( 7 ) < 7 );
+
+  ALEPH_TEST_END();
+}
+
+void testReproducibility()
+{
+  ALEPH_TEST_BEGIN( "Bootstrap: Reproducibility" );
+
+  std::vector<double> samples;
+  for( unsigned i = 0; i < 100; i++ )
+    samples.push_back( std::sin( double(i) ) );
+
+  unsigned numBootstrapSamples = 500;
+
+  std::vector<double> means1;
+  std::vector<double> means2;
+  std::vector<double> means3;
+  std::vector<double> means4;
+
+  aleph::math::Bootstrap bootstrap1( 42 );
+  aleph::math::Bootstrap bootstrap2( 42 );
+  aleph::math::Bootstrap bootstrap3( 43 );
+
+  bootstrap1.makeReplicates( numBootstrapSamples,
+                             samples.begin(), samples.end(),
+                             meanCalculation,
+                             std::back_inserter( means1 ) );
+
+  bootstrap2.makeReplicatesParallel( numBootstrapSamples,
+                                     samples.begin(), samples.end(),
+                                     meanCalculation,
+                                     std::back_inserter( means2 ) );
+
+  bootstrap3.makeReplicates( numBootstrapSamples,
+                             samples.begin(), samples.end(),
+                             meanCalculation,
+                             std::back_inserter( means3 ) );
+
+  // Ranges without random access need to be handled as well; the
+  // results must not change.
+  std::list<double> list( samples.begin(), samples.end() );
+
+  bootstrap1.makeReplicatesParallel( numBootstrapSamples,
+                                     list.begin(), list.end(),
+                                     meanCalculation,
+                                     std::back_inserter( means4 ) );
+
+  ALEPH_ASSERT_EQUAL( means1.size(), numBootstrapSamples );
+  ALEPH_ASSERT_EQUAL( means2.size(), numBootstrapSamples );
+  ALEPH_ASSERT_EQUAL( means3.size(), numBootstrapSamples );
+  ALEPH_ASSERT_EQUAL( means4.size(), numBootstrapSamples );
+
+  ALEPH_ASSERT_THROW( means1 == means2 );
+  ALEPH_ASSERT_THROW( means1 != means3 );
+  ALEPH_ASSERT_THROW( means1 == means4 );
+
+  bootstrap1.setParallel();
+
+  auto se1 = bootstrap1.standardError( numBootstrapSamples, samples.begin(), samples.end(), meanCalculation );
+  auto se2 = bootstrap2.standardError( numBootstrapSamples, samples.begin(), samples.end(), meanCalculation );
+
+  ALEPH_ASSERT_EQUAL( se1, se2 );
+
+  ALEPH_TEST_END();
+}
+
 int main(int, char**)
 {
   testSimple();
   testStandardError();
+  testPhilox();
+  testReproducibility();
 }
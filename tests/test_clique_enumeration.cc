@@ -3,6 +3,7 @@
 #include <aleph/geometry/RipsExpanderTopDown.hh>
 
 #include <aleph/topology/MaximalCliques.hh>
+#include <aleph/topology/RandomGraph.hh>
 
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
@@ -81,6 +82,17 @@ template <class Data, class Vertex> void triangles()
   ALEPH_ASSERT_THROW( std::find( C22.begin(), C22.end(), std::set<Vertex>( {0,1,2} ) ) != C22.end() );
   ALEPH_ASSERT_THROW( std::find( C22.begin(), C22.end(), std::set<Vertex>( {3,4,5} ) ) != C22.end() );
 
+  auto C13 = maximalCliquesEppstein( K1 ).toSets();
+  auto C23 = maximalCliquesEppstein( K2 ).toSets();
+
+  std::sort( C12.begin(), C12.end() );
+  std::sort( C13.begin(), C13.end() );
+  std::sort( C22.begin(), C22.end() );
+  std::sort( C23.begin(), C23.end() );
+
+  ALEPH_ASSERT_THROW( C12 == C13 );
+  ALEPH_ASSERT_THROW( C22 == C23 );
+
   aleph::geometry::RipsExpanderTopDown<SimplicialComplex> expander;
 
   auto expandedK1 = expander( K1, 3 );
@@ -137,6 +149,17 @@ template <class Data, class Vertex> void trianglesNonZeroBasedIndices()
   ALEPH_ASSERT_THROW( std::find( C2.begin(), C2.end(), std::set<Vertex>( {1,2,3} ) ) != C2.end() );
   ALEPH_ASSERT_THROW( std::find( C2.begin(), C2.end(), std::set<Vertex>( {1,2,4} ) ) != C2.end() );
 
+  auto C3 = maximalCliquesEppstein( K );
+
+  ALEPH_ASSERT_EQUAL( C3.size(), 2 );
+  ALEPH_ASSERT_EQUAL( C3.vertices().size(), 6 );
+
+  for( auto&& clique : C3 )
+  {
+    auto C = std::set<Vertex>( clique.begin(), clique.end() );
+    ALEPH_ASSERT_THROW( std::find( C1.begin(), C1.end(), C ) != C1.end() );
+  }
+
   aleph::geometry::RipsExpanderTopDown<SimplicialComplex> expander;
 
   auto L = expander( K, 3 );
@@ -149,7 +172,32 @@ template <class Data, class Vertex> void trianglesNonZeroBasedIndices()
   ALEPH_TEST_END();
 }
 
+void randomGraphs()
+{
+  ALEPH_TEST_BEGIN( "Random graphs" );
+
+  for( auto&& p : { 0.0, 0.1, 0.3, 0.5, 0.9 } )
+  {
+    auto K = aleph::topology::generateErdosRenyiGraph( 60, p );
 
+    auto C1 = maximalCliquesKoch( K );
+    auto C2 = maximalCliquesEppstein( K ).toSets();
+
+    // Enforces the usage of sorted arrays instead of bit sets for the
+    // candidate sets.
+    auto C3 = maximalCliquesEppstein( K, 0 ).toSets();
+
+    std::sort( C1.begin(), C1.end() );
+    std::sort( C2.begin(), C2.end() );
+    std::sort( C3.begin(), C3.end() );
+
+    ALEPH_ASSERT_EQUAL( C1.size(), C2.size() );
+    ALEPH_ASSERT_THROW( C1 == C2 );
+    ALEPH_ASSERT_THROW( C1 == C3 );
+  }
+
+  ALEPH_TEST_END();
+}
 
 int main()
 {
@@ -158,4 +206,6 @@ int main()
 
   trianglesNonZeroBasedIndices<double, unsigned>();
   trianglesNonZeroBasedIndices<float,  unsigned>();
+
+  randomGraphs();
 }
@@ -0,0 +1,253 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/RipsExpander.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/topology/EdgeCollapse.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/**
+  Expands a filtered graph to the given dimension and checks that the
+  persistence diagrams of all dimensions below it agree, regardless of
+  whether the graph has been collapsed or not. Every simplex obtains
+  the weight of its last face according to the filtration order.
+*/
+
+template <class Compare, class SimplicialComplex> void checkExpansion( const SimplicialComplex& K,
+                                                                       const SimplicialComplex& L,
+                                                                       unsigned dimension )
+{
+  using Simplex = typename SimplicialComplex::ValueType;
+
+  aleph::geometry::RipsExpander<SimplicialComplex> ripsExpander;
+
+  auto expand = [&] ( const SimplicialComplex& S )
+  {
+    auto T = ripsExpander( S, dimension );
+
+    SimplicialComplex U;
+
+    for( auto it = T.begin_dimension(); it != T.end_dimension(); ++it )
+    {
+      auto s = *it;
+
+      if( s.dimension() > 1 )
+      {
+        auto w = U.find( *s.begin_boundary() )->data();
+
+        for( auto itFace = s.begin_boundary(); itFace != s.end_boundary(); ++itFace )
+          w = std::max( w, U.find( *itFace )->data(), Compare() );
+
+        s.setData( w );
+      }
+
+      U.push_back( s );
+    }
+
+    U.sort( aleph::topology::filtrations::Data<Simplex, Compare>() );
+    return U;
+  };
+
+  auto X = expand( K );
+  auto Y = expand( L );
+
+  ALEPH_ASSERT_THROW( Y.size() <= X.size() );
+
+  // All unpaired creators are required because the collapsed graph may
+  // be expanded to a lower dimension than the original one.
+  auto D = aleph::calculatePersistenceDiagrams( X, true, true );
+  auto E = aleph::calculatePersistenceDiagrams( Y, true, true );
+
+  using PersistenceDiagram = typename decltype( D )::value_type;
+  using Point              = typename PersistenceDiagram::Point;
+
+  // Diagrams without any points may be missing, so they are treated as
+  // empty diagrams for the comparison. Since points may be reported in
+  // a different order, they are sorted.
+  auto get = [] ( const std::vector<PersistenceDiagram>& diagrams, unsigned d )
+  {
+    std::vector<Point> points;
+
+    for( auto&& diagram : diagrams )
+    {
+      if( diagram.dimension() == d )
+      {
+        for( auto&& p : diagram )
+          if( p.x() != p.y() )
+            points.push_back( p );
+      }
+    }
+
+    std::sort( points.begin(), points.end() );
+    return points;
+  };
+
+  for( unsigned d = 0; d < dimension; d++ )
+  {
+    auto A = get( D, d );
+    auto B = get( E, d );
+
+    ALEPH_ASSERT_EQUAL( A.size(), B.size() );
+    ALEPH_ASSERT_THROW( A == B );
+  }
+}
+
+template <class T> void testTriangle()
+{
+  ALEPH_TEST_BEGIN( "Edge collapse: triangle" );
+
+  using Simplex           = aleph::topology::Simplex<T, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  SimplicialComplex K = {
+    Simplex( 0 ), Simplex( 1 ), Simplex( 2 ), Simplex( 3 ),
+    Simplex( {0,1}, T(1) ),
+    Simplex( {1,2}, T(1) ),
+    Simplex( {0,2}, T(2) ),
+    Simplex( {2,3}, T(3) ),
+    Simplex( {1,3}, T(4) ),
+    Simplex( {0,3}, T(5) ),
+  };
+
+  auto L = aleph::topology::collapseEdges( K );
+
+  // The last edge is dominated by vertex 1 (and vertex 2), while the
+  // edge {1,3} is dominated by vertex 2 once it is not delayed any
+  // more. The remaining edges form a tree that creates the 1-cycle
+  // of the triangle {0,1,2}.
+  ALEPH_ASSERT_EQUAL( L.size(), 7 );
+  ALEPH_ASSERT_THROW( L.contains( Simplex( {0,1} ) ) );
+  ALEPH_ASSERT_THROW( L.contains( Simplex( {1,2} ) ) );
+  ALEPH_ASSERT_THROW( L.contains( Simplex( {2,3} ) ) );
+
+  for( auto&& s : L )
+    ALEPH_ASSERT_THROW( K.find( s ) != K.end() && K.find( s )->data() == s.data() );
+
+  checkExpansion< std::less<T> >( K, L, 2 );
+
+  Simplex triangle( {0,1,2}, T(2) );
+  SimplicialComplex M = { Simplex( 0 ), Simplex( 1 ), Simplex( 2 ), Simplex( {0,1} ), Simplex( {0,2} ), Simplex( {1,2} ), triangle };
+
+  ALEPH_EXPECT_EXCEPTION( aleph::topology::collapseEdges( M ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testVietorisRips()
+{
+  ALEPH_TEST_BEGIN( "Edge collapse: Vietoris--Rips complex" );
+
+  using PointCloud        = aleph::containers::PointCloud<T>;
+  using Distance          = aleph::geometry::distances::Euclidean<T>;
+  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> coordinate( T(0), T(1) );
+
+  unsigned n = 80;
+
+  PointCloud pc( n, 3 );
+
+  for( unsigned i = 0; i < n; i++ )
+    pc.set( i, { coordinate( rng ), coordinate( rng ), coordinate( rng ) } );
+
+  auto K
+    = aleph::geometry::buildVietorisRipsComplex(
+      NearestNeighbours( pc ),
+      T( 0.5 ),
+      1
+  );
+
+  auto L = aleph::topology::collapseEdges( K );
+
+  std::size_t numVertices = 0;
+
+  for( auto&& s : L )
+  {
+    if( s.dimension() == 0 )
+      ++numVertices;
+
+    // Edges may only be delayed, but never appear earlier
+    else
+      ALEPH_ASSERT_THROW( s.data() >= K.find( s )->data() );
+  }
+
+  ALEPH_ASSERT_EQUAL( numVertices, n );
+  ALEPH_ASSERT_THROW( 2 * L.size() < K.size() );
+
+  checkExpansion< std::less<T> >( K, L, 2 );
+  checkExpansion< std::less<T> >( K, L, 3 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRandomGraph()
+{
+  ALEPH_TEST_BEGIN( "Edge collapse: random graph with descending weights" );
+
+  using Simplex           = aleph::topology::Simplex<T, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+  using Filtration        = aleph::topology::filtrations::Data<Simplex, std::greater<T> >;
+
+  std::mt19937 rng( 23 );
+  std::bernoulli_distribution edge( 0.6 );
+
+  // Few distinct weights result in many ties in the filtration, which
+  // have to be treated consistently.
+  std::uniform_int_distribution<int> weight( 1, 5 );
+
+  unsigned n = 25;
+
+  std::vector<Simplex> simplices;
+
+  for( unsigned i = 0; i < n; i++ )
+    simplices.push_back( Simplex( i, T(10) ) );
+
+  for( unsigned i = 0; i < n; i++ )
+    for( unsigned j = i+1; j < n; j++ )
+      if( edge( rng ) )
+        simplices.push_back( Simplex( {i,j}, T( weight( rng ) ) ) );
+
+  SimplicialComplex K( simplices.begin(), simplices.end() );
+  K.sort( Filtration() );
+
+  auto L = aleph::topology::collapseEdges( K );
+
+  ALEPH_ASSERT_THROW( L.size() < K.size() );
+
+  for( auto&& s : L )
+    ALEPH_ASSERT_THROW( s.data() <= K.find( s )->data() );
+
+  checkExpansion< std::greater<T> >( K, L, 2 );
+  checkExpansion< std::greater<T> >( K, L, 3 );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testTriangle<double>();
+  testTriangle<float> ();
+
+  testVietorisRips<double>();
+  testVietorisRips<float> ();
+
+  testRandomGraph<double>();
+  testRandomGraph<float> ();
+}
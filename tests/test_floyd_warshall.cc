@@ -1,14 +1,21 @@
 #include <tests/Base.hh>
 
+#include <aleph/topology/Dijkstra.hh>
 #include <aleph/topology/FloydWarshall.hh>
+#include <aleph/topology/RandomGraph.hh>
+#include <aleph/topology/ShortestPaths.hh>
 
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
+#include <limits>
+#include <random>
 #include <vector>
 
 template <class T> void test()
 {
+  ALEPH_TEST_BEGIN( "Simple graph" );
+
   using Simplex           = aleph::topology::Simplex<T, unsigned>;
   using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
 
@@ -30,10 +37,98 @@ template <class T> void test()
   ALEPH_ASSERT_EQUAL( M(0,2), T(3) );
   ALEPH_ASSERT_EQUAL( M(3,1), T(5) );
   ALEPH_ASSERT_EQUAL( M(0,0), T(0) );
+
+  auto D = aleph::topology::dijkstra( K );
+
+  ALEPH_ASSERT_EQUAL( D.numRows(), 4 );
+  ALEPH_ASSERT_EQUAL( D(0,2), T(3) );
+  ALEPH_ASSERT_EQUAL( D(3,1), T(5) );
+  ALEPH_ASSERT_EQUAL( D(0,0), T(0) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRandomGraphs()
+{
+  ALEPH_TEST_BEGIN( "Random graphs" );
+
+  using Simplex           = aleph::topology::Simplex<T, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<double> edgeDistribution( 0.0, 1.0 );
+  std::uniform_int_distribution<unsigned> weightDistribution( 1, 10 );
+
+  for( auto&& p : { 0.02, 0.1, 0.5 } )
+  {
+    unsigned n = 150;
+
+    std::vector<Simplex> simplices;
+
+    for( unsigned i = 0; i < n; i++ )
+      simplices.push_back( Simplex( i ) );
+
+    for( unsigned u = 0; u < n; u++ )
+      for( unsigned v = u+1; v < n; v++ )
+        if( edgeDistribution( rng ) < p )
+          simplices.push_back( Simplex( {u,v}, T( weightDistribution( rng ) ) ) );
+
+    SimplicialComplex K( simplices.begin(), simplices.end() );
+
+    // Block sizes that do not divide the number of vertices ensure that
+    // partial tiles are handled correctly.
+    auto M1 = aleph::topology::floydWarshall( K, T(0), 1 );
+    auto M2 = aleph::topology::floydWarshall( K, T(0), 7 );
+    auto M3 = aleph::topology::floydWarshall( K );
+    auto M4 = aleph::topology::dijkstra( K );
+    auto M5 = aleph::topology::allPairsShortestPaths( K );
+
+    for( unsigned i = 0; i < n; i++ )
+    {
+      for( unsigned j = i; j < n; j++ )
+      {
+        ALEPH_ASSERT_EQUAL( M1(i,j), M2(i,j) );
+        ALEPH_ASSERT_EQUAL( M1(i,j), M3(i,j) );
+        ALEPH_ASSERT_EQUAL( M1(i,j), M4(i,j) );
+        ALEPH_ASSERT_EQUAL( M1(i,j), M5(i,j) );
+      }
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
+void testUnreachable()
+{
+  ALEPH_TEST_BEGIN( "Unreachable vertices" );
+
+  using Simplex           = aleph::topology::Simplex<unsigned, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  SimplicialComplex K = {
+    {0}, {1}, {2},
+    Simplex( {0,1}, 2 )
+  };
+
+  auto M = aleph::topology::floydWarshall( K );
+  auto D = aleph::topology::dijkstra( K );
+
+  ALEPH_ASSERT_EQUAL( M(0,1), 2 );
+  ALEPH_ASSERT_EQUAL( D(0,1), 2 );
+  ALEPH_ASSERT_EQUAL( M(0,2), std::numeric_limits<unsigned>::max() );
+  ALEPH_ASSERT_EQUAL( D(0,2), std::numeric_limits<unsigned>::max() );
+
+  ALEPH_TEST_END();
 }
 
 int main( int, char** )
 {
   test<float> ();
   test<double>();
+
+  testRandomGraphs<float>   ();
+  testRandomGraphs<double>  ();
+  testRandomGraphs<unsigned>();
+
+  testUnreachable();
 }
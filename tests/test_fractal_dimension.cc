@@ -5,6 +5,12 @@
 
 #include <tests/Base.hh>
 
+#include <algorithm>
+#include <iterator>
+
+#include <cmath>
+#include <cstddef>
+
 using namespace aleph::geometry::distances;
 using namespace aleph::containers;
 using namespace aleph;
@@ -31,8 +37,65 @@ template <class T> void testCorrelationDimension()
   ALEPH_TEST_END();
 }
 
+template <class T> void testStreamingCorrelationDimension()
+{
+  ALEPH_TEST_BEGIN( "Correlation dimension (streaming)" );
+
+  using PointCloud = PointCloud<T>;
+  PointCloud pc = load<T>(
+    CMAKE_SOURCE_DIR + std::string( "/tests/input/Iris_comma_separated.txt" )
+  );
+
+  auto cds1 = correlationDimensionIntegral( pc, Euclidean<double>() );
+  auto cds2 = streamingCorrelationDimensionIntegral( pc, 32, Euclidean<double>() );
+
+  ALEPH_ASSERT_THROW( cds2.x.empty() == false );
+  ALEPH_ASSERT_EQUAL( cds2.x.size(), cds2.y.size() );
+  ALEPH_ASSERT_THROW( cds2.x.size() <= 32 );
+
+  // The last bin contains the largest distance, so all pairs have to be
+  // counted at this point.
+  ALEPH_ASSERT_THROW( std::abs( cds2.y.back() - 1.0 ) < 1e-12 );
+
+  // Every sample has to match the exact value of the correlation
+  // integral at the corresponding radius. A tolerance of a few pairs
+  // accounts for distances that are rounded into a neighbouring bin.
+  auto n         = static_cast<double>( pc.size() );
+  auto tolerance = 3.0 / ( n * (n-1) * 0.5 );
+
+  for( std::size_t i = 0; i < cds2.x.size(); i++ )
+  {
+    ALEPH_ASSERT_THROW( i == 0 || cds2.x[i-1] < cds2.x[i] );
+    ALEPH_ASSERT_THROW( i == 0 || cds2.y[i-1] < cds2.y[i] || cds2.y[i-1] == cds2.y[i] );
+
+    auto it = std::upper_bound( cds1.x.begin(), cds1.x.end(), cds2.x[i] );
+    auto y  = it == cds1.x.begin() ? 0.0 : cds1.y.at( std::size_t( std::distance( cds1.x.begin(), it ) - 1 ) );
+
+    ALEPH_ASSERT_THROW( std::abs( cds2.y[i] - y ) <= tolerance );
+  }
+
+  // The estimate differs from the one of the exact sequence because the
+  // samples are spaced uniformly on a logarithmic scale.
+  auto nu = correlationDimension( cds2 );
+
+  ALEPH_ASSERT_THROW( nu > 1.0 );
+
+  // Restricting the range of radii ------------------------------------
+
+  auto cds3 = streamingCorrelationDimensionIntegral( pc, 16, Euclidean<double>(), 0.5, 2.0 );
+
+  ALEPH_ASSERT_THROW( cds3.x.empty() == false );
+  ALEPH_ASSERT_THROW( cds3.x.back() <= 2.0 + 1e-9 );
+  ALEPH_ASSERT_THROW( cds3.y.back() < 1.0 );
+
+  ALEPH_TEST_END();
+}
+
 int main(int, char**)
 {
   testCorrelationDimension<float> ();
   testCorrelationDimension<double>();
+
+  testStreamingCorrelationDimension<float> ();
+  testStreamingCorrelationDimension<double>();
 }
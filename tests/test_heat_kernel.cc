@@ -7,6 +7,10 @@
 #include <aleph/topology/Simplex.hh>
 #include <aleph/topology/SimplicialComplex.hh>
 
+#include <utility>
+
+#include <cmath>
+
 template <class T> aleph::topology::SimplicialComplex< aleph::topology::Simplex<T, unsigned> > createTestSimplicialComplex()
 {
   using Simplex           = typename aleph::topology::Simplex<T, unsigned>;
@@ -86,6 +90,91 @@ template <class T> void testHeatKernelSimple()
   ALEPH_TEST_END();
 }
 
+template <class T> void testSparseLaplacianMatrix()
+{
+  ALEPH_TEST_BEGIN( "Sparse weighted Laplacian matrix" );
+
+  auto K = createTestSimplicialComplex<T>();
+  auto L = aleph::geometry::weightedLaplacianMatrix( K );
+  auto S = aleph::geometry::sparseWeightedLaplacianMatrix( K );
+
+  ALEPH_ASSERT_EQUAL( L.rows(), S.rows() );
+  ALEPH_ASSERT_EQUAL( L.cols(), S.cols() );
+  ALEPH_ASSERT_EQUAL( S.nonZeros(), 12 );
+
+  for( unsigned i = 0; i < L.rows(); i++ )
+    for( unsigned j = 0; j < L.cols(); j++ )
+      ALEPH_ASSERT_EQUAL( L(i,j), S.coeff(i,j) );
+
+  ALEPH_TEST_END();
+}
+
+void testHeatKernelTruncated()
+{
+  ALEPH_TEST_BEGIN( "Truncated heat kernel" );
+
+  using Simplex           = aleph::topology::Simplex<double, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  // Cycle graph with additional chords; its Laplacian spectrum is
+  // non-trivial but still small enough to be compared with the dense
+  // solver.
+  unsigned n = 60;
+
+  std::vector<Simplex> simplices;
+
+  for( unsigned i = 0; i < n; i++ )
+    simplices.push_back( Simplex( {i}, 1.0 ) );
+
+  for( unsigned i = 0; i < n; i++ )
+  {
+    simplices.push_back( Simplex( {i, (i+1) % n}, 1.0 + 0.1 * (i % 7) ) );
+
+    if( i % 5 == 0 )
+      simplices.push_back( Simplex( {i, (i+n/2) % n}, 0.5 ) );
+  }
+
+  SimplicialComplex K( simplices.begin(), simplices.end() );
+
+  aleph::geometry::HeatKernel full( K );
+  aleph::geometry::HeatKernel complete( K, n );
+
+  // Using the complete spectrum, the results have to coincide with the
+  // ones of the dense solver.
+  for( auto&& t : { 0.01, 0.1, 1.0, 10.0 } )
+  {
+    ALEPH_ASSERT_THROW( std::abs( full.trace(t) - complete.trace(t) ) < 1e-6 );
+
+    for( unsigned i = 0; i < n; i += 7 )
+    {
+      using IndexType = aleph::geometry::HeatKernel::IndexType;
+
+      ALEPH_ASSERT_THROW( std::abs( full( IndexType(i), t ) - complete( IndexType(i), t ) ) < 1e-6 );
+      ALEPH_ASSERT_THROW( std::abs( full( IndexType(i), IndexType(i+1), t ) - complete( IndexType(i), IndexType(i+1), t ) ) < 1e-6 );
+    }
+  }
+
+  // Using a truncated spectrum, large time values are still dominated
+  // by the smallest eigenvalues.
+  aleph::geometry::HeatKernel truncated( K, 10 );
+
+  for( auto&& pair : { std::make_pair( 10.0, 5e-2 ), std::make_pair( 100.0, 1e-6 ) } )
+  {
+    auto t   = pair.first;
+    auto eps = pair.second;
+
+    ALEPH_ASSERT_THROW( std::abs( full.trace(t) - truncated.trace(t) ) < eps );
+
+    for( unsigned i = 0; i < n; i += 7 )
+    {
+      using IndexType = aleph::geometry::HeatKernel::IndexType;
+      ALEPH_ASSERT_THROW( std::abs( full( IndexType(i), t ) - truncated( IndexType(i), t ) ) < eps );
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
 #endif
 
 int main( int, char** )
@@ -96,5 +185,10 @@ int main( int, char** )
 
   testHeatKernelSimple<float> ();
   testHeatKernelSimple<double>();
+
+  testSparseLaplacianMatrix<float> ();
+  testSparseLaplacianMatrix<double>();
+
+  testHeatKernelTruncated();
 #endif
 }
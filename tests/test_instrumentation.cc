@@ -0,0 +1,148 @@
+// Instrumentation is always enabled for this test, regardless of the
+// configuration of the library.
+#define ALEPH_WITH_INSTRUMENTATION
+
+#include <tests/Base.hh>
+
+#include <aleph/geometry/RipsExpander.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <aleph/persistentHomology/algorithms/Twist.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/utilities/AllocationCounter.hh>
+#include <aleph/utilities/Instrumentation.hh>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using DataType          = double;
+using VertexType        = unsigned;
+using Simplex           = aleph::topology::Simplex<DataType, VertexType>;
+using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+SimplicialComplex makeComplex()
+{
+  std::vector<Simplex> simplices;
+
+  unsigned n = 10;
+  unsigned k = 0;
+
+  for( VertexType i = 0; i < n; i++ )
+    simplices.push_back( Simplex( i ) );
+
+  for( VertexType i = 0; i < n; i++ )
+    for( VertexType j = i+1; j < n; j++ )
+      simplices.push_back( Simplex( {i,j}, DataType( ( 7 * k++ ) % 45 ) ) );
+
+  SimplicialComplex K( simplices.begin(), simplices.end() );
+
+  aleph::geometry::RipsExpander<SimplicialComplex> expander;
+
+  K = expander( K, 2 );
+  K = expander.assignMaximumWeight( K );
+
+  K.sort( aleph::topology::filtrations::Data<Simplex>() );
+  return K;
+}
+
+void testRecorder()
+{
+  ALEPH_TEST_BEGIN( "Instrumentation: Recorder" );
+
+  using namespace aleph::utilities::instrumentation;
+
+  auto&& recorder = Recorder::instance();
+
+  recorder.reset();
+  recorder.enable();
+
+  auto K = makeComplex();
+  auto D = aleph::calculatePersistenceDiagrams<aleph::persistentHomology::algorithms::Twist>( K );
+
+  recorder.disable();
+
+  auto phases   = recorder.phases();
+  auto counters = recorder.counters();
+  auto maxima   = recorder.maxima();
+
+  for( auto&& name : { "ripsExpansion", "makeBoundaryMatrix", "dualize", "reduction", "pairing", "makePersistenceDiagrams", "calculatePersistenceDiagrams" } )
+  {
+    ALEPH_ASSERT_THROW( phases.find( name ) != phases.end() );
+    ALEPH_ASSERT_EQUAL( phases.at( name ).calls, 1 );
+    ALEPH_ASSERT_THROW( phases.at( name ).seconds >= 0.0 );
+  }
+
+  ALEPH_ASSERT_THROW( phases.at( "makeBoundaryMatrix" ).allocations > 0 );
+  ALEPH_ASSERT_THROW( phases.at( "calculatePersistenceDiagrams" ).seconds >= phases.at( "reduction" ).seconds );
+
+  ALEPH_ASSERT_EQUAL( counters.at( "boundary_matrix_columns" ), static_cast<std::int64_t>( K.size() ) );
+  ALEPH_ASSERT_EQUAL( counters.at( "rips_expansion_simplices" ), static_cast<std::int64_t>( K.size() ) );
+  ALEPH_ASSERT_THROW( counters.at( "column_additions" ) > 0 );
+  ALEPH_ASSERT_THROW( counters.at( "column_clearings" ) > 0 );
+  ALEPH_ASSERT_EQUAL( counters.at( "reduction_entry_delta" ), counters.at( "reduced_matrix_entries" ) - counters.at( "boundary_matrix_entries" ) );
+  ALEPH_ASSERT_THROW( maxima.at( "reduced_column_length" ) > 0 );
+
+  auto json = recorder.toJSON();
+
+  ALEPH_ASSERT_THROW( json.find( "\"phases\"" )           != std::string::npos );
+  ALEPH_ASSERT_THROW( json.find( "\"reduction\"" )        != std::string::npos );
+  ALEPH_ASSERT_THROW( json.find( "\"column_additions\"" ) != std::string::npos );
+
+  // Nothing is recorded while the recorder is disabled, and the results
+  // of the calculation do not depend on the instrumentation.
+  recorder.reset();
+
+  auto E = aleph::calculatePersistenceDiagrams<aleph::persistentHomology::algorithms::Twist>( K );
+
+  ALEPH_ASSERT_THROW( recorder.phases().empty() );
+  ALEPH_ASSERT_THROW( recorder.counters().empty() );
+  ALEPH_ASSERT_EQUAL( D.size(), E.size() );
+
+  for( std::size_t i = 0; i < D.size(); i++ )
+    ALEPH_ASSERT_THROW( D[i] == E[i] );
+
+  ALEPH_ASSERT_THROW( recorder.toJSON() == "{\n  \"phases\": {},\n  \"counters\": {},\n  \"maxima\": {}\n}\n" );
+
+  ALEPH_TEST_END();
+}
+
+void testAllocationCounter()
+{
+  ALEPH_TEST_BEGIN( "Instrumentation: Allocation counter" );
+
+  using namespace aleph::utilities;
+
+  auto&& heap = HeapStatistics::instance();
+
+  auto allocations = heap.allocations();
+  auto current     = heap.current();
+  auto n           = instrumentation::detail::numAllocations();
+
+  {
+    std::unique_ptr<double>   p( new double( 1.0 ) );
+    std::unique_ptr<double[]> q( new double[16] );
+
+    ALEPH_ASSERT_EQUAL( heap.allocations() - allocations, 2 );
+    ALEPH_ASSERT_EQUAL( instrumentation::detail::numAllocations() - n, 2 );
+    ALEPH_ASSERT_EQUAL( heap.current() - current, 17 * sizeof(double) );
+  }
+
+  // Array and non-array deallocations are paired with their allocations,
+  // so all memory is returned.
+  ALEPH_ASSERT_EQUAL( heap.current(), current );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testRecorder();
+  testAllocationCounter();
+}
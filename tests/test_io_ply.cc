@@ -0,0 +1,156 @@
+#include <tests/Base.hh>
+
+#include <aleph/topology/CompactMesh.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/io/PLY.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+template <class D, class V> void testComplex()
+{
+  ALEPH_TEST_BEGIN( "PLY file parsing: simplicial complexes" );
+
+  using Simplex           = aleph::topology::Simplex<D, V>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  std::vector<std::string> filenames = {
+    CMAKE_SOURCE_DIR + std::string( "/tests/input/Octahedron_ascii.ply" ),
+    CMAKE_SOURCE_DIR + std::string( "/tests/input/Octahedron_little_endian.ply" ),
+    CMAKE_SOURCE_DIR + std::string( "/tests/input/Octahedron_big_endian.ply" )
+  };
+
+  std::vector<SimplicialComplex> complexes;
+
+  for( auto&& filename : filenames )
+  {
+    SimplicialComplex K;
+
+    aleph::topology::io::PLYReader reader;
+    reader.setDataProperty( "quality" );
+    reader( filename, K );
+
+    auto n0 = std::count_if( K.begin(), K.end(), [] ( const Simplex& s ) { return s.dimension() == 0; } );
+    auto n1 = std::count_if( K.begin(), K.end(), [] ( const Simplex& s ) { return s.dimension() == 1; } );
+    auto n2 = std::count_if( K.begin(), K.end(), [] ( const Simplex& s ) { return s.dimension() == 2; } );
+
+    ALEPH_ASSERT_EQUAL( n0,  6 );
+    ALEPH_ASSERT_EQUAL( n1, 12 );
+    ALEPH_ASSERT_EQUAL( n2,  8 );
+
+    // Weights of vertices are taken from the data property, and every
+    // higher-dimensional simplex receives the maximum weight of its
+    // faces.
+    ALEPH_ASSERT_THROW( K.contains( Simplex( {0,2,4} ) ) );
+    ALEPH_ASSERT_EQUAL( K.find( Simplex( V(0) ) )->data(), D(0.5) );
+    ALEPH_ASSERT_EQUAL( K.find( Simplex( {0,2,4} ) )->data(), D(4.5) );
+
+    complexes.push_back( K );
+  }
+
+  for( auto&& K : complexes )
+  {
+    ALEPH_ASSERT_THROW( std::equal( K.begin(), K.end(), complexes.front().begin() ) );
+
+    for( auto&& s : K )
+      ALEPH_ASSERT_EQUAL( s.data(), complexes.front().find( s )->data() );
+  }
+
+  {
+    SimplicialComplex K;
+
+    std::ifstream in( filenames.back(), std::ios::binary );
+
+    aleph::topology::io::PLYReader reader;
+    reader.setDataProperty( "quality" );
+    reader( in, K );
+
+    ALEPH_ASSERT_EQUAL( K.size(), complexes.back().size() );
+  }
+
+  ALEPH_TEST_END();
+}
+
+void testMesh()
+{
+  ALEPH_TEST_BEGIN( "PLY file parsing: meshes" );
+
+  using Mesh = aleph::topology::CompactMesh<float, double>;
+
+  for( auto&& name : { "ascii", "little_endian", "big_endian" } )
+  {
+    Mesh M;
+
+    aleph::topology::io::PLYReader reader;
+    reader( CMAKE_SOURCE_DIR + std::string( "/tests/input/Octahedron_" ) + name + ".ply", M );
+
+    ALEPH_ASSERT_EQUAL( M.numVertices(), 6 );
+    ALEPH_ASSERT_EQUAL( M.numFaces(),    8 );
+    ALEPH_ASSERT_EQUAL( M.numEdges(),   12 );
+    ALEPH_ASSERT_EQUAL( M.numConnectedComponents(), 1 );
+
+    // The default data property is the last coordinate
+    ALEPH_ASSERT_EQUAL( M.data(4),  1.0 );
+    ALEPH_ASSERT_EQUAL( M.data(5), -1.0 );
+
+    for( Mesh::Index v = 0; v < 6; v++ )
+      ALEPH_ASSERT_EQUAL( M.link(v).size(), 4 );
+
+    ALEPH_ASSERT_THROW( M.face(1) == std::vector<Mesh::Index>( { 2, 1, 4 } ) );
+  }
+
+  ALEPH_TEST_END();
+}
+
+void testElementsWithoutProperties()
+{
+  ALEPH_TEST_BEGIN( "PLY file parsing: elements without properties" );
+
+  using Mesh = aleph::topology::CompactMesh<float, double>;
+
+  // Adds an element without properties to the end of the header. Since
+  // it does not occupy any bytes, its count must not be checked against
+  // the remaining size of the file.
+  std::string contents;
+
+  {
+    std::ifstream in( CMAKE_SOURCE_DIR + std::string( "/tests/input/Octahedron_little_endian.ply" ), std::ios::binary );
+    contents.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+
+    auto position = contents.find( "end_header" );
+    ALEPH_ASSERT_THROW( position != std::string::npos );
+
+    contents.insert( position, "element marker 1000\n" );
+  }
+
+  std::string filename = "/tmp/Octahedron_empty_element.ply";
+
+  {
+    std::ofstream out( filename, std::ios::binary );
+    out << contents;
+  }
+
+  Mesh M;
+
+  aleph::topology::io::PLYReader reader;
+  reader( filename, M );
+
+  ALEPH_ASSERT_EQUAL( M.numVertices(), 6 );
+  ALEPH_ASSERT_EQUAL( M.numFaces(),    8 );
+
+  ALEPH_TEST_END();
+}
+
+int main(int, char**)
+{
+  testComplex<double, unsigned>();
+  testComplex<float,  short>();
+
+  testMesh();
+  testElementsWithoutProperties();
+}
@@ -1,9 +1,20 @@
 #include <tests/Base.hh>
 
+#include <aleph/config/Eigen.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/math/BinnedKernelDensityEstimator.hh>
 #include <aleph/math/KernelDensityEstimator.hh>
+#include <aleph/math/TreeKernelDensityEstimator.hh>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
+#include <cmath>
+#include <cstddef>
+
 void test1D()
 {
   ALEPH_TEST_BEGIN( "1D example" );
@@ -30,8 +41,145 @@ void test2D()
 {
 }
 
+/*
+  Creates a point cloud that consists of two Gaussian blobs; this ensures
+  that the density varies considerably.
+*/
+
+aleph::containers::PointCloud<double> makePointCloud( std::size_t n, std::size_t d )
+{
+  aleph::containers::PointCloud<double> pc( n, d );
+
+  std::mt19937 rng( 42 );
+  std::normal_distribution<double> distribution( 0.0, 1.0 );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    std::vector<double> p( d );
+
+    for( auto&& x : p )
+      x = distribution( rng ) + ( i % 2 == 0 ? 0.0 : 5.0 );
+
+    pc.set( i, p.begin(), p.end() );
+  }
+
+  return pc;
+}
+
+template <class Kernel> std::vector<double> bruteForceDensities( const aleph::containers::PointCloud<double>& pc, double h, Kernel kernel )
+{
+  auto n = pc.size();
+  auto d = pc.dimension();
+
+  std::vector<double> densities( n );
+
+  for( std::size_t i = 0; i < n; i++ )
+  {
+    auto p = pc[i];
+
+    for( std::size_t j = 0; j < n; j++ )
+    {
+      auto q          = pc[j];
+      double distance = 0.0;
+
+      for( std::size_t k = 0; k < d; k++ )
+        distance += ( p[k] - q[k] ) * ( p[k] - q[k] );
+
+      densities[i] += kernel( std::sqrt( distance ) / h );
+    }
+
+    densities[i] /= std::pow( h, static_cast<double>( d ) ) * static_cast<double>( n );
+  }
+
+  return densities;
+}
+
+template <class Kernel> void testTree( Kernel kernel )
+{
+  ALEPH_TEST_BEGIN( "Tree-based estimator" );
+
+  auto pc        = makePointCloud( 2000, 3 );
+  auto h         = 0.5;
+  auto reference = bruteForceDensities( pc, h, kernel );
+
+  // Exact evaluation --------------------------------------------------
+
+  {
+    aleph::math::TreeKernelDensityEstimator<Kernel> kde( pc, h, kernel, 0.0, 8 );
+    auto densities = kde.densities();
+
+    ALEPH_ASSERT_EQUAL( densities.size(), reference.size() );
+
+    for( std::size_t i = 0; i < densities.size(); i++ )
+      ALEPH_ASSERT_THROW( std::abs( densities[i] - reference[i] ) <= 1e-12 * reference[i] );
+
+    // Querying arbitrary positions must yield the same values
+    for( std::size_t i = 0; i < 10; i++ )
+    {
+      auto p = pc[i];
+      ALEPH_ASSERT_THROW( std::abs( kde( p.begin() ) - reference[i] ) <= 1e-12 * reference[i] );
+    }
+  }
+
+  // Approximate evaluation --------------------------------------------
+
+  for( double tolerance : { 1e-2, 1e-4 } )
+  {
+    aleph::math::TreeKernelDensityEstimator<Kernel> kde( pc, h, kernel, tolerance );
+    auto densities = kde.densities();
+
+    for( std::size_t i = 0; i < densities.size(); i++ )
+      ALEPH_ASSERT_THROW( std::abs( densities[i] - reference[i] ) <= tolerance * reference[i] );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class Kernel> void testBinned( Kernel kernel )
+{
+#ifdef ALEPH_WITH_EIGEN
+  ALEPH_TEST_BEGIN( "Binned estimator" );
+
+  auto pc        = makePointCloud( 2000, 2 );
+  auto h         = 1.0;
+  auto reference = bruteForceDensities( pc, h, kernel );
+
+  aleph::math::BinnedKernelDensityEstimator<Kernel> kde( pc, h, kernel, 128 );
+  auto densities = kde.densities();
+
+  ALEPH_ASSERT_EQUAL( densities.size(), reference.size() );
+
+  double maxReference = 0.0;
+  double maxError     = 0.0;
+
+  for( std::size_t i = 0; i < densities.size(); i++ )
+  {
+    maxReference = std::max( maxReference, reference[i] );
+    maxError     = std::max( maxError, std::abs( densities[i] - reference[i] ) );
+  }
+
+  // The binning introduces an error that depends on the ratio between
+  // the bandwidth and the spacing of the grid.
+  ALEPH_ASSERT_THROW( maxError <= 0.02 * maxReference );
+
+  // Far away from the data, the estimate has to vanish
+  std::vector<double> x = { 100.0, 100.0 };
+  ALEPH_ASSERT_EQUAL( kde( x.begin() ), 0.0 );
+
+  ALEPH_TEST_END();
+#else
+  (void) kernel;
+#endif
+}
+
 int main(int, char**)
 {
   test1D();
   test2D();
+
+  testTree( aleph::math::kernels::Gaussian() );
+  testTree( aleph::math::kernels::Epanechnikov() );
+
+  testBinned( aleph::math::kernels::Gaussian() );
+  testBinned( aleph::math::kernels::Epanechnikov() );
 }
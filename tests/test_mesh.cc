@@ -1,5 +1,6 @@
 #include <tests/Base.hh>
 
+#include <aleph/topology/CompactMesh.hh>
 #include <aleph/topology/Mesh.hh>
 #include <aleph/topology/MorseSmaleComplex.hh>
 
@@ -153,9 +154,200 @@ void test3()
   ALEPH_TEST_END();
 }
 
+void test4()
+{
+  ALEPH_TEST_BEGIN( "Compact mesh" );
+
+  using Mesh  = aleph::topology::CompactMesh<double, double>;
+  using Index = Mesh::Index;
+
+  std::vector<double> coordinates = {
+    0.0, 0.0, 0.0,
+    1.0, 0.0, 0.0,
+    2.0, 0.0, 0.0,
+    0.0, 1.0, 0.0,
+    1.0, 1.0, 0.0,
+    2.0, 1.0, 0.0,
+    0.0, 2.0, 0.0,
+    1.0, 2.0, 0.0,
+    2.0, 2.0, 0.0
+  };
+
+  std::vector<double> data = { 0.0, 1.0, 0.0, 1.0, 2.0, 1.0, 0.0, 1.0, 0.0 };
+
+  std::vector<Index> triangles = {
+    0, 1, 4,
+    0, 4, 3,
+    1, 2, 4,
+    2, 5, 4,
+    4, 5, 8,
+    4, 8, 7,
+    3, 4, 6,
+    4, 7, 6
+  };
+
+  Mesh M( coordinates, data, triangles );
+
+  ALEPH_ASSERT_EQUAL( M.numVertices(), 9 );
+  ALEPH_ASSERT_EQUAL( M.numFaces(),    8 );
+  ALEPH_ASSERT_EQUAL( M.numEdges(),   16 );
+  ALEPH_ASSERT_EQUAL( M.numConnectedComponents(), 1 );
+
+  ALEPH_ASSERT_EQUAL( M.data(4), 2.0 );
+
+  {
+    auto l1 = M.link(1);
+    auto l3 = M.link(3);
+    auto l5 = M.link(5);
+    auto l7 = M.link(7);
+
+    ALEPH_ASSERT_EQUAL( l1.size(), 3 );
+    ALEPH_ASSERT_EQUAL( l1.size(), l3.size() );
+    ALEPH_ASSERT_EQUAL( l1.size(), l5.size() );
+    ALEPH_ASSERT_EQUAL( l1.size(), l7.size() );
+
+    auto l4 = M.link(4);
+
+    ALEPH_ASSERT_EQUAL( l4.size(), 8 );
+  }
+
+  {
+    auto lower  = M.getLowerNeighbours(4);
+    auto higher = M.getHigherNeighbours(4);
+
+    ALEPH_ASSERT_EQUAL( lower.size(),  8 );
+    ALEPH_ASSERT_EQUAL( higher.size(), 0 );
+
+    ALEPH_ASSERT_THROW( M.hasEdge(0,4) );
+    ALEPH_ASSERT_THROW( M.hasEdge(4,0) );
+    ALEPH_ASSERT_THROW( M.hasEdge(6,3) );
+    ALEPH_ASSERT_THROW( M.hasEdge(3,6) );
+    ALEPH_ASSERT_THROW( !M.hasEdge(0,8) );
+    ALEPH_ASSERT_THROW( !M.hasEdge(1,3) );
+  }
+
+  {
+    auto faces = M.faces();
+
+    ALEPH_ASSERT_EQUAL( faces.size(), 8 );
+    ALEPH_ASSERT_THROW( faces.front() == std::vector<Index>( { 0, 1, 4 } ) );
+    ALEPH_ASSERT_THROW( faces.back()  == std::vector<Index>( { 4, 7, 6 } ) );
+  }
+
+  {
+    auto st = M.star(0);
+
+    ALEPH_ASSERT_EQUAL( st.numVertices(), 4 );
+    ALEPH_ASSERT_EQUAL( st.numFaces(),    2 );
+    ALEPH_ASSERT_EQUAL( st.data(3),     2.0 );
+
+    ALEPH_ASSERT_THROW( st.hasEdge(0,1) );
+    ALEPH_ASSERT_THROW( st.hasEdge(0,2) );
+    ALEPH_ASSERT_THROW( st.hasEdge(0,3) );
+    ALEPH_ASSERT_THROW( st.hasEdge(1,3) );
+    ALEPH_ASSERT_THROW( !st.hasEdge(1,2) );
+  }
+
+  // Compare with pointer-based mesh -----------------------------------
+
+  {
+    aleph::topology::Mesh<double, double> N;
+
+    for( std::size_t i = 0; i < data.size(); i++ )
+      N.addVertex( coordinates[3*i], coordinates[3*i+1], coordinates[3*i+2], data[i] );
+
+    for( std::size_t i = 0; i < triangles.size(); i += 3 )
+      N.addFace( triangles.begin() + long(i), triangles.begin() + long(i+3) );
+
+    for( Index v = 0; v < 9; v++ )
+    {
+      ALEPH_ASSERT_EQUAL( M.link(v).size(),                N.link(v).size() );
+      ALEPH_ASSERT_EQUAL( M.getLowerNeighbours(v).size(),  N.getLowerNeighbours(v).size() );
+      ALEPH_ASSERT_EQUAL( M.getHigherNeighbours(v).size(), N.getHigherNeighbours(v).size() );
+    }
+  }
+
+  aleph::topology::MorseSmaleComplex<Mesh> msc;
+  msc( M );
+
+  ALEPH_TEST_END();
+}
+
+void test5()
+{
+  ALEPH_TEST_BEGIN( "Compact mesh: closed surfaces and errors" );
+
+  using Mesh  = aleph::topology::CompactMesh<float>;
+  using Index = Mesh::Index;
+
+  // Two disjoint tetrahedra; the second one is described by a face list
+  // with explicit offsets.
+  std::vector<float> coordinates = {
+    0.f, 0.f, 0.f,
+    1.f, 0.f, 0.f,
+    0.f, 1.f, 0.f,
+    0.f, 0.f, 1.f,
+    5.f, 0.f, 0.f,
+    6.f, 0.f, 0.f,
+    5.f, 1.f, 0.f,
+    5.f, 0.f, 1.f
+  };
+
+  std::vector<Index> indices = {
+    0, 2, 1,
+    0, 1, 3,
+    1, 2, 3,
+    0, 3, 2,
+    4, 6, 5,
+    4, 5, 7,
+    5, 6, 7,
+    4, 7, 6
+  };
+
+  std::vector<Index> offsets = { 0, 3, 6, 9, 12, 15, 18, 21, 24 };
+
+  Mesh M( coordinates, {}, indices, offsets );
+
+  ALEPH_ASSERT_EQUAL( M.numVertices(), 8 );
+  ALEPH_ASSERT_EQUAL( M.numFaces(),    8 );
+  ALEPH_ASSERT_EQUAL( M.numEdges(),   12 );
+  ALEPH_ASSERT_EQUAL( M.numConnectedComponents(), 2 );
+
+  for( Index v = 0; v < 8; v++ )
+    ALEPH_ASSERT_EQUAL( M.link(v).size(), 3 );
+
+  // Every link of a closed surface is a cycle: consecutive vertices of
+  // the link have to be connected.
+  {
+    auto link = M.link(0);
+
+    for( std::size_t i = 0; i < link.size(); i++ )
+      ALEPH_ASSERT_THROW( M.hasEdge( link[i], link[ (i+1) % link.size() ] ) );
+  }
+
+  {
+    std::vector<Index> inconsistent = { 0, 1, 2, 0, 1, 3 };
+    ALEPH_EXPECT_EXCEPTION( Mesh( coordinates, {}, inconsistent ), std::runtime_error );
+  }
+
+  {
+    std::vector<Index> nonManifold = { 0, 1, 2, 1, 0, 3, 0, 1, 4 };
+    ALEPH_EXPECT_EXCEPTION( Mesh( coordinates, {}, nonManifold ), std::runtime_error );
+  }
+
+  {
+    std::vector<Index> unknown = { 0, 1, 9 };
+    ALEPH_EXPECT_EXCEPTION( Mesh( coordinates, {}, unknown ), std::runtime_error );
+  }
+
+  ALEPH_TEST_END();
+}
+
 int main(int, char**)
 {
   test1();
   test2();
   test3();
+  test4();
+  test5();
 }
@@ -5,6 +5,8 @@
 #include <aleph/persistenceDiagrams/Norms.hh>
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
 #include <aleph/persistenceDiagrams/PersistenceIndicatorFunction.hh>
+#include <aleph/persistenceDiagrams/PersistenceLandscape.hh>
+#include <aleph/persistenceDiagrams/Vectorization.hh>
 
 #include <aleph/persistenceDiagrams/distances/Bottleneck.hh>
 #include <aleph/persistenceDiagrams/distances/Hausdorff.hh>
@@ -14,10 +16,14 @@
 
 #include <aleph/persistenceDiagrams/kernels/KernelEmbedding.hh>
 #include <aleph/persistenceDiagrams/kernels/MultiScaleKernel.hh>
+#include <aleph/persistenceDiagrams/kernels/RandomFourierFeatures.hh>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
+#include <numeric>
 #include <random>
+#include <stdexcept>
 #include <vector>
 
 #include <cmath>
@@ -45,6 +51,38 @@ template <class T> aleph::PersistenceDiagram<T> createRandomPersistenceDiagram(
   return D;
 }
 
+template <class T> void testBettiCurve()
+{
+  ALEPH_TEST_BEGIN( "Betti curve" );
+
+  auto D = createRandomPersistenceDiagram<T>( 100 );
+  D.add( T(0.5) );
+
+  aleph::BettiCurve<T> f( 50, T(0), T(1) );
+
+  auto curve = f( D );
+
+  ALEPH_ASSERT_EQUAL( curve.size(), 50 );
+
+  for( std::size_t i = 0; i < curve.size(); i++ )
+  {
+    auto t = f.threshold(i);
+
+    auto betti = std::count_if( D.begin(), D.end(),
+                                [&t] ( const typename aleph::PersistenceDiagram<T>::Point& p )
+                                {
+                                  return double( p.x() ) <= t && t < double( p.y() );
+                                } );
+
+    ALEPH_ASSERT_EQUAL( curve[i], float( betti ) );
+  }
+
+  ALEPH_EXPECT_EXCEPTION( aleph::BettiCurve<T>( 0, T(0), T(1) ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::BettiCurve<T>( 2, T(1), T(0) ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
 template <class T> void testBottleneckDistance()
 {
   ALEPH_TEST_BEGIN( "Bottleneck distance" );
@@ -253,6 +291,93 @@ template <class T> void testMultiScaleKernel()
   ALEPH_TEST_END();
 }
 
+template <class T> void testMultiScaleKernelMatrix()
+{
+  ALEPH_TEST_BEGIN( "Multi-scale kernel matrix" );
+
+  std::vector< aleph::PersistenceDiagram<T> > diagrams;
+
+  for( unsigned i = 0; i < 6; i++ )
+    diagrams.push_back( createRandomPersistenceDiagram<T>( 20 + 10*i ) );
+
+  for( double sigma : { 0.01, 0.1, 1.0, 10.0 } )
+  {
+    auto K = aleph::multiScaleKernelMatrix( diagrams, sigma );
+    auto D = aleph::multiScalePseudoMetricMatrix( diagrams, sigma );
+
+    ALEPH_ASSERT_EQUAL( K.numRows(), diagrams.size() );
+    ALEPH_ASSERT_EQUAL( D.numRows(), diagrams.size() );
+
+    for( std::size_t i = 0; i < diagrams.size(); i++ )
+    {
+      ALEPH_ASSERT_EQUAL( D(i,i), 0.0 );
+
+      for( std::size_t j = 0; j < diagrams.size(); j++ )
+      {
+        auto k = aleph::multiScaleKernel( diagrams[i], diagrams[j], sigma );
+        auto d = aleph::multiScalePseudoMetric( diagrams[i], diagrams[j], sigma );
+
+        // The reference implementation calculates distances with the data
+        // type of the diagram, so single precision may cause deviations.
+        ALEPH_ASSERT_THROW( std::abs( K(i,j) - k ) < 1e-5 * std::max( std::abs( k ), 1.0 ) );
+
+        if( i != j )
+          ALEPH_ASSERT_THROW( std::abs( D(i,j) - d ) < 1e-3 * std::max( d, 1.0 ) );
+      }
+    }
+  }
+
+  // Spread out the points so that the approximation is able to skip
+  // pairs of points that are far away from each other.
+  for( auto&& D : diagrams )
+  {
+    aleph::PersistenceDiagram<T> E;
+
+    for( auto&& p : D )
+      E.add( T(200) * p.x(), T(200) * p.y() );
+
+    D = E;
+  }
+
+  {
+    double epsilon = 1e-6;
+
+    auto K = aleph::multiScaleKernelMatrix( diagrams, 1.0 );
+    auto L = aleph::multiScaleKernelMatrix( diagrams, 1.0, epsilon );
+
+    for( std::size_t i = 0; i < diagrams.size(); i++ )
+    {
+      for( std::size_t j = 0; j < diagrams.size(); j++ )
+        ALEPH_ASSERT_THROW( std::abs( K(i,j) - L(i,j) ) <= epsilon );
+    }
+  }
+
+  ALEPH_EXPECT_EXCEPTION( aleph::multiScaleKernelMatrix( diagrams, 1.0, -1.0 ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::multiScaleKernelMatrix( diagrams, 0.0 ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::multiScaleKernelMatrix( diagrams, -1.0 ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::multiScaleKernel( diagrams.front(), diagrams.back(), 0.0 ), std::runtime_error );
+
+  // The smoothing parameter determines the width of the Gaussians, so
+  // the kernel of two single points follows the closed-form solution.
+  {
+    aleph::PersistenceDiagram<T> D1;
+    aleph::PersistenceDiagram<T> D2;
+
+    D1.add( T(0), T(1) );
+    D2.add( T(0), T(2) );
+
+    for( double sigma : { 0.1, 1.0, 10.0 } )
+    {
+      auto k = 1.0 / ( 8.0 * M_PI * sigma ) * ( std::exp( -1.0 / ( 8.0 * sigma ) ) - std::exp( -5.0 / ( 8.0 * sigma ) ) );
+
+      ALEPH_ASSERT_THROW( std::abs( aleph::multiScaleKernel( D1, D2, sigma ) - k ) < 1e-12 );
+      ALEPH_ASSERT_THROW( std::abs( aleph::multiScaleKernelMatrix( std::vector< aleph::PersistenceDiagram<T> >( { D1, D2 } ), sigma )(0,1) - k ) < 1e-12 );
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
 template <class T> void testNearestNeighbourDistance()
 {
   ALEPH_TEST_BEGIN( "Nearest neighbour distance" );
@@ -268,6 +393,255 @@ template <class T> void testNearestNeighbourDistance()
   ALEPH_TEST_END();
 }
 
+template <class T> void testPersistenceImage()
+{
+  ALEPH_TEST_BEGIN( "Persistence image" );
+
+  // A single point whose Gaussian is completely contained in the image
+  // results in an image whose pixels sum to the weight of the point.
+  {
+    aleph::PersistenceDiagram<T> D;
+    D.add( T(0.5), T(1.0) );
+    D.add( T(0.1) );
+
+    aleph::PersistenceImage<T> f( 40, 20, T(0), T(1), T(0), T(1), 0.05 );
+
+    auto image = f( D );
+    auto sum   = std::accumulate( image.begin(), image.end(), 0.0 );
+
+    ALEPH_ASSERT_EQUAL( image.size(), 800 );
+    ALEPH_ASSERT_THROW( std::abs( sum - 0.5 ) < 1e-4 );
+
+    auto max = std::distance( image.begin(), std::max_element( image.begin(), image.end() ) );
+
+    // Row 10 contains persistence values in [0.5, 0.55], while column 20
+    // contains birth values in [0.5, 0.525]. Since the point lies on the
+    // boundary of two pixels in both directions, the maximum may be in
+    // any of the adjacent ones.
+    ALEPH_ASSERT_THROW( max / 40 == 9  || max / 40 == 10 );
+    ALEPH_ASSERT_THROW( max % 40 == 19 || max % 40 == 20 );
+  }
+
+  // Compare the separable calculation with a direct evaluation of all
+  // pixels.
+  {
+    auto D     = createRandomPersistenceDiagram<T>( 30 );
+    auto sigma = 0.1;
+
+    aleph::PersistenceImage<T> f( 16, 8, T(0), T(1), T(0), T(1), sigma );
+
+    auto image = f( D );
+
+    for( unsigned j = 0; j < 8; j++ )
+    {
+      for( unsigned i = 0; i < 16; i++ )
+      {
+        double value = 0.0;
+
+        for( auto&& p : D )
+        {
+          auto x = double( p.x() );
+          auto y = double( p.persistence() );
+          auto s = sigma * std::sqrt( 2.0 );
+
+          auto gx = 0.5 * ( std::erf( ( (i+1) / 16.0 - x ) / s ) - std::erf( ( i / 16.0 - x ) / s ) );
+          auto gy = 0.5 * ( std::erf( ( (j+1) /  8.0 - y ) / s ) - std::erf( ( j /  8.0 - y ) / s ) );
+
+          value += double( p.persistence() ) * gx * gy;
+        }
+
+        ALEPH_ASSERT_THROW( std::abs( image[j*16+i] - value ) < 1e-5 );
+      }
+    }
+  }
+
+  // Feature matrices
+  {
+    std::vector< aleph::PersistenceDiagram<T> > diagrams;
+
+    for( unsigned i = 0; i < 5; i++ )
+      diagrams.push_back( createRandomPersistenceDiagram<T>( 20 ) );
+
+    aleph::PersistenceImage<T> f( 10, 10, T(0), T(1), T(0), T(1), 0.1 );
+    aleph::BettiCurve<T>       g( 25, T(0), T(1) );
+
+    auto X = aleph::calculateFeatureMatrix( f, diagrams );
+    auto Y = aleph::calculateFeatureMatrix( g, diagrams );
+
+    ALEPH_ASSERT_EQUAL( X.size(), diagrams.size() * f.size() );
+    ALEPH_ASSERT_EQUAL( Y.size(), diagrams.size() * g.size() );
+
+    for( std::size_t i = 0; i < diagrams.size(); i++ )
+    {
+      auto x = f( diagrams[i] );
+      auto y = g( diagrams[i] );
+
+      ALEPH_ASSERT_THROW( std::equal( x.begin(), x.end(), X.begin() + std::ptrdiff_t( i * f.size() ) ) );
+      ALEPH_ASSERT_THROW( std::equal( y.begin(), y.end(), Y.begin() + std::ptrdiff_t( i * g.size() ) ) );
+    }
+  }
+
+  ALEPH_EXPECT_EXCEPTION( aleph::PersistenceImage<T>( 0, 10, T(0), T(1), T(0), T(1), 0.1 ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::PersistenceImage<T>( 10, 10, T(0), T(1), T(0), T(1), 0.0 ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testPersistenceLandscape()
+{
+  ALEPH_TEST_BEGIN( "Persistence landscape" );
+
+  {
+    aleph::PersistenceDiagram<T> D;
+    D.add( T(0), T(2) );
+    D.add( T(1), T(3) );
+    D.add( T(1) );
+
+    aleph::PersistenceLandscape L( D );
+
+    ALEPH_ASSERT_EQUAL( L.numLevels(), 2 );
+    ALEPH_ASSERT_EQUAL( L(0, 0.5), 0.5 );
+    ALEPH_ASSERT_EQUAL( L(0, 1.5), 0.5 );
+    ALEPH_ASSERT_EQUAL( L(0, 2.0), 1.0 );
+    ALEPH_ASSERT_EQUAL( L(0, 3.0), 0.0 );
+    ALEPH_ASSERT_EQUAL( L(1, 1.5), 0.5 );
+    ALEPH_ASSERT_EQUAL( L(1, 2.5), 0.0 );
+    ALEPH_ASSERT_EQUAL( L(2, 1.5), 0.0 );
+  }
+
+  // Compare all levels with the k-th largest value of all tent functions
+  {
+    auto D = createRandomPersistenceDiagram<T>( 50 );
+    aleph::PersistenceLandscape L( D );
+
+    auto tent = [] ( const typename aleph::PersistenceDiagram<T>::Point& p, double t )
+    {
+      return std::max( 0.0, std::min( t - static_cast<double>( p.x() ), static_cast<double>( p.y() ) - t ) );
+    };
+
+    for( unsigned i = 0; i <= 1000; i++ )
+    {
+      auto t = i / 1000.0;
+
+      std::vector<double> values;
+      for( auto&& p : D )
+        values.push_back( tent(p, t) );
+
+      std::sort( values.begin(), values.end(), std::greater<double>() );
+
+      for( std::size_t k = 0; k < D.size(); k++ )
+        ALEPH_ASSERT_THROW( std::abs( L(k,t) - values[k] ) < 1e-12 );
+    }
+  }
+
+  // Mean, distances, and inner products
+  {
+    std::vector<aleph::PersistenceLandscape> landscapes;
+    for( unsigned i = 0; i < 10; i++ )
+      landscapes.push_back( aleph::PersistenceLandscape( createRandomPersistenceDiagram<T>( 20 ) ) );
+
+    auto M = aleph::PersistenceLandscape::mean( landscapes.begin(), landscapes.end() );
+    auto S = landscapes.front();
+    S     += landscapes.back();
+
+    for( unsigned i = 0; i <= 100; i++ )
+    {
+      auto t = i / 100.0;
+
+      for( std::size_t k = 0; k < 20; k++ )
+      {
+        double mean = 0.0;
+        for( auto&& L : landscapes )
+          mean += L(k,t);
+
+        mean /= static_cast<double>( landscapes.size() );
+
+        ALEPH_ASSERT_THROW( std::abs( M(k,t) - mean ) < 1e-12 );
+        ALEPH_ASSERT_THROW( std::abs( S(k,t) - landscapes.front()(k,t) - landscapes.back()(k,t) ) < 1e-12 );
+      }
+    }
+
+    auto&& L1 = landscapes[0];
+    auto&& L2 = landscapes[1];
+
+    ALEPH_ASSERT_EQUAL( L1.distance( L1 ), 0.0 );
+    ALEPH_ASSERT_THROW( std::abs( L1.innerProduct( L1 ) - L1.norm() * L1.norm() ) < 1e-9 );
+    ALEPH_ASSERT_THROW( L1.distance( L2, 1.0 ) > 0.0 );
+    ALEPH_ASSERT_THROW( L1.distance( L2, std::numeric_limits<double>::infinity() ) <= L1.distance( L2, 1.0 ) + 1e-12 );
+    ALEPH_EXPECT_EXCEPTION( L1.distance( L2, 0.5 ), std::runtime_error );
+
+    // Numerical integration on a fine grid, which contains all
+    // levels as the diagrams are in the unit square
+    unsigned n = 200001;
+
+    aleph::DiscretePersistenceLandscape D1( L1, 0.0, 1.0, n, 20 );
+    aleph::DiscretePersistenceLandscape D2( L2, 0.0, 1.0, n, 20 );
+
+    for( double p : { 1.0, 2.0, 3.5 } )
+      ALEPH_ASSERT_THROW( std::abs( L1.distance( L2, p ) - D1.distance( D2, p ) ) < 1e-6 );
+
+    ALEPH_ASSERT_THROW( std::abs( L1.innerProduct( L2 ) - D1.innerProduct( D2 ) ) < 1e-6 );
+    ALEPH_ASSERT_THROW( std::abs( L1.distance( L2, std::numeric_limits<double>::infinity() ) - D1.distance( D2, std::numeric_limits<double>::infinity() ) ) < 1e-5 );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testDiscretePersistenceLandscape()
+{
+  ALEPH_TEST_BEGIN( "Discrete persistence landscape" );
+
+  std::vector<aleph::PersistenceLandscape> landscapes;
+  std::vector<aleph::DiscretePersistenceLandscape> discreteLandscapes;
+
+  for( unsigned i = 0; i < 50; i++ )
+  {
+    landscapes.push_back( aleph::PersistenceLandscape( createRandomPersistenceDiagram<T>( 20 ) ) );
+    discreteLandscapes.push_back( aleph::DiscretePersistenceLandscape( landscapes.back(), 0.0, 1.0, 101, 5 ) );
+  }
+
+  auto&& D = discreteLandscapes.front();
+
+  ALEPH_ASSERT_EQUAL( D.numSamples(), 101 );
+  ALEPH_ASSERT_EQUAL( D.numLevels(),    5 );
+  ALEPH_ASSERT_EQUAL( D.values().size(), 505 );
+
+  for( std::size_t k = 0; k < 5; k++ )
+    for( std::size_t i = 0; i < 101; i++ )
+      ALEPH_ASSERT_THROW( std::abs( D(k,i) - landscapes.front()(k, D.parameter(i)) ) < 1e-12 );
+
+  auto M1 = aleph::PersistenceLandscape::mean( landscapes.begin(), landscapes.end() );
+  auto M2 = aleph::DiscretePersistenceLandscape::mean( discreteLandscapes.begin(), discreteLandscapes.end() );
+
+  ALEPH_ASSERT_THROW( aleph::DiscretePersistenceLandscape( M1, 0.0, 1.0, 101, 5 ).distance( M2, std::numeric_limits<double>::infinity() ) < 1e-12 );
+
+  ALEPH_EXPECT_EXCEPTION( aleph::DiscretePersistenceLandscape( 1.0, 0.0, 101, 5 ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( D.distance( aleph::DiscretePersistenceLandscape( 0.0, 1.0, 100, 5 ) ), std::runtime_error );
+
+  aleph::math::Bootstrap bootstrap( 42 );
+
+  auto band  = aleph::confidenceBand( bootstrap, 200, 0.05, discreteLandscapes.begin(), discreteLandscapes.end() );
+  auto lower = band.first;
+  auto upper = band.second;
+
+  ALEPH_ASSERT_THROW( lower.distance( M2, std::numeric_limits<double>::infinity() ) > 0.0 );
+  ALEPH_ASSERT_THROW( std::abs( lower.distance( M2, std::numeric_limits<double>::infinity() ) - upper.distance( M2, std::numeric_limits<double>::infinity() ) ) < 1e-12 );
+
+  for( std::size_t i = 0; i < M2.values().size(); i++ )
+  {
+    ALEPH_ASSERT_THROW( lower.values()[i] < M2.values()[i] );
+    ALEPH_ASSERT_THROW( upper.values()[i] > M2.values()[i] );
+  }
+
+  // The same seed has to result in the same band
+  aleph::math::Bootstrap other( 42 );
+  auto band2 = aleph::confidenceBand( other, 200, 0.05, discreteLandscapes.begin(), discreteLandscapes.end() );
+
+  ALEPH_ASSERT_THROW( band2.first.values() == lower.values() );
+
+  ALEPH_TEST_END();
+}
+
 template <class T> void testPointSetDistances()
 {
   ALEPH_TEST_BEGIN( "Point set distances" );
@@ -315,6 +689,52 @@ template <class T> void testPointSetDistances()
   ALEPH_TEST_END();
 }
 
+template <class T> void testRandomFourierFeatures()
+{
+  ALEPH_TEST_BEGIN( "Random Fourier features" );
+
+  auto D1 = createRandomPersistenceDiagram<T>( 50 );
+  auto D2 = createRandomPersistenceDiagram<T>( 50 );
+
+  double sigma = 0.5;
+
+  auto w = aleph::detail::DefaultWeightFunction( 1.0, 1.0 );
+  auto k = aleph::detail::DefaultKernel( sigma );
+
+  aleph::RandomFourierFeatures<> phi( 5000, sigma, 1.0, 1.0, 42 );
+
+  auto x1 = phi( D1 );
+  auto x2 = phi( D2 );
+
+  ALEPH_ASSERT_EQUAL( x1.size(), phi.dimension() );
+  ALEPH_ASSERT_EQUAL( x2.size(), phi.dimension() );
+
+  // Identical seeds result in identical features
+  {
+    aleph::RandomFourierFeatures<> psi( 5000, sigma, 1.0, 1.0, 42 );
+    ALEPH_ASSERT_THROW( psi( D1 ) == x1 );
+  }
+
+  auto k11 = aleph::linearKernel( D1, D1, w, k );
+  auto k12 = aleph::linearKernel( D1, D2, w, k );
+
+  ALEPH_ASSERT_THROW( std::abs( aleph::linearKernel( x1, x1 ) - k11 ) < 0.05 * k11 );
+  ALEPH_ASSERT_THROW( std::abs( aleph::linearKernel( x1, x2 ) - k12 ) < 0.05 * k11 );
+
+  auto d12 = aleph::pseudoMetric( D1, D2, w, k );
+
+  ALEPH_ASSERT_EQUAL( aleph::pseudoMetric( x1, x1 ), 0.0 );
+  ALEPH_ASSERT_THROW( d12 > 0.0 );
+  ALEPH_ASSERT_THROW( std::abs( aleph::pseudoMetric( x1, x2 ) - d12 ) < 0.25 * d12 );
+
+  ALEPH_ASSERT_EQUAL( aleph::gaussianKernel( x1, x1, 1.0 ), 1.0 );
+  ALEPH_ASSERT_THROW( aleph::gaussianKernel( x1, x2, 1.0 ) < 1.0 );
+
+  ALEPH_EXPECT_EXCEPTION( aleph::RandomFourierFeatures<>( 0, sigma, 1.0, 1.0 ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
 template <class T> void testWassersteinDistance()
 {
   ALEPH_TEST_BEGIN( "Wasserstein distance" );
@@ -360,9 +780,15 @@ template <class T> void testWassersteinDistance()
 
 int main(int, char**)
 {
+  testBettiCurve<float> ();
+  testBettiCurve<double>();
+
   testBottleneckDistance<float> ();
   testBottleneckDistance<double>();
 
+  testDiscretePersistenceLandscape<float> ();
+  testDiscretePersistenceLandscape<double>();
+
   testEnvelope<float> ();
   testEnvelope<double>();
 
@@ -378,15 +804,27 @@ int main(int, char**)
   testMultiScaleKernel<float> ();
   testMultiScaleKernel<double>();
 
+  testMultiScaleKernelMatrix<float> ();
+  testMultiScaleKernelMatrix<double>();
+
   testNearestNeighbourDistance<float> ();
   testNearestNeighbourDistance<double>();
 
   testPersistenceIndicatorFunction<float> ();
   testPersistenceIndicatorFunction<double>();
 
+  testPersistenceImage<float> ();
+  testPersistenceImage<double>();
+
+  testPersistenceLandscape<float> ();
+  testPersistenceLandscape<double>();
+
   testPointSetDistances<float> ();
   testPointSetDistances<double>();
 
+  testRandomFourierFeatures<float> ();
+  testRandomFourierFeatures<double>();
+
   testWassersteinDistance<float> ();
   testWassersteinDistance<double>();
 }
@@ -887,6 +887,67 @@ template <class T> void testWeightedTriangle()
   ALEPH_TEST_END();
 }
 
+template <class T> void testStratumIndex()
+{
+  ALEPH_TEST_BEGIN( "Persistent intersection homology: stratum index" );
+
+  auto pc = sampleFromDisk( T(1), 50 );
+
+  using Distance          = aleph::geometry::distances::Euclidean<T>;
+  using NearestNeighbours = aleph::geometry::BruteForce<decltype(pc), Distance>;
+
+  auto K
+    = aleph::geometry::buildVietorisRipsComplex(
+      NearestNeighbours( pc ),
+      T( 0.4 ),
+      3
+  );
+
+  using SimplicialComplex = decltype(K);
+  using Simplex           = typename SimplicialComplex::ValueType;
+  using Vertex            = typename Simplex::VertexType;
+
+  // Use a random subset of vertices and the simplices spanned by them
+  // as a stratum. This ensures that intersections of all dimensions do
+  // occur.
+  std::mt19937 rng( 42 );
+  std::bernoulli_distribution coin( 0.6 );
+
+  std::vector<bool> selected( pc.size() );
+  for( std::size_t i = 0; i < selected.size(); i++ )
+    selected[i] = coin( rng );
+
+  std::vector<Simplex> simplices;
+
+  for( auto&& s : K )
+  {
+    if( std::all_of( s.begin(), s.end(), [&selected] ( Vertex v ) { return selected[v]; } ) )
+      simplices.push_back( s );
+  }
+
+  SimplicialComplex X( simplices.begin(), simplices.end() );
+  aleph::topology::StratumIndex<Vertex> index( X );
+
+  for( auto&& s : K )
+  {
+    auto intersection = aleph::topology::lastLexicographicalIntersection( X, s );
+    auto dimension    = intersection.empty() ? -1 : static_cast<long>( intersection.dimension() );
+
+    ALEPH_ASSERT_EQUAL( index.maximumIntersectionDimension( s ), dimension );
+    ALEPH_ASSERT_EQUAL( index.contains( s ), X.contains( s ) );
+  }
+
+  // Empty strata never intersect anything
+  {
+    aleph::topology::StratumIndex<Vertex> empty( SimplicialComplex{} );
+
+    for( auto&& s : K )
+      ALEPH_ASSERT_EQUAL( empty.maximumIntersectionDimension( s ), -1 );
+  }
+
+  ALEPH_TEST_END();
+}
+
 int main(int, char**)
 {
   test<float> ();
@@ -918,4 +979,7 @@ int main(int, char**)
 
   testWeightedTriangle<float> ();
   testWeightedTriangle<double>();
+
+  testStratumIndex<float> ();
+  testStratumIndex<double>();
 }
@@ -0,0 +1,193 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/RepresentativeCycles.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <cmath>
+
+/**
+  Checks that a set of simplices forms a cycle, i.e. that every face of
+  the simplices occurs an even number of times.
+*/
+
+template <class Simplex> bool isCycle( const std::vector<Simplex>& simplices )
+{
+  std::map<Simplex, unsigned> faces;
+
+  for( auto&& s : simplices )
+  {
+    for( auto it = s.begin_boundary(); it != s.end_boundary(); ++it )
+      faces[ *it ] += 1;
+  }
+
+  return std::all_of( faces.begin(), faces.end(),
+                      [] ( const std::pair<const Simplex, unsigned>& pair )
+                      {
+                        return pair.second % 2 == 0;
+                      } );
+}
+
+template <class T> void testSquare()
+{
+  ALEPH_TEST_BEGIN( "Representative cycles: square" );
+
+  using Simplex           = aleph::topology::Simplex<T, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  // A square whose cycle is created by the edge {2,3} and destroyed by
+  // the second triangle. The diagonal creates a smaller cycle that is
+  // destroyed by the first triangle.
+  SimplicialComplex K = {
+    Simplex( 0, T(0) ), Simplex( 1, T(0) ), Simplex( 2, T(0) ), Simplex( 3, T(0) ),
+    Simplex( {0,1}, T(1) ),
+    Simplex( {1,2}, T(1) ),
+    Simplex( {2,3}, T(1) ),
+    Simplex( {0,3}, T(1) ),
+    Simplex( {0,2}, T(2) ),
+    Simplex( {0,1,2}, T(3) ),
+    Simplex( {0,2,3}, T(4) )
+  };
+
+  K.sort( aleph::topology::filtrations::Data<Simplex>() );
+
+  std::vector< aleph::RepresentativeCycle<Simplex> > cycles;
+  aleph::calculatePersistenceDiagrams( K, false, false, &cycles );
+
+  // Three pairs in dimension zero, two pairs in dimension one
+  ALEPH_ASSERT_EQUAL( cycles.size(), 5 );
+
+  for( auto&& cycle : cycles )
+    ALEPH_ASSERT_THROW( isCycle( cycle.simplices ) );
+
+  auto&& last = cycles.back();
+
+  ALEPH_ASSERT_THROW( last.creator   == Simplex( {2,3} ) );
+  ALEPH_ASSERT_THROW( last.destroyer == Simplex( {0,2,3} ) );
+  ALEPH_ASSERT_EQUAL( last.simplices.size(), 4 );
+
+  std::vector<Simplex> square = { Simplex( {0,1} ), Simplex( {1,2} ), Simplex( {2,3} ), Simplex( {0,3} ) };
+
+  for( auto&& s : square )
+    ALEPH_ASSERT_THROW( std::find( last.simplices.begin(), last.simplices.end(), s ) != last.simplices.end() );
+
+  // Only the pair of the square has a persistence of three
+  aleph::calculatePersistenceDiagrams( K, false, false, &cycles, T(3) );
+
+  ALEPH_ASSERT_EQUAL( cycles.size(), 1 );
+  ALEPH_ASSERT_EQUAL( cycles.front().simplices.size(), 4 );
+
+  // The boundary matrix must not be dualized
+  auto M = aleph::topology::makeBoundaryMatrix<aleph::defaults::Representation>( K );
+
+  using Index = typename aleph::defaults::Representation::Index;
+
+  aleph::RepresentativeCycleRecorder<Index> recorder;
+
+  ALEPH_EXPECT_EXCEPTION( aleph::calculatePersistencePairing( M.dualize(), false, std::numeric_limits<Index>::max(), &recorder ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::calculatePersistenceDiagrams( K, true, false, &cycles ), std::runtime_error );
+
+  // Recording cycles does not change the pairing
+  auto pairing = aleph::calculatePersistencePairing( M, false, std::numeric_limits<Index>::max(), &recorder );
+
+  ALEPH_ASSERT_THROW( pairing == aleph::calculatePersistencePairing( M ) );
+  ALEPH_ASSERT_EQUAL( recorder.cycles().size(), 5 );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRandom()
+{
+  ALEPH_TEST_BEGIN( "Representative cycles: Vietoris--Rips complex" );
+
+  using PointCloud        = aleph::containers::PointCloud<T>;
+  using Distance          = aleph::geometry::distances::Euclidean<T>;
+  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+
+  std::mt19937 rng( 42 );
+  std::normal_distribution<T> noise( T(0), T(0.1) );
+
+  unsigned n = 50;
+
+  PointCloud pc( n, 2 );
+
+  // Noisy circle, which results in one prominent cycle. The expansion
+  // threshold is sufficiently large for the cycle to be destroyed.
+  for( unsigned i = 0; i < n; i++ )
+  {
+    auto phi = T( 2 * M_PI * i / n );
+    pc.set( i, { std::cos( phi ) + noise( rng ), std::sin( phi ) + noise( rng ) } );
+  }
+
+  auto K
+    = aleph::geometry::buildVietorisRipsComplex(
+      NearestNeighbours( pc ),
+      T( 2.0 ),
+      2
+  );
+
+  using SimplicialComplex = decltype(K);
+  using Simplex           = typename SimplicialComplex::ValueType;
+
+  // Diagrams and cycles are obtained from a single reduction, and the
+  // diagrams do not depend on the dualization.
+  std::vector< aleph::RepresentativeCycle<Simplex> > cycles;
+
+  auto diagrams = aleph::calculatePersistenceDiagrams( K, false, false, &cycles );
+
+  ALEPH_ASSERT_THROW( diagrams == aleph::calculatePersistenceDiagrams( K ) );
+
+  std::size_t numPairs = 0;
+
+  for( auto&& D : diagrams )
+    numPairs += D.size() - D.betti();
+
+  ALEPH_ASSERT_EQUAL( cycles.size(), numPairs );
+
+  for( auto&& cycle : cycles )
+  {
+    ALEPH_ASSERT_THROW( isCycle( cycle.simplices ) );
+    ALEPH_ASSERT_THROW( std::find( cycle.simplices.begin(), cycle.simplices.end(), cycle.creator ) != cycle.simplices.end() );
+
+    // The creator is the youngest simplex of its cycle
+    for( auto&& s : cycle.simplices )
+      ALEPH_ASSERT_THROW( K.index( s ) <= K.index( cycle.creator ) );
+  }
+
+  // Only the prominent cycle remains for a large threshold
+  aleph::calculatePersistenceDiagrams( K, false, false, &cycles, T(0.5) );
+
+  ALEPH_ASSERT_THROW( std::count_if( cycles.begin(), cycles.end(),
+                                     [] ( const aleph::RepresentativeCycle<Simplex>& cycle )
+                                     {
+                                       return cycle.creator.dimension() == 1;
+                                     } ) == 1 );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testSquare<double>();
+  testSquare<float> ();
+
+  testRandom<double>();
+  testRandom<float> ();
+}
@@ -0,0 +1,219 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/SparseRipsComplex.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistenceDiagrams/distances/Bottleneck.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <cmath>
+
+template <class T> aleph::containers::PointCloud<T> makeCircle( unsigned n, T noise, unsigned seed )
+{
+  std::mt19937 rng( seed );
+  std::uniform_real_distribution<T> angle( T(0), T( 2 * M_PI ) );
+  std::normal_distribution<T> perturbation( T(0), noise );
+
+  aleph::containers::PointCloud<T> pc( n, 2 );
+
+  for( unsigned i = 0; i < n; i++ )
+  {
+    auto phi = angle( rng );
+    pc.set( i, { std::cos( phi ) + perturbation( rng ), std::sin( phi ) + perturbation( rng ) } );
+  }
+
+  return pc;
+}
+
+template <class T> aleph::containers::PointCloud<T> makeCube( unsigned n, unsigned seed )
+{
+  std::mt19937 rng( seed );
+  std::uniform_real_distribution<T> coordinate( T(0), T(1) );
+
+  aleph::containers::PointCloud<T> pc( n, 3 );
+
+  for( unsigned i = 0; i < n; i++ )
+    pc.set( i, { coordinate( rng ), coordinate( rng ), coordinate( rng ) } );
+
+  return pc;
+}
+
+/** Transforms all points of a persistence diagram to a logarithmic scale */
+template <class T> aleph::PersistenceDiagram<T> logarithmic( const aleph::PersistenceDiagram<T>& D )
+{
+  aleph::PersistenceDiagram<T> E;
+
+  for( auto&& p : D )
+    E.add( std::log( p.x() ), std::log( p.y() ) );
+
+  return E;
+}
+
+template <class T> void testGreedyPermutation()
+{
+  ALEPH_TEST_BEGIN( "Greedy permutation" );
+
+  using Distance = aleph::geometry::distances::Euclidean<T>;
+
+  auto pc          = makeCube<T>( 200, 42 );
+  auto permutation = aleph::geometry::greedyPermutation( pc );
+  auto&& indices   = permutation.first;
+  auto&& radii     = permutation.second;
+
+  ALEPH_ASSERT_EQUAL( indices.size(), pc.size() );
+  ALEPH_ASSERT_EQUAL( radii.size(),   pc.size() );
+  ALEPH_ASSERT_EQUAL( indices.front(), 0 );
+  ALEPH_ASSERT_THROW( std::isinf( radii.front() ) );
+
+  {
+    auto sorted = indices;
+    std::sort( sorted.begin(), sorted.end() );
+
+    for( std::size_t i = 0; i < sorted.size(); i++ )
+      ALEPH_ASSERT_EQUAL( sorted[i], i );
+  }
+
+  Distance dist;
+  aleph::geometry::distances::Traits<Distance> traits;
+
+  for( std::size_t k = 1; k < indices.size(); k++ )
+  {
+    ALEPH_ASSERT_THROW( radii[k] <= radii[k-1] );
+
+    // The insertion radius is the distance to the closest point that
+    // has been inserted previously.
+    auto p = pc[ indices[k] ];
+    auto r = std::numeric_limits<T>::max();
+
+    for( std::size_t l = 0; l < k; l++ )
+    {
+      auto q = pc[ indices[l] ];
+      r      = std::min( r, traits.from( dist( p.begin(), q.begin(), pc.dimension() ) ) );
+    }
+
+    ALEPH_ASSERT_THROW( std::abs( r - radii[k] ) <= T( 1e-5 ) );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testSparseSkeleton()
+{
+  ALEPH_TEST_BEGIN( "Sparse skeleton" );
+
+  using Distance = aleph::geometry::distances::Euclidean<T>;
+
+  unsigned n = 300;
+
+  auto pc = makeCube<T>( n, 23 );
+  auto K  = aleph::geometry::buildSparseRipsSkeleton( pc, T(1) );
+
+  Distance dist;
+  aleph::geometry::distances::Traits<Distance> traits;
+
+  std::size_t numVertices = 0;
+  std::size_t numEdges    = 0;
+
+  for( auto&& s : K )
+  {
+    if( s.dimension() == 0 )
+    {
+      ++numVertices;
+      ALEPH_ASSERT_EQUAL( s.data(), T(0) );
+    }
+    else
+    {
+      ++numEdges;
+
+      auto p = pc[ s[0] ];
+      auto q = pc[ s[1] ];
+      auto d = traits.from( dist( p.begin(), q.begin(), pc.dimension() ) );
+
+      ALEPH_ASSERT_THROW( s.data() >= d * ( 1 - T( 1e-5 ) ) );
+    }
+  }
+
+  ALEPH_ASSERT_EQUAL( numVertices, n );
+  ALEPH_ASSERT_THROW( numEdges >= n - 1 );
+  ALEPH_ASSERT_THROW( numEdges <  n * ( n - 1 ) / 4 );
+
+  // A smaller approximation factor permits more edges
+  auto L = aleph::geometry::buildSparseRipsSkeleton( pc, T( 0.1 ) );
+
+  ALEPH_ASSERT_THROW( L.size() > K.size() );
+
+  ALEPH_EXPECT_EXCEPTION( aleph::geometry::buildSparseRipsSkeleton( pc, T(0) ), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( aleph::geometry::buildSparseRipsSkeleton( pc, T(-1) ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testApproximation()
+{
+  ALEPH_TEST_BEGIN( "Sparse Vietoris--Rips complex: approximation" );
+
+  using PointCloud        = aleph::containers::PointCloud<T>;
+  using Distance          = aleph::geometry::distances::Euclidean<T>;
+  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+
+  auto pc = makeCircle<T>( 60, T( 0.05 ), 42 );
+
+  auto K
+    = aleph::geometry::buildVietorisRipsComplex(
+      NearestNeighbours( pc ),
+      T(3),
+      2
+  );
+
+  auto D = aleph::calculatePersistenceDiagrams( K );
+
+  ALEPH_ASSERT_EQUAL( D.size(), 2 );
+
+  for( auto epsilon : { T( 0.1 ), T( 0.5 ), T(1) } )
+  {
+    auto L = aleph::geometry::buildSparseVietorisRipsComplex( pc, epsilon, 2 );
+    auto E = aleph::calculatePersistenceDiagrams( L );
+
+    ALEPH_ASSERT_THROW( L.size() <= K.size() );
+    ALEPH_ASSERT_EQUAL( E.size(), 2 );
+
+    ALEPH_ASSERT_EQUAL( D[0].betti(), 1 );
+    ALEPH_ASSERT_EQUAL( E[0].betti(), 1 );
+
+    D[1].removeDiagonal();
+    E[1].removeDiagonal();
+
+    // The persistence diagrams of the sparse filtration are interleaved
+    // multiplicatively with the persistence diagrams of the full one.
+    auto d = aleph::distances::bottleneckDistance( logarithmic( D[1] ), logarithmic( E[1] ) );
+
+    ALEPH_ASSERT_THROW( d <= std::log( 1 + epsilon ) + T( 1e-4 ) );
+  }
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testGreedyPermutation<double>();
+  testGreedyPermutation<float> ();
+
+  testSparseSkeleton<double>();
+  testSparseSkeleton<float> ();
+
+  testApproximation<double>();
+  testApproximation<float> ();
+}
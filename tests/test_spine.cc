@@ -124,14 +124,38 @@ template <class T> void testPinchedTorus()
   ALEPH_ASSERT_EQUAL( D1[1].dimension(), 1 );
   ALEPH_ASSERT_EQUAL( D1[1].betti(),     1 );
 
+  // The complex is too dense to have any free faces, so no collapses
+  // are possible. This mostly checks that large complexes can still be
+  // processed quickly.
+  auto L  = aleph::topology::spine( K );
+
+  ALEPH_ASSERT_THROW( L.size() <= K.size() );
+
+  // Elementary collapses preserve the homotopy type, so the spine has
+  // to have the same Betti numbers as the original complex.
+  {
+    auto M = K;
+    M.sort( aleph::topology::filtrations::Data<typename decltype(M)::ValueType>() );
+    L.sort( aleph::topology::filtrations::Data<typename decltype(L)::ValueType>() );
+
+    auto DK = aleph::calculatePersistenceDiagrams( M );
+    auto DL = aleph::calculatePersistenceDiagrams( L );
+
+    ALEPH_ASSERT_THROW( DL.size() >= 2 );
+    ALEPH_ASSERT_EQUAL( DL[0].betti(), DK[0].betti() );
+    ALEPH_ASSERT_EQUAL( DL[1].betti(), DK[1].betti() );
+
+    for( auto&& D : DL )
+    {
+      if( D.dimension() >= 2 )
+        ALEPH_ASSERT_EQUAL( D.betti(), 0 );
+    }
+  }
+
 #if 0
   // FIXME: this is still too large to be easily processed by the
   // algorithm...
 
-  auto L  = aleph::topology::spine( K );
-
-  ALEPH_ASSERT_THROW( L.size() < K.size() );
-
   auto K0 = aleph::topology::Skeleton()(0, K);
   auto K1 = K0;
   auto K2 = K;
@@ -239,7 +263,19 @@ template <class T> void testS1vS1()
   // Spine calculation -------------------------------------------------
 
   auto M = aleph::topology::dumb::spine( K );
+  auto N = aleph::topology::spine( K );
+
   K.sort( aleph::topology::filtrations::Data<typename decltype(K)::ValueType>() );
+  N.sort( aleph::topology::filtrations::Data<typename decltype(N)::ValueType>() );
+
+  {
+    auto D = aleph::calculatePersistenceDiagrams( N, true, true );
+
+    ALEPH_ASSERT_THROW( N.size() < K.size() );
+    ALEPH_ASSERT_THROW( D.size() >=       2 );
+    ALEPH_ASSERT_EQUAL( D[0].betti(),     1 );
+    ALEPH_ASSERT_EQUAL( D[1].betti(),     2 );
+  }
 
   {
     std::ofstream out( "/tmp/M.txt" );
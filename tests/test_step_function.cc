@@ -1,3 +1,4 @@
+#include <aleph/math/FlatStepFunction.hh>
 #include <aleph/math/StepFunction.hh>
 
 #include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
@@ -6,7 +7,11 @@
 #include <tests/Base.hh>
 
 #include <iterator>
+#include <limits>
+#include <random>
 #include <set>
+#include <stdexcept>
+#include <vector>
 
 #include <cmath>
 
@@ -221,6 +226,204 @@ template <class T> void testStepFunctionNormalization()
   ALEPH_TEST_END();
 }
 
+template <class T> void testFlatStepFunction()
+{
+  ALEPH_TEST_BEGIN( "Flat step function: Basic properties" );
+
+  StepFunction<T> f;
+  f.add( 0, 1, 1 );
+  f.add( 2, 3, 1 );
+  f.add( 3, 4, 2 );
+
+  FlatStepFunction<T> g( f );
+
+  // Breakpoints of the gap and of the touching intervals have to be
+  // stored explicitly.
+  ALEPH_ASSERT_EQUAL( g.size(), 4 );
+  ALEPH_ASSERT_EQUAL( g.breakpoints().size(), 5 );
+
+  ALEPH_ASSERT_EQUAL( g(-1) , 0 );
+  ALEPH_ASSERT_EQUAL( g(0)  , 1 );
+  ALEPH_ASSERT_EQUAL( g(0.5), 1 );
+  ALEPH_ASSERT_EQUAL( g(1.5), 0 );
+  ALEPH_ASSERT_EQUAL( g(2)  , 1 );
+  ALEPH_ASSERT_EQUAL( g(3)  , 2 );
+  ALEPH_ASSERT_EQUAL( g(3.5), 2 );
+  ALEPH_ASSERT_EQUAL( g(4.0), 2 );
+  ALEPH_ASSERT_EQUAL( g(4.5), 0 );
+
+  ALEPH_ASSERT_EQUAL( g.integral(), f.integral() );
+  ALEPH_ASSERT_EQUAL( g.max(),      f.max() );
+
+  auto h = g.toStepFunction();
+
+  ALEPH_ASSERT_EQUAL( h.integral(), f.integral() );
+  ALEPH_ASSERT_EQUAL( h(0.5), 1 );
+  ALEPH_ASSERT_EQUAL( h(3.5), 2 );
+
+  // Normalization -----------------------------------------------------
+
+  auto n = normalize( g, T(0), T(10) );
+
+  ALEPH_ASSERT_EQUAL( n(0.5),  5 );
+  ALEPH_ASSERT_EQUAL( n(1.5),  0 );
+  ALEPH_ASSERT_EQUAL( n(3.5), 10 );
+  ALEPH_ASSERT_EQUAL( n.max(), T(10) );
+
+  // Scalar addition only changes the support, so gaps remain zero, and
+  // normalizing to a range that does not start at zero keeps them.
+  auto s = g + T(1);
+
+  ALEPH_ASSERT_EQUAL( s(0.5), 2 );
+  ALEPH_ASSERT_EQUAL( s(1.5), 0 );
+  ALEPH_ASSERT_EQUAL( s(3.5), 3 );
+  ALEPH_ASSERT_EQUAL( s.integral(), f.integral() + 3 );
+
+  auto m = normalize( g, T(1), T(2) );
+
+  ALEPH_ASSERT_EQUAL( m(0.5), T(1.5) );
+  ALEPH_ASSERT_EQUAL( m(1.5), 0 );
+  ALEPH_ASSERT_EQUAL( m(3.5), 2 );
+
+  // Invalid input -----------------------------------------------------
+
+  bool thrown = false;
+
+  try
+  {
+    FlatStepFunction<T> invalid( { T(0), T(2), T(1) }, { T(1), T(1) } );
+  }
+  catch( std::runtime_error& )
+  {
+    thrown = true;
+  }
+
+  ALEPH_ASSERT_THROW( thrown );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testFlatStepFunctionArithmetic()
+{
+  ALEPH_TEST_BEGIN( "Flat step function: Arithmetic" );
+
+  FlatStepFunction<T> f( { T(0), T(1), T(2) }, { T(1), T(3) } );
+  FlatStepFunction<T> g( { T(0.5), T(1.5) }, { T(2) } );
+
+  auto h = f+g;
+
+  ALEPH_ASSERT_EQUAL( h( T(0.25) ), 1 );
+  ALEPH_ASSERT_EQUAL( h( T(0.75) ), 3 );
+  ALEPH_ASSERT_EQUAL( h( T(1.25) ), 5 );
+  ALEPH_ASSERT_EQUAL( h( T(1.75) ), 3 );
+  ALEPH_ASSERT_EQUAL( h.integral(), f.integral() + g.integral() );
+
+  auto d = f-g;
+
+  ALEPH_ASSERT_EQUAL( d( T(0.75) ), -1 );
+  ALEPH_ASSERT_EQUAL( d( T(1.25) ),  1 );
+  ALEPH_ASSERT_EQUAL( d.integral(), f.integral() - g.integral() );
+
+  // Adding a function to its negation must result in the zero function
+  // on the domain, which is stored as a single interval.
+  auto z = f + (-f);
+
+  ALEPH_ASSERT_EQUAL( z.size(), 1 );
+  ALEPH_ASSERT_EQUAL( z.integral(), 0 );
+
+  ALEPH_ASSERT_EQUAL( d.abs().integral(), T(3) );
+  ALEPH_ASSERT_EQUAL( (f-g).abs().pow( 2 ).integral(), T(6) );
+
+  // Disjoint domains --------------------------------------------------
+
+  FlatStepFunction<T> u( { T(0), T(1) }, { T(1) } );
+  FlatStepFunction<T> v( { T(2), T(3) }, { T(2) } );
+
+  auto w = u+v;
+
+  ALEPH_ASSERT_EQUAL( w( T(1.5) ), 0 );
+  ALEPH_ASSERT_EQUAL( w.integral(), T(3) );
+
+  ALEPH_ASSERT_EQUAL( lpDistance( u, v ), T(3) );
+  ALEPH_ASSERT_EQUAL( lpDistance( u, v, std::numeric_limits<T>::infinity() ), T(2) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testFlatStepFunctionDistance()
+{
+  ALEPH_TEST_BEGIN( "Flat step function: Distance" );
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> distribution( T(0), T(10) );
+
+  auto makeDiagram = [&rng, &distribution] ()
+  {
+    aleph::PersistenceDiagram<T> D;
+
+    for( unsigned i = 0; i < 50; i++ )
+    {
+      auto x = distribution( rng );
+      auto y = distribution( rng );
+
+      D.add( std::min(x,y), std::max(x,y) );
+    }
+
+    return D;
+  };
+
+  for( unsigned k = 0; k < 10; k++ )
+  {
+    auto f1 = aleph::persistenceIndicatorFunction( makeDiagram() );
+    auto f2 = aleph::persistenceIndicatorFunction( makeDiagram() );
+
+    FlatStepFunction<T> g1( f1 );
+    FlatStepFunction<T> g2( f2 );
+
+    auto tolerance = T(1e-3);
+
+    ALEPH_ASSERT_THROW( std::abs( g1.integral() - f1.integral() ) < tolerance );
+    ALEPH_ASSERT_THROW( std::abs( g2.integral() - f2.integral() ) < tolerance );
+
+    // Reference values: both functions are constant between any two
+    // subsequent points of their joint domain, so evaluating them in
+    // the middle of such an interval yields the exact integral.
+    T d1 = T();
+    T e1 = T();
+
+    {
+      std::set<T> D;
+      f1.domain( std::inserter( D, D.begin() ) );
+      f2.domain( std::inserter( D, D.begin() ) );
+
+      for( auto it = D.begin(); std::next( it ) != D.end(); ++it )
+      {
+        auto a = *it;
+        auto b = *std::next( it );
+        auto x = ( a + b ) / 2;
+        auto y = std::abs( f1(x) - f2(x) );
+
+        d1 += y     * ( b - a );
+        e1 += y * y * ( b - a );
+      }
+
+      e1 = std::sqrt( e1 );
+    }
+
+    auto d2 = lpDistance( g1, g2 );
+    auto d3 = ( g1 - g2 ).abs().integral();
+
+    ALEPH_ASSERT_THROW( std::abs( d1 - d2 ) < tolerance );
+    ALEPH_ASSERT_THROW( std::abs( d2 - d3 ) < tolerance );
+
+    auto e2 = lpDistance( g1, g2, T(2) );
+
+    ALEPH_ASSERT_THROW( std::abs( e1 - e2 ) < tolerance );
+  }
+
+  ALEPH_TEST_END();
+}
+
 template <class T> void testPersistenceIndicatorFunction()
 {
   using PersistenceDiagram = aleph::PersistenceDiagram<T>;
@@ -281,6 +484,15 @@ int main()
   testStepFunctionNormalization<double>();
   testStepFunctionNormalization<float> ();
 
+  testFlatStepFunction<double>();
+  testFlatStepFunction<float> ();
+
+  testFlatStepFunctionArithmetic<double>();
+  testFlatStepFunctionArithmetic<float> ();
+
+  testFlatStepFunctionDistance<double>();
+  testFlatStepFunctionDistance<float> ();
+
   testPersistenceIndicatorFunction<double>();
   testPersistenceIndicatorFunction<float>();
 }
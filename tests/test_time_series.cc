@@ -0,0 +1,235 @@
+#include <tests/Base.hh>
+
+#include <aleph/persistenceDiagrams/PersistenceDiagram.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/TimeSeries.hh>
+
+#include <aleph/topology/BoundaryMatrix.hh>
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <aleph/topology/io/Function.hh>
+
+#include <aleph/topology/representations/Vector.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+
+template <class T> std::vector<typename aleph::PersistenceDiagram<T>::Point> points( const aleph::PersistenceDiagram<T>& D )
+{
+  std::vector<typename aleph::PersistenceDiagram<T>::Point> result( D.begin(), D.end() );
+  std::sort( result.begin(), result.end() );
+
+  return result;
+}
+
+template <class T> aleph::PersistenceDiagram<T> reference( const std::vector<T>& values, bool sublevel )
+{
+  using Simplex           = aleph::topology::Simplex<T, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  SimplicialComplex K;
+
+  if( sublevel )
+  {
+    K = aleph::topology::io::loadFunction<SimplicialComplex>( values.begin(), values.end(),
+                                                              [] ( T x, T y ) { return std::max(x,y); } );
+
+    K.sort( aleph::topology::filtrations::Data<Simplex>() );
+  }
+  else
+  {
+    K = aleph::topology::io::loadFunction<SimplicialComplex>( values.begin(), values.end(),
+                                                              [] ( T x, T y ) { return std::min(x,y); } );
+
+    K.sort( aleph::topology::filtrations::Data<Simplex, std::greater<T> >() );
+  }
+
+  // A single vertex is a top-level simplex, so its class would not be
+  // reported otherwise.
+  auto diagrams = aleph::calculatePersistenceDiagrams( K, true, true );
+
+  ALEPH_ASSERT_EQUAL( diagrams.size(), 1 );
+  return diagrams.front();
+}
+
+template <class T> void testSimple()
+{
+  ALEPH_TEST_BEGIN( "Time series: simple functions" );
+
+  {
+    std::vector<T> values = { 3, 1, 4, 0, 5, 2, 6 };
+
+    auto D = aleph::calculateSublevelSetPersistenceDiagram( values.begin(), values.end(), false );
+
+    ALEPH_ASSERT_EQUAL( D.dimension(), 0 );
+    ALEPH_ASSERT_EQUAL( D.size(),      3 );
+    ALEPH_ASSERT_EQUAL( D.betti(),     1 );
+
+    auto P = points( D );
+
+    using Point = typename aleph::PersistenceDiagram<T>::Point;
+
+    ALEPH_ASSERT_THROW( P.at(0) == Point( 0 ) );
+    ALEPH_ASSERT_THROW( P.at(1) == Point( 1, 4 ) );
+    ALEPH_ASSERT_THROW( P.at(2) == Point( 2, 5 ) );
+
+    D = aleph::calculateSublevelSetPersistenceDiagram( values.begin(), values.end() );
+    ALEPH_ASSERT_EQUAL( D.size(), values.size() );
+  }
+
+  {
+    std::vector<T> values;
+
+    auto D = aleph::calculateSublevelSetPersistenceDiagram( values.begin(), values.end() );
+    ALEPH_ASSERT_THROW( D.empty() );
+  }
+
+  // Plateaus and constant functions
+  {
+    std::vector<T> values = { 2, 2, 2, 2 };
+
+    auto D = aleph::calculateSuperlevelSetPersistenceDiagram( values.begin(), values.end() );
+    auto E = reference( values, false );
+
+    ALEPH_ASSERT_THROW( points( D ) == points( E ) );
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRandom()
+{
+  ALEPH_TEST_BEGIN( "Time series: random functions" );
+
+  std::mt19937 rng( 42 );
+  std::uniform_int_distribution<int> distribution( 0, 20 );
+
+  for( unsigned n : { 1u, 2u, 3u, 5u, 17u, 100u, 500u } )
+  {
+    for( unsigned k = 0; k < 10; k++ )
+    {
+      std::vector<T> values( n );
+      for( auto&& value : values )
+        value = static_cast<T>( distribution( rng ) );
+
+      auto D1 = aleph::calculateSublevelSetPersistenceDiagram( values.begin(), values.end() );
+      auto E1 = reference( values, true );
+
+      ALEPH_ASSERT_EQUAL( D1.size(), E1.size() );
+      ALEPH_ASSERT_THROW( points( D1 ) == points( E1 ) );
+
+      auto D2 = aleph::calculateSuperlevelSetPersistenceDiagram( values.begin(), values.end() );
+      auto E2 = reference( values, false );
+
+      ALEPH_ASSERT_EQUAL( D2.size(), E2.size() );
+      ALEPH_ASSERT_THROW( points( D2 ) == points( E2 ) );
+    }
+  }
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testMatrix()
+{
+  ALEPH_TEST_BEGIN( "Time series: boundary matrix" );
+
+  using Representation = aleph::topology::representations::Vector<unsigned>;
+  using BoundaryMatrix = aleph::topology::BoundaryMatrix<Representation>;
+
+  BoundaryMatrix M;
+  std::vector<T> functionValues;
+
+  aleph::topology::io::loadFunction( CMAKE_SOURCE_DIR + std::string( "/tests/input/Functions_simple.txt" ),
+                                     M,
+                                     functionValues );
+
+  // The loader treats all values of the file as a single function and
+  // appends the edge weights, so the samples need to be read again.
+  std::vector<T> values;
+
+  {
+    std::ifstream in( CMAKE_SOURCE_DIR + std::string( "/tests/input/Functions_simple.txt" ) );
+
+    std::copy( std::istream_iterator<T>( in ),
+               std::istream_iterator<T>(),
+               std::back_inserter( values ) );
+  }
+
+  auto D = aleph::calculatePersistenceDiagram( M, functionValues );
+  auto E = aleph::calculateSublevelSetPersistenceDiagram( values.begin(), values.end() );
+
+  ALEPH_ASSERT_EQUAL( D.size(), E.size() );
+  ALEPH_ASSERT_THROW( points( D ) == points( E ) );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testSlidingWindow()
+{
+  ALEPH_TEST_BEGIN( "Time series: sliding window" );
+
+  std::mt19937 rng( 23 );
+  std::uniform_int_distribution<int> distribution( -10, 10 );
+
+  std::vector<T> values( 300 );
+  for( auto&& value : values )
+    value = static_cast<T>( distribution( rng ) );
+
+  for( std::size_t w : { 1, 7, 32, 50 } )
+  {
+    for( std::size_t b : { 0, 1, 3, 8, 64 } )
+    {
+      aleph::SlidingWindowPersistence<T>                     S( w, b );
+      aleph::SlidingWindowPersistence<T, std::greater<T> >   R( w, b );
+
+      ALEPH_ASSERT_THROW( S.blockSize() <= w );
+
+      for( std::size_t i = 0; i < values.size(); i++ )
+      {
+        S.push( values[i] );
+        R.push( values[i] );
+
+        auto begin = values.begin() + std::ptrdiff_t( i + 1 - S.size() );
+        auto end   = values.begin() + std::ptrdiff_t( i + 1 );
+
+        ALEPH_ASSERT_EQUAL( S.size(), std::min( i + 1, w ) );
+
+        auto D1 = S.diagram();
+        auto E1 = aleph::calculateSublevelSetPersistenceDiagram( begin, end );
+
+        ALEPH_ASSERT_THROW( points( D1 ) == points( E1 ) );
+
+        auto D2 = R.diagram( false );
+        auto E2 = aleph::calculateSuperlevelSetPersistenceDiagram( begin, end, false );
+
+        ALEPH_ASSERT_THROW( points( D2 ) == points( E2 ) );
+      }
+    }
+  }
+
+  ALEPH_EXPECT_EXCEPTION( aleph::SlidingWindowPersistence<T>( 0 ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testSimple<double>();
+  testSimple<float> ();
+
+  testRandom<double>();
+  testRandom<int>   ();
+
+  testMatrix<double>();
+
+  testSlidingWindow<double>();
+  testSlidingWindow<float> ();
+}
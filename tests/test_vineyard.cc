@@ -0,0 +1,192 @@
+#include <tests/Base.hh>
+
+#include <aleph/containers/PointCloud.hh>
+
+#include <aleph/geometry/BruteForce.hh>
+#include <aleph/geometry/VietorisRipsComplex.hh>
+
+#include <aleph/geometry/distances/Euclidean.hh>
+
+#include <aleph/persistentHomology/Calculation.hh>
+#include <aleph/persistentHomology/Vineyard.hh>
+
+#include <aleph/topology/Simplex.hh>
+#include <aleph/topology/SimplicialComplex.hh>
+
+#include <aleph/topology/filtrations/Data.hh>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/**
+  Assigns every simplex the maximum of the values of its vertices, which
+  results in a valid filtration.
+*/
+
+template <class SimplicialComplex, class T> std::vector<T> lowerStar( const SimplicialComplex& K, const std::vector<T>& f )
+{
+  std::vector<T> values;
+  values.reserve( K.size() );
+
+  for( auto&& s : K )
+  {
+    T value = f.at( *s.begin() );
+
+    for( auto&& v : s )
+      value = std::max( value, f.at(v) );
+
+    values.push_back( value );
+  }
+
+  return values;
+}
+
+template <class T> void testSimple()
+{
+  ALEPH_TEST_BEGIN( "Vineyard: simple complex" );
+
+  using Simplex           = aleph::topology::Simplex<T, unsigned>;
+  using SimplicialComplex = aleph::topology::SimplicialComplex<Simplex>;
+
+  // Two vertices that are connected by an edge; the order of vertices
+  // changes the creator of the essential class.
+  SimplicialComplex K = {
+    Simplex( 0, T(0) ),
+    Simplex( 1, T(1) ),
+    Simplex( {0,1}, T(2) )
+  };
+
+  aleph::Vineyard<Simplex> V( K );
+
+  {
+    auto D = V.persistenceDiagrams();
+
+    ALEPH_ASSERT_EQUAL( D.size(),         1 );
+    ALEPH_ASSERT_EQUAL( D.front().size(), 2 );
+    ALEPH_ASSERT_EQUAL( D.front().betti(), 1 );
+  }
+
+  ALEPH_ASSERT_EQUAL( V.update( std::vector<T>( { T(1), T(0), T(2) } ) ), 1 );
+  ALEPH_ASSERT_EQUAL( V.index(0), 1 );
+  ALEPH_ASSERT_EQUAL( V.position(0), 1 );
+
+  {
+    auto D = V.persistenceDiagrams();
+    auto E = aleph::calculatePersistenceDiagrams( V.complex() );
+
+    ALEPH_ASSERT_THROW( D == E );
+  }
+
+  // An edge may not precede its vertices
+  ALEPH_EXPECT_EXCEPTION( V.transpose(1), std::runtime_error );
+  ALEPH_EXPECT_EXCEPTION( V.transpose(2), std::out_of_range );
+  ALEPH_EXPECT_EXCEPTION( V.update( std::vector<T>( { T(0) } ) ), std::runtime_error );
+
+  ALEPH_TEST_END();
+}
+
+template <class T> void testRandom()
+{
+  ALEPH_TEST_BEGIN( "Vineyard: random updates" );
+
+  using PointCloud        = aleph::containers::PointCloud<T>;
+  using Distance          = aleph::geometry::distances::Euclidean<T>;
+  using NearestNeighbours = aleph::geometry::BruteForce<PointCloud, Distance>;
+
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution<T> coordinate( T(0), T(1) );
+  std::normal_distribution<T> noise( T(0), T(0.05) );
+
+  unsigned n = 40;
+
+  PointCloud pc( n, 2 );
+
+  for( unsigned i = 0; i < n; i++ )
+    pc.set( i, { coordinate( rng ), coordinate( rng ) } );
+
+  auto K
+    = aleph::geometry::buildVietorisRipsComplex(
+      NearestNeighbours( pc ),
+      T( 0.3 ),
+      2
+  );
+
+  using Simplex           = typename decltype(K)::ValueType;
+  using SimplicialComplex = decltype(K);
+
+  std::vector<T> f( n );
+  for( auto&& x : f )
+    x = coordinate( rng );
+
+  {
+    auto values = lowerStar( K, f );
+
+    std::vector<Simplex> simplices( K.begin(), K.end() );
+
+    for( std::size_t i = 0; i < simplices.size(); i++ )
+      simplices[i].setData( values[i] );
+
+    K = SimplicialComplex( simplices.begin(), simplices.end() );
+  }
+
+  aleph::Vineyard<Simplex> V( K );
+
+  for( unsigned round = 0; round < 20; round++ )
+  {
+    for( auto&& x : f )
+      x += noise( rng );
+
+    auto values = lowerStar( K, f );
+
+    // Every other update uses a simplicial complex with new weights in
+    // order to mimic recalculating weights.
+    if( round % 2 == 0 )
+      V.update( values );
+    else
+    {
+      std::vector<Simplex> simplices( K.begin(), K.end() );
+
+      for( std::size_t i = 0; i < simplices.size(); i++ )
+        simplices[i].setData( values[i] );
+
+      V.update( SimplicialComplex( simplices.begin(), simplices.end() ) );
+    }
+
+    auto L = V.complex();
+
+    std::vector<Simplex> simplices( K.begin(), K.end() );
+    for( std::size_t i = 0; i < simplices.size(); i++ )
+      simplices[i].setData( values[i] );
+
+    SimplicialComplex M( simplices.begin(), simplices.end() );
+    M.sort( aleph::topology::filtrations::Data<Simplex>() );
+
+    ALEPH_ASSERT_THROW( std::equal( L.begin(), L.end(), M.begin() ) );
+
+    auto D = V.persistenceDiagrams();
+    auto E = aleph::calculatePersistenceDiagrams( M );
+
+    ALEPH_ASSERT_EQUAL( D.size(), E.size() );
+    ALEPH_ASSERT_THROW( D == E );
+
+    auto F = V.persistenceDiagrams( true );
+    auto G = aleph::calculatePersistenceDiagrams( M, false, true );
+
+    ALEPH_ASSERT_THROW( F == G );
+  }
+
+  ALEPH_ASSERT_THROW( V.transpositions() > 0 );
+
+  ALEPH_TEST_END();
+}
+
+int main( int, char** )
+{
+  testSimple<double>();
+  testSimple<float> ();
+
+  testRandom<double>();
+  testRandom<float> ();
+}
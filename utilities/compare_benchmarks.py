@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+#
+# This file is part of 'Aleph - A Library for Exploring Persistent
+# Homology'. It compares two sets of benchmark results, as written by
+# the `run_benchmarks` target, and reports all cases whose median time
+# or peak memory changed by more than a given threshold.
+#
+# Usage: compare_benchmarks.py [--threshold T] BASELINE CURRENT
+#
+# The script exits with a non-zero status if any case became slower or
+# requires more memory, so it can be used to detect regressions.
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+  results = dict()
+
+  with open(filename) as f:
+    for line in f:
+      line = line.strip()
+      if not line:
+        continue
+
+      result = json.loads(line)
+      key    = (result['benchmark'], result['case'], json.dumps(result['parameters'], sort_keys=True))
+
+      results[key] = result
+
+  return results
+
+
+def ratio(a, b):
+  return b / a if a > 0 else float('inf') if b > 0 else 1.0
+
+
+if __name__ == '__main__':
+  parser = argparse.ArgumentParser(description='Compares two sets of benchmark results')
+  parser.add_argument('--threshold', type=float, default=0.1, help='Relative change that is reported')
+  parser.add_argument('BASELINE')
+  parser.add_argument('CURRENT')
+
+  arguments = parser.parse_args()
+
+  baseline = load(arguments.BASELINE)
+  current  = load(arguments.CURRENT)
+
+  regressions = 0
+
+  for key in sorted(set(baseline) & set(current)):
+    old = baseline[key]
+    new = current[key]
+
+    time   = ratio(old['seconds_median'], new['seconds_median'])
+    memory = ratio(old['peak_bytes'],     new['peak_bytes'])
+
+    if abs(time - 1.0) <= arguments.threshold and abs(memory - 1.0) <= arguments.threshold:
+      continue
+
+    if time > 1.0 + arguments.threshold or memory > 1.0 + arguments.threshold:
+      regressions += 1
+      status = 'REGRESSION'
+    else:
+      status = 'IMPROVEMENT'
+
+    print('{:<12} {}/{} {}: time x{:.2f}, memory x{:.2f}'.format(status, key[0], key[1], key[2], time, memory))
+
+  for key in sorted(set(baseline) ^ set(current)):
+    print('{:<12} {}/{} {}'.format('MISSING' if key in baseline else 'NEW', key[0], key[1], key[2]))
+
+  sys.exit(1 if regressions > 0 else 0)